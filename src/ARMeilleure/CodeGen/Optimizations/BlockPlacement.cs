@@ -1,5 +1,6 @@
 using ARMeilleure.IntermediateRepresentation;
 using ARMeilleure.Translation;
+using System;
 using System.Diagnostics;
 using static ARMeilleure.IntermediateRepresentation.Operand.Factory;
 
@@ -14,6 +15,13 @@ namespace ARMeilleure.CodeGen.Optimizations
             BasicBlock block;
             BasicBlock nextBlock;
 
+            // If the function was profiled, lay out the blocks by following the hottest successor of each block
+            // first, so that the most executed paths fall through.
+            if (cfg.Entry.Weight != 0)
+            {
+                PlaceHotPaths(cfg);
+            }
+
             BasicBlock lastBlock = cfg.Blocks.Last;
 
             // Move cold blocks at the end of the list, so that they are emitted away from hot code.
@@ -68,5 +76,80 @@ namespace ARMeilleure.CodeGen.Optimizations
                 cfg.Update();
             }
         }
+
+        private static void PlaceHotPaths(ControlFlowGraph cfg)
+        {
+            BasicBlock[] seeds = new BasicBlock[cfg.Blocks.Count];
+            BasicBlock[] order = new BasicBlock[cfg.Blocks.Count];
+            bool[] placed = new bool[cfg.Blocks.Count];
+
+            int seedsCount = 0;
+
+            for (BasicBlock block = cfg.Blocks.First; block != null; block = block.ListNext)
+            {
+                seeds[seedsCount++] = block;
+            }
+
+            // Chains are started from the hottest block not yet placed. The sort is stable, so blocks with equal
+            // weights keep the order they were emitted in.
+            int[] keys = new int[seedsCount];
+
+            for (int i = 0; i < keys.Length; i++)
+            {
+                keys[i] = i;
+            }
+
+            Array.Sort(keys, (x, y) =>
+            {
+                int result = seeds[y].Weight.CompareTo(seeds[x].Weight);
+
+                return result != 0 ? result : x.CompareTo(y);
+            });
+
+            int orderCount = 0;
+            int seedIndex = 0;
+
+            BasicBlock current = cfg.Entry;
+
+            while (current != null)
+            {
+                placed[current.Index] = true;
+                order[orderCount++] = current;
+
+                BasicBlock next = null;
+
+                for (int i = 0; i < current.SuccessorsCount; i++)
+                {
+                    BasicBlock succ = current.GetSuccessor(i);
+
+                    if (!placed[succ.Index] &&
+                        succ.Frequency != BasicBlockFrequency.Cold &&
+                        (next == null || succ.Weight > next.Weight))
+                    {
+                        next = succ;
+                    }
+                }
+
+                while (next == null && seedIndex < keys.Length)
+                {
+                    BasicBlock seed = seeds[keys[seedIndex++]];
+
+                    if (!placed[seed.Index])
+                    {
+                        next = seed;
+                    }
+                }
+
+                current = next;
+            }
+
+            Debug.Assert(orderCount == cfg.Blocks.Count);
+
+            for (int i = 0; i < orderCount; i++)
+            {
+                cfg.Blocks.Remove(order[i]);
+                cfg.Blocks.AddLast(order[i]);
+            }
+        }
     }
 }
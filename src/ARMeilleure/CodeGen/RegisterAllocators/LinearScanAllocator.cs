@@ -25,6 +25,7 @@ namespace ARMeilleure.CodeGen.RegisterAllocators
         private LiveInterval[] _parentIntervals;
 
         private List<(IntrusiveList<Operation>, Operation)> _operationNodes;
+        private List<uint> _operationWeights;
         private int _operationsCount;
 
         private class AllocationContext
@@ -390,6 +391,13 @@ namespace ARMeilleure.CodeGen.RegisterAllocators
 
             Debug.Assert(currentFirstUse >= 0, "Current interval has no uses.");
 
+            if (_operationWeights != null &&
+                usePositions[selectedReg] >= currentFirstUse &&
+                blockedPositions[selectedReg] > current.GetEnd())
+            {
+                selectedReg = GetCheapestRegisterToSpill(context, current, regType, usePositions, blockedPositions, selectedReg);
+            }
+
             if (usePositions[selectedReg] < currentFirstUse)
             {
                 // All intervals on inactive and active are being used before current,
@@ -444,6 +452,59 @@ namespace ARMeilleure.CodeGen.RegisterAllocators
             }
         }
 
+        private int GetCheapestRegisterToSpill(
+            AllocationContext context,
+            LiveInterval current,
+            RegisterType regType,
+            ReadOnlySpan<int> usePositions,
+            ReadOnlySpan<int> blockedPositions,
+            int selectedReg)
+        {
+            // The intervals taken out of the register will have to be reloaded at their next use, so with a profile
+            // available, prefer the register whose intervals are next used on the least executed blocks. Only
+            // registers that would be available for the entire current lifetime are considered.
+            Span<ulong> spillCosts = stackalloc ulong[usePositions.Length];
+
+            spillCosts.Clear();
+
+            AddSpillCosts(context.Active, current, regType, spillCosts, overlapsOnly: false);
+            AddSpillCosts(context.Inactive, current, regType, spillCosts, overlapsOnly: true);
+
+            int currentFirstUse = current.FirstUse();
+
+            for (int index = 0; index < usePositions.Length; index++)
+            {
+                if (usePositions[index] > currentFirstUse &&
+                    blockedPositions[index] > current.GetEnd() &&
+                    spillCosts[index] < spillCosts[selectedReg])
+                {
+                    selectedReg = index;
+                }
+            }
+
+            return selectedReg;
+        }
+
+        private void AddSpillCosts(BitMap intervals, LiveInterval current, RegisterType regType, Span<ulong> spillCosts, bool overlapsOnly)
+        {
+            foreach (int iIndex in intervals)
+            {
+                LiveInterval interval = _intervals[iIndex];
+
+                if (interval.IsFixed || interval.Register.Type != regType || (overlapsOnly && !interval.Overlaps(current)))
+                {
+                    continue;
+                }
+
+                int nextUse = interval.NextUseAfter(current.GetStart());
+
+                if (nextUse != LiveInterval.NotFound)
+                {
+                    spillCosts[interval.Register.Index] += _operationWeights[nextUse / InstructionGap];
+                }
+            }
+        }
+
         private static int GetHighestValueIndex(ReadOnlySpan<int> span)
         {
             int highest = int.MinValue;
@@ -800,6 +861,7 @@ namespace ARMeilleure.CodeGen.RegisterAllocators
         private void NumberLocals(ControlFlowGraph cfg, int registersCount)
         {
             _operationNodes = new List<(IntrusiveList<Operation>, Operation)>();
+            _operationWeights = cfg.Entry.Weight != 0 ? new List<uint>() : null;
             _intervals = new List<LiveInterval>();
 
             for (int index = 0; index < registersCount; index++)
@@ -830,6 +892,7 @@ namespace ARMeilleure.CodeGen.RegisterAllocators
                 for (Operation node = block.Operations.First; node != default; node = node.ListNext)
                 {
                     _operationNodes.Add((block.Operations, node));
+                    _operationWeights?.Add(block.Weight);
 
                     for (int i = 0; i < node.DestinationsCount; i++)
                     {
@@ -868,6 +931,7 @@ namespace ARMeilleure.CodeGen.RegisterAllocators
                 {
                     // Pretend we have a dummy instruction on the empty block.
                     _operationNodes.Add((default, default));
+                    _operationWeights?.Add(block.Weight);
 
                     _operationsCount += InstructionGap;
                 }
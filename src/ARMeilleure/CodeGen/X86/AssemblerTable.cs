@@ -158,6 +158,10 @@ namespace ARMeilleure.CodeGen.X86
             Add(X86Instruction.Neg,           new InstructionInfo(0x030000f7, BadOp,      BadOp,      BadOp,      BadOp,      InstructionFlags.None));
             Add(X86Instruction.Not,           new InstructionInfo(0x020000f7, BadOp,      BadOp,      BadOp,      BadOp,      InstructionFlags.None));
             Add(X86Instruction.Or,            new InstructionInfo(0x00000009, 0x01000083, 0x01000081, BadOp,      0x0000000b, InstructionFlags.None));
+            Add(X86Instruction.Packssdw,      new InstructionInfo(BadOp,      BadOp,      BadOp,      BadOp,      0x00000f6b, InstructionFlags.Vex | InstructionFlags.Prefix66));
+            Add(X86Instruction.Packsswb,      new InstructionInfo(BadOp,      BadOp,      BadOp,      BadOp,      0x00000f63, InstructionFlags.Vex | InstructionFlags.Prefix66));
+            Add(X86Instruction.Packusdw,      new InstructionInfo(BadOp,      BadOp,      BadOp,      BadOp,      0x000f382b, InstructionFlags.Vex | InstructionFlags.Prefix66));
+            Add(X86Instruction.Packuswb,      new InstructionInfo(BadOp,      BadOp,      BadOp,      BadOp,      0x00000f67, InstructionFlags.Vex | InstructionFlags.Prefix66));
             Add(X86Instruction.Paddb,         new InstructionInfo(BadOp,      BadOp,      BadOp,      BadOp,      0x00000ffc, InstructionFlags.Vex | InstructionFlags.Prefix66));
             Add(X86Instruction.Paddd,         new InstructionInfo(BadOp,      BadOp,      BadOp,      BadOp,      0x00000ffe, InstructionFlags.Vex | InstructionFlags.Prefix66));
             Add(X86Instruction.Paddq,         new InstructionInfo(BadOp,      BadOp,      BadOp,      BadOp,      0x00000fd4, InstructionFlags.Vex | InstructionFlags.Prefix66));
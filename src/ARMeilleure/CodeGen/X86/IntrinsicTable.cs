@@ -77,6 +77,10 @@ namespace ARMeilleure.CodeGen.X86
             Add(Intrinsic.X86Mulps,         new IntrinsicInfo(X86Instruction.Mulps,         IntrinsicType.Binary));
             Add(Intrinsic.X86Mulsd,         new IntrinsicInfo(X86Instruction.Mulsd,         IntrinsicType.Binary));
             Add(Intrinsic.X86Mulss,         new IntrinsicInfo(X86Instruction.Mulss,         IntrinsicType.Binary));
+            Add(Intrinsic.X86Packssdw,      new IntrinsicInfo(X86Instruction.Packssdw,      IntrinsicType.Binary));
+            Add(Intrinsic.X86Packsswb,      new IntrinsicInfo(X86Instruction.Packsswb,      IntrinsicType.Binary));
+            Add(Intrinsic.X86Packusdw,      new IntrinsicInfo(X86Instruction.Packusdw,      IntrinsicType.Binary));
+            Add(Intrinsic.X86Packuswb,      new IntrinsicInfo(X86Instruction.Packuswb,      IntrinsicType.Binary));
             Add(Intrinsic.X86Paddb,         new IntrinsicInfo(X86Instruction.Paddb,         IntrinsicType.Binary));
             Add(Intrinsic.X86Paddd,         new IntrinsicInfo(X86Instruction.Paddd,         IntrinsicType.Binary));
             Add(Intrinsic.X86Paddq,         new IntrinsicInfo(X86Instruction.Paddq,         IntrinsicType.Binary));
@@ -95,6 +95,10 @@ namespace ARMeilleure.CodeGen.X86
         Neg,
         Not,
         Or,
+        Packssdw,
+        Packsswb,
+        Packusdw,
+        Packuswb,
         Paddb,
         Paddd,
         Paddq,
@@ -19,6 +19,9 @@ namespace ARMeilleure.Decoders.Optimizations
 
             const ulong Allowance = 4;
 
+            // Maximum distance past the end of the contiguous region for a block to be linked into the function.
+            const ulong MaxLinkDistance = 0x10000;
+
             Block entryBlock = blocks[entryBlockId];
 
             Block startBlock = entryBlock;
@@ -58,25 +61,49 @@ namespace ARMeilleure.Decoders.Optimizations
                 return blocks.ToArray(); // Nothing to do here.
             }
 
-            // Mark branches whose target is outside of the contiguous region as an exit block.
+            bool[] linked = new bool[blocks.Count];
+
             for (int i = startBlockIndex; i <= endBlockIndex; i++)
+            {
+                linked[i] = true;
+            }
+
+            if (ARMeilleure.Optimizations.UseSuperblocks)
+            {
+                // Blocks below the entry point are not linked, as the function is hashed for PTC and registered for
+                // invalidation from its entry point, so changes to their code would go unnoticed.
+                LinkOutOfLineBlocks(blocks, linked, entryAddress, endBlock.EndAddress + MaxLinkDistance);
+            }
+
+            // Mark branches whose target is outside of the function as an exit block.
+            for (int i = 0; i < blocks.Count; i++)
             {
                 Block block = blocks[i];
 
-                if (block.Branch != null && (block.Branch.Address > endBlock.EndAddress || block.Branch.EndAddress < startBlock.Address))
+                if (!linked[i])
+                {
+                    continue;
+                }
+
+                if (block.Branch != null && !IsLinked(blocks, linked, block.Branch))
                 {
                     block.Branch.Exit = true;
                 }
+
+                if (block.Next != null && !IsLinked(blocks, linked, block.Next))
+                {
+                    block.Next.Exit = true;
+                }
             }
 
             var newBlocks = new List<Block>(blocks.Count);
 
-            // Finally, rebuild decoded block list, ignoring blocks outside the contiguous range.
+            // Finally, rebuild decoded block list, ignoring blocks outside the function.
             for (int i = 0; i < blocks.Count; i++)
             {
                 Block block = blocks[i];
 
-                if (block.Exit || (i >= startBlockIndex && i <= endBlockIndex))
+                if (block.Exit || linked[i])
                 {
                     newBlocks.Add(block);
                 }
@@ -84,5 +111,77 @@ namespace ARMeilleure.Decoders.Optimizations
 
             return newBlocks.ToArray();
         }
+
+        private static void LinkOutOfLineBlocks(List<Block> blocks, bool[] linked, ulong minAddress, ulong maxAddress)
+        {
+            // Guest compilers often move cold paths or parts of a loop away from the rest of the function, and jump
+            // back once they are done. Treating those as separate functions would force the guest registers to be
+            // written back to the context and reloaded on every transition, so the blocks which are reached from the
+            // function and branch back into it are linked into it instead. Blocks which never return to the function
+            // are still considered tail calls.
+            bool[] reachable = new bool[blocks.Count];
+
+            Queue<int> workQueue = new();
+
+            for (int i = 0; i < blocks.Count; i++)
+            {
+                if (linked[i])
+                {
+                    reachable[i] = true;
+                    workQueue.Enqueue(i);
+                }
+            }
+
+            while (workQueue.TryDequeue(out int index))
+            {
+                Block block = blocks[index];
+
+                VisitSuccessor(block.Branch);
+                VisitSuccessor(block.Next);
+
+                void VisitSuccessor(Block succ)
+                {
+                    if (succ != null &&
+                        !succ.Exit &&
+                        succ.Address >= minAddress &&
+                        succ.EndAddress <= maxAddress &&
+                        TryGetIndex(blocks, succ, out int succIndex) &&
+                        !reachable[succIndex])
+                    {
+                        reachable[succIndex] = true;
+                        workQueue.Enqueue(succIndex);
+                    }
+                }
+            }
+
+            bool modified;
+
+            do
+            {
+                modified = false;
+
+                for (int i = 0; i < blocks.Count; i++)
+                {
+                    Block block = blocks[i];
+
+                    if (reachable[i] && !linked[i] && (IsLinked(blocks, linked, block.Branch) || IsLinked(blocks, linked, block.Next)))
+                    {
+                        linked[i] = true;
+                        modified = true;
+                    }
+                }
+            }
+            while (modified);
+        }
+
+        private static bool IsLinked(List<Block> blocks, bool[] linked, Block block)
+        {
+            return block != null && TryGetIndex(blocks, block, out int index) && linked[index];
+        }
+
+        private static bool TryGetIndex(List<Block> blocks, Block block, out int index)
+        {
+            return Decoder.BinarySearch(blocks, block.Address, out index) && blocks[index] == block;
+        }
     }
 }
@@ -1979,6 +1979,10 @@ namespace ARMeilleure.Instructions
 
                 context.Copy(GetVec(op.Rd), context.VectorZeroUpper96(res));
             }
+            else if (Optimizations.UseSse41)
+            {
+                EmitSse41RecipEstimateOpF(context, rSqrt: false, scalar: true);
+            }
             else
             {
                 EmitScalarUnaryOpF(context, (op1) =>
@@ -2009,6 +2013,10 @@ namespace ARMeilleure.Instructions
 
                 context.Copy(GetVec(op.Rd), res);
             }
+            else if (Optimizations.UseSse41)
+            {
+                EmitSse41RecipEstimateOpF(context, rSqrt: false, scalar: false);
+            }
             else
             {
                 EmitVectorUnaryOpF(context, (op1) =>
@@ -2434,6 +2442,10 @@ namespace ARMeilleure.Instructions
 
                 context.Copy(GetVec(op.Rd), context.VectorZeroUpper96(res));
             }
+            else if (Optimizations.UseSse41)
+            {
+                EmitSse41RecipEstimateOpF(context, rSqrt: true, scalar: true);
+            }
             else
             {
                 EmitScalarUnaryOpF(context, (op1) =>
@@ -2468,6 +2480,10 @@ namespace ARMeilleure.Instructions
 
                 context.Copy(GetVec(op.Rd), res);
             }
+            else if (Optimizations.UseSse41)
+            {
+                EmitSse41RecipEstimateOpF(context, rSqrt: true, scalar: false);
+            }
             else
             {
                 EmitVectorUnaryOpF(context, (op1) =>
@@ -3690,6 +3706,10 @@ namespace ARMeilleure.Instructions
             {
                 InstEmitSimdHelperArm64.EmitVectorSaturatingBinaryOpRd(context, Intrinsic.Arm64SqxtnV);
             }
+            else if (Optimizations.UseSse41 && ((OpCodeSimd)context.CurrOp).Size < 2)
+            {
+                EmitSse41VectorSaturatingNarrowOp(context, SaturatingNarrowFlags.VectorSxSx);
+            }
             else
             {
                 EmitSaturatingNarrowOp(context, SaturatingNarrowFlags.VectorSxSx);
@@ -3714,6 +3734,10 @@ namespace ARMeilleure.Instructions
             {
                 InstEmitSimdHelperArm64.EmitVectorSaturatingBinaryOpRd(context, Intrinsic.Arm64SqxtunV);
             }
+            else if (Optimizations.UseSse41 && ((OpCodeSimd)context.CurrOp).Size < 2)
+            {
+                EmitSse41VectorSaturatingNarrowOp(context, SaturatingNarrowFlags.VectorSxZx);
+            }
             else
             {
                 EmitSaturatingNarrowOp(context, SaturatingNarrowFlags.VectorSxZx);
@@ -4502,6 +4526,10 @@ namespace ARMeilleure.Instructions
             {
                 InstEmitSimdHelperArm64.EmitVectorSaturatingBinaryOpRd(context, Intrinsic.Arm64UqxtnV);
             }
+            else if (Optimizations.UseSse41 && ((OpCodeSimd)context.CurrOp).Size < 2)
+            {
+                EmitSse41VectorSaturatingNarrowOp(context, SaturatingNarrowFlags.VectorZxZx);
+            }
             else
             {
                 EmitSaturatingNarrowOp(context, SaturatingNarrowFlags.VectorZxZx);
@@ -4821,6 +4849,208 @@ namespace ARMeilleure.Instructions
             context.Copy(GetVec(op.Rd), res);
         }
 
+        // Bit exact FRECPE and FRSQRTE. Outside of the special cases (NaN, infinity, zero, subnormal, overflow and flush to
+        // zero), the estimate only depends on the sign, the exponent and the top 8 bits of the fraction, and is computed
+        // from them with the arithmetic used to build the estimate tables, which is exact in either precision. If any
+        // element hits a special case, the whole operation falls back to the soft float helpers, which also raise the
+        // FPSR exceptions.
+        private static void EmitSse41RecipEstimateOpF(ArmEmitterContext context, bool rSqrt, bool scalar)
+        {
+            OpCodeSimd op = (OpCodeSimd)context.CurrOp;
+
+            int sizeF = op.Size & 1;
+
+            Intrinsic addOp, mulOp, divOp, sqrtOp, maxOp, roundOp, cmpOp, addIOp, subIOp, shlOp, shrOp;
+
+            Operand one, minNormal, maxValue;
+
+            long signMask, expMask, fracTop8Mask, fracTop7Mask, expLsb;
+            int expShift;
+
+            if (sizeF == 0)
+            {
+                addOp = Intrinsic.X86Addps;
+                mulOp = Intrinsic.X86Mulps;
+                divOp = Intrinsic.X86Divps;
+                sqrtOp = Intrinsic.X86Sqrtps;
+                maxOp = Intrinsic.X86Maxps;
+                roundOp = Intrinsic.X86Roundps;
+                cmpOp = Intrinsic.X86Cmpps;
+                addIOp = Intrinsic.X86Paddd;
+                subIOp = Intrinsic.X86Psubd;
+                shlOp = Intrinsic.X86Pslld;
+                shrOp = Intrinsic.X86Psrld;
+
+                one = X86GetAllElements(context, 1f);
+                minNormal = X86GetAllElements(context, BitConverter.Int32BitsToSingle(0x00800000));
+
+                // When FPCR.FZ is set, FRECPE flushes the results that would be subnormal to zero.
+                maxValue = X86GetAllElements(context, rSqrt ? float.PositiveInfinity : MathF.Pow(2f, 126));
+
+                signMask = int.MinValue;
+                expMask = 0x7F800000;
+                fracTop8Mask = 0x007F8000;
+                fracTop7Mask = 0x007F0000;
+                expLsb = 0x00800000;
+                expShift = 23;
+            }
+            else /* if (sizeF == 1) */
+            {
+                addOp = Intrinsic.X86Addpd;
+                mulOp = Intrinsic.X86Mulpd;
+                divOp = Intrinsic.X86Divpd;
+                sqrtOp = Intrinsic.X86Sqrtpd;
+                maxOp = Intrinsic.X86Maxpd;
+                roundOp = Intrinsic.X86Roundpd;
+                cmpOp = Intrinsic.X86Cmppd;
+                addIOp = Intrinsic.X86Paddq;
+                subIOp = Intrinsic.X86Psubq;
+                shlOp = Intrinsic.X86Psllq;
+                shrOp = Intrinsic.X86Psrlq;
+
+                one = X86GetAllElements(context, 1d);
+                minNormal = X86GetAllElements(context, BitConverter.Int64BitsToDouble(0x0010000000000000L));
+                maxValue = X86GetAllElements(context, rSqrt ? double.PositiveInfinity : Math.Pow(2d, 1022));
+
+                signMask = long.MinValue;
+                expMask = 0x7FF0000000000000L;
+                fracTop8Mask = 0x000FF00000000000L;
+                fracTop7Mask = 0x000FE00000000000L;
+                expLsb = 0x0010000000000000L;
+                expShift = 52;
+            }
+
+            Operand GetAllElementsF(double value)
+            {
+                return sizeF == 0 ? X86GetAllElements(context, (float)value) : X86GetAllElements(context, value);
+            }
+
+            Operand GetAllElementsI(long value)
+            {
+                return sizeF == 0 ? X86GetAllElements(context, (int)value) : X86GetAllElements(context, value);
+            }
+
+            Operand n = GetVec(op.Rn);
+
+            // FRSQRTE takes the input as is, as negative inputs are invalid.
+            Operand value = rSqrt ? n : context.AddIntrinsic(Intrinsic.X86Pandn, GetAllElementsI(signMask), n);
+
+            // The comparisons are ordered, so NaNs are out of range.
+            Operand inRange = context.AddIntrinsic(Intrinsic.X86Pand,
+                context.AddIntrinsic(cmpOp, minNormal, value, Const((int)CmpCondition.LessThanOrEqual)),
+                context.AddIntrinsic(cmpOp, value, maxValue, Const((int)CmpCondition.LessThan)));
+
+            Operand allInRange;
+
+            if (scalar && sizeF == 0)
+            {
+                allInRange = context.SignExtend32(OperandType.I64, context.VectorExtract(OperandType.I32, inRange, 0));
+            }
+            else if (scalar || op.RegisterSize == RegisterSize.Simd64)
+            {
+                allInRange = context.VectorExtract(OperandType.I64, inRange, 0);
+            }
+            else
+            {
+                allInRange = context.BitwiseAnd(
+                    context.VectorExtract(OperandType.I64, inRange, 0),
+                    context.VectorExtract(OperandType.I64, inRange, 1));
+            }
+
+            Operand lblFast = Label();
+            Operand lblEnd = Label();
+
+            context.BranchIf(lblFast, allInRange, Const(-1L), Comparison.Equal, BasicBlockFrequency.Cold);
+
+            string name = rSqrt ? nameof(SoftFloat32.FPRSqrtEstimate) : nameof(SoftFloat32.FPRecipEstimate);
+
+            if (scalar)
+            {
+                EmitScalarUnaryOpF(context, (op1) => EmitSoftFloatCall(context, name, op1));
+            }
+            else
+            {
+                EmitVectorUnaryOpF(context, (op1) => EmitSoftFloatCall(context, name, op1));
+            }
+
+            context.Branch(lblEnd);
+
+            context.MarkLabel(lblFast);
+
+            Operand rcFloor = Const(X86GetRoundControl(FPRoundingMode.TowardsMinusInfinity));
+            Operand rcCeil = Const(X86GetRoundControl(FPRoundingMode.TowardsPlusInfinity));
+
+            Operand estimate;
+            Operand exp;
+
+            if (!rSqrt)
+            {
+                // a = (256 + frac[7:0]) * 2 + 1; b = floor(2^19 / a); estimate = (b + 1) / 2.
+                Operand a = context.AddIntrinsic(Intrinsic.X86Pand, n, GetAllElementsI(fracTop8Mask));
+
+                a = context.AddIntrinsic(Intrinsic.X86Por, a, one);
+                a = context.AddIntrinsic(addOp, context.AddIntrinsic(mulOp, a, GetAllElementsF(512d)), one);
+
+                Operand b = context.AddIntrinsic(roundOp, context.AddIntrinsic(divOp, GetAllElementsF(1 << 19), a), rcFloor);
+
+                estimate = context.AddIntrinsic(addOp, b, one);
+
+                // resultExp = 253 - exp (2045 - exp for doubles), with the sign of the input.
+                exp = context.AddIntrinsic(Intrinsic.X86Pand, n, GetAllElementsI(expMask));
+                exp = context.AddIntrinsic(subIOp, GetAllElementsI((sizeF == 0 ? 253L : 2045L) << expShift), exp);
+
+                exp = context.AddIntrinsic(Intrinsic.X86Por, exp, context.AddIntrinsic(Intrinsic.X86Pand, n, GetAllElementsI(signMask)));
+            }
+            else
+            {
+                // Odd exponent: a = (128 + frac[7:1]) * 2 + 1; even exponent: a = ((256 + frac[7:1] * 2) + 1) * 2.
+                // Both are computed as s * (257 + frac[7:1] * 2), where s is 2 when the exponent is even and 1 otherwise.
+                // b + 1 = max(513, ceil(sqrt(2^28 / a))); estimate = (b + 1) / 2.
+                Operand even = context.AddIntrinsic(Intrinsic.X86Pandn, n, GetAllElementsI(expLsb));
+
+                Operand s = context.AddIntrinsic(addIOp, one, even);
+
+                Operand a = context.AddIntrinsic(Intrinsic.X86Pand, n, GetAllElementsI(fracTop7Mask));
+
+                a = context.AddIntrinsic(addIOp, context.AddIntrinsic(Intrinsic.X86Por, a, one), even);
+                a = context.AddIntrinsic(addOp, context.AddIntrinsic(mulOp, a, GetAllElementsF(256d)), s);
+
+                Operand b = context.AddIntrinsic(sqrtOp, context.AddIntrinsic(divOp, GetAllElementsF(1 << 28), a));
+
+                b = context.AddIntrinsic(roundOp, b, rcCeil);
+
+                estimate = context.AddIntrinsic(maxOp, b, GetAllElementsF(513d));
+
+                // resultExp = (380 - exp) / 2 ((3068 - exp) / 2 for doubles), the input is positive.
+                exp = context.AddIntrinsic(shrOp, n, Const(expShift));
+                exp = context.AddIntrinsic(subIOp, GetAllElementsI(sizeF == 0 ? 380L : 3068L), exp);
+                exp = context.AddIntrinsic(shrOp, exp, Const(1));
+                exp = context.AddIntrinsic(shlOp, exp, Const(expShift));
+            }
+
+            estimate = context.AddIntrinsic(roundOp, context.AddIntrinsic(mulOp, estimate, GetAllElementsF(0.5d)), rcFloor);
+
+            // The estimate is in the [256, 511] range, so the top 8 bits of the fraction of estimate / 256 are its low
+            // 8 bits.
+            estimate = context.AddIntrinsic(mulOp, estimate, GetAllElementsF(1d / 256d));
+            estimate = context.AddIntrinsic(Intrinsic.X86Pand, estimate, GetAllElementsI(fracTop8Mask));
+
+            Operand res = context.AddIntrinsic(Intrinsic.X86Por, estimate, exp);
+
+            if (scalar)
+            {
+                res = sizeF == 0 ? context.VectorZeroUpper96(res) : context.VectorZeroUpper64(res);
+            }
+            else if (op.RegisterSize == RegisterSize.Simd64)
+            {
+                res = context.VectorZeroUpper64(res);
+            }
+
+            context.Copy(GetVec(op.Rd), res);
+
+            context.MarkLabel(lblEnd);
+        }
+
         private static Operand EmitSse41Round32Exp8OpF(ArmEmitterContext context, Operand value, bool scalar)
         {
             Operand roundMask;
@@ -1670,6 +1670,67 @@ namespace ARMeilleure.Instructions
             context.Copy(d, res);
         }
 
+        public static void EmitSse41VectorSaturatingNarrowOp(ArmEmitterContext context, SaturatingNarrowFlags flags)
+        {
+            OpCodeSimd op = (OpCodeSimd)context.CurrOp;
+
+            Debug.Assert((flags & SaturatingNarrowFlags.Scalar) == 0);
+            Debug.Assert(op.Size < 2);
+
+            bool signedSrc = (flags & SaturatingNarrowFlags.SignedSrc) != 0;
+            bool signedDst = (flags & SaturatingNarrowFlags.SignedDst) != 0;
+
+            Operand n = GetVec(op.Rn);
+
+            Operand res;
+
+            if (signedSrc)
+            {
+                Intrinsic packInst = signedDst
+                    ? (op.Size == 0 ? Intrinsic.X86Packsswb : Intrinsic.X86Packssdw)
+                    : (op.Size == 0 ? Intrinsic.X86Packuswb : Intrinsic.X86Packusdw);
+
+                res = context.AddIntrinsic(packInst, n, n);
+            }
+            else
+            {
+                // The packs take signed sources, so the unsigned values are clamped to the destination range first.
+                Debug.Assert(!signedDst);
+
+                Operand max = op.Size == 0 ? X86GetAllElements(context, (short)0xFF) : X86GetAllElements(context, 0xFFFF);
+
+                Operand clamped = context.AddIntrinsic(op.Size == 0 ? Intrinsic.X86Pminuw : Intrinsic.X86Pminud, n, max);
+
+                res = context.AddIntrinsic(op.Size == 0 ? Intrinsic.X86Packuswb : Intrinsic.X86Packusdw, clamped, clamped);
+            }
+
+            // An element saturated if extending it back does not give the source element.
+            Intrinsic extendInst = signedDst
+                ? (op.Size == 0 ? Intrinsic.X86Pmovsxbw : Intrinsic.X86Pmovsxwd)
+                : (op.Size == 0 ? Intrinsic.X86Pmovzxbw : Intrinsic.X86Pmovzxwd);
+
+            Operand diff = context.AddIntrinsic(Intrinsic.X86Pxor, context.AddIntrinsic(extendInst, res), n);
+
+            Operand saturated = context.BitwiseOr(
+                context.VectorExtract(OperandType.I64, diff, 0),
+                context.VectorExtract(OperandType.I64, diff, 1));
+
+            SetFpFlag(context, FPState.QcFlag, context.BitwiseOr(GetFpFlag(FPState.QcFlag), context.ICompareNotEqual(saturated, Const(0L))));
+
+            Operand d = GetVec(op.Rd);
+
+            if (op.RegisterSize == RegisterSize.Simd128)
+            {
+                res = context.AddIntrinsic(Intrinsic.X86Punpcklqdq, d, res);
+            }
+            else
+            {
+                res = context.VectorZeroUpper64(res);
+            }
+
+            context.Copy(d, res);
+        }
+
         // long SignedSignSatQ(long op, int size);
         public static Operand EmitSignedSignSatQ(ArmEmitterContext context, Operand op, int size)
         {
@@ -15,6 +15,7 @@ namespace ARMeilleure.IntermediateRepresentation
 
         public int Index { get; set; }
         public BasicBlockFrequency Frequency { get; set; }
+        public uint Weight { get; set; }
         public BasicBlock ListPrevious { get; set; }
         public BasicBlock ListNext { get; set; }
         public IntrusiveList<Operation> Operations { get; }
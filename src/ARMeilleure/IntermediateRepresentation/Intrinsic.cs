@@ -74,6 +74,10 @@ namespace ARMeilleure.IntermediateRepresentation
         X86Mulps,
         X86Mulsd,
         X86Mulss,
+        X86Packssdw,
+        X86Packsswb,
+        X86Packusdw,
+        X86Packuswb,
         X86Paddb,
         X86Paddd,
         X86Paddq,
@@ -7,6 +7,7 @@ namespace ARMeilleure.Memory
         IntPtr Pointer { get; }
 
         void Commit(ulong offset, ulong size);
+        void Decommit(ulong offset, ulong size);
 
         void MapAsRw(ulong offset, ulong size);
         void MapAsRx(ulong offset, ulong size);
@@ -6,6 +6,7 @@ using System.Collections.Generic;
 using System.Diagnostics;
 using System.Linq;
 using System.Text;
+using System.Threading;
 
 namespace ARMeilleure
 {
@@ -20,6 +21,45 @@ namespace ARMeilleure
 
         private static readonly ConcurrentDictionary<ulong, long> _ticksPerFunction;
 
+        private static long _translationStallTicks;
+
+        /// <summary>
+        /// Total <see cref="Stopwatch"/> ticks guest threads spent waiting on the translation of a function
+        /// that was not in the cache yet.
+        /// </summary>
+        public static long TranslationStallTicks => Interlocked.Read(ref _translationStallTicks);
+
+        private static int _rejitQueueDepth;
+        private static int _rejitQueueMaxDepth;
+        private static long _rejitRequestsCount;
+        private static long _rejitQueueLatencyTicks;
+        private static long _rejitQueueMaxLatencyTicks;
+
+        /// <summary>
+        /// Number of functions currently waiting to be translated again with high quality code.
+        /// </summary>
+        public static int RejitQueueDepth => Volatile.Read(ref _rejitQueueDepth);
+
+        /// <summary>
+        /// Highest number of functions that were waiting at once to be translated again with high quality code.
+        /// </summary>
+        public static int RejitQueueMaxDepth => Volatile.Read(ref _rejitQueueMaxDepth);
+
+        /// <summary>
+        /// Number of rejit requests taken by the background translator threads.
+        /// </summary>
+        public static long RejitRequestsCount => Interlocked.Read(ref _rejitRequestsCount);
+
+        /// <summary>
+        /// Total <see cref="Stopwatch"/> ticks rejit requests spent in the queue before being taken.
+        /// </summary>
+        public static long RejitQueueLatencyTicks => Interlocked.Read(ref _rejitQueueLatencyTicks);
+
+        /// <summary>
+        /// Highest number of <see cref="Stopwatch"/> ticks a rejit request spent in the queue before being taken.
+        /// </summary>
+        public static long RejitQueueMaxLatencyTicks => Interlocked.Read(ref _rejitQueueMaxLatencyTicks);
+
         static Statistics()
         {
             _ticksPerFunction = new ConcurrentDictionary<ulong, long>();
@@ -53,6 +93,59 @@ namespace ARMeilleure
 #endif
         }
 
+        /// <summary>
+        /// Adds time a guest thread spent waiting on the translation of a function, for any of the JIT backends.
+        /// </summary>
+        /// <param name="ticks">Number of <see cref="Stopwatch"/> ticks the thread was stalled</param>
+        public static void RecordTranslationStall(long ticks)
+        {
+            Interlocked.Add(ref _translationStallTicks, ticks);
+        }
+
+        internal static void RecordRejitEnqueue()
+        {
+            int depth = Interlocked.Increment(ref _rejitQueueDepth);
+            int maxDepth = Volatile.Read(ref _rejitQueueMaxDepth);
+
+            while (depth > maxDepth)
+            {
+                int oldMaxDepth = Interlocked.CompareExchange(ref _rejitQueueMaxDepth, depth, maxDepth);
+
+                if (oldMaxDepth == maxDepth)
+                {
+                    break;
+                }
+
+                maxDepth = oldMaxDepth;
+            }
+        }
+
+        internal static void RecordRejitDequeue(long latencyTicks)
+        {
+            Interlocked.Decrement(ref _rejitQueueDepth);
+            Interlocked.Increment(ref _rejitRequestsCount);
+            Interlocked.Add(ref _rejitQueueLatencyTicks, latencyTicks);
+
+            long maxLatencyTicks = Interlocked.Read(ref _rejitQueueMaxLatencyTicks);
+
+            while (latencyTicks > maxLatencyTicks)
+            {
+                long oldMaxLatencyTicks = Interlocked.CompareExchange(ref _rejitQueueMaxLatencyTicks, latencyTicks, maxLatencyTicks);
+
+                if (oldMaxLatencyTicks == maxLatencyTicks)
+                {
+                    break;
+                }
+
+                maxLatencyTicks = oldMaxLatencyTicks;
+            }
+        }
+
+        internal static void RecordRejitQueueCleared(int count)
+        {
+            Interlocked.Add(ref _rejitQueueDepth, -count);
+        }
+
         internal static void ResumeTimer()
         {
 #if M_PROFILE
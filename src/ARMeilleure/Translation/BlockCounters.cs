@@ -0,0 +1,126 @@
+using ARMeilleure.Common;
+using ARMeilleure.Decoders;
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using static ARMeilleure.Translation.PTC.PtcProfiler;
+
+namespace ARMeilleure.Translation
+{
+    /// <summary>
+    /// Represents the counters of the blocks of a function translated with instrumentation.
+    /// </summary>
+    /// <remarks>
+    /// Every edge of the guest control flow graph ends at the start of a block, so the count of a block is the sum of
+    /// the counts of its incoming edges, or the count of the edge itself when the block has a single predecessor.
+    /// </remarks>
+    sealed class BlockCounters : IDisposable
+    {
+        private readonly Block[] _blocks;
+        private readonly Counter<uint>[] _counters;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="BlockCounters"/> class with a counter for each of the
+        /// specified blocks that is not an exit block.
+        /// </summary>
+        /// <param name="countTable"><see cref="EntryTable{T}"/> instance the counters are allocated from</param>
+        /// <param name="blocks">Decoded blocks of the function</param>
+        public BlockCounters(EntryTable<uint> countTable, Block[] blocks)
+        {
+            _blocks = blocks;
+            _counters = new Counter<uint>[blocks.Length];
+
+            for (int index = 0; index < blocks.Length; index++)
+            {
+                if (!blocks[index].Exit)
+                {
+                    _counters[index] = new Counter<uint>(countTable);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the counter of the block at the specified index.
+        /// </summary>
+        /// <param name="index">Index of the block</param>
+        /// <returns>Counter of the block, or <see langword="null"/> if it is an exit block</returns>
+        public Counter<uint> GetCounter(int index)
+        {
+            return _counters[index];
+        }
+
+        /// <summary>
+        /// Takes a snapshot of the counters of the blocks which were entered at least once.
+        /// </summary>
+        /// <returns>Profile of the blocks, sorted by address</returns>
+        public List<BlockProfile> GetProfile()
+        {
+            List<BlockProfile> profile = new();
+
+            for (int index = 0; index < _counters.Length; index++)
+            {
+                if (_counters[index] == null)
+                {
+                    continue;
+                }
+
+                uint count = Volatile.Read(ref _counters[index].Value);
+
+                if (count != 0)
+                {
+                    profile.Add(new BlockProfile(_blocks[index].Address, count));
+                }
+            }
+
+            profile.Sort((x, y) => x.Address.CompareTo(y.Address));
+
+            return profile;
+        }
+
+        /// <summary>
+        /// Gets the count of the block at the specified address from a profile.
+        /// </summary>
+        /// <param name="profile">Profile sorted by address</param>
+        /// <param name="address">Address of the block</param>
+        /// <returns>Count of the block, or 0 if it is not in the profile</returns>
+        public static uint GetWeight(List<BlockProfile> profile, ulong address)
+        {
+            int left = 0;
+            int right = profile.Count - 1;
+
+            while (left <= right)
+            {
+                int middle = left + ((right - left) >> 1);
+
+                ulong middleAddress = profile[middle].Address;
+
+                if (middleAddress == address)
+                {
+                    return profile[middle].Count;
+                }
+
+                if (middleAddress < address)
+                {
+                    left = middle + 1;
+                }
+                else
+                {
+                    right = middle - 1;
+                }
+            }
+
+            return 0;
+        }
+
+        /// <summary>
+        /// Releases all resources used by the <see cref="BlockCounters"/> instance.
+        /// </summary>
+        public void Dispose()
+        {
+            foreach (Counter<uint> counter in _counters)
+            {
+                counter?.Dispose();
+            }
+        }
+    }
+}
@@ -109,6 +109,72 @@ namespace ARMeilleure.Translation.Cache
             }
         }
 
+        public static void Map(ReadOnlySpan<CompiledFunction> funcs, Span<IntPtr> funcPtrs)
+        {
+            Debug.Assert(funcs.Length == funcPtrs.Length);
+
+            if (funcs.IsEmpty)
+            {
+                return;
+            }
+
+            lock (_lock)
+            {
+                Debug.Assert(_initialized);
+
+                if (OperatingSystem.IsMacOS() && RuntimeInformation.ProcessArchitecture == Architecture.Arm64)
+                {
+                    for (int i = 0; i < funcs.Length; i++)
+                    {
+                        funcPtrs[i] = Map(funcs[i]);
+                    }
+
+                    return;
+                }
+
+                int[] funcOffsets = new int[funcs.Length];
+
+                int regionStart = int.MaxValue;
+                int regionEnd = 0;
+
+                for (int i = 0; i < funcs.Length; i++)
+                {
+                    funcOffsets[i] = Allocate(funcs[i].Code.Length);
+
+                    regionStart = Math.Min(regionStart, funcOffsets[i]);
+                    regionEnd = Math.Max(regionEnd, funcOffsets[i] + funcs[i].Code.Length);
+                }
+
+                // The protection is only changed once for all the functions, instead of twice for each of them.
+                ReprotectAsWritable(regionStart, regionEnd - regionStart);
+
+                for (int i = 0; i < funcs.Length; i++)
+                {
+                    funcPtrs[i] = _jitRegion.Pointer + funcOffsets[i];
+
+                    Marshal.Copy(funcs[i].Code, 0, funcPtrs[i], funcs[i].Code.Length);
+                }
+
+                ReprotectAsExecutable(regionStart, regionEnd - regionStart);
+
+                for (int i = 0; i < funcs.Length; i++)
+                {
+                    byte[] code = funcs[i].Code;
+
+                    if (OperatingSystem.IsWindows() && RuntimeInformation.ProcessArchitecture == Architecture.Arm64)
+                    {
+                        FlushInstructionCache(Process.GetCurrentProcess().Handle, funcPtrs[i], (UIntPtr)code.Length);
+                    }
+                    else
+                    {
+                        _jitCacheInvalidator?.Invalidate(funcPtrs[i], (ulong)code.Length);
+                    }
+
+                    Add(funcOffsets[i], code.Length, funcs[i].UnwindInfo);
+                }
+            }
+        }
+
         public static void Unmap(IntPtr pointer)
         {
             lock (_lock)
@@ -21,6 +21,11 @@ namespace ARMeilleure.Translation
         private bool _needsNewBlock;
         private BasicBlockFrequency _nextBlockFreq;
 
+        /// <summary>
+        /// Gets or sets the profiled execution count given to the blocks created from now on, or 0 if unknown.
+        /// </summary>
+        public uint BlockWeight { get; set; }
+
         public EmitterContext()
         {
             _localsCount = 0;
@@ -658,6 +663,7 @@ namespace ARMeilleure.Translation
 
             _irBlock = nextBlock;
             _irBlock.Frequency = _nextBlockFreq;
+            _irBlock.Weight = BlockWeight;
 
             _needsNewBlock = false;
             _nextBlockFreq = BasicBlockFrequency.Default;
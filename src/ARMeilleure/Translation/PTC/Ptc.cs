@@ -3,10 +3,10 @@ using ARMeilleure.CodeGen.Linking;
 using ARMeilleure.CodeGen.Unwinding;
 using ARMeilleure.Common;
 using ARMeilleure.Memory;
+using ARMeilleure.Translation.Cache;
 using Ryujinx.Common;
 using Ryujinx.Common.Configuration;
 using Ryujinx.Common.Logging;
-using Ryujinx.Common.Memory;
 using System;
 using System.Buffers.Binary;
 using System.Collections.Generic;
@@ -26,10 +26,9 @@ namespace ARMeilleure.Translation.PTC
 
     class Ptc : IPtcLoadState
     {
-        private const string OuterHeaderMagicString = "PTCohd\0\0";
-        private const string InnerHeaderMagicString = "PTCihd\0\0";
+        private const string HeaderMagicString = "PTCv2hd\0";
 
-        private const uint InternalVersion = 6950; //! To be incremented manually for each change to the ARMeilleure project.
+        private const uint InternalVersion = 6952; //! To be incremented manually for each change to the ARMeilleure project.
 
         private const string ActualDir = "0";
         private const string BackupDir = "1";
@@ -41,23 +40,27 @@ namespace ARMeilleure.Translation.PTC
         public static readonly Symbol CountTableSymbol = new(SymbolType.Special, 2);
         public static readonly Symbol DispatchStubSymbol = new(SymbolType.Special, 3);
 
-        private const byte FillingByte = 0x00;
         private const CompressionLevel SaveCompressionLevel = CompressionLevel.Fastest;
 
         public PtcProfiler Profiler { get; }
 
         // Carriers.
-        private MemoryStream _infosStream;
-        private List<byte[]> _codesList;
-        private MemoryStream _relocsStream;
-        private MemoryStream _unwindInfosStream;
+        private List<(IndexEntry entry, byte[] chunk)> _newEntries;
 
-        private readonly ulong _outerHeaderMagic;
-        private readonly ulong _innerHeaderMagic;
+        // Cache file loaded from disk, whose functions are decoded the first time they are dispatched.
+        private PtcMappedFile _cacheFile;
+        private int _indexEntriesCount;
+        private bool[] _invalidEntries;
+
+        // Journal of the functions translated after boot, merged into the cache file on the next one.
+        private PtcJournal _journal;
+
+        private readonly ulong _headerMagic;
 
         private readonly ManualResetEvent _waitEvent;
 
         private readonly object _lock;
+        private readonly ReaderWriterLockSlim _cacheFileLock;
 
         private bool _disposed;
 
@@ -71,6 +74,8 @@ namespace ARMeilleure.Translation.PTC
 
         public PtcState State { get; private set; }
 
+        public bool IsJournaling => _journal != null;
+
         // Progress reporting helpers.
         private volatile int _translateCount;
         private volatile int _translateTotalCount;
@@ -82,12 +87,12 @@ namespace ARMeilleure.Translation.PTC
 
             InitializeCarriers();
 
-            _outerHeaderMagic = BinaryPrimitives.ReadUInt64LittleEndian(EncodingCache.UTF8NoBOM.GetBytes(OuterHeaderMagicString).AsSpan());
-            _innerHeaderMagic = BinaryPrimitives.ReadUInt64LittleEndian(EncodingCache.UTF8NoBOM.GetBytes(InnerHeaderMagicString).AsSpan());
+            _headerMagic = BinaryPrimitives.ReadUInt64LittleEndian(EncodingCache.UTF8NoBOM.GetBytes(HeaderMagicString).AsSpan());
 
             _waitEvent = new ManualResetEvent(true);
 
             _lock = new object();
+            _cacheFileLock = new ReaderWriterLockSlim();
 
             _disposed = false;
 
@@ -143,6 +148,7 @@ namespace ARMeilleure.Translation.PTC
             CachePathBackup = Path.Combine(workPathBackup, DisplayVersion);
 
             PreLoad();
+            MergeJournal();
             Profiler.PreLoad();
 
             Enable();
@@ -150,35 +156,32 @@ namespace ARMeilleure.Translation.PTC
 
         private void InitializeCarriers()
         {
-            _infosStream = MemoryStreamManager.Shared.GetStream();
-            _codesList = new List<byte[]>();
-            _relocsStream = MemoryStreamManager.Shared.GetStream();
-            _unwindInfosStream = MemoryStreamManager.Shared.GetStream();
+            _newEntries = new List<(IndexEntry entry, byte[] chunk)>();
         }
 
         private void DisposeCarriers()
         {
-            _infosStream.Dispose();
-            _codesList.Clear();
-            _relocsStream.Dispose();
-            _unwindInfosStream.Dispose();
+            _newEntries.Clear();
         }
 
         private bool AreCarriersEmpty()
         {
-            return _infosStream.Length == 0L && _codesList.Count == 0 && _relocsStream.Length == 0L && _unwindInfosStream.Length == 0L;
+            return _newEntries.Count == 0;
         }
 
         private void ResetCarriersIfNeeded()
         {
-            if (AreCarriersEmpty())
+            lock (_lock)
             {
-                return;
-            }
+                if (AreCarriersEmpty())
+                {
+                    return;
+                }
 
-            DisposeCarriers();
+                DisposeCarriers();
 
-            InitializeCarriers();
+                InitializeCarriers();
+            }
         }
 
         private void PreLoad()
@@ -189,226 +192,302 @@ namespace ARMeilleure.Translation.PTC
             FileInfo fileInfoActual = new(fileNameActual);
             FileInfo fileInfoBackup = new(fileNameBackup);
 
-            if (fileInfoActual.Exists && fileInfoActual.Length != 0L)
+            _cacheFileLock.EnterWriteLock();
+
+            try
             {
-                if (!Load(fileNameActual, false))
+                ReleaseCacheFile();
+
+                if (fileInfoActual.Exists && fileInfoActual.Length != 0L)
                 {
-                    if (fileInfoBackup.Exists && fileInfoBackup.Length != 0L)
+                    if (!Load(fileNameActual, false))
                     {
-                        Load(fileNameBackup, true);
+                        if (fileInfoBackup.Exists && fileInfoBackup.Length != 0L)
+                        {
+                            Load(fileNameBackup, true);
+                        }
                     }
                 }
+                else if (fileInfoBackup.Exists && fileInfoBackup.Length != 0L)
+                {
+                    Load(fileNameBackup, true);
+                }
             }
-            else if (fileInfoBackup.Exists && fileInfoBackup.Length != 0L)
+            finally
             {
-                Load(fileNameBackup, true);
+                _cacheFileLock.ExitWriteLock();
             }
         }
 
-        private unsafe bool Load(string fileName, bool isBackup)
+        private bool Load(string fileName, bool isBackup)
         {
-            using (FileStream compressedStream = new(fileName, FileMode.Open))
-            using (DeflateStream deflateStream = new(compressedStream, CompressionMode.Decompress, true))
+            FileStream stream = new(fileName, FileMode.Open);
+
+            if (!IsHeaderValid(stream, out Header header))
             {
-                OuterHeader outerHeader = DeserializeStructure<OuterHeader>(compressedStream);
+                InvalidateCacheFile(stream);
+                stream.Dispose();
 
-                if (!outerHeader.IsHeaderValid())
-                {
-                    InvalidateCompressedStream(compressedStream);
+                return false;
+            }
 
-                    return false;
-                }
+            // Only the headers and the index are validated here, the code of each function is read
+            // and checked the first time it is dispatched.
+            PtcMappedFile cacheFile = new(stream);
 
-                if (outerHeader.Magic != _outerHeaderMagic)
-                {
-                    InvalidateCompressedStream(compressedStream);
+            if (!IsIndexValid(cacheFile, header))
+            {
+                cacheFile.Dispose();
 
-                    return false;
-                }
+                using FileStream invalidStream = new(fileName, FileMode.Open);
 
-                if (outerHeader.CacheFileVersion != InternalVersion)
-                {
-                    InvalidateCompressedStream(compressedStream);
+                InvalidateCacheFile(invalidStream);
 
-                    return false;
-                }
+                return false;
+            }
 
-                if (outerHeader.Endianness != GetEndianness())
-                {
-                    InvalidateCompressedStream(compressedStream);
+            _cacheFile = cacheFile;
+            _indexEntriesCount = header.IndexEntriesCount;
+            _invalidEntries = new bool[header.IndexEntriesCount];
 
-                    return false;
-                }
+            Logger.Info?.Print(LogClass.Ptc, $"{(isBackup ? "Loaded Backup Translation Cache" : "Loaded Translation Cache")} (size: {cacheFile.Length} bytes, translated functions: {header.IndexEntriesCount}).");
 
-                if (outerHeader.FeatureInfo != GetFeatureInfo())
-                {
-                    InvalidateCompressedStream(compressedStream);
+            return true;
+        }
 
-                    return false;
-                }
+        private bool IsHeaderValid(FileStream stream, out Header header)
+        {
+            header = default;
 
-                if (outerHeader.MemoryManagerMode != GetMemoryManagerMode())
-                {
-                    InvalidateCompressedStream(compressedStream);
+            if (stream.Length < Unsafe.SizeOf<Header>())
+            {
+                return false;
+            }
 
-                    return false;
-                }
+            header = DeserializeStructure<Header>(stream);
 
-                if (outerHeader.OSPlatform != GetOSPlatform())
-                {
-                    InvalidateCompressedStream(compressedStream);
+            if (!header.IsHeaderValid() ||
+                header.Magic != _headerMagic ||
+                header.CacheFileVersion != InternalVersion ||
+                header.Endianness != GetEndianness() ||
+                header.FeatureInfo != GetFeatureInfo() ||
+                header.MemoryManagerMode != GetMemoryManagerMode() ||
+                header.OSPlatform != GetOSPlatform() ||
+                header.Architecture != (uint)RuntimeInformation.ProcessArchitecture)
+            {
+                return false;
+            }
+
+            if (header.IndexEntriesCount < 0 || header.IndexEntriesCount > int.MaxValue / Unsafe.SizeOf<IndexEntry>())
+            {
+                return false;
+            }
+
+            return Unsafe.SizeOf<Header>() + (long)header.IndexEntriesCount * Unsafe.SizeOf<IndexEntry>() <= stream.Length;
+        }
+
+        private static bool IsIndexValid(PtcMappedFile cacheFile, Header header)
+        {
+            int indexLength = header.IndexEntriesCount * Unsafe.SizeOf<IndexEntry>();
+
+            ReadOnlySpan<byte> indexBytes = cacheFile.GetSpan(Unsafe.SizeOf<Header>(), indexLength);
+
+            if (XXHash128.ComputeHash(indexBytes) != header.IndexHash)
+            {
+                return false;
+            }
 
+            ReadOnlySpan<IndexEntry> index = MemoryMarshal.Cast<byte, IndexEntry>(indexBytes);
+
+            long chunksStart = Unsafe.SizeOf<Header>() + (long)indexLength;
+
+            for (int i = 0; i < index.Length; i++)
+            {
+                ref readonly IndexEntry entry = ref index[i];
+
+                if (entry.ChunkOffset < chunksStart || entry.ChunkLength < 0 || entry.ChunkOffset + entry.ChunkLength > cacheFile.Length)
+                {
                     return false;
                 }
 
-                if (outerHeader.Architecture != (uint)RuntimeInformation.ProcessArchitecture)
+                // Lookups do a binary search on the guest address.
+                if (i != 0 && index[i - 1].Address >= entry.Address)
                 {
-                    InvalidateCompressedStream(compressedStream);
-
                     return false;
                 }
+            }
 
-                IntPtr intPtr = IntPtr.Zero;
+            return true;
+        }
 
-                try
-                {
-                    intPtr = Marshal.AllocHGlobal(new IntPtr(outerHeader.UncompressedStreamSize));
+        private static void InvalidateCacheFile(FileStream stream)
+        {
+            stream.SetLength(0L);
+        }
 
-                    using UnmanagedMemoryStream stream = new((byte*)intPtr.ToPointer(), outerHeader.UncompressedStreamSize, outerHeader.UncompressedStreamSize, FileAccess.ReadWrite);
-                    try
-                    {
-                        deflateStream.CopyTo(stream);
-                    }
-                    catch
-                    {
-                        InvalidateCompressedStream(compressedStream);
+        private void ReleaseCacheFile()
+        {
+            _cacheFile?.Dispose();
+            _cacheFile = null;
 
-                        return false;
-                    }
+            _indexEntriesCount = 0;
+            _invalidEntries = null;
+        }
 
-                    Debug.Assert(stream.Position == stream.Length);
+        private ReadOnlySpan<IndexEntry> GetIndex()
+        {
+            if (_cacheFile == null)
+            {
+                return ReadOnlySpan<IndexEntry>.Empty;
+            }
 
-                    stream.Seek(0L, SeekOrigin.Begin);
+            return MemoryMarshal.Cast<byte, IndexEntry>(_cacheFile.GetSpan(Unsafe.SizeOf<Header>(), _indexEntriesCount * Unsafe.SizeOf<IndexEntry>()));
+        }
 
-                    InnerHeader innerHeader = DeserializeStructure<InnerHeader>(stream);
+        private static int FindEntry(ReadOnlySpan<IndexEntry> index, ulong address)
+        {
+            int left = 0;
+            int right = index.Length - 1;
 
-                    if (!innerHeader.IsHeaderValid())
-                    {
-                        InvalidateCompressedStream(compressedStream);
+            while (left <= right)
+            {
+                int middle = left + ((right - left) >> 1);
 
-                        return false;
-                    }
+                ulong middleAddress = index[middle].Address;
 
-                    if (innerHeader.Magic != _innerHeaderMagic)
-                    {
-                        InvalidateCompressedStream(compressedStream);
+                if (middleAddress == address)
+                {
+                    return middle;
+                }
 
-                        return false;
-                    }
+                if (middleAddress < address)
+                {
+                    left = middle + 1;
+                }
+                else
+                {
+                    right = middle - 1;
+                }
+            }
 
-                    ReadOnlySpan<byte> infosBytes = new(stream.PositionPointer, innerHeader.InfosLength);
-                    stream.Seek(innerHeader.InfosLength, SeekOrigin.Current);
+            return -1;
+        }
 
-                    Hash128 infosHash = XXHash128.ComputeHash(infosBytes);
+        private void MergeJournal()
+        {
+            string fileNameJournal = $"{CachePathActual}.journal";
 
-                    if (innerHeader.InfosHash != infosHash)
-                    {
-                        InvalidateCompressedStream(compressedStream);
+            if (!File.Exists(fileNameJournal))
+            {
+                return;
+            }
 
-                        return false;
-                    }
+            List<(IndexEntry entry, byte[] chunk)> entries = ReadJournal(fileNameJournal);
 
-                    ReadOnlySpan<byte> codesBytes = (int)innerHeader.CodesLength > 0 ? new(stream.PositionPointer, (int)innerHeader.CodesLength) : ReadOnlySpan<byte>.Empty;
-                    stream.Seek(innerHeader.CodesLength, SeekOrigin.Current);
+            if (entries.Count != 0)
+            {
+                // The journal is in the order the functions were translated, so later entries replace earlier ones.
+                _newEntries.AddRange(entries);
 
-                    Hash128 codesHash = XXHash128.ComputeHash(codesBytes);
+                try
+                {
+                    SaveAndReload();
+                }
+                finally
+                {
+                    ResetCarriersIfNeeded();
+                }
 
-                    if (innerHeader.CodesHash != codesHash)
-                    {
-                        InvalidateCompressedStream(compressedStream);
+                Logger.Info?.Print(LogClass.Ptc, $"Merged Translation Cache journal (translated functions: {entries.Count}).");
+            }
 
-                        return false;
-                    }
+            File.Delete(fileNameJournal);
+        }
 
-                    ReadOnlySpan<byte> relocsBytes = new(stream.PositionPointer, innerHeader.RelocsLength);
-                    stream.Seek(innerHeader.RelocsLength, SeekOrigin.Current);
+        private List<(IndexEntry entry, byte[] chunk)> ReadJournal(string fileName)
+        {
+            List<(IndexEntry entry, byte[] chunk)> entries = new();
 
-                    Hash128 relocsHash = XXHash128.ComputeHash(relocsBytes);
+            try
+            {
+                using FileStream stream = new(fileName, FileMode.Open, FileAccess.Read);
 
-                    if (innerHeader.RelocsHash != relocsHash)
-                    {
-                        InvalidateCompressedStream(compressedStream);
+                if (!IsHeaderValid(stream, out _))
+                {
+                    return entries;
+                }
 
-                        return false;
+                foreach (byte[] record in PtcJournal.ReadRecords(stream))
+                {
+                    if (record.Length < Unsafe.SizeOf<IndexEntry>())
+                    {
+                        break;
                     }
 
-                    ReadOnlySpan<byte> unwindInfosBytes = new(stream.PositionPointer, innerHeader.UnwindInfosLength);
-                    stream.Seek(innerHeader.UnwindInfosLength, SeekOrigin.Current);
+                    IndexEntry entry = MemoryMarshal.Read<IndexEntry>(record);
 
-                    Hash128 unwindInfosHash = XXHash128.ComputeHash(unwindInfosBytes);
+                    byte[] chunk = record.AsSpan(Unsafe.SizeOf<IndexEntry>()).ToArray();
 
-                    if (innerHeader.UnwindInfosHash != unwindInfosHash)
+                    if (entry.ChunkLength != chunk.Length || XXHash128.ComputeHash(chunk) != entry.ChunkHash)
                     {
-                        InvalidateCompressedStream(compressedStream);
-
-                        return false;
+                        break;
                     }
 
-                    Debug.Assert(stream.Position == stream.Length);
-
-                    stream.Seek((long)Unsafe.SizeOf<InnerHeader>(), SeekOrigin.Begin);
+                    entries.Add((entry, chunk));
+                }
+            }
+            catch (IOException ex)
+            {
+                Logger.Warning?.Print(LogClass.Ptc, $"Failed to read the Translation Cache journal: {ex.Message}");
+            }
 
-                    _infosStream.Write(infosBytes);
-                    stream.Seek(innerHeader.InfosLength, SeekOrigin.Current);
+            return entries;
+        }
 
-                    _codesList.ReadFrom(stream);
+        /// <summary>
+        /// Starts writing the functions translated from now on to a journal, so that they are kept even if the
+        /// emulator is closed or killed before the cache file is saved again.
+        /// </summary>
+        public void StartJournal()
+        {
+            if (State != PtcState.Enabled && State != PtcState.Continuing)
+            {
+                return;
+            }
 
-                    _relocsStream.Write(relocsBytes);
-                    stream.Seek(innerHeader.RelocsLength, SeekOrigin.Current);
+            using MemoryStream headerStream = new();
 
-                    _unwindInfosStream.Write(unwindInfosBytes);
-                    stream.Seek(innerHeader.UnwindInfosLength, SeekOrigin.Current);
+            SerializeStructure(headerStream, CreateHeader(ReadOnlySpan<IndexEntry>.Empty));
 
-                    Debug.Assert(stream.Position == stream.Length);
+            lock (_lock)
+            {
+                try
+                {
+                    _journal = new PtcJournal($"{CachePathActual}.journal", headerStream.ToArray());
                 }
-                finally
+                catch (IOException ex)
                 {
-                    if (intPtr != IntPtr.Zero)
-                    {
-                        Marshal.FreeHGlobal(intPtr);
-                    }
+                    Logger.Warning?.Print(LogClass.Ptc, $"Failed to create the Translation Cache journal: {ex.Message}");
                 }
             }
-
-            long fileSize = new FileInfo(fileName).Length;
-
-            Logger.Info?.Print(LogClass.Ptc, $"{(isBackup ? "Loaded Backup Translation Cache" : "Loaded Translation Cache")} (size: {fileSize} bytes, translated functions: {GetEntriesCount()}).");
-
-            return true;
         }
 
-        private static void InvalidateCompressedStream(FileStream compressedStream)
+        private void StopJournal()
         {
-            compressedStream.SetLength(0L);
+            lock (_lock)
+            {
+                _journal?.Dispose();
+                _journal = null;
+            }
         }
 
-        private void PreSave()
+        internal void PreSave()
         {
             _waitEvent.Reset();
 
             try
             {
-                string fileNameActual = $"{CachePathActual}.cache";
-                string fileNameBackup = $"{CachePathBackup}.cache";
-
-                FileInfo fileInfoActual = new(fileNameActual);
-
-                if (fileInfoActual.Exists && fileInfoActual.Length != 0L)
-                {
-                    File.Copy(fileNameActual, fileNameBackup, true);
-                }
-
-                Save(fileNameActual);
+                SaveAndReload();
             }
             finally
             {
@@ -418,226 +497,354 @@ namespace ARMeilleure.Translation.PTC
             _waitEvent.Set();
         }
 
-        private unsafe void Save(string fileName)
+        private void SaveAndReload()
         {
-            int translatedFuncsCount;
+            string fileNameActual = $"{CachePathActual}.cache";
+            string fileNameBackup = $"{CachePathBackup}.cache";
+            string fileNameTemp = $"{CachePathActual}.tmp";
 
-            InnerHeader innerHeader = new()
+            if (Save(fileNameTemp))
             {
-                Magic = _innerHeaderMagic,
+                // The new file holds every function that can still be loaded from the old one,
+                // so it replaces the mapping once it is complete.
+                _cacheFileLock.EnterWriteLock();
 
-                InfosLength = (int)_infosStream.Length,
-                CodesLength = _codesList.Length(),
-                RelocsLength = (int)_relocsStream.Length,
-                UnwindInfosLength = (int)_unwindInfosStream.Length,
-            };
+                try
+                {
+                    ReleaseCacheFile();
 
-            OuterHeader outerHeader = new()
-            {
-                Magic = _outerHeaderMagic,
+                    FileInfo fileInfoActual = new(fileNameActual);
 
-                CacheFileVersion = InternalVersion,
-                Endianness = GetEndianness(),
-                FeatureInfo = GetFeatureInfo(),
-                MemoryManagerMode = GetMemoryManagerMode(),
-                OSPlatform = GetOSPlatform(),
-                Architecture = (uint)RuntimeInformation.ProcessArchitecture,
+                    if (fileInfoActual.Exists && fileInfoActual.Length != 0L)
+                    {
+                        File.Move(fileNameActual, fileNameBackup, true);
+                    }
 
-                UncompressedStreamSize =
-                (long)Unsafe.SizeOf<InnerHeader>() +
-                innerHeader.InfosLength +
-                innerHeader.CodesLength +
-                innerHeader.RelocsLength +
-                innerHeader.UnwindInfosLength,
-            };
+                    File.Move(fileNameTemp, fileNameActual, true);
 
-            outerHeader.SetHeaderHash();
+                    Load(fileNameActual, false);
+                }
+                finally
+                {
+                    _cacheFileLock.ExitWriteLock();
+                }
+            }
+        }
 
-            IntPtr intPtr = IntPtr.Zero;
+        private bool Save(string fileName)
+        {
+            // Saving runs on its own thread while guest threads can still add translated functions.
+            List<(IndexEntry entry, byte[] chunk)> savedEntries;
 
-            try
+            lock (_lock)
             {
-                intPtr = Marshal.AllocHGlobal(new IntPtr(outerHeader.UncompressedStreamSize));
+                savedEntries = new List<(IndexEntry entry, byte[] chunk)>(_newEntries);
+            }
 
-                using UnmanagedMemoryStream stream = new((byte*)intPtr.ToPointer(), outerHeader.UncompressedStreamSize, outerHeader.UncompressedStreamSize, FileAccess.ReadWrite);
-                stream.Seek((long)Unsafe.SizeOf<InnerHeader>(), SeekOrigin.Begin);
+            // Functions translated in this session replace the ones with the same address in the loaded cache file.
+            Dictionary<ulong, (IndexEntry entry, byte[] chunk)> newEntries = new();
 
-                ReadOnlySpan<byte> infosBytes = new(stream.PositionPointer, innerHeader.InfosLength);
-                _infosStream.WriteTo(stream);
+            foreach (var newEntry in savedEntries)
+            {
+                newEntries[newEntry.entry.Address] = newEntry;
+            }
 
-                ReadOnlySpan<byte> codesBytes = (int)innerHeader.CodesLength > 0 ? new(stream.PositionPointer, (int)innerHeader.CodesLength) : ReadOnlySpan<byte>.Empty;
-                _codesList.WriteTo(stream);
+            ReadOnlySpan<IndexEntry> index = GetIndex();
 
-                ReadOnlySpan<byte> relocsBytes = new(stream.PositionPointer, innerHeader.RelocsLength);
-                _relocsStream.WriteTo(stream);
+            List<(IndexEntry entry, byte[] chunk)> entries = new(index.Length + newEntries.Count);
 
-                ReadOnlySpan<byte> unwindInfosBytes = new(stream.PositionPointer, innerHeader.UnwindInfosLength);
-                _unwindInfosStream.WriteTo(stream);
+            for (int i = 0; i < index.Length; i++)
+            {
+                if (!_invalidEntries[i] && !newEntries.ContainsKey(index[i].Address))
+                {
+                    entries.Add((index[i], null));
+                }
+            }
 
-                Debug.Assert(stream.Position == stream.Length);
+            entries.AddRange(newEntries.Values);
+            entries.Sort((x, y) => x.entry.Address.CompareTo(y.entry.Address));
 
-                innerHeader.InfosHash = XXHash128.ComputeHash(infosBytes);
-                innerHeader.CodesHash = XXHash128.ComputeHash(codesBytes);
-                innerHeader.RelocsHash = XXHash128.ComputeHash(relocsBytes);
-                innerHeader.UnwindInfosHash = XXHash128.ComputeHash(unwindInfosBytes);
+            IndexEntry[] newIndex = new IndexEntry[entries.Count];
 
-                innerHeader.SetHeaderHash();
+            long fileSize = Unsafe.SizeOf<Header>() + (long)newIndex.Length * Unsafe.SizeOf<IndexEntry>();
 
-                stream.Seek(0L, SeekOrigin.Begin);
-                SerializeStructure(stream, innerHeader);
+            for (int i = 0; i < newIndex.Length; i++)
+            {
+                newIndex[i] = entries[i].entry;
+                newIndex[i].ChunkOffset = fileSize;
 
-                translatedFuncsCount = GetEntriesCount();
+                fileSize += newIndex[i].ChunkLength;
+            }
 
-                ResetCarriersIfNeeded();
+            Header header = CreateHeader(newIndex);
 
-                using FileStream compressedStream = new(fileName, FileMode.OpenOrCreate);
-                using DeflateStream deflateStream = new(compressedStream, SaveCompressionLevel, true);
-                try
-                {
-                    SerializeStructure(compressedStream, outerHeader);
+            try
+            {
+                using FileStream stream = new(fileName, FileMode.Create);
 
-                    stream.Seek(0L, SeekOrigin.Begin);
-                    stream.CopyTo(deflateStream);
-                }
-                catch
-                {
-                    compressedStream.Position = 0L;
-                }
+                SerializeStructure(stream, header);
+
+                stream.Write(MemoryMarshal.AsBytes(newIndex.AsSpan()));
 
-                if (compressedStream.Position < compressedStream.Length)
+                // Chunks of the loaded cache file are copied as they are, without decompressing them.
+                foreach (var (entry, chunk) in entries)
                 {
-                    compressedStream.SetLength(compressedStream.Position);
+                    if (chunk != null)
+                    {
+                        stream.Write(chunk);
+                    }
+                    else
+                    {
+                        stream.Write(_cacheFile.GetSpan(entry.ChunkOffset, entry.ChunkLength));
+                    }
                 }
+
+                Debug.Assert(stream.Position == fileSize);
             }
-            finally
+            catch
             {
-                if (intPtr != IntPtr.Zero)
-                {
-                    Marshal.FreeHGlobal(intPtr);
-                }
+                File.Delete(fileName);
+
+                return false;
             }
 
-            long fileSize = new FileInfo(fileName).Length;
+            Logger.Info?.Print(LogClass.Ptc, $"Saved Translation Cache (size: {fileSize} bytes, translated functions: {newIndex.Length}).");
+
+            return true;
+        }
 
-            if (fileSize != 0L)
+        private Header CreateHeader(ReadOnlySpan<IndexEntry> index)
+        {
+            Header header = new()
             {
-                Logger.Info?.Print(LogClass.Ptc, $"Saved Translation Cache (size: {fileSize} bytes, translated functions: {translatedFuncsCount}).");
-            }
+                Magic = _headerMagic,
+
+                CacheFileVersion = InternalVersion,
+                Endianness = GetEndianness(),
+                FeatureInfo = GetFeatureInfo(),
+                MemoryManagerMode = GetMemoryManagerMode(),
+                OSPlatform = GetOSPlatform(),
+                Architecture = (uint)RuntimeInformation.ProcessArchitecture,
+
+                IndexEntriesCount = index.Length,
+                IndexHash = XXHash128.ComputeHash(MemoryMarshal.AsBytes(index)),
+            };
+
+            header.SetHeaderHash();
+
+            return header;
         }
 
         public void LoadTranslations(Translator translator)
         {
-            if (AreCarriersEmpty())
+            LoadTranslations(translator, PtcLoadScheduler.GetDegreeOfParallelism());
+        }
+
+        internal void LoadTranslations(Translator translator, int degreeOfParallelism)
+        {
+            int entriesCount = GetIndex().Length;
+
+            if (entriesCount == 0)
             {
                 return;
             }
 
-            long infosStreamLength = _infosStream.Length;
-            long relocsStreamLength = _relocsStream.Length;
-            long unwindInfosStreamLength = _unwindInfosStream.Length;
+            // Functions translated with high quality were hot in previous runs, so they are loaded now. The others are
+            // only loaded the first time they are dispatched. Changed functions and functions that should be translated
+            // again with high quality are invalidated, so they can be retranslated before the game starts.
+            CompiledFunction[] compiledFuncs = new CompiledFunction[entriesCount];
+            Counter<uint>[] callCounters = new Counter<uint>[entriesCount];
 
-            _infosStream.Seek(0L, SeekOrigin.Begin);
-            _relocsStream.Seek(0L, SeekOrigin.Begin);
-            _unwindInfosStream.Seek(0L, SeekOrigin.Begin);
+            Stopwatch sw = Stopwatch.StartNew();
 
-            using (BinaryReader relocsReader = new(_relocsStream, EncodingCache.UTF8NoBOM, true))
-            using (BinaryReader unwindInfosReader = new(_unwindInfosStream, EncodingCache.UTF8NoBOM, true))
+            PtcLoadScheduler.Run(entriesCount, degreeOfParallelism, (start, end) =>
             {
-                for (int index = 0; index < GetEntriesCount(); index++)
-                {
-                    InfoEntry infoEntry = DeserializeStructure<InfoEntry>(_infosStream);
+                ReadOnlySpan<IndexEntry> index = GetIndex();
 
-                    if (infoEntry.Stubbed)
-                    {
-                        SkipCode(index, infoEntry.CodeLength);
-                        SkipReloc(infoEntry.RelocEntriesCount);
-                        SkipUnwindInfo(unwindInfosReader);
-
-                        continue;
-                    }
+                for (int i = start; i < end; i++)
+                {
+                    ref readonly IndexEntry entry = ref index[i];
 
-                    bool isEntryChanged = infoEntry.Hash != ComputeHash(translator.Memory, infoEntry.Address, infoEntry.GuestSize);
+                    bool isEntryChanged = entry.Hash != ComputeHash(translator.Memory, entry.Address, entry.GuestSize);
 
-                    if (isEntryChanged || (!infoEntry.HighCq && Profiler.ProfiledFuncs.TryGetValue(infoEntry.Address, out var value) && value.HighCq))
+                    if (isEntryChanged || (!entry.HighCq && Profiler.ProfiledFuncs.TryGetValue(entry.Address, out var value) && value.HighCq))
                     {
-                        infoEntry.Stubbed = true;
-                        infoEntry.CodeLength = 0;
-                        UpdateInfo(infoEntry);
-
-                        StubCode(index);
-                        StubReloc(infoEntry.RelocEntriesCount);
-                        StubUnwindInfo(unwindInfosReader);
+                        _invalidEntries[i] = true;
 
                         if (isEntryChanged)
                         {
-                            Logger.Info?.Print(LogClass.Ptc, $"Invalidated translated function (address: 0x{infoEntry.Address:X16})");
+                            Logger.Info?.Print(LogClass.Ptc, $"Invalidated translated function (address: 0x{entry.Address:X16})");
                         }
 
                         continue;
                     }
 
-                    byte[] code = ReadCode(index, infoEntry.CodeLength);
+                    if (entry.HighCq)
+                    {
+                        TryDecodeFunction(translator, i, entry, out compiledFuncs[i], out callCounters[i]);
+                    }
+                }
+            });
 
-                    Counter<uint> callCounter = null;
+            List<int> loadedEntries = new();
+            int availableCount = 0;
 
-                    if (infoEntry.RelocEntriesCount != 0)
-                    {
-                        RelocEntry[] relocEntries = GetRelocEntries(relocsReader, infoEntry.RelocEntriesCount);
+            for (int i = 0; i < entriesCount; i++)
+            {
+                if (!_invalidEntries[i])
+                {
+                    availableCount++;
 
-                        PatchCode(translator, code, relocEntries, out callCounter);
+                    if (compiledFuncs[i].Code != null)
+                    {
+                        loadedEntries.Add(i);
                     }
+                }
+            }
 
-                    UnwindInfo unwindInfo = ReadUnwindInfo(unwindInfosReader);
+            // Everything is mapped and published to the translator at once, taking the locks only once.
+            CompiledFunction[] loadedFuncs = new CompiledFunction[loadedEntries.Count];
+            IntPtr[] loadedFuncPointers = new IntPtr[loadedEntries.Count];
 
-                    TranslatedFunction func = FastTranslate(code, callCounter, infoEntry.GuestSize, unwindInfo, infoEntry.HighCq);
+            for (int i = 0; i < loadedEntries.Count; i++)
+            {
+                loadedFuncs[i] = compiledFuncs[loadedEntries[i]];
+            }
 
-                    translator.RegisterFunction(infoEntry.Address, func);
+            JitCache.Map(loadedFuncs, loadedFuncPointers);
 
-                    bool isAddressUnique = translator.Functions.TryAdd(infoEntry.Address, infoEntry.GuestSize, func);
+            ReadOnlySpan<IndexEntry> loadedIndex = GetIndex();
 
-                    Debug.Assert(isAddressUnique, $"The address 0x{infoEntry.Address:X16} is not unique.");
-                }
+            List<(ulong address, ulong size, TranslatedFunction func)> funcs = new(loadedEntries.Count);
+
+            for (int i = 0; i < loadedEntries.Count; i++)
+            {
+                int entryIndex = loadedEntries[i];
+
+                ref readonly IndexEntry entry = ref loadedIndex[entryIndex];
+
+                GuestFunction gFunc = Marshal.GetDelegateForFunctionPointer<GuestFunction>(loadedFuncPointers[i]);
+
+                TranslatedFunction func = new(gFunc, loadedFuncPointers[i], callCounters[entryIndex], null, entry.GuestSize, entry.HighCq);
+
+                funcs.Add((entry.Address, entry.GuestSize, func));
             }
 
-            if (_infosStream.Length != infosStreamLength || _infosStream.Position != infosStreamLength ||
-                _relocsStream.Length != relocsStreamLength || _relocsStream.Position != relocsStreamLength ||
-                _unwindInfosStream.Length != unwindInfosStreamLength || _unwindInfosStream.Position != unwindInfosStreamLength)
+            int addedCount = translator.Functions.TryAddRange(funcs);
+
+            Debug.Assert(addedCount == funcs.Count, "The addresses of the loaded functions are not unique.");
+
+            foreach (var (address, _, func) in funcs)
             {
-                throw new Exception("The length of a memory stream has changed, or its position has not reached or has exceeded its end.");
+                translator.RegisterFunction(address, func);
             }
 
-            Logger.Info?.Print(LogClass.Ptc, $"{translator.Functions.Count} translated functions loaded");
-        }
+            sw.Stop();
 
-        private int GetEntriesCount()
-        {
-            return _codesList.Count;
+            Logger.Info?.Print(LogClass.Ptc, $"{funcs.Count} of {availableCount} translated functions loaded, the rest are loaded on first use | Thread count: {degreeOfParallelism} in {sw.Elapsed.TotalSeconds} s");
         }
 
-        [Conditional("DEBUG")]
-        private void SkipCode(int index, int codeLength)
+        public bool HasTranslation(ulong address)
         {
-            Debug.Assert(_codesList[index].Length == 0);
-            Debug.Assert(codeLength == 0);
-        }
+            _cacheFileLock.EnterReadLock();
 
-        private void SkipReloc(int relocEntriesCount)
-        {
-            _relocsStream.Seek(relocEntriesCount * RelocEntry.Stride, SeekOrigin.Current);
+            try
+            {
+                int entryIndex = FindEntry(GetIndex(), address);
+
+                return entryIndex >= 0 && !_invalidEntries[entryIndex];
+            }
+            finally
+            {
+                _cacheFileLock.ExitReadLock();
+            }
         }
 
-        private void SkipUnwindInfo(BinaryReader unwindInfosReader)
+        public bool TryLoadTranslation(Translator translator, ulong address, out TranslatedFunction func)
         {
-            int pushEntriesLength = unwindInfosReader.ReadInt32();
+            func = null;
+
+            _cacheFileLock.EnterReadLock();
+
+            try
+            {
+                ReadOnlySpan<IndexEntry> index = GetIndex();
+
+                int entryIndex = FindEntry(index, address);
+
+                if (entryIndex < 0 || _invalidEntries[entryIndex])
+                {
+                    return false;
+                }
+
+                IndexEntry entry = index[entryIndex];
+
+                // The guest code may have been modified since the cache was loaded.
+                if (entry.Hash != ComputeHash(translator.Memory, entry.Address, entry.GuestSize))
+                {
+                    _invalidEntries[entryIndex] = true;
+
+                    Logger.Info?.Print(LogClass.Ptc, $"Invalidated translated function (address: 0x{entry.Address:X16})");
+
+                    return false;
+                }
+
+                if (!TryDecodeFunction(translator, entryIndex, entry, out CompiledFunction compiledFunc, out Counter<uint> callCounter))
+                {
+                    return false;
+                }
+
+                func = FastTranslate(compiledFunc, callCounter, entry.GuestSize, entry.HighCq);
 
-            _unwindInfosStream.Seek(pushEntriesLength * UnwindPushEntry.Stride + UnwindInfo.Stride, SeekOrigin.Current);
+                return true;
+            }
+            finally
+            {
+                _cacheFileLock.ExitReadLock();
+            }
         }
 
-        private byte[] ReadCode(int index, int codeLength)
+        private bool TryDecodeFunction(Translator translator, int entryIndex, in IndexEntry entry, out CompiledFunction compiledFunc, out Counter<uint> callCounter)
         {
-            Debug.Assert(_codesList[index].Length == codeLength);
+            if (entry.ChunkHash != XXHash128.ComputeHash(_cacheFile.GetSpan(entry.ChunkOffset, entry.ChunkLength)))
+            {
+                _invalidEntries[entryIndex] = true;
+
+                Logger.Warning?.Print(LogClass.Ptc, $"Corrupted translated function (address: 0x{entry.Address:X16})");
+
+                compiledFunc = default;
+                callCounter = null;
+
+                return false;
+            }
+
+            byte[] code = new byte[entry.CodeLength];
+            byte[] infos = new byte[entry.RelocEntriesCount * RelocEntry.Stride + entry.UnwindInfoLength];
+
+            using (UnmanagedMemoryStream chunkStream = _cacheFile.GetStream(entry.ChunkOffset, entry.ChunkLength))
+            using (DeflateStream deflateStream = new(chunkStream, CompressionMode.Decompress))
+            {
+                deflateStream.ReadExactly(code);
+                deflateStream.ReadExactly(infos);
+            }
+
+            using MemoryStream infosStream = new(infos);
+            using BinaryReader infosReader = new(infosStream, EncodingCache.UTF8NoBOM);
+
+            callCounter = null;
+
+            if (entry.RelocEntriesCount != 0)
+            {
+                RelocEntry[] relocEntries = GetRelocEntries(infosReader, entry.RelocEntriesCount);
 
-            return _codesList[index];
+                PatchCode(translator, code, relocEntries, out callCounter);
+            }
+
+            UnwindInfo unwindInfo = ReadUnwindInfo(infosReader);
+
+            compiledFunc = new CompiledFunction(code, unwindInfo, RelocInfo.Empty);
+
+            return true;
         }
 
         private static RelocEntry[] GetRelocEntries(BinaryReader relocsReader, int relocEntriesCount)
@@ -735,46 +942,14 @@ namespace ARMeilleure.Translation.PTC
         }
 
         private static TranslatedFunction FastTranslate(
-            byte[] code,
+            CompiledFunction cFunc,
             Counter<uint> callCounter,
             ulong guestSize,
-            UnwindInfo unwindInfo,
             bool highCq)
         {
-            var cFunc = new CompiledFunction(code, unwindInfo, RelocInfo.Empty);
             var gFunc = cFunc.MapWithPointer<GuestFunction>(out IntPtr gFuncPointer);
 
-            return new TranslatedFunction(gFunc, gFuncPointer, callCounter, guestSize, highCq);
-        }
-
-        private void UpdateInfo(InfoEntry infoEntry)
-        {
-            _infosStream.Seek(-Unsafe.SizeOf<InfoEntry>(), SeekOrigin.Current);
-
-            SerializeStructure(_infosStream, infoEntry);
-        }
-
-        private void StubCode(int index)
-        {
-            _codesList[index] = Array.Empty<byte>();
-        }
-
-        private void StubReloc(int relocEntriesCount)
-        {
-            for (int i = 0; i < relocEntriesCount * RelocEntry.Stride; i++)
-            {
-                _relocsStream.WriteByte(FillingByte);
-            }
-        }
-
-        private void StubUnwindInfo(BinaryReader unwindInfosReader)
-        {
-            int pushEntriesLength = unwindInfosReader.ReadInt32();
-
-            for (int i = 0; i < pushEntriesLength * UnwindPushEntry.Stride + UnwindInfo.Stride; i++)
-            {
-                _unwindInfosStream.WriteByte(FillingByte);
-            }
+            return new TranslatedFunction(gFunc, gFuncPointer, callCounter, null, guestSize, highCq);
         }
 
         public void MakeAndSaveTranslations(Translator translator)
@@ -791,13 +966,7 @@ namespace ARMeilleure.Translation.PTC
                 return;
             }
 
-            int degreeOfParallelism = Environment.ProcessorCount;
-
-            // If there are enough cores lying around, we leave one alone for other tasks.
-            if (degreeOfParallelism > 4)
-            {
-                degreeOfParallelism--;
-            }
+            int degreeOfParallelism = PtcLoadScheduler.GetDegreeOfParallelism();
 
             Logger.Info?.Print(LogClass.Ptc, $"{_translateCount} of {_translateTotalCount} functions translated | Thread count: {degreeOfParallelism}");
 
@@ -822,7 +991,11 @@ namespace ARMeilleure.Translation.PTC
 
                     Debug.Assert(Profiler.IsAddressInStaticCodeRange(address));
 
-                    TranslatedFunction func = translator.Translate(address, item.funcProfile.Mode, item.funcProfile.HighCq);
+                    TranslatedFunction func = translator.Translate(
+                        address,
+                        item.funcProfile.Mode,
+                        item.funcProfile.HighCq,
+                        blockProfile: Profiler.GetBlockProfile(address));
 
                     bool isAddressUnique = translator.Functions.TryAdd(address, func.GuestSize, func);
 
@@ -908,57 +1081,71 @@ namespace ARMeilleure.Translation.PTC
 
         public void WriteCompiledFunction(ulong address, ulong guestSize, Hash128 hash, bool highCq, CompiledFunction compiledFunc)
         {
-            lock (_lock)
-            {
-                byte[] code = compiledFunc.Code;
-                RelocInfo relocInfo = compiledFunc.RelocInfo;
-                UnwindInfo unwindInfo = compiledFunc.UnwindInfo;
-
-                InfoEntry infoEntry = new()
-                {
-                    Address = address,
-                    GuestSize = guestSize,
-                    Hash = hash,
-                    HighCq = highCq,
-                    Stubbed = false,
-                    CodeLength = code.Length,
-                    RelocEntriesCount = relocInfo.Entries.Length,
-                };
+            byte[] code = compiledFunc.Code;
+            RelocInfo relocInfo = compiledFunc.RelocInfo;
+            UnwindInfo unwindInfo = compiledFunc.UnwindInfo;
 
-                SerializeStructure(_infosStream, infoEntry);
+            // Each function is compressed on its own, so that it can be decoded without the rest of the cache.
+            using MemoryStream chunkStream = new();
 
-                WriteCode(code.AsSpan());
+            using (DeflateStream deflateStream = new(chunkStream, SaveCompressionLevel, true))
+            using (BinaryWriter chunkWriter = new(deflateStream, EncodingCache.UTF8NoBOM, true))
+            {
+                chunkWriter.Write(code);
 
                 // WriteReloc.
-                using var relocInfoWriter = new BinaryWriter(_relocsStream, EncodingCache.UTF8NoBOM, true);
-
                 foreach (RelocEntry entry in relocInfo.Entries)
                 {
-                    relocInfoWriter.Write(entry.Position);
-                    relocInfoWriter.Write((byte)entry.Symbol.Type);
-                    relocInfoWriter.Write(entry.Symbol.Value);
+                    chunkWriter.Write(entry.Position);
+                    chunkWriter.Write((byte)entry.Symbol.Type);
+                    chunkWriter.Write(entry.Symbol.Value);
                 }
 
                 // WriteUnwindInfo.
-                using var unwindInfoWriter = new BinaryWriter(_unwindInfosStream, EncodingCache.UTF8NoBOM, true);
-
-                unwindInfoWriter.Write(unwindInfo.PushEntries.Length);
+                chunkWriter.Write(unwindInfo.PushEntries.Length);
 
                 foreach (UnwindPushEntry unwindPushEntry in unwindInfo.PushEntries)
                 {
-                    unwindInfoWriter.Write((int)unwindPushEntry.PseudoOp);
-                    unwindInfoWriter.Write(unwindPushEntry.PrologOffset);
-                    unwindInfoWriter.Write(unwindPushEntry.RegIndex);
-                    unwindInfoWriter.Write(unwindPushEntry.StackOffsetOrAllocSize);
+                    chunkWriter.Write((int)unwindPushEntry.PseudoOp);
+                    chunkWriter.Write(unwindPushEntry.PrologOffset);
+                    chunkWriter.Write(unwindPushEntry.RegIndex);
+                    chunkWriter.Write(unwindPushEntry.StackOffsetOrAllocSize);
                 }
 
-                unwindInfoWriter.Write(unwindInfo.PrologSize);
+                chunkWriter.Write(unwindInfo.PrologSize);
             }
-        }
 
-        private void WriteCode(ReadOnlySpan<byte> code)
-        {
-            _codesList.Add(code.ToArray());
+            byte[] chunk = chunkStream.ToArray();
+
+            IndexEntry indexEntry = new()
+            {
+                Address = address,
+                GuestSize = guestSize,
+                Hash = hash,
+                HighCq = highCq,
+                CodeLength = code.Length,
+                RelocEntriesCount = relocInfo.Entries.Length,
+                UnwindInfoLength = sizeof(int) + unwindInfo.PushEntries.Length * UnwindPushEntry.Stride + UnwindInfo.Stride,
+                ChunkLength = chunk.Length,
+                ChunkHash = XXHash128.ComputeHash(chunk),
+            };
+
+            lock (_lock)
+            {
+                if (_journal != null)
+                {
+                    byte[] record = new byte[Unsafe.SizeOf<IndexEntry>() + chunk.Length];
+
+                    MemoryMarshal.Write(record, in indexEntry);
+                    chunk.CopyTo(record, Unsafe.SizeOf<IndexEntry>());
+
+                    _journal.Append(record);
+                }
+                else
+                {
+                    _newEntries.Add((indexEntry, chunk));
+                }
+            }
         }
 
         public static bool GetEndianness()
@@ -1012,8 +1199,8 @@ namespace ARMeilleure.Translation.PTC
             return osPlatform;
         }
 
-        [StructLayout(LayoutKind.Sequential, Pack = 1/*, Size = 86*/)]
-        private struct OuterHeader
+        [StructLayout(LayoutKind.Sequential, Pack = 1/*, Size = 98*/)]
+        private struct Header
         {
             public ulong Magic;
 
@@ -1025,70 +1212,46 @@ namespace ARMeilleure.Translation.PTC
             public uint OSPlatform;
             public uint Architecture;
 
-            public long UncompressedStreamSize;
+            public int IndexEntriesCount;
+            public Hash128 IndexHash;
 
             public Hash128 HeaderHash;
 
             public void SetHeaderHash()
             {
-                Span<OuterHeader> spanHeader = MemoryMarshal.CreateSpan(ref this, 1);
+                Span<Header> spanHeader = MemoryMarshal.CreateSpan(ref this, 1);
 
-                HeaderHash = XXHash128.ComputeHash(MemoryMarshal.AsBytes(spanHeader)[..(Unsafe.SizeOf<OuterHeader>() - Unsafe.SizeOf<Hash128>())]);
+                HeaderHash = XXHash128.ComputeHash(MemoryMarshal.AsBytes(spanHeader)[..(Unsafe.SizeOf<Header>() - Unsafe.SizeOf<Hash128>())]);
             }
 
             public bool IsHeaderValid()
             {
-                Span<OuterHeader> spanHeader = MemoryMarshal.CreateSpan(ref this, 1);
+                Span<Header> spanHeader = MemoryMarshal.CreateSpan(ref this, 1);
 
-                return XXHash128.ComputeHash(MemoryMarshal.AsBytes(spanHeader)[..(Unsafe.SizeOf<OuterHeader>() - Unsafe.SizeOf<Hash128>())]) == HeaderHash;
+                return XXHash128.ComputeHash(MemoryMarshal.AsBytes(spanHeader)[..(Unsafe.SizeOf<Header>() - Unsafe.SizeOf<Hash128>())]) == HeaderHash;
             }
         }
 
         [StructLayout(LayoutKind.Sequential, Pack = 1/*, Size = 40*/)]
         private record struct FeatureInfo(ulong FeatureInfo0, ulong FeatureInfo1, ulong FeatureInfo2, ulong FeatureInfo3, ulong FeatureInfo4);
 
-        [StructLayout(LayoutKind.Sequential, Pack = 1/*, Size = 128*/)]
-        private struct InnerHeader
-        {
-            public ulong Magic;
-
-            public int InfosLength;
-            public long CodesLength;
-            public int RelocsLength;
-            public int UnwindInfosLength;
-
-            public Hash128 InfosHash;
-            public Hash128 CodesHash;
-            public Hash128 RelocsHash;
-            public Hash128 UnwindInfosHash;
-
-            public Hash128 HeaderHash;
-
-            public void SetHeaderHash()
-            {
-                Span<InnerHeader> spanHeader = MemoryMarshal.CreateSpan(ref this, 1);
-
-                HeaderHash = XXHash128.ComputeHash(MemoryMarshal.AsBytes(spanHeader)[..(Unsafe.SizeOf<InnerHeader>() - Unsafe.SizeOf<Hash128>())]);
-            }
-
-            public bool IsHeaderValid()
-            {
-                Span<InnerHeader> spanHeader = MemoryMarshal.CreateSpan(ref this, 1);
-
-                return XXHash128.ComputeHash(MemoryMarshal.AsBytes(spanHeader)[..(Unsafe.SizeOf<InnerHeader>() - Unsafe.SizeOf<Hash128>())]) == HeaderHash;
-            }
-        }
-
-        [StructLayout(LayoutKind.Sequential, Pack = 1/*, Size = 42*/)]
-        private struct InfoEntry
+        /// <summary>
+        /// Entry of the index at the start of the cache file, sorted by guest address. The code, relocations
+        /// and unwind info of the function are stored together in a compressed chunk at <see cref="ChunkOffset"/>.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential, Pack = 1/*, Size = 73*/)]
+        private struct IndexEntry
         {
             public ulong Address;
             public ulong GuestSize;
             public Hash128 Hash;
             public bool HighCq;
-            public bool Stubbed;
             public int CodeLength;
             public int RelocEntriesCount;
+            public int UnwindInfoLength;
+            public long ChunkOffset;
+            public int ChunkLength;
+            public Hash128 ChunkHash;
         }
 
         private void Enable()
@@ -1132,6 +1295,21 @@ namespace ARMeilleure.Translation.PTC
                 Wait();
                 _waitEvent.Dispose();
 
+                StopJournal();
+
+                _cacheFileLock.EnterWriteLock();
+
+                try
+                {
+                    ReleaseCacheFile();
+                }
+                finally
+                {
+                    _cacheFileLock.ExitWriteLock();
+                }
+
+                _cacheFileLock.Dispose();
+
                 DisposeCarriers();
             }
         }
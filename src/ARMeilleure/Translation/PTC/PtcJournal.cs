@@ -0,0 +1,162 @@
+using Ryujinx.Common.Logging;
+using System;
+using System.Buffers.Binary;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.IO;
+using System.Threading;
+
+namespace ARMeilleure.Translation.PTC
+{
+    /// <summary>
+    /// Append only file of records, written from a low priority background thread.
+    /// </summary>
+    /// <remarks>
+    /// Each record is prefixed by its length. The records are flushed to the operating system as soon as they are
+    /// written, so that they survive the process being killed, and a record cut short by it is ignored when reading.
+    /// </remarks>
+    sealed class PtcJournal : IDisposable
+    {
+        private readonly FileStream _stream;
+        private readonly ConcurrentQueue<byte[]> _records;
+        private readonly AutoResetEvent _recordEvent;
+        private readonly Thread _writerThread;
+
+        private volatile bool _disposed;
+        private volatile bool _failed;
+
+        /// <summary>
+        /// Creates a new journal, replacing the file if it already exists.
+        /// </summary>
+        /// <param name="fileName">Name of the journal file</param>
+        /// <param name="header">Data written at the start of the file, before the records</param>
+        public PtcJournal(string fileName, ReadOnlySpan<byte> header)
+        {
+            _stream = new FileStream(fileName, FileMode.Create, FileAccess.Write, FileShare.Read);
+
+            _stream.Write(header);
+            _stream.Flush();
+
+            _records = new ConcurrentQueue<byte[]>();
+            _recordEvent = new AutoResetEvent(false);
+
+            _writerThread = new Thread(WriteRecords)
+            {
+                Name = "Ptc.JournalWriter",
+                Priority = ThreadPriority.Lowest,
+                IsBackground = true,
+            };
+
+            _writerThread.Start();
+        }
+
+        /// <summary>
+        /// Queues a record to be appended to the journal.
+        /// </summary>
+        /// <param name="record">Record to append</param>
+        public void Append(byte[] record)
+        {
+            if (_failed)
+            {
+                return;
+            }
+
+            _records.Enqueue(record);
+            _recordEvent.Set();
+        }
+
+        private void WriteRecords()
+        {
+            while (!_disposed)
+            {
+                _recordEvent.WaitOne();
+
+                Flush();
+            }
+        }
+
+        private void Flush()
+        {
+            if (_records.IsEmpty || _failed)
+            {
+                return;
+            }
+
+            Span<byte> length = stackalloc byte[sizeof(int)];
+
+            try
+            {
+                while (_records.TryDequeue(out byte[] record))
+                {
+                    BinaryPrimitives.WriteInt32LittleEndian(length, record.Length);
+
+                    _stream.Write(length);
+                    _stream.Write(record);
+                }
+
+                _stream.Flush();
+            }
+            catch (Exception ex)
+            {
+                // An exception escaping the writer thread would take the process down. The records already written
+                // remain readable, the journal just stops growing.
+                Logger.Warning?.Print(LogClass.Ptc, $"Failed to write the Translation Cache journal, it is disabled: {ex.Message}");
+
+                _failed = true;
+
+                _records.Clear();
+            }
+        }
+
+        /// <summary>
+        /// Reads the records of a journal, up to the end of the file or the first record that is incomplete.
+        /// </summary>
+        /// <param name="stream">Stream of the journal file, positioned after the header</param>
+        /// <returns>Records of the journal</returns>
+        public static List<byte[]> ReadRecords(Stream stream)
+        {
+            List<byte[]> records = new();
+
+            Span<byte> length = stackalloc byte[sizeof(int)];
+
+            while (stream.Length - stream.Position >= sizeof(int))
+            {
+                stream.ReadExactly(length);
+
+                int recordLength = BinaryPrimitives.ReadInt32LittleEndian(length);
+
+                if (recordLength < 0 || recordLength > stream.Length - stream.Position)
+                {
+                    break;
+                }
+
+                byte[] record = new byte[recordLength];
+
+                stream.ReadExactly(record);
+
+                records.Add(record);
+            }
+
+            return records;
+        }
+
+        /// <summary>
+        /// Writes the records that are still queued and closes the journal.
+        /// </summary>
+        public void Dispose()
+        {
+            if (!_disposed)
+            {
+                _disposed = true;
+
+                _recordEvent.Set();
+                _writerThread.Join();
+
+                Flush();
+
+                _recordEvent.Dispose();
+                _stream.Dispose();
+            }
+        }
+    }
+}
@@ -0,0 +1,239 @@
+using System;
+using System.IO;
+using System.Runtime.ExceptionServices;
+using System.Threading;
+
+namespace ARMeilleure.Translation.PTC
+{
+    /// <summary>
+    /// Splits the entries of the cache into segments which are loaded by a set of worker threads.
+    /// </summary>
+    /// <remarks>
+    /// Each worker starts with an equal, contiguous share of the segments. A worker that runs out of segments takes
+    /// the upper half of the segments left to the worker with the most remaining, so that all of them finish around
+    /// the same time even when some segments take much longer to load than others.
+    /// </remarks>
+    static class PtcLoadScheduler
+    {
+        private const int SegmentSize = 256;
+
+        /// <summary>
+        /// Gets the number of threads that should be used to load or translate functions.
+        /// </summary>
+        /// <returns>Number of threads</returns>
+        public static int GetDegreeOfParallelism()
+        {
+            int degreeOfParallelism = GetBigCoreCount();
+
+            // If there are enough cores lying around, we leave one alone for other tasks.
+            if (degreeOfParallelism > 4)
+            {
+                degreeOfParallelism--;
+            }
+
+            return degreeOfParallelism;
+        }
+
+        private static int GetBigCoreCount()
+        {
+            int processorCount = Environment.ProcessorCount;
+
+            if (!OperatingSystem.IsLinux() && !OperatingSystem.IsAndroid())
+            {
+                return processorCount;
+            }
+
+            // On heterogeneous systems, work given to the little cores finishes long after the rest and holds back
+            // the whole load. Cores clocked at least 3/4 as fast as the fastest one are counted as big.
+            long[] maxFrequencies = new long[processorCount];
+            long highestFrequency = 0;
+
+            try
+            {
+                for (int i = 0; i < processorCount; i++)
+                {
+                    string path = $"/sys/devices/system/cpu/cpu{i}/cpufreq/cpuinfo_max_freq";
+
+                    if (!File.Exists(path) || !long.TryParse(File.ReadAllText(path).Trim(), out maxFrequencies[i]))
+                    {
+                        return processorCount;
+                    }
+
+                    highestFrequency = Math.Max(highestFrequency, maxFrequencies[i]);
+                }
+            }
+            catch (Exception ex) when (ex is IOException || ex is UnauthorizedAccessException)
+            {
+                return processorCount;
+            }
+
+            int bigCoreCount = 0;
+
+            foreach (long maxFrequency in maxFrequencies)
+            {
+                if (maxFrequency * 4 >= highestFrequency * 3)
+                {
+                    bigCoreCount++;
+                }
+            }
+
+            return Math.Max(1, bigCoreCount);
+        }
+
+        /// <summary>
+        /// Loads entries in parallel, returning once all of them were loaded.
+        /// </summary>
+        /// <param name="count">Number of entries</param>
+        /// <param name="degreeOfParallelism">Maximum number of threads to use, including the calling thread</param>
+        /// <param name="loadRange">Callback that loads the entries from the start index, inclusive, to the end index, exclusive</param>
+        public static void Run(int count, int degreeOfParallelism, Action<int, int> loadRange)
+        {
+            int segmentsCount = (count + SegmentSize - 1) / SegmentSize;
+
+            if (segmentsCount == 0)
+            {
+                return;
+            }
+
+            int workersCount = Math.Clamp(degreeOfParallelism, 1, segmentsCount);
+
+            long[] ranges = new long[workersCount];
+
+            for (int i = 0; i < workersCount; i++)
+            {
+                ranges[i] = PackRange(segmentsCount * i / workersCount, segmentsCount * (i + 1) / workersCount);
+            }
+
+            Exception exception = null;
+
+            void Work(int workerIndex)
+            {
+                try
+                {
+                    while (Volatile.Read(ref exception) == null &&
+                        (TryTakeSegment(ranges, workerIndex, out int segment) || TryStealSegment(ranges, workerIndex, out segment)))
+                    {
+                        int start = segment * SegmentSize;
+
+                        loadRange(start, Math.Min(start + SegmentSize, count));
+                    }
+                }
+                catch (Exception ex)
+                {
+                    Interlocked.CompareExchange(ref exception, ex, null);
+                }
+            }
+
+            Thread[] threads = new Thread[workersCount - 1];
+
+            for (int i = 0; i < threads.Length; i++)
+            {
+                int workerIndex = i + 1;
+
+                threads[i] = new Thread(() => Work(workerIndex))
+                {
+                    Name = $"Ptc.LoadThread.{workerIndex}",
+                    IsBackground = true,
+                };
+
+                threads[i].Start();
+            }
+
+            Work(0);
+
+            foreach (Thread thread in threads)
+            {
+                thread.Join();
+            }
+
+            if (exception != null)
+            {
+                ExceptionDispatchInfo.Throw(exception);
+            }
+        }
+
+        private static bool TryTakeSegment(long[] ranges, int workerIndex, out int segment)
+        {
+            while (true)
+            {
+                long range = Volatile.Read(ref ranges[workerIndex]);
+
+                (int start, int end) = UnpackRange(range);
+
+                if (start >= end)
+                {
+                    segment = 0;
+
+                    return false;
+                }
+
+                if (Interlocked.CompareExchange(ref ranges[workerIndex], PackRange(start + 1, end), range) == range)
+                {
+                    segment = start;
+
+                    return true;
+                }
+            }
+        }
+
+        private static bool TryStealSegment(long[] ranges, int workerIndex, out int segment)
+        {
+            while (true)
+            {
+                int victimIndex = -1;
+                int victimRemaining = 0;
+                long victimRange = 0;
+
+                for (int i = 0; i < ranges.Length; i++)
+                {
+                    if (i == workerIndex)
+                    {
+                        continue;
+                    }
+
+                    long range = Volatile.Read(ref ranges[i]);
+
+                    (int start, int end) = UnpackRange(range);
+
+                    if (end - start > victimRemaining)
+                    {
+                        victimIndex = i;
+                        victimRemaining = end - start;
+                        victimRange = range;
+                    }
+                }
+
+                if (victimIndex < 0)
+                {
+                    segment = 0;
+
+                    return false;
+                }
+
+                (int victimStart, int victimEnd) = UnpackRange(victimRange);
+
+                int middle = victimStart + victimRemaining / 2;
+
+                if (Interlocked.CompareExchange(ref ranges[victimIndex], PackRange(victimStart, middle), victimRange) == victimRange)
+                {
+                    // Our own range is empty, so no other worker will try to steal from it while it is replaced.
+                    Volatile.Write(ref ranges[workerIndex], PackRange(middle + 1, victimEnd));
+
+                    segment = middle;
+
+                    return true;
+                }
+            }
+        }
+
+        private static long PackRange(int start, int end)
+        {
+            return ((long)start << 32) | (uint)end;
+        }
+
+        private static (int start, int end) UnpackRange(long range)
+        {
+            return ((int)(range >> 32), (int)range);
+        }
+    }
+}
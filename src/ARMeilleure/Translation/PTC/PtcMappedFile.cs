@@ -0,0 +1,67 @@
+using System;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+
+namespace ARMeilleure.Translation.PTC
+{
+    /// <summary>
+    /// Read only view of a cache file mapped into memory, so that its contents are only paged in when accessed.
+    /// </summary>
+    unsafe sealed class PtcMappedFile : IDisposable
+    {
+        private readonly FileStream _stream;
+        private readonly MemoryMappedFile _file;
+        private readonly MemoryMappedViewAccessor _view;
+        private readonly byte* _pointer;
+
+        public long Length { get; }
+
+        /// <summary>
+        /// Maps the whole file, taking ownership of the stream.
+        /// </summary>
+        /// <param name="stream">Stream of the file to map</param>
+        public PtcMappedFile(FileStream stream)
+        {
+            _stream = stream;
+
+            Length = stream.Length;
+
+            _file = MemoryMappedFile.CreateFromFile(stream, null, 0L, MemoryMappedFileAccess.Read, HandleInheritability.None, leaveOpen: true);
+            _view = _file.CreateViewAccessor(0L, 0L, MemoryMappedFileAccess.Read);
+
+            byte* pointer = null;
+
+            _view.SafeMemoryMappedViewHandle.AcquirePointer(ref pointer);
+
+            _pointer = pointer + _view.PointerOffset;
+        }
+
+        public ReadOnlySpan<byte> GetSpan(long offset, int length)
+        {
+            if ((ulong)offset + (ulong)length > (ulong)Length)
+            {
+                throw new ArgumentOutOfRangeException(nameof(offset));
+            }
+
+            return new ReadOnlySpan<byte>(_pointer + offset, length);
+        }
+
+        public UnmanagedMemoryStream GetStream(long offset, int length)
+        {
+            if ((ulong)offset + (ulong)length > (ulong)Length)
+            {
+                throw new ArgumentOutOfRangeException(nameof(offset));
+            }
+
+            return new UnmanagedMemoryStream(_pointer + offset, length);
+        }
+
+        public void Dispose()
+        {
+            _view.SafeMemoryMappedViewHandle.ReleasePointer();
+            _view.Dispose();
+            _file.Dispose();
+            _stream.Dispose();
+        }
+    }
+}
@@ -23,10 +23,11 @@ namespace ARMeilleure.Translation.PTC
     {
         private const string OuterHeaderMagicString = "Pohd\0\0\0\0";
 
-        private const uint InternalVersion = 5518; //! Not to be incremented manually for each change to the ARMeilleure project.
+        private const uint InternalVersion = 6412; //! Not to be incremented manually for each change to the ARMeilleure project.
 
         private static readonly uint[] _migrateInternalVersions = {
             1866,
+            5518,
         };
 
         private const int SaveInterval = 30; // Seconds.
@@ -48,6 +49,7 @@ namespace ARMeilleure.Translation.PTC
         private Hash128 _lastHash;
 
         public Dictionary<ulong, FuncProfile> ProfiledFuncs { get; private set; }
+        public Dictionary<ulong, List<BlockProfile>> BlockProfiles { get; private set; }
 
         public bool Enabled { get; private set; }
 
@@ -70,6 +72,7 @@ namespace ARMeilleure.Translation.PTC
             _disposed = false;
 
             ProfiledFuncs = new Dictionary<ulong, FuncProfile>();
+            BlockProfiles = new Dictionary<ulong, List<BlockProfile>>();
 
             Enabled = false;
         }
@@ -87,7 +90,7 @@ namespace ARMeilleure.Translation.PTC
             }
         }
 
-        public void UpdateEntry(ulong address, ExecutionMode mode, bool highCq)
+        public void UpdateEntry(ulong address, ExecutionMode mode, bool highCq, List<BlockProfile> blockProfile = null)
         {
             if (IsAddressInStaticCodeRange(address))
             {
@@ -98,10 +101,23 @@ namespace ARMeilleure.Translation.PTC
                     Debug.Assert(ProfiledFuncs.ContainsKey(address));
 
                     ProfiledFuncs[address] = new FuncProfile(mode, highCq: true);
+
+                    if (blockProfile != null)
+                    {
+                        BlockProfiles[address] = blockProfile;
+                    }
                 }
             }
         }
 
+        public List<BlockProfile> GetBlockProfile(ulong address)
+        {
+            lock (_lock)
+            {
+                return BlockProfiles.GetValueOrDefault(address);
+            }
+        }
+
         public bool IsAddressInStaticCodeRange(ulong address)
         {
             return address >= StaticCodeStart && address < StaticCodeStart + StaticCodeSize;
@@ -113,7 +129,7 @@ namespace ARMeilleure.Translation.PTC
 
             foreach (var profiledFunc in ProfiledFuncs)
             {
-                if (!funcs.ContainsKey(profiledFunc.Key))
+                if (!funcs.ContainsKey(profiledFunc.Key) && !_ptc.HasTranslation(profiledFunc.Key))
                 {
                     profiledFuncsToTranslate.Enqueue((profiledFunc.Key, profiledFunc.Value));
                 }
@@ -126,6 +142,9 @@ namespace ARMeilleure.Translation.PTC
         {
             ProfiledFuncs.Clear();
             ProfiledFuncs.TrimExcess();
+
+            BlockProfiles.Clear();
+            BlockProfiles.TrimExcess();
         }
 
         public void PreLoad()
@@ -222,9 +241,15 @@ namespace ARMeilleure.Translation.PTC
                 {
                     case InternalVersion:
                         ProfiledFuncs = Deserialize(stream);
+                        BlockProfiles = DeserializeBlockProfiles(stream);
+                        break;
+                    case 5518:
+                        ProfiledFuncs = Deserialize(stream);
+                        BlockProfiles = new Dictionary<ulong, List<BlockProfile>>();
                         break;
                     case 1866:
                         ProfiledFuncs = Deserialize(stream, (address, profile) => (address + 0x500000UL, profile));
+                        BlockProfiles = new Dictionary<ulong, List<BlockProfile>>();
                         break;
                     default:
                         Logger.Error?.Print(LogClass.Ptc, $"No migration path for {nameof(outerHeader.InfoFileVersion)} '{outerHeader.InfoFileVersion}'. Discarding cache.");
@@ -254,6 +279,11 @@ namespace ARMeilleure.Translation.PTC
             return DeserializeDictionary<ulong, FuncProfile>(stream, DeserializeStructure<FuncProfile>);
         }
 
+        private static Dictionary<ulong, List<BlockProfile>> DeserializeBlockProfiles(Stream stream)
+        {
+            return DeserializeDictionary<ulong, List<BlockProfile>>(stream, DeserializeList<BlockProfile>);
+        }
+
         private static ReadOnlySpan<byte> GetReadOnlySpan(MemoryStream memoryStream)
         {
             return new(memoryStream.GetBuffer(), (int)memoryStream.Position, (int)memoryStream.Length - (int)memoryStream.Position);
@@ -306,6 +336,7 @@ namespace ARMeilleure.Translation.PTC
                 lock (_lock)
                 {
                     Serialize(stream, ProfiledFuncs);
+                    SerializeBlockProfiles(stream, BlockProfiles);
 
                     profiledFuncsCount = ProfiledFuncs.Count;
                 }
@@ -359,6 +390,11 @@ namespace ARMeilleure.Translation.PTC
             SerializeDictionary(stream, profiledFuncs, SerializeStructure);
         }
 
+        private static void SerializeBlockProfiles(Stream stream, Dictionary<ulong, List<BlockProfile>> blockProfiles)
+        {
+            SerializeDictionary(stream, blockProfiles, SerializeList);
+        }
+
         [StructLayout(LayoutKind.Sequential, Pack = 1/*, Size = 29*/)]
         private struct OuterHeader
         {
@@ -398,6 +434,22 @@ namespace ARMeilleure.Translation.PTC
             }
         }
 
+        /// <summary>
+        /// Number of times a block of a function was entered while it ran with instrumentation.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential, Pack = 1/*, Size = 12*/)]
+        public struct BlockProfile
+        {
+            public ulong Address;
+            public uint Count;
+
+            public BlockProfile(ulong address, uint count)
+            {
+                Address = address;
+                Count = count;
+            }
+        }
+
         public void Start()
         {
             if (_ptc.State == PtcState.Enabled ||
@@ -6,11 +6,13 @@ namespace ARMeilleure.Translation
     {
         public ulong Address;
         public ExecutionMode Mode;
+        public long Timestamp;
 
-        public RejitRequest(ulong address, ExecutionMode mode)
+        public RejitRequest(ulong address, ExecutionMode mode, long timestamp)
         {
             Address = address;
             Mode = mode;
+            Timestamp = timestamp;
         }
     }
 }
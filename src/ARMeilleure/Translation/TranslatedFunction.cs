@@ -1,5 +1,7 @@
 using ARMeilleure.Common;
 using System;
+using System.Diagnostics;
+using System.Threading;
 
 namespace ARMeilleure.Translation
 {
@@ -7,18 +9,40 @@ namespace ARMeilleure.Translation
     {
         private readonly GuestFunction _func; // Ensure that this delegate will not be garbage collected.
 
+        private int _rejitRequested;
+
         public IntPtr FuncPointer { get; }
         public Counter<uint> CallCounter { get; }
+        public BlockCounters BlockCounters { get; }
         public ulong GuestSize { get; }
         public bool HighCq { get; }
+        public long Timestamp { get; }
 
-        public TranslatedFunction(GuestFunction func, IntPtr funcPointer, Counter<uint> callCounter, ulong guestSize, bool highCq)
+        public TranslatedFunction(
+            GuestFunction func,
+            IntPtr funcPointer,
+            Counter<uint> callCounter,
+            BlockCounters blockCounters,
+            ulong guestSize,
+            bool highCq)
         {
             _func = func;
             FuncPointer = funcPointer;
             CallCounter = callCounter;
+            BlockCounters = blockCounters;
             GuestSize = guestSize;
             HighCq = highCq;
+            Timestamp = Stopwatch.GetTimestamp();
+        }
+
+        public bool TryRequestRejit()
+        {
+            return Interlocked.Exchange(ref _rejitRequested, 1) == 0;
+        }
+
+        public void ResetRejitRequest()
+        {
+            Volatile.Write(ref _rejitRequested, 0);
         }
 
         public ulong Execute(State.ExecutionContext context)
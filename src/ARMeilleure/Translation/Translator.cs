@@ -17,6 +17,7 @@ using System.Diagnostics;
 using System.Runtime.InteropServices;
 using System.Threading;
 using static ARMeilleure.IntermediateRepresentation.Operand.Factory;
+using static ARMeilleure.Translation.PTC.PtcProfiler;
 
 namespace ARMeilleure.Translation
 {
@@ -106,6 +107,7 @@ namespace ARMeilleure.Translation
 
                 _ptc.Profiler.Start();
 
+                _ptc.StartJournal();
                 _ptc.Disable();
 
                 // Simple heuristic, should be user configurable in future. (1 for 4 core/ht or less, 2 for 6 core + ht
@@ -211,7 +213,14 @@ namespace ARMeilleure.Translation
         {
             if (!Functions.TryGetValue(address, out TranslatedFunction func))
             {
-                func = Translate(address, mode, highCq: false);
+                long startTimestamp = Stopwatch.GetTimestamp();
+
+                if (!_ptc.TryLoadTranslation(this, address, out func))
+                {
+                    func = Translate(address, mode, highCq: false);
+                }
+
+                Statistics.RecordTranslationStall(Stopwatch.GetTimestamp() - startTimestamp);
 
                 TranslatedFunction oldFunc = Functions.GetOrAdd(address, func.GuestSize, func);
 
@@ -240,8 +249,18 @@ namespace ARMeilleure.Translation
             }
         }
 
-        internal TranslatedFunction Translate(ulong address, ExecutionMode mode, bool highCq, bool singleStep = false)
+        internal TranslatedFunction Translate(
+            ulong address,
+            ExecutionMode mode,
+            bool highCq,
+            bool singleStep = false,
+            List<BlockProfile> blockProfile = null)
         {
+            // After boot, only the functions promoted to high quality are journaled, as the others are cheap to
+            // translate again, and need absolute references to their block counters.
+            bool hasPtc = _ptc.State != PtcState.Disabled ||
+                (highCq && !singleStep && _ptc.IsJournaling && _ptc.Profiler.IsAddressInStaticCodeRange(address));
+
             var context = new ArmEmitterContext(
                 Memory,
                 CountTable,
@@ -249,7 +268,7 @@ namespace ARMeilleure.Translation
                 Stubs,
                 address,
                 highCq,
-                _ptc.State != PtcState.Disabled,
+                hasPtc,
                 mode: Aarch32Mode.User);
 
             Logger.StartPass(PassName.Decoding);
@@ -260,6 +279,21 @@ namespace ARMeilleure.Translation
 
             Logger.StartPass(PassName.Translation);
 
+            BlockCounters blockCounters = null;
+
+            if (highCq)
+            {
+                if (blockProfile != null)
+                {
+                    context.BlockWeight = BlockCounters.GetWeight(blockProfile, address);
+                }
+            }
+            else if (!singleStep && !context.HasPtc && Optimizations.UseProfileGuidedRejit)
+            {
+                // The counters are referenced by absolute address, so this is only done for code that is not cached.
+                blockCounters = new BlockCounters(CountTable, blocks);
+            }
+
             EmitSynchronization(context);
 
             if (blocks[0].Address != address)
@@ -267,7 +301,13 @@ namespace ARMeilleure.Translation
                 context.Branch(context.GetLabel(address));
             }
 
-            ControlFlowGraph cfg = EmitAndGetCFG(context, blocks, out Range funcRange, out Counter<uint> counter);
+            ControlFlowGraph cfg = EmitAndGetCFG(
+                context,
+                blocks,
+                highCq ? blockProfile : null,
+                blockCounters,
+                out Range funcRange,
+                out Counter<uint> counter);
 
             ulong funcSize = funcRange.End - funcRange.Start;
 
@@ -302,14 +342,29 @@ namespace ARMeilleure.Translation
 
             Allocators.ResetAll();
 
-            return new TranslatedFunction(func, funcPointer, counter, funcSize, highCq);
+            return new TranslatedFunction(func, funcPointer, counter, blockCounters, funcSize, highCq);
         }
 
         private void BackgroundTranslate()
         {
             while (_threadCount != 0 && Queue.TryDequeue(out RejitRequest request))
             {
-                TranslatedFunction func = Translate(request.Address, request.Mode, highCq: true);
+                List<BlockProfile> blockProfile = null;
+
+                if (Functions.TryGetValue(request.Address, out TranslatedFunction currentFunc))
+                {
+                    // A loop and the call counter may both request the same function to be promoted.
+                    if (currentFunc.HighCq)
+                    {
+                        continue;
+                    }
+
+                    blockProfile = currentFunc.BlockCounters?.GetProfile();
+                }
+
+                blockProfile ??= _ptc.Profiler.GetBlockProfile(request.Address);
+
+                TranslatedFunction func = Translate(request.Address, request.Mode, highCq: true, blockProfile: blockProfile);
 
                 Functions.AddOrUpdate(request.Address, func.GuestSize, func, (key, oldFunc) =>
                 {
@@ -319,7 +374,7 @@ namespace ARMeilleure.Translation
 
                 if (_ptc.Profiler.Enabled)
                 {
-                    _ptc.Profiler.UpdateEntry(request.Address, request.Mode, highCq: true);
+                    _ptc.Profiler.UpdateEntry(request.Address, request.Mode, highCq: true, blockProfile);
                 }
 
                 RegisterFunction(request.Address, func);
@@ -341,11 +396,28 @@ namespace ARMeilleure.Translation
         private static ControlFlowGraph EmitAndGetCFG(
             ArmEmitterContext context,
             Block[] blocks,
+            List<BlockProfile> blockProfile,
+            BlockCounters blockCounters,
             out Range range,
             out Counter<uint> counter)
         {
             counter = null;
 
+            HashSet<ulong> loopHeaders = null;
+
+            if (blockCounters != null)
+            {
+                loopHeaders = new HashSet<ulong>();
+
+                foreach (Block block in blocks)
+                {
+                    if (block.Branch != null && !block.Branch.Exit && block.Branch.Address <= block.Address)
+                    {
+                        loopHeaders.Add(block.Branch.Address);
+                    }
+                }
+            }
+
             ulong rangeStart = ulong.MaxValue;
             ulong rangeEnd = 0;
 
@@ -378,8 +450,18 @@ namespace ARMeilleure.Translation
 
                 context.CurrBlock = block;
 
+                if (blockProfile != null)
+                {
+                    context.BlockWeight = BlockCounters.GetWeight(blockProfile, block.Address);
+                }
+
                 context.MarkLabel(context.GetLabel(block.Address));
 
+                if (blockCounters != null && !block.Exit)
+                {
+                    EmitBlockCounter(context, blockCounters.GetCounter(blkIndex), loopHeaders.Contains(block.Address));
+                }
+
                 if (block.Exit)
                 {
                     // Left option here as it may be useful if we need to return to managed rather than tail call in
@@ -473,6 +555,30 @@ namespace ARMeilleure.Translation
             context.MarkLabel(lblEnd);
         }
 
+        internal static void EmitBlockCounter(ArmEmitterContext context, Counter<uint> counter, bool isLoopHeader)
+        {
+            // Functions that are called rarely but spend a long time in a loop are promoted from the loop header,
+            // instead of waiting for the call counter.
+            const int MinsLoopIterationsForRejit = 1000;
+
+            Operand address = Const(ref counter.Value);
+
+            Operand curCount = context.Load(OperandType.I32, address);
+            Operand count = context.Add(curCount, Const(1));
+            context.Store(address, count);
+
+            if (isLoopHeader)
+            {
+                Operand lblEnd = Label();
+
+                context.BranchIf(lblEnd, curCount, Const(MinsLoopIterationsForRejit), Comparison.NotEqual, BasicBlockFrequency.Cold);
+
+                context.Call(typeof(NativeInterface).GetMethod(nameof(NativeInterface.EnqueueForRejit)), Const(context.EntryAddress));
+
+                context.MarkLabel(lblEnd);
+            }
+        }
+
         internal static void EmitSynchronization(EmitterContext context)
         {
             long countOffs = NativeContext.GetCounterOffset();
@@ -526,7 +632,21 @@ namespace ARMeilleure.Translation
 
         internal void EnqueueForRejit(ulong guestAddress, ExecutionMode mode)
         {
-            Queue.Enqueue(guestAddress, mode);
+            int priority = TranslatorQueue.LowestPriority;
+
+            if (Functions.TryGetValue(guestAddress, out TranslatedFunction func))
+            {
+                // A loop and the call counter may both request the same function to be promoted.
+                if (!func.TryRequestRejit())
+                {
+                    return;
+                }
+
+                // The faster the function got hot since it was translated, the sooner it is promoted.
+                priority = TranslatorQueue.GetPriority(Stopwatch.GetTimestamp() - func.Timestamp);
+            }
+
+            Queue.Enqueue(guestAddress, mode, priority);
         }
 
         private void EnqueueForDeletion(ulong guestAddress, TranslatedFunction func)
@@ -546,6 +666,7 @@ namespace ARMeilleure.Translation
                 JitCache.Unmap(func.FuncPointer);
 
                 func.CallCounter?.Dispose();
+                func.BlockCounters?.Dispose();
             }
 
             Functions.Clear();
@@ -555,6 +676,7 @@ namespace ARMeilleure.Translation
                 JitCache.Unmap(kv.Value.FuncPointer);
 
                 kv.Value.CallCounter?.Dispose();
+                kv.Value.BlockCounters?.Dispose();
             }
         }
 
@@ -567,14 +689,12 @@ namespace ARMeilleure.Translation
                 return;
             }
 
-            lock (Queue.Sync)
+            while (Queue.TryDrop(out RejitRequest request))
             {
-                while (Queue.Count > 0 && Queue.TryDequeue(out RejitRequest request))
+                if (Functions.TryGetValue(request.Address, out var func) && func.CallCounter != null)
                 {
-                    if (Functions.TryGetValue(request.Address, out var func) && func.CallCounter != null)
-                    {
-                        Volatile.Write(ref func.CallCounter.Value, 0);
-                    }
+                    Volatile.Write(ref func.CallCounter.Value, 0);
+                    func.ResetRejitRequest();
                 }
             }
         }
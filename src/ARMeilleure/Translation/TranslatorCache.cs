@@ -22,6 +22,25 @@ namespace ARMeilleure.Translation
             return AddOrUpdate(address, size, value, null);
         }
 
+        public int TryAddRange(IReadOnlyList<(ulong address, ulong size, T value)> items)
+        {
+            int addedCount = 0;
+
+            _treeLock.EnterWriteLock();
+
+            foreach (var (address, size, value) in items)
+            {
+                if (_tree.AddOrUpdate(address, address + size, value, null))
+                {
+                    addedCount++;
+                }
+            }
+
+            _treeLock.ExitWriteLock();
+
+            return addedCount;
+        }
+
         public bool AddOrUpdate(ulong address, ulong size, T value, Func<ulong, T, T> updateFactoryCallback)
         {
             _treeLock.EnterWriteLock();
@@ -1,42 +1,74 @@
 using ARMeilleure.Diagnostics;
 using ARMeilleure.State;
 using System;
-using System.Collections.Generic;
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Numerics;
 using System.Threading;
 
 namespace ARMeilleure.Translation
 {
     /// <summary>
-    /// Represents a queue of <see cref="RejitRequest"/>.
+    /// Represents a queue of <see cref="RejitRequest"/>, ordered by priority.
     /// </summary>
     /// <remarks>
-    /// This does not necessarily behave like a queue, i.e: a FIFO collection.
+    /// This does not necessarily behave like a queue, i.e: a FIFO collection. Requests are kept on one lock-free queue
+    /// per priority level, and the requests with the lowest level are dequeued first, so that guest threads never wait
+    /// on the background translator threads to enqueue a request.
     /// </remarks>
     sealed class TranslatorQueue : IDisposable
     {
-        private bool _disposed;
-        private readonly Stack<RejitRequest> _requests;
-        private readonly HashSet<ulong> _requestAddresses;
+        /// <summary>
+        /// Number of priority levels.
+        /// </summary>
+        public const int PriorityLevels = 32;
 
         /// <summary>
-        /// Gets the object used to synchronize access to the <see cref="TranslatorQueue"/>.
+        /// Priority level given to requests for which the hotness of the function is unknown.
         /// </summary>
-        public object Sync { get; }
+        public const int LowestPriority = PriorityLevels - 1;
+
+        private int _disposed;
+        private int _count;
+        private int _waitingCount;
+        private readonly ConcurrentQueue<RejitRequest>[] _requests;
+        private readonly SemaphoreSlim _requestSignal;
 
         /// <summary>
         /// Gets the number of requests in the <see cref="TranslatorQueue"/>.
         /// </summary>
-        public int Count => _requests.Count;
+        public int Count => Math.Max(0, Volatile.Read(ref _count));
 
         /// <summary>
         /// Initializes a new instance of the <see cref="TranslatorQueue"/> class.
         /// </summary>
         public TranslatorQueue()
         {
-            Sync = new object();
+            _requests = new ConcurrentQueue<RejitRequest>[PriorityLevels];
 
-            _requests = new Stack<RejitRequest>();
-            _requestAddresses = new HashSet<ulong>();
+            for (int i = 0; i < _requests.Length; i++)
+            {
+                _requests[i] = new ConcurrentQueue<RejitRequest>();
+            }
+
+            _requestSignal = new SemaphoreSlim(0);
+        }
+
+        /// <summary>
+        /// Gets the priority level of a request for a function, from the time it took to reach the number of calls
+        /// required for a rejit since it was translated.
+        /// </summary>
+        /// <remarks>
+        /// Functions which are called more often reach the threshold faster, and get a lower level. Each level covers
+        /// twice the time of the previous one.
+        /// </remarks>
+        /// <param name="elapsedTicks"><see cref="Stopwatch"/> ticks elapsed since the function was translated</param>
+        /// <returns>Priority level of the request</returns>
+        public static int GetPriority(long elapsedTicks)
+        {
+            ulong elapsedMicroseconds = (ulong)Math.Max(1L, (long)(elapsedTicks * (1_000_000d / Stopwatch.Frequency)));
+
+            return Math.Min(BitOperations.Log2(elapsedMicroseconds), LowestPriority);
         }
 
         /// <summary>
@@ -44,18 +76,21 @@ namespace ARMeilleure.Translation
         /// </summary>
         /// <param name="address">Address of request</param>
         /// <param name="mode"><see cref="ExecutionMode"/> of request</param>
-        public void Enqueue(ulong address, ExecutionMode mode)
+        /// <param name="priority">Priority level of request, lower levels are dequeued first</param>
+        public void Enqueue(ulong address, ExecutionMode mode, int priority)
         {
-            lock (Sync)
-            {
-                if (_requestAddresses.Add(address))
-                {
-                    _requests.Push(new RejitRequest(address, mode));
+            _requests[Math.Clamp(priority, 0, LowestPriority)].Enqueue(new RejitRequest(address, mode, Stopwatch.GetTimestamp()));
 
-                    TranslatorEventSource.Log.RejitQueueAdd(1);
+            Interlocked.Increment(ref _count);
 
-                    Monitor.Pulse(Sync);
-                }
+            TranslatorEventSource.Log.RejitQueueAdd(1);
+            Statistics.RecordRejitEnqueue();
+
+            // The count must be incremented before checking for waiting threads, which increment the waiting count
+            // before checking the count, so that at least one side sees the other.
+            if (Volatile.Read(ref _waitingCount) != 0)
+            {
+                _requestSignal.Release();
             }
         }
 
@@ -67,23 +102,76 @@ namespace ARMeilleure.Translation
         /// <returns><see langword="true"/> on success; otherwise <see langword="false"/></returns>
         public bool TryDequeue(out RejitRequest result)
         {
-            while (!_disposed)
+            while (Volatile.Read(ref _disposed) == 0)
             {
-                lock (Sync)
+                if (TryTake(out result))
                 {
-                    if (_requests.TryPop(out result))
-                    {
-                        _requestAddresses.Remove(result.Address);
+                    return true;
+                }
+
+                Interlocked.Increment(ref _waitingCount);
+
+                if (Volatile.Read(ref _count) <= 0 && Volatile.Read(ref _disposed) == 0)
+                {
+                    _requestSignal.Wait();
+                }
+
+                Interlocked.Decrement(ref _waitingCount);
+            }
 
-                        TranslatorEventSource.Log.RejitQueueAdd(-1);
+            result = default;
 
-                        return true;
-                    }
+            return false;
+        }
 
-                    if (!_disposed)
-                    {
-                        Monitor.Wait(Sync);
-                    }
+        /// <summary>
+        /// Tries to dequeue a <see cref="RejitRequest"/> without blocking the thread.
+        /// </summary>
+        /// <param name="result"><see cref="RejitRequest"/> dequeued</param>
+        /// <returns><see langword="true"/> on success; otherwise <see langword="false"/></returns>
+        public bool TryTake(out RejitRequest result)
+        {
+            if (TryRemove(out result))
+            {
+                Statistics.RecordRejitDequeue(Stopwatch.GetTimestamp() - result.Timestamp);
+
+                return true;
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Tries to remove a <see cref="RejitRequest"/> that will not be translated, without blocking the thread.
+        /// </summary>
+        /// <remarks>
+        /// Unlike <see cref="TryTake"/>, the request is counted as cleared rather than taken by a translator thread.
+        /// </remarks>
+        /// <param name="result"><see cref="RejitRequest"/> removed</param>
+        /// <returns><see langword="true"/> on success; otherwise <see langword="false"/></returns>
+        public bool TryDrop(out RejitRequest result)
+        {
+            if (TryRemove(out result))
+            {
+                Statistics.RecordRejitQueueCleared(1);
+
+                return true;
+            }
+
+            return false;
+        }
+
+        private bool TryRemove(out RejitRequest result)
+        {
+            foreach (ConcurrentQueue<RejitRequest> requests in _requests)
+            {
+                if (requests.TryDequeue(out result))
+                {
+                    Interlocked.Decrement(ref _count);
+
+                    TranslatorEventSource.Log.RejitQueueAdd(-1);
+
+                    return true;
                 }
             }
 
@@ -97,15 +185,20 @@ namespace ARMeilleure.Translation
         /// </summary>
         public void Clear()
         {
-            lock (Sync)
+            int removedCount = 0;
+
+            foreach (ConcurrentQueue<RejitRequest> requests in _requests)
             {
-                TranslatorEventSource.Log.RejitQueueAdd(-_requests.Count);
+                while (requests.TryDequeue(out _))
+                {
+                    removedCount++;
+                }
+            }
 
-                _requests.Clear();
-                _requestAddresses.Clear();
+            Interlocked.Add(ref _count, -removedCount);
 
-                Monitor.PulseAll(Sync);
-            }
+            TranslatorEventSource.Log.RejitQueueAdd(-removedCount);
+            Statistics.RecordRejitQueueCleared(removedCount);
         }
 
         /// <summary>
@@ -113,11 +206,18 @@ namespace ARMeilleure.Translation
         /// </summary>
         public void Dispose()
         {
-            if (!_disposed)
+            if (Interlocked.Exchange(ref _disposed, 1) == 0)
             {
-                _disposed = true;
-
                 Clear();
+
+                // Wake up every waiting thread, so that they can observe the disposal. The semaphore itself is not
+                // disposed, as threads which have not observed the disposal yet may still be about to wait on it.
+                int waitingCount = Volatile.Read(ref _waitingCount);
+
+                if (waitingCount != 0)
+                {
+                    _requestSignal.Release(waitingCount);
+                }
             }
         }
     }
@@ -29,7 +29,9 @@ namespace LibRyujinx.Sample
                                                   bool enablePtc,
                                                   bool enableInternetAccess,
                                                   IntPtr timeZone,
-                                                  bool ignoreMissingServices);
+                                                  bool ignoreMissingServices,
+                                                  int jitCacheBudgetMiB,
+                                                  bool useHugePages);
 
         [DllImport(dll, EntryPoint = "graphics_initialize_renderer")]
         internal extern static bool InitializeGraphicsRenderer(GraphicsBackend backend, NativeGraphicsInterop nativeGraphicsInterop);
@@ -103,6 +105,7 @@ namespace LibRyujinx.Sample
         public bool EnableTextureRecompression = false;
         public BackendThreading BackendThreading = BackendThreading.Auto;
         public AspectRatio AspectRatio = AspectRatio.Fixed16x9;
+        public bool EnableDisplayTiming = true;
 
         public GraphicsConfiguration()
         {
@@ -71,6 +71,8 @@ namespace LibRyujinx.NativeSample
                     true,
                     false,
                     timeZone,
+                    false,
+                    0,
                     false);
                 LibRyujinxInterop.InitializeInput(ClientSize.X, ClientSize.Y);
                 Marshal.FreeHGlobal(timeZone);
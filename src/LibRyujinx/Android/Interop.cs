@@ -30,9 +30,7 @@ namespace LibRyujinx.Android
             ("test", "()V"),
             ("updateUiHandler", "(JJJIIIIJJ)V"),
             ("frameEnded", "()V"),
-            ("updateProgress", "(JF)V"),
-            ("getSurfacePtr", "()J"),
-            ("getWindowHandle", "()J")
+            ("updateProgress", "(JF)V")
         };
 
         internal static void Initialize(JEnvRef jniEnv)
@@ -129,16 +127,6 @@ namespace LibRyujinx.Android
             });
         }
 
-        public static JLong GetSurfacePtr()
-        {
-            return CallLongMethod("getSurfacePtr", "()J");
-        }
-
-        public static JLong GetWindowsHandle()
-        {
-            return CallLongMethod("getWindowHandle", "()J");
-        }
-
         public static void UpdateUiHandler(string newTitle,
             string newMessage,
             string newWatermark,
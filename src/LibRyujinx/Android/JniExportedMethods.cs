@@ -35,6 +35,22 @@ namespace LibRyujinx
         [DllImport("libryujinxjni")]
         internal extern static void setCurrentTransform(long native_window, int transform);
 
+        [DllImport("libryujinxjni")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal extern static bool getIsInitialOrientationFlipped();
+
+        [DllImport("libryujinxjni")]
+        internal extern static void framePacerWaitForPresent(long native_window);
+
+        [DllImport("libryujinxjni")]
+        internal extern static void framePacerFramePresented(long native_window);
+
+        [DllImport("libryujinxjni")]
+        internal extern static long surfaceManagerAcquireCurrent();
+
+        [DllImport("libryujinxjni")]
+        internal extern static void surfaceManagerRelease(long native_window);
+
         public delegate IntPtr JniCreateSurface(IntPtr native_surface, IntPtr instance);
 
         [UnmanagedCallersOnly(EntryPoint = "javaInitialize")]
@@ -78,7 +94,9 @@ namespace LibRyujinx
                                                     bool enablePtc,
                                                     bool enableInternetAccess,
                                                     IntPtr timeZonePtr,
-                                                    bool ignoreMissingServices)
+                                                    bool ignoreMissingServices,
+                                                    int jitCacheBudgetMiB,
+                                                    bool useHugePages)
         {
             debug_break(4);
             Logger.Trace?.Print(LogClass.Application, "Jni Function Call");
@@ -94,7 +112,9 @@ namespace LibRyujinx
                                     enablePtc,
                                     enableInternetAccess,
                                     timezone,
-                                    ignoreMissingServices);
+                                    ignoreMissingServices,
+                                    jitCacheBudgetMiB,
+                                    useHugePages);
         }
 
         [UnmanagedCallersOnly(EntryPoint = "deviceGetGameFifo")]
@@ -236,7 +256,8 @@ namespace LibRyujinx
                 bool enableMacroHLE,
                 bool enableShaderCache,
                 bool enableTextureRecompression,
-                int backendThreading)
+                int backendThreading,
+                bool enableDisplayTiming)
         {
             Logger.Trace?.Print(LogClass.Application, "Jni Function Call");
             SearchPathContainer.Platform = UnderlyingPlatform.Android;
@@ -250,7 +271,8 @@ namespace LibRyujinx
                 EnableMacroHLE = enableMacroHLE,
                 EnableShaderCache = enableShaderCache,
                 EnableTextureRecompression = enableTextureRecompression,
-                BackendThreading = (BackendThreading)backendThreading
+                BackendThreading = (BackendThreading)backendThreading,
+                EnableDisplayTiming = enableDisplayTiming
             });
         }
 
@@ -279,8 +301,19 @@ namespace LibRyujinx
 
             CreateSurface createSurfaceFunc = instance =>
             {
-                _surfacePtr = Interop.GetSurfacePtr();
-                _window = Interop.GetWindowsHandle();
+                // The renderer keeps its own reference, so the window stays valid while it is presented to,
+                // even after the frontend has moved on to a new one.
+                surfaceManagerRelease(_window);
+
+                _window = surfaceManagerAcquireCurrent();
+                _surfacePtr = _window;
+
+                if (_window == 0)
+                {
+                    Logger.Error?.Print(LogClass.Gpu, "No native window is available to create the surface on.");
+
+                    return IntPtr.Zero;
+                }
 
                 var api = VulkanLoader?.GetApi() ?? Vk.GetApi();
                 if (api.TryGetInstanceExtension(new Instance(instance), out KhrAndroidSurface surfaceExtension))
@@ -0,0 +1,110 @@
+using Ryujinx.Common.Logging;
+using System;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace LibRyujinx.Android
+{
+    /// <summary>
+    /// Writer for the per-frame telemetry ring owned by libryujinxjni.
+    /// </summary>
+    /// <remarks>
+    /// The layout must match telemetry.h in the native library and the reader in PerformanceMonitor.kt.
+    /// There is a single producer, the present callback, so publishing a record needs no locks.
+    /// </remarks>
+    internal unsafe static class NativeTelemetry
+    {
+        private const uint Magic = 0x4D545952;
+        private const uint Version = 1;
+
+        [StructLayout(LayoutKind.Sequential, Size = 64)]
+        private struct TelemetryHeader
+        {
+            public uint Magic;
+            public uint Version;
+            public uint RecordSize;
+            public uint Capacity;
+            public ulong WriteIndex;
+        }
+
+        [StructLayout(LayoutKind.Sequential, Size = 64)]
+        private struct FrameRecord
+        {
+            public ulong Sequence;
+            public long Timestamp;
+            public long FrameTime;
+            public long FifoTime;
+            public long GpuWaitTime;
+            public long PresentLatency;
+            public long JitStallTime;
+            public long PresentError;
+        }
+
+        private static TelemetryHeader* _header;
+        private static FrameRecord* _records;
+        private static ulong _mask;
+        private static long _lastTimestamp;
+
+        [DllImport("libryujinxjni")]
+        private extern static IntPtr telemetryGetBuffer();
+
+        public static bool IsAvailable => _header != null;
+
+        public static void Initialize()
+        {
+            // The frame time of the first frame of a session is not relative to the last frame of the previous one.
+            _lastTimestamp = 0;
+
+            if (_header != null)
+            {
+                return;
+            }
+
+            var header = (TelemetryHeader*)telemetryGetBuffer();
+
+            if (header == null || header->Magic != Magic || header->Version != Version || header->RecordSize != sizeof(FrameRecord))
+            {
+                Logger.Warning?.Print(LogClass.Application, "Native telemetry buffer is unavailable or has an unexpected layout");
+                return;
+            }
+
+            _records = (FrameRecord*)(header + 1);
+            _mask = header->Capacity - 1;
+            _header = header;
+        }
+
+        public static long ToNanoseconds(long ticks)
+        {
+            return (long)(ticks * (1_000_000_000.0 / Stopwatch.Frequency));
+        }
+
+        public static void WriteFrame(long fifoTicks, long gpuWaitTicks, long presentStartTicks, long jitStallTicks, long presentError)
+        {
+            if (_header == null)
+            {
+                return;
+            }
+
+            long timestamp = ToNanoseconds(Stopwatch.GetTimestamp());
+            ulong index = _header->WriteIndex;
+            FrameRecord* record = &_records[index & _mask];
+
+            // Invalidate the slot before touching the payload so readers can detect a torn copy.
+            Interlocked.Exchange(ref record->Sequence, 0UL);
+
+            record->Timestamp = timestamp;
+            record->FrameTime = _lastTimestamp == 0 ? 0 : timestamp - _lastTimestamp;
+            record->FifoTime = ToNanoseconds(fifoTicks);
+            record->GpuWaitTime = ToNanoseconds(gpuWaitTicks);
+            record->PresentLatency = timestamp - ToNanoseconds(presentStartTicks);
+            record->JitStallTime = ToNanoseconds(jitStallTicks);
+            record->PresentError = presentError;
+
+            Volatile.Write(ref record->Sequence, index + 1);
+            Volatile.Write(ref _header->WriteIndex, index + 1);
+
+            _lastTimestamp = timestamp;
+        }
+    }
+}
@@ -21,7 +21,9 @@ namespace LibRyujinx
                                             bool enablePtc,
                                             bool enableInternetAccess,
                                             string? timeZone,
-                                            bool ignoreMissingServices)
+                                            bool ignoreMissingServices,
+                                            int jitCacheBudgetMiB,
+                                            bool useHugePages)
         {
             if (SwitchDevice == null)
             {
@@ -37,7 +39,9 @@ namespace LibRyujinx
                                                   enablePtc,
                                                   enableInternetAccess,
                                                   timeZone,
-                                                  ignoreMissingServices);
+                                                  ignoreMissingServices,
+                                                  jitCacheBudgetMiB,
+                                                  useHugePages);
         }
 
         public static void InstallFirmware(Stream stream, bool isXci)
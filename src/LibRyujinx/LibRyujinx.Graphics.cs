@@ -13,6 +13,7 @@ using Ryujinx.Graphics.Vulkan;
 using Silk.NET.Vulkan;
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Runtime.InteropServices;
 using System.Threading;
 
@@ -66,7 +67,10 @@ namespace LibRyujinx
             {
                 Renderer = new VulkanRenderer(Vk.GetApi(), (instance, vk) => new SurfaceKHR(createSurfaceFunc == null ? null : (ulong?)createSurfaceFunc(instance.Handle)),
                     () => requiredExtensions,
-                    null);
+                    null)
+                {
+                    PresentTimingEnabled = GraphicsConfiguration.EnableDisplayTiming,
+                };
             }
             else
             {
@@ -97,6 +101,13 @@ namespace LibRyujinx
             var device = SwitchDevice!.EmulationContext!;
             _gpuDoneEvent = new ManualResetEvent(true);
 
+            // When the initial orientation is flipped, the half turn reported by the surface must not be applied,
+            // which setCurrentTransform takes care of. Those surfaces are left to it instead of being pre-rotated.
+            if (Ryujinx.Common.PlatformInfo.IsBionic && Renderer is VulkanRenderer baseRenderer)
+            {
+                baseRenderer.PreRotateHalfTurn = !getIsInitialOrientationFlipped();
+            }
+
             device.Gpu.Renderer.Initialize(_enableGraphicsLogging ? GraphicsDebugLevel.All : GraphicsDebugLevel.None);
 
             _gpuCancellationTokenSource = new CancellationTokenSource();
@@ -117,8 +128,19 @@ namespace LibRyujinx
                     if (Ryujinx.Common.PlatformInfo.IsBionic)
                     {
                         setRenderingThread();
+                        NativeTelemetry.Initialize();
                     }
 
+                    // Presents scheduled with display timing are already paced by the driver, waiting on the frame
+                    // pacer as well would only delay them further.
+                    bool useFramePacer = Ryujinx.Common.PlatformInfo.IsBionic && !(Renderer is VulkanRenderer { PresentTimingStatistics.IsSupported: true });
+
+                    long fifoTicks = 0;
+                    long gpuWaitTicks = 0;
+                    long lastJitStallTicks = ARMeilleure.Statistics.TranslationStallTicks;
+                    int appliedTransform = -1;
+                    int appliedSwapchainGeneration = -1;
+
                     while (_isActive)
                     {
                         if (_isStopped)
@@ -126,21 +148,70 @@ namespace LibRyujinx
                             break;
                         }
 
+                        long waitStart = Stopwatch.GetTimestamp();
+
                         if (device.WaitFifo())
                         {
+                            long fifoStart = Stopwatch.GetTimestamp();
+                            gpuWaitTicks += fifoStart - waitStart;
+
                             device.Statistics.RecordFifoStart();
                             device.ProcessFrame();
                             device.Statistics.RecordFifoEnd();
+
+                            fifoTicks += Stopwatch.GetTimestamp() - fifoStart;
+                        }
+                        else
+                        {
+                            gpuWaitTicks += Stopwatch.GetTimestamp() - waitStart;
                         }
 
                         while (device.ConsumeFrameAvailable())
                         {
+                            if (useFramePacer && device.EnableDeviceVsync)
+                            {
+                                framePacerWaitForPresent(_window);
+                            }
+
+                            long jitStallTicks = ARMeilleure.Statistics.TranslationStallTicks;
+                            long frameFifoTicks = fifoTicks;
+                            long frameGpuWaitTicks = gpuWaitTicks;
+                            long frameJitStallTicks = jitStallTicks - lastJitStallTicks;
+                            long presentStart = Stopwatch.GetTimestamp();
+
+                            fifoTicks = 0;
+                            gpuWaitTicks = 0;
+                            lastJitStallTicks = jitStallTicks;
+
                             device.PresentFrame(() =>
                             {
+                                long presentError = 0;
+
                                 if (device.Gpu.Renderer is ThreadedRenderer threaded && threaded.BaseRenderer is VulkanRenderer vulkanRenderer)
                                 {
-                                    setCurrentTransform(_window, (int)vulkanRenderer.CurrentTransform);
+                                    int transform = (int)vulkanRenderer.CurrentTransform;
+                                    int swapchainGeneration = vulkanRenderer.SwapchainGeneration;
+
+                                    // Pre-rotated swapchains get the buffer transform from the driver. Otherwise the compositor
+                                    // rotates the frame, and the transform only has to be set again after it changed or the
+                                    // swapchain was recreated, which resets it.
+                                    if (!vulkanRenderer.IsPreRotated && (transform != appliedTransform || swapchainGeneration != appliedSwapchainGeneration))
+                                    {
+                                        setCurrentTransform(_window, transform);
+                                    }
+
+                                    appliedTransform = transform;
+                                    appliedSwapchainGeneration = swapchainGeneration;
+                                    presentError = vulkanRenderer.PresentTimingStatistics.LastError;
                                 }
+
+                                if (useFramePacer)
+                                {
+                                    framePacerFramePresented(_window);
+                                }
+
+                                NativeTelemetry.WriteFrame(frameFifoTicks, frameGpuWaitTicks, presentStart, frameJitStallTicks, presentError);
+
                                 _swapBuffersCallback?.Invoke();
                             });
                         }
@@ -231,6 +302,7 @@ namespace LibRyujinx
         public bool EnableTextureRecompression = false;
         public BackendThreading BackendThreading = BackendThreading.Auto;
         public AspectRatio AspectRatio = AspectRatio.Fixed16x9;
+        public bool EnableDisplayTiming = true;
 
         public GraphicsConfiguration()
         {
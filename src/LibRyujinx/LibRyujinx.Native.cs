@@ -40,7 +40,9 @@ namespace LibRyujinx
                                                   bool enablePtc,
                                                   bool enableInternetAccess,
                                                   IntPtr timeZone,
-                                                  bool ignoreMissingServices)
+                                                  bool ignoreMissingServices,
+                                                  int jitCacheBudgetMiB,
+                                                  bool useHugePages)
         {
             return InitializeDevice(isHostMapped,
                                     useHypervisor,
@@ -51,7 +53,9 @@ namespace LibRyujinx
                                     enablePtc,
                                     enableInternetAccess,
                                     Marshal.PtrToStringAnsi(timeZone),
-                                    ignoreMissingServices);
+                                    ignoreMissingServices,
+                                    jitCacheBudgetMiB,
+                                    useHugePages);
         }
 
         [UnmanagedCallersOnly(EntryPoint = "device_reload_file_system")]
@@ -4,6 +4,7 @@ using Ryujinx.HLE.HOS.Services.Account.Acc;
 using Ryujinx.HLE.HOS;
 using Ryujinx.Input.HLE;
 using Ryujinx.HLE;
+using Ryujinx.Cpu.LightningJit;
 using System;
 using System.Runtime.InteropServices;
 using Ryujinx.Common.Configuration;
@@ -732,13 +733,17 @@ namespace LibRyujinx
                                       bool enablePtc,
                                       bool enableInternetAccess,
                                       string? timeZone,
-                                      bool ignoreMissingServices)
+                                      bool ignoreMissingServices,
+                                      int jitCacheBudgetMiB,
+                                      bool useHugePages)
         {
             if (LibRyujinx.Renderer == null)
             {
                 return false;
             }
 
+            LightningJitEngine.JitCacheBudget = (ulong)Math.Max(jitCacheBudgetMiB, 0) * 1024 * 1024;
+
             var renderer = LibRyujinx.Renderer;
             BackendThreading threadingMode = LibRyujinx.GraphicsConfiguration.BackendThreading;
 
@@ -774,7 +779,10 @@ namespace LibRyujinx
                                                                   100,
                                                                   useHypervisor,
                                                                   "",
-                                                                  Ryujinx.Common.Configuration.Multiplayer.MultiplayerMode.Disabled);
+                                                                  Ryujinx.Common.Configuration.Multiplayer.MultiplayerMode.Disabled)
+            {
+                UseHugePages = useHugePages,
+            };
 
             EmulationContext = new Switch(configuration);
 
@@ -14,15 +14,29 @@ namespace LibRyujinx
 {
     public class VulkanLoader : IDisposable
     {
-        private delegate IntPtr GetInstanceProcAddress(IntPtr instance, IntPtr name);
-        private delegate IntPtr GetDeviceProcAddress(IntPtr device, IntPtr name);
+        // Vulkan entry point names are ASCII and well below this length.
+        private const int MaxNameLength = 256;
 
         private IntPtr _loadedLibrary = IntPtr.Zero;
-        private GetInstanceProcAddress _getInstanceProcAddr;
-        private GetDeviceProcAddress _getDeviceProcAddr;
+        private IntPtr _dispatchTable = IntPtr.Zero;
+
+        [DllImport("libryujinxjni")]
+        private extern static IntPtr vulkanLoaderCreate(IntPtr driver);
+
+        [DllImport("libryujinxjni")]
+        private extern static void vulkanLoaderDestroy(IntPtr table);
+
+        [DllImport("libryujinxjni")]
+        private unsafe extern static IntPtr vulkanLoaderGetProcAddr(IntPtr table, IntPtr instance, IntPtr device, byte* name);
 
         public void Dispose()
         {
+            if (_dispatchTable != IntPtr.Zero)
+            {
+                vulkanLoaderDestroy(_dispatchTable);
+                _dispatchTable = IntPtr.Zero;
+            }
+
             if (_loadedLibrary != IntPtr.Zero)
             {
                 NativeLibrary.Free(_loadedLibrary);
@@ -36,60 +50,51 @@ namespace LibRyujinx
 
             if (_loadedLibrary != IntPtr.Zero)
             {
-                var instanceGetProc = NativeLibrary.GetExport(_loadedLibrary, "vkGetInstanceProcAddr");
-                var deviceProc = NativeLibrary.GetExport(_loadedLibrary, "vkGetDeviceProcAddr");
+                _dispatchTable = vulkanLoaderCreate(_loadedLibrary);
 
-                _getInstanceProcAddr = Marshal.GetDelegateForFunctionPointer<GetInstanceProcAddress>(instanceGetProc);
-                _getDeviceProcAddr = Marshal.GetDelegateForFunctionPointer<GetDeviceProcAddress>(deviceProc);
+                if (_dispatchTable == IntPtr.Zero)
+                {
+                    Logger.Error?.Print(LogClass.Gpu, "Custom driver does not export vkGetInstanceProcAddr and vkGetDeviceProcAddr");
+                }
             }
         }
 
         public unsafe Vk GetApi()
         {
-
-            if (_loadedLibrary == IntPtr.Zero)
+            if (_dispatchTable == IntPtr.Zero)
             {
                 return Vk.GetApi();
             }
+
             var ctx = new MultiNativeContext(new INativeContext[1]);
             var ret = new Vk(ctx);
             ctx.Contexts[0] = new LamdaNativeContext
             (
                 x =>
                 {
-                    var xPtr = Marshal.StringToHGlobalAnsi(x);
-                    byte* xp = (byte*)xPtr;
-                    try
+                    if (x.Length >= MaxNameLength)
                     {
-                        nint ptr = default;
-                        ptr = _getInstanceProcAddr(ret.CurrentInstance.GetValueOrDefault().Handle, xPtr);
-
-                        if (ptr == default)
-                        {
-                            ptr = _getInstanceProcAddr(IntPtr.Zero, xPtr);
-
-                            if (ptr == default)
-                            {
-                                var currentDevice = ret.CurrentDevice.GetValueOrDefault().Handle;
-                                if (currentDevice != IntPtr.Zero)
-                                {
-                                    ptr = _getDeviceProcAddr(currentDevice, xPtr);
-                                }
-
-                                if (ptr == default)
-                                {
-                                    Logger.Warning?.Print(LogClass.Gpu, $"Failed to get function pointer: {x}");
-                                }
-
-                            }
-                        }
-
-                        return ptr;
+                        Logger.Warning?.Print(LogClass.Gpu, $"Failed to get function pointer: {x}");
+
+                        return IntPtr.Zero;
                     }
-                    finally
+
+                    byte* name = stackalloc byte[MaxNameLength];
+
+                    int length = Encoding.ASCII.GetBytes(x, new Span<byte>(name, MaxNameLength - 1));
+                    name[length] = 0;
+
+                    nint ptr = vulkanLoaderGetProcAddr(_dispatchTable,
+                        ret.CurrentInstance.GetValueOrDefault().Handle,
+                        ret.CurrentDevice.GetValueOrDefault().Handle,
+                        name);
+
+                    if (ptr == default)
                     {
-                        Marshal.FreeHGlobal(xPtr);
+                        Logger.Warning?.Print(LogClass.Gpu, $"Failed to get function pointer: {x}");
                     }
+
+                    return ptr;
                 }
             );
             return ret;
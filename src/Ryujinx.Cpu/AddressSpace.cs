@@ -30,10 +30,12 @@ namespace Ryujinx.Cpu
             MemoryBlock baseMemory = null;
             MemoryBlock mirrorMemory = null;
 
+            MemoryAllocationFlags asFlags = backingMemory.HugePages ? AsFlags | MemoryAllocationFlags.HugePages : AsFlags;
+
             try
             {
-                baseMemory = new MemoryBlock(asSize, AsFlags);
-                mirrorMemory = new MemoryBlock(asSize, AsFlags);
+                baseMemory = new MemoryBlock(asSize, asFlags);
+                mirrorMemory = new MemoryBlock(asSize, asFlags);
                 addressSpace = new AddressSpace(backingMemory, baseMemory, mirrorMemory, asSize);
             }
             catch (SystemException)
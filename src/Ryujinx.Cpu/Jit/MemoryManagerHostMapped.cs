@@ -23,6 +23,10 @@ namespace Ryujinx.Cpu.Jit
         private readonly PageTable<ulong> _pageTable;
 
         private readonly MemoryEhMeilleure _memoryEh;
+        private readonly UserfaultfdWriteTracker _writeTracker;
+
+        // Pages protected from any access while writes are tracked with userfaultfd, as a mask of 64 pages per entry.
+        private readonly Dictionary<ulong, ulong> _noAccessPages;
 
         private readonly ManagedPageFlags _pages;
 
@@ -70,6 +74,12 @@ namespace Ryujinx.Cpu.Jit
 
             Tracking = new MemoryTracking(this, (int)MemoryBlock.GetPageSize(), invalidAccessHandler);
             _memoryEh = new MemoryEhMeilleure(_addressSpace.Base, _addressSpace.Mirror, Tracking);
+
+            if (OperatingSystem.IsLinux() && UserfaultfdWriteTracker.IsSupported)
+            {
+                _writeTracker = new UserfaultfdWriteTracker(_addressSpace.Base, Tracking);
+                _noAccessPages = new Dictionary<ulong, ulong>();
+            }
         }
 
         /// <summary>
@@ -94,6 +104,9 @@ namespace Ryujinx.Cpu.Jit
             _pages.AddMapping(va, size);
             PtMap(va, pa, size);
 
+            // Ranges that can't be registered fall back to page protection when they are reprotected.
+            _writeTracker?.Register(va, size);
+
             Tracking.Map(va, size);
         }
 
@@ -108,6 +121,12 @@ namespace Ryujinx.Cpu.Jit
             _pages.RemoveMapping(va, size);
             PtUnmap(va, size);
             _addressSpace.Unmap(va, size);
+
+            if (_writeTracker != null)
+            {
+                // The range is no longer accessible, it must not be made accessible when it is reprotected.
+                UpdateNoAccessPages(va, size, false);
+            }
         }
 
         private void PtMap(ulong va, ulong pa, ulong size)
@@ -412,7 +431,14 @@ namespace Ryujinx.Cpu.Jit
         {
             if (guest)
             {
-                _addressSpace.Base.Reprotect(va, size, protection, false);
+                if (_writeTracker != null)
+                {
+                    WriteTrackerReprotect(va, size, protection);
+                }
+                else
+                {
+                    _addressSpace.Base.Reprotect(va, size, protection, false);
+                }
             }
             else
             {
@@ -420,6 +446,72 @@ namespace Ryujinx.Cpu.Jit
             }
         }
 
+        private void WriteTrackerReprotect(ulong va, ulong size, MemoryPermission protection)
+        {
+            // Writes are tracked with userfaultfd, so the host protection only has to change for pages that must also
+            // fault on reads, which is rare, so the mappings are not split for write tracking.
+            if (protection == MemoryPermission.None)
+            {
+                UpdateNoAccessPages(va, size, true);
+
+                _addressSpace.Base.Reprotect(va, size, MemoryPermission.None, false);
+            }
+            else if (UpdateNoAccessPages(va, size, false))
+            {
+                _addressSpace.Base.Reprotect(va, size, MemoryPermission.ReadAndWrite, false);
+            }
+
+            if (!_writeTracker.WriteProtect(va, size, protection != MemoryPermission.ReadAndWrite))
+            {
+                _addressSpace.Base.Reprotect(va, size, protection, false);
+            }
+        }
+
+        private bool UpdateNoAccessPages(ulong va, ulong size, bool noAccess)
+        {
+            lock (_noAccessPages)
+            {
+                if (!noAccess && _noAccessPages.Count == 0)
+                {
+                    return false;
+                }
+
+                bool changed = false;
+
+                ulong endPage = (va + size + PageMask) >> PageBits;
+
+                for (ulong page = va >> PageBits; page < endPage;)
+                {
+                    ulong entry = page >> 6;
+                    int bit = (int)(page & 63);
+                    int count = (int)Math.Min(64 - (ulong)bit, endPage - page);
+                    ulong mask = (count == 64 ? ulong.MaxValue : (1UL << count) - 1) << bit;
+
+                    _noAccessPages.TryGetValue(entry, out ulong pages);
+
+                    ulong newPages = noAccess ? pages | mask : pages & ~mask;
+
+                    if (newPages != pages)
+                    {
+                        changed = true;
+
+                        if (newPages == 0)
+                        {
+                            _noAccessPages.Remove(entry);
+                        }
+                        else
+                        {
+                            _noAccessPages[entry] = newPages;
+                        }
+                    }
+
+                    page += (ulong)count;
+                }
+
+                return changed;
+            }
+        }
+
         /// <inheritdoc/>
         public RegionHandle BeginTracking(ulong address, ulong size, int id, RegionFlags flags = RegionFlags.None)
         {
@@ -443,6 +535,7 @@ namespace Ryujinx.Cpu.Jit
         /// </summary>
         protected override void Destroy()
         {
+            _writeTracker?.Dispose();
             _addressSpace.Dispose();
             _memoryEh.Dispose();
         }
@@ -20,6 +20,7 @@ namespace Ryujinx.Cpu.Jit
         private readonly MemoryBlock _addressSpace;
         private readonly MemoryBlock _backingMemory;
         private readonly PageTable<ulong> _pageTable;
+        private readonly PageTranslationCache _translationCache;
 
         public int AddressSpaceBits { get; }
         protected override ulong AddressSpaceSize { get; }
@@ -54,6 +55,7 @@ namespace Ryujinx.Cpu.Jit
             _addressSpace = addressSpace;
             _backingMemory = backingMemory;
             _pageTable = new PageTable<ulong>();
+            _translationCache = new PageTranslationCache();
             _invalidAccessHandler = invalidAccessHandler;
             _unsafeMode = unsafeMode;
             AddressSpaceSize = addressSpace.Size;
@@ -96,6 +98,7 @@ namespace Ryujinx.Cpu.Jit
             _addressSpace.MapView(_backingMemory, pa, va, size);
             _pages.AddMapping(va, size);
             PtMap(va, pa, size);
+            _translationCache.Invalidate(va, size);
 
             Tracking.Map(va, size);
         }
@@ -122,6 +125,7 @@ namespace Ryujinx.Cpu.Jit
 
             _pages.RemoveMapping(va, size);
             PtUnmap(va, size);
+            _translationCache.Invalidate(va, size);
             _addressSpace.UnmapView(_backingMemory, va, size);
         }
 
@@ -141,6 +145,31 @@ namespace Ryujinx.Cpu.Jit
         {
         }
 
+        public override T Read<T>(ulong va)
+        {
+            // Accesses within a single page only need one translation.
+            if ((va & PageMask) + (ulong)Unsafe.SizeOf<T>() <= PageSize)
+            {
+                return _backingMemory.Read<T>(GetPhysicalAddressChecked(va));
+            }
+
+            return base.Read<T>(va);
+        }
+
+        public override void Write<T>(ulong va, T value)
+        {
+            if ((va & PageMask) + (ulong)Unsafe.SizeOf<T>() <= PageSize)
+            {
+                SignalMemoryTracking(va, (ulong)Unsafe.SizeOf<T>(), write: true);
+
+                _backingMemory.Write(GetPhysicalAddressChecked(va), value);
+
+                return;
+            }
+
+            base.Write(va, value);
+        }
+
         public ref T GetRef<T>(ulong va) where T : unmanaged
         {
             if (!IsContiguous(va, Unsafe.SizeOf<T>()))
@@ -245,17 +274,42 @@ namespace Ryujinx.Cpu.Jit
 
         private ulong GetPhysicalAddressChecked(ulong va)
         {
+            if (_translationCache.TryTranslate(va, out ulong pa))
+            {
+                return pa;
+            }
+
             if (!IsMapped(va))
             {
                 ThrowInvalidMemoryRegionException($"Not mapped: va=0x{va:X16}");
             }
 
-            return GetPhysicalAddressInternal(va);
+            return TranslateAndCache(va);
         }
 
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
         private ulong GetPhysicalAddressInternal(ulong va)
         {
-            return _pageTable.Read(va) + (va & PageMask);
+            if (_translationCache.TryTranslate(va, out ulong pa))
+            {
+                return pa;
+            }
+
+            return TranslateAndCache(va);
+        }
+
+        private ulong TranslateAndCache(ulong va)
+        {
+            int generation = _translationCache.GetGeneration();
+            ulong pa = _pageTable.Read(va) + (va & PageMask);
+
+            // Unmapped pages are not cached, as a cache hit must imply that the page is mapped.
+            if (ValidateAddress(va) && _pages.IsMapped(va))
+            {
+                _translationCache.Fill(va, pa, generation);
+            }
+
+            return pa;
         }
 
         /// <inheritdoc/>
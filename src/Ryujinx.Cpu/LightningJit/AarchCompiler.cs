@@ -16,12 +16,13 @@ namespace Ryujinx.Cpu.LightningJit
             ulong address,
             AddressTable<ulong> funcTable,
             IntPtr dispatchStubPtr,
+            InlineCacheTable inlineCaches,
             ExecutionMode executionMode,
             Architecture targetArch)
         {
             if (executionMode == ExecutionMode.Aarch64)
             {
-                return A64Compiler.Compile(cpuPreset, memoryManager, address, funcTable, dispatchStubPtr, targetArch);
+                return A64Compiler.Compile(cpuPreset, memoryManager, address, funcTable, dispatchStubPtr, inlineCaches, targetArch);
             }
             else
             {
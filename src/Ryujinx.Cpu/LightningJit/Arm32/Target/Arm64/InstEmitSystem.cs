@@ -10,6 +10,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm32.Target.Arm64
     static class InstEmitSystem
     {
         private delegate void SoftwareInterruptHandler(ulong address, int imm);
+        private delegate void SupervisorCallHandler(ulong address, int imm, IntPtr framePointer, IntPtr hostAddress);
         private delegate ulong Get64();
         private delegate bool GetBool();
 
@@ -331,7 +332,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm32.Target.Arm64
 
         private static IntPtr GetSvcHandlerPtr()
         {
-            return Marshal.GetFunctionPointerForDelegate<SoftwareInterruptHandler>(NativeInterface.SupervisorCall);
+            return Marshal.GetFunctionPointerForDelegate<SupervisorCallHandler>(NativeInterface.SupervisorCall);
         }
 
         private static IntPtr GetUdfHandlerPtr()
@@ -386,7 +387,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm32.Target.Arm64
         {
             Assembler asm = new(writer);
 
-            WriteCall(ref asm, regAlloc, GetSvcHandlerPtr(), skipContext: true, spillBaseOffset, null, pc, svcId);
+            WriteCall(ref asm, regAlloc, GetSvcHandlerPtr(), skipContext: true, spillBaseOffset, null, passFrame: true, pc, svcId);
             WriteSyncPoint(writer, ref asm, regAlloc, tailMerger, spillBaseOffset);
         }
 
@@ -479,6 +480,19 @@ namespace Ryujinx.Cpu.LightningJit.Arm32.Target.Arm64
             int spillBaseOffset,
             int? resultRegister,
             params ulong[] callArgs)
+        {
+            WriteCall(ref asm, regAlloc, funcPtr, skipContext, spillBaseOffset, resultRegister, passFrame: false, callArgs);
+        }
+
+        private static void WriteCall(
+            ref Assembler asm,
+            RegisterAllocator regAlloc,
+            IntPtr funcPtr,
+            bool skipContext,
+            int spillBaseOffset,
+            int? resultRegister,
+            bool passFrame,
+            params ulong[] callArgs)
         {
             uint resultMask = 0u;
 
@@ -487,7 +501,8 @@ namespace Ryujinx.Cpu.LightningJit.Arm32.Target.Arm64
                 resultMask = 1u << resultRegister.Value;
             }
 
-            int tempRegister = callArgs.Length;
+            int argsCount = callArgs.Length + (passFrame ? 2 : 0);
+            int tempRegister = argsCount;
 
             if (resultRegister.HasValue && tempRegister == resultRegister.Value)
             {
@@ -501,13 +516,20 @@ namespace Ryujinx.Cpu.LightningJit.Arm32.Target.Arm64
             // We need at least one register to put the function address on, so that reduces the number of
             // registers we can use for that by one.
 
-            Debug.Assert(callArgs.Length < 8);
+            Debug.Assert(argsCount < 8);
 
             for (int index = 0; index < callArgs.Length; index++)
             {
                 asm.Mov(Register(index), callArgs[index]);
             }
 
+            if (passFrame)
+            {
+                // Frame pointer and address of the call, used to walk the call stack of the thread.
+                asm.Mov(Register(callArgs.Length), Register(29));
+                asm.Adr(Register(callArgs.Length + 1), 0);
+            }
+
             Operand rn = Register(tempRegister);
 
             asm.Mov(rn, (ulong)funcPtr);
@@ -14,11 +14,12 @@ namespace Ryujinx.Cpu.LightningJit.Arm64
             ulong address,
             AddressTable<ulong> funcTable,
             IntPtr dispatchStubPtr,
+            InlineCacheTable inlineCaches,
             Architecture targetArch)
         {
             if (targetArch == Architecture.Arm64)
             {
-                return Compiler.Compile(cpuPreset, memoryManager, address, funcTable, dispatchStubPtr);
+                return Compiler.Compile(cpuPreset, memoryManager, address, funcTable, dispatchStubPtr, inlineCaches);
             }
             else
             {
@@ -21,6 +21,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
             public readonly TailMerger TailMerger;
             public readonly AddressTable<ulong> FuncTable;
             public readonly IntPtr DispatchStubPointer;
+            public readonly InlineCacheList InlineCaches;
 
             private readonly MultiBlock _multiBlock;
             private readonly RegisterSaveRestore _registerSaveRestore;
@@ -34,6 +35,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
                 MultiBlock multiBlock,
                 AddressTable<ulong> funcTable,
                 IntPtr dispatchStubPointer,
+                InlineCacheList inlineCaches,
                 IntPtr pageTablePointer)
             {
                 Writer = writer;
@@ -43,6 +45,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
                 _multiBlock = multiBlock;
                 FuncTable = funcTable;
                 DispatchStubPointer = dispatchStubPointer;
+                InlineCaches = inlineCaches;
                 _pageTablePointer = pageTablePointer;
             }
 
@@ -304,7 +307,13 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
             }
         }
 
-        public static CompiledFunction Compile(CpuPreset cpuPreset, IMemoryManager memoryManager, ulong address, AddressTable<ulong> funcTable, IntPtr dispatchStubPtr)
+        public static CompiledFunction Compile(
+            CpuPreset cpuPreset,
+            IMemoryManager memoryManager,
+            ulong address,
+            AddressTable<ulong> funcTable,
+            IntPtr dispatchStubPtr,
+            InlineCacheTable inlineCaches)
         {
             MultiBlock multiBlock = Decoder.DecodeMulti(cpuPreset, memoryManager, address);
 
@@ -325,8 +334,9 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
                 multiBlock.HasHostCall ? CalculateStackSizeForCallSpill(regAlloc.AllGprMask, regAlloc.AllFpSimdMask, regAlloc.AllPStateMask) : 0);
 
             TailMerger tailMerger = new();
+            InlineCacheList inlineCacheList = inlineCaches != null ? new(inlineCaches) : null;
 
-            Context context = new(writer, regAlloc, tailMerger, rsr, multiBlock, funcTable, dispatchStubPtr, memoryManager.PageTablePointer);
+            Context context = new(writer, regAlloc, tailMerger, rsr, multiBlock, funcTable, dispatchStubPtr, inlineCacheList, memoryManager.PageTablePointer);
 
             context.WritePrologue();
 
@@ -417,6 +427,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
                             context.WriteEpilogueWithoutContext,
                             funcTable,
                             dispatchStubPtr,
+                            inlineCacheList,
                             lastInstructionName,
                             pc,
                             lastInstructionEncoding,
@@ -478,7 +489,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
 
             tailMerger.WriteReturn(writer, context.WriteEpilogueWithoutContext);
 
-            return new(writer.AsByteSpan(), (int)(pc - address));
+            return new(writer.AsByteSpan(), (int)(pc - address), inlineCacheList?.ToArray());
         }
 
         private static int CalculateStackSizeForCallSpill(uint gprUseMask, uint fpSimdUseMask, uint pStateUseMask)
@@ -540,6 +551,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
                             context.WriteEpilogueWithoutContext,
                             context.FuncTable,
                             context.DispatchStubPointer,
+                            context.InlineCaches,
                             name,
                             pc,
                             encoding,
@@ -11,7 +11,15 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
 {
     static class InstEmitSystem
     {
+        // Registers that can be used by the inline cache lookup of an indirect branch, as their values were already
+        // stored to the context.
+        private const uint InlineCacheScratchRegsMask = 0x1fffe; // X1 to X16
+
+        // Register used to pass the inline cache to the miss stub.
+        private const int InlineCacheRegister = 17;
+
         private delegate void SoftwareInterruptHandler(ulong address, int imm);
+        private delegate void SupervisorCallHandler(ulong address, int imm, IntPtr framePointer, IntPtr hostAddress);
         private delegate ulong Get64();
         private delegate bool GetBool();
 
@@ -37,7 +45,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
 
                 Assembler asm = new(writer);
 
-                WriteCall(ref asm, regAlloc, GetSvcHandlerPtr(), spillBaseOffset, null, pc, svcId);
+                WriteCall(ref asm, regAlloc, GetSvcHandlerPtr(), spillBaseOffset, null, passFrame: true, pc, svcId);
                 WriteSyncPoint(writer, ref asm, regAlloc, tailMerger, spillBaseOffset);
             }
             else if (name == InstName.UdfPermUndef)
@@ -151,7 +159,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
 
         private static IntPtr GetSvcHandlerPtr()
         {
-            return Marshal.GetFunctionPointerForDelegate<SoftwareInterruptHandler>(NativeInterface.SupervisorCall);
+            return Marshal.GetFunctionPointerForDelegate<SupervisorCallHandler>(NativeInterface.SupervisorCall);
         }
 
         private static IntPtr GetUdfHandlerPtr()
@@ -216,6 +224,7 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
             Action writeEpilogue,
             AddressTable<ulong> funcTable,
             IntPtr dispatchStubPtr,
+            InlineCacheList inlineCaches,
             InstName name,
             ulong pc,
             uint encoding,
@@ -280,7 +289,8 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
                                 spillBaseOffset,
                                 pc,
                                 Register(rnIndex),
-                                isTail);
+                                isTail,
+                                inlineCaches);
                         }
                     }
                     break;
@@ -302,7 +312,8 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
             int spillBaseOffset,
             ulong pc,
             Operand guestAddress,
-            bool isTail = false)
+            bool isTail = false,
+            InlineCacheList inlineCaches = null)
         {
             int tempRegister;
 
@@ -322,6 +333,32 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
 
             tempRegister = regAlloc.FixedContextRegister == 1 ? 2 : 1;
 
+            IntPtr inlineCache = IntPtr.Zero;
+
+            if (guestAddress.Kind == OperandKind.Register && inlineCaches != null)
+            {
+                inlineCache = inlineCaches.Allocate();
+            }
+
+            uint scratchMask = InlineCacheScratchRegsMask & ~((1u << regAlloc.FixedContextRegister) | (1u << regAlloc.FixedPageTableRegister) | (1u << tempRegister));
+
+            if (inlineCache != IntPtr.Zero)
+            {
+                int guestAddressRegister = guestAddress.GetRegister().Index;
+
+                scratchMask &= ~(1u << guestAddressRegister);
+
+                // X0 is overwritten with the context pointer below.
+                if (guestAddressRegister == 0)
+                {
+                    Operand copy = Register(AllocateScratchRegister(ref scratchMask));
+
+                    asm.Mov(copy, guestAddress);
+
+                    guestAddress = copy;
+                }
+            }
+
             if (!isTail)
             {
                 WriteSpillSkipContext(ref asm, regAlloc, spillBaseOffset);
@@ -334,7 +371,11 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
                 asm.Mov(Register(0), Register(regAlloc.FixedContextRegister));
             }
 
-            if (guestAddress.Kind == OperandKind.Constant && funcTable != null)
+            if (inlineCache != IntPtr.Zero)
+            {
+                WriteInlineCacheLookup(writer, ref asm, inlineCaches.MissStubPointer, funcPtr, inlineCache, guestAddress, rn, scratchMask);
+            }
+            else if (guestAddress.Kind == OperandKind.Constant && funcTable != null)
             {
                 ulong funcPtrLoc = (ulong)Unsafe.AsPointer(ref funcTable.GetValue(guestAddress.Value));
 
@@ -366,6 +407,112 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
             }
         }
 
+        private static void WriteInlineCacheLookup(
+            CodeWriter writer,
+            ref Assembler asm,
+            IntPtr missStubPtr,
+            IntPtr dispatchStubPtr,
+            IntPtr inlineCache,
+            Operand guestAddress,
+            Operand rn,
+            uint scratchMask)
+        {
+            Operand cache = Register(AllocateScratchRegister(ref scratchMask));
+            Operand entryAddress = Register(AllocateScratchRegister(ref scratchMask));
+            Operand entryFuncTableEntry = Register(AllocateScratchRegister(ref scratchMask));
+
+            Span<int> hitBranchIndices = stackalloc int[InlineCacheTable.EntriesCount];
+
+            asm.Mov(cache, (ulong)inlineCache);
+
+            // The entries are filled in order, so a monomorphic branch only checks the first one.
+            for (int index = 0; index < InlineCacheTable.EntriesCount; index++)
+            {
+                asm.LdpRiUn(entryAddress, entryFuncTableEntry, cache, index * InlineCacheTable.EntrySize);
+                asm.Cmp(entryAddress, guestAddress);
+
+                hitBranchIndices[index] = writer.InstructionPointer;
+
+                asm.B(ArmCondition.Eq, 0);
+            }
+
+            // Miss. If the cache is not full yet, the miss stub adds the target to it, otherwise the branch is megamorphic
+            // and uses the dispatch stub.
+            asm.LdrRiUn(entryAddress, cache, InlineCacheTable.CountOffset);
+            asm.Cmp(entryAddress, new Operand(OperandKind.Constant, OperandType.I64, InlineCacheTable.EntriesCount));
+
+            int megamorphicBranchIndex = writer.InstructionPointer;
+
+            asm.B(ArmCondition.GeUn, 0);
+            asm.Mov(Register(InlineCacheRegister), cache);
+            asm.Mov(rn, (ulong)missStubPtr);
+
+            int missEndBranchIndex = writer.InstructionPointer;
+
+            asm.B(0);
+
+            PatchBranch(writer, megamorphicBranchIndex);
+
+            if (InlineCacheTable.CollectStatistics)
+            {
+                WriteIncrement(ref asm, cache, InlineCacheTable.MegamorphicDispatchesOffset, entryAddress);
+            }
+
+            asm.Mov(rn, (ulong)dispatchStubPtr);
+
+            int megamorphicEndBranchIndex = writer.InstructionPointer;
+
+            asm.B(0);
+
+            foreach (int branchIndex in hitBranchIndices)
+            {
+                PatchBranch(writer, branchIndex);
+            }
+
+            if (InlineCacheTable.CollectStatistics)
+            {
+                WriteIncrement(ref asm, cache, InlineCacheTable.HitsOffset, entryAddress);
+            }
+
+            asm.LdrRiUn(rn, entryFuncTableEntry, 0);
+
+            PatchBranch(writer, missEndBranchIndex);
+            PatchBranch(writer, megamorphicEndBranchIndex);
+        }
+
+        private static void WriteIncrement(ref Assembler asm, Operand baseAddress, int offset, Operand tempRegister)
+        {
+            asm.LdrRiUn(tempRegister, baseAddress, offset);
+            asm.Add(tempRegister, tempRegister, new Operand(OperandKind.Constant, OperandType.I64, 1UL));
+            asm.StrRiUn(tempRegister, baseAddress, offset);
+        }
+
+        private static void PatchBranch(CodeWriter writer, int branchIndex)
+        {
+            uint branchInst = writer.ReadInstructionAt(branchIndex);
+            int delta = writer.InstructionPointer - branchIndex;
+
+            if ((branchInst & 0xfc000000u) == 0x14000000u)
+            {
+                writer.WriteInstructionAt(branchIndex, branchInst | ((uint)delta & 0x3ffffff));
+            }
+            else
+            {
+                writer.WriteInstructionAt(branchIndex, branchInst | (((uint)delta & 0x7ffff) << 5));
+            }
+        }
+
+        private static int AllocateScratchRegister(ref uint mask)
+        {
+            int index = BitOperations.TrailingZeroCount(mask);
+
+            Debug.Assert(index < 32);
+
+            mask &= ~(1u << index);
+
+            return index;
+        }
+
         private static void WriteCall(
             ref Assembler asm,
             RegisterAllocator regAlloc,
@@ -373,6 +520,18 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
             int spillBaseOffset,
             int? resultRegister,
             params ulong[] callArgs)
+        {
+            WriteCall(ref asm, regAlloc, funcPtr, spillBaseOffset, resultRegister, passFrame: false, callArgs);
+        }
+
+        private static void WriteCall(
+            ref Assembler asm,
+            RegisterAllocator regAlloc,
+            IntPtr funcPtr,
+            int spillBaseOffset,
+            int? resultRegister,
+            bool passFrame,
+            params ulong[] callArgs)
         {
             uint resultMask = 0u;
 
@@ -381,7 +540,8 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
                 resultMask = 1u << resultRegister.Value;
             }
 
-            int tempRegister = callArgs.Length;
+            int argsCount = callArgs.Length + (passFrame ? 2 : 0);
+            int tempRegister = argsCount;
 
             if (resultRegister.HasValue && tempRegister == resultRegister.Value)
             {
@@ -395,13 +555,20 @@ namespace Ryujinx.Cpu.LightningJit.Arm64.Target.Arm64
             // We need at least one register to put the function address on, so that reduces the number of
             // registers we can use for that by one.
 
-            Debug.Assert(callArgs.Length < 8);
+            Debug.Assert(argsCount < 8);
 
             for (int index = 0; index < callArgs.Length; index++)
             {
                 asm.Mov(Register(index), callArgs[index]);
             }
 
+            if (passFrame)
+            {
+                // Frame pointer and address of the call, used to walk the call stack of the thread.
+                asm.Mov(Register(callArgs.Length), Register(29));
+                asm.Adr(Register(callArgs.Length + 1), 0);
+            }
+
             Operand rn = Register(tempRegister);
 
             asm.Mov(rn, (ulong)funcPtr);
@@ -33,22 +33,33 @@ namespace Ryujinx.Cpu.LightningJit.Cache
 
         public int Allocate(int size)
         {
+            // Best fit, so that the holes left by freed functions are filled before the end of the cache is used, and
+            // large free blocks are kept whole for the pages they span to stay decommitted.
+            int bestIndex = -1;
+
             for (int i = 0; i < _blocks.Count; i++)
             {
                 MemoryBlock block = _blocks[i];
 
-                if (block.Size > size)
+                if (block.Size == size)
                 {
-                    _blocks[i] = new(block.Offset + size, block.Size - size);
+                    _blocks.RemoveAt(i);
                     return block.Offset;
                 }
-                else if (block.Size == size)
+                else if (block.Size > size && (bestIndex < 0 || block.Size < _blocks[bestIndex].Size))
                 {
-                    _blocks.RemoveAt(i);
-                    return block.Offset;
+                    bestIndex = i;
                 }
             }
 
+            if (bestIndex >= 0)
+            {
+                MemoryBlock block = _blocks[bestIndex];
+
+                _blocks[bestIndex] = new(block.Offset + size, block.Size - size);
+                return block.Offset;
+            }
+
             // We don't have enough free memory to perform the allocation.
             return -1;
         }
@@ -59,7 +70,8 @@ namespace Ryujinx.Cpu.LightningJit.Cache
 
             if (index < 0)
             {
-                index = ~index;
+                // The block containing the range starts before it, so it comes before the insertion point.
+                index = ~index - 1;
             }
 
             int endOffset = offset + size;
@@ -92,7 +104,15 @@ namespace Ryujinx.Cpu.LightningJit.Cache
             Insert(new MemoryBlock(offset, size));
         }
 
-        private void Insert(MemoryBlock block)
+        public void Free(int offset, int size, out int freeOffset, out int freeSize)
+        {
+            MemoryBlock block = Insert(new MemoryBlock(offset, size));
+
+            freeOffset = block.Offset;
+            freeSize = block.Size;
+        }
+
+        private MemoryBlock Insert(MemoryBlock block)
         {
             int index = _blocks.BinarySearch(block);
 
@@ -126,6 +146,8 @@ namespace Ryujinx.Cpu.LightningJit.Cache
             }
 
             _blocks.Insert(index, block);
+
+            return block;
         }
 
         public void Clear()
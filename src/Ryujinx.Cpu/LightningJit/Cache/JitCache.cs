@@ -16,16 +16,33 @@ namespace Ryujinx.Cpu.LightningJit.Cache
         private const int CodeAlignment = 4; // Bytes.
         private const int CacheSize = 2047 * 1024 * 1024;
 
+        // Minimum number of whole free pages for them to be decommitted, so that freeing a few small functions does not
+        // cause the pages to be committed and decommitted over and over again.
+        private const int MinDecommitPages = 16;
+
         private static ReservedRegion _jitRegion;
         private static JitCacheInvalidation _jitCacheInvalidator;
 
         private static CacheMemoryAllocator _cacheAllocator;
 
+        private static ulong[] _decommittedPages;
+        private static int _highWatermark;
+
         private static readonly List<CacheEntry> _cacheEntries = new();
 
         private static readonly object _lock = new();
         private static bool _initialized;
 
+        /// <summary>
+        /// Start of the memory region where the functions are placed.
+        /// </summary>
+        public static IntPtr RegionPointer => _jitRegion.Pointer;
+
+        /// <summary>
+        /// Size of the memory region where the functions are placed.
+        /// </summary>
+        public static int RegionSize => CacheSize;
+
         [SupportedOSPlatform("windows")]
         [LibraryImport("kernel32.dll", SetLastError = true)]
         public static partial IntPtr FlushInstructionCache(IntPtr hProcess, IntPtr lpAddress, UIntPtr dwSize);
@@ -52,6 +69,7 @@ namespace Ryujinx.Cpu.LightningJit.Cache
                 }
 
                 _cacheAllocator = new CacheMemoryAllocator(CacheSize);
+                _decommittedPages = new ulong[(CacheSize / _pageSize + 63) / 64];
 
                 _initialized = true;
             }
@@ -109,8 +127,10 @@ namespace Ryujinx.Cpu.LightningJit.Cache
 
                 if (TryFind(funcOffset, out CacheEntry entry, out int entryIndex) && entry.Offset == funcOffset)
                 {
-                    _cacheAllocator.Free(funcOffset, AlignCodeSize(entry.Size));
+                    _cacheAllocator.Free(funcOffset, AlignCodeSize(entry.Size), out int freeOffset, out int freeSize);
                     _cacheEntries.RemoveAt(entryIndex);
+
+                    DecommitFreePages(freeOffset, freeSize);
                 }
             }
         }
@@ -148,9 +168,74 @@ namespace Ryujinx.Cpu.LightningJit.Cache
 
             _jitRegion.ExpandIfNeeded((ulong)allocOffset + (ulong)codeSize);
 
+            CommitDecommittedPages(allocOffset, codeSize);
+
+            _highWatermark = Math.Max(_highWatermark, allocOffset + codeSize);
+
             return allocOffset;
         }
 
+        private static void DecommitFreePages(int offset, int size)
+        {
+            // The pages can't be decommitted on macOS, where the cache is written through the JIT write protection
+            // mechanism instead.
+            if (OperatingSystem.IsMacOS() || OperatingSystem.IsIOS())
+            {
+                return;
+            }
+
+            // Only the pages that are entirely free, and that were committed at some point, are decommitted.
+            int startPage = (offset + _pageMask) / _pageSize;
+            int endPage = Math.Min(offset + size, (_highWatermark + _pageMask) & ~_pageMask) / _pageSize;
+
+            if (endPage - startPage < MinDecommitPages)
+            {
+                return;
+            }
+
+            int runStart = -1;
+
+            for (int page = startPage; page <= endPage; page++)
+            {
+                if (page < endPage && !IsPageDecommitted(page))
+                {
+                    if (runStart < 0)
+                    {
+                        runStart = page;
+                    }
+
+                    _decommittedPages[page / 64] |= 1UL << (page & 63);
+                }
+                else if (runStart >= 0)
+                {
+                    _jitRegion.Block.Decommit((ulong)runStart * (ulong)_pageSize, (ulong)(page - runStart) * (ulong)_pageSize);
+
+                    runStart = -1;
+                }
+            }
+        }
+
+        private static void CommitDecommittedPages(int offset, int size)
+        {
+            int startPage = offset / _pageSize;
+            int endPage = (offset + size + _pageMask) / _pageSize;
+
+            for (int page = startPage; page < endPage; page++)
+            {
+                if (IsPageDecommitted(page))
+                {
+                    _decommittedPages[page / 64] &= ~(1UL << (page & 63));
+
+                    _jitRegion.Block.Commit((ulong)page * (ulong)_pageSize, (ulong)_pageSize);
+                }
+            }
+        }
+
+        private static bool IsPageDecommitted(int page)
+        {
+            return (_decommittedPages[page / 64] & (1UL << (page & 63))) != 0;
+        }
+
         private static int AlignCodeSize(int codeSize)
         {
             return checked(codeSize + (CodeAlignment - 1)) & ~(CodeAlignment - 1);
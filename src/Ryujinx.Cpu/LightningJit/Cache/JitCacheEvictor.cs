@@ -0,0 +1,429 @@
+using Ryujinx.Common.Logging;
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace Ryujinx.Cpu.LightningJit.Cache
+{
+    /// <summary>
+    /// Keeps the code of the functions of a translator within a memory budget, by evicting the functions which were not
+    /// called recently.
+    /// </summary>
+    /// <remarks>
+    /// Functions are evicted using the clock algorithm. The reference bit of a function is cleared by removing it from
+    /// the function table, so the next call to it goes through the translator, which sets the bit again and puts it
+    /// back in the table.
+    ///
+    /// The code of an evicted function can't be freed right away, as threads may be executing it, or return to it.
+    /// Each guest thread reports its call stack when it calls the translator, and while it is in a supervisor call, and
+    /// the code is only freed once every thread has reported a call stack without it, after the function was evicted.
+    /// </remarks>
+    class JitCacheEvictor
+    {
+        // Number of times threads must call the translator before trying to free evicted functions again.
+        private const int ReclaimInterval = 32;
+
+        private readonly struct ClockEntry
+        {
+            public ulong Address { get; }
+            public TranslatedFunction Function { get; }
+
+            public ClockEntry(ulong address, TranslatedFunction function)
+            {
+                Address = address;
+                Function = function;
+            }
+        }
+
+        private readonly struct RetiredFunction
+        {
+            public IntPtr FuncPointer { get; }
+            public int HostSize { get; }
+            public IntPtr[] InlineCaches { get; }
+            public ulong Epoch { get; }
+
+            public RetiredFunction(IntPtr funcPointer, int hostSize, IntPtr[] inlineCaches, ulong epoch)
+            {
+                FuncPointer = funcPointer;
+                HostSize = hostSize;
+                InlineCaches = inlineCaches;
+                Epoch = epoch;
+            }
+        }
+
+        private class ThreadState
+        {
+            public ulong Epoch { get; set; }
+            public bool InSupervisorCall { get; set; }
+            public ulong[] CallStack { get; set; } = Array.Empty<ulong>();
+        }
+
+        private readonly Translator _translator;
+        private readonly IStackWalker _stackWalker;
+        private readonly ulong _budget;
+        private readonly ulong _lowWatermark;
+
+        private readonly object _lock = new();
+        private readonly Dictionary<int, ThreadState> _threads = new();
+        private readonly List<ClockEntry> _clock = new();
+        private readonly List<RetiredFunction> _retired = new();
+        private readonly List<ulong> _callStacks = new();
+
+        private int _clockHand;
+        private int _staleClockEntries;
+        private ulong _liveSize;
+        private ulong _epoch;
+        private int _safepointsSinceReclaim;
+
+        public JitCacheEvictor(Translator translator, IStackWalker stackWalker, ulong budget)
+        {
+            _translator = translator;
+            _stackWalker = stackWalker;
+            _budget = budget;
+            _lowWatermark = budget - budget / 8;
+
+            Logger.Info?.Print(LogClass.Cpu, $"JIT cache budget: {budget / (1024 * 1024)} MiB.");
+        }
+
+        public void RegisterThread()
+        {
+            lock (_lock)
+            {
+                // The thread has not executed any code yet, so it can't have any function on its call stack.
+                _threads[Environment.CurrentManagedThreadId] = new ThreadState() { Epoch = _epoch };
+            }
+        }
+
+        public void UnregisterThread()
+        {
+            lock (_lock)
+            {
+                _threads.Remove(Environment.CurrentManagedThreadId);
+
+                Reclaim();
+            }
+        }
+
+        /// <summary>
+        /// Reports the call stack of the current thread, when it calls the translator to get the address of a function.
+        /// </summary>
+        /// <param name="framePointer">Frame pointer of the dispatch stub</param>
+        public void EnterSafepoint(IntPtr framePointer)
+        {
+            ulong[] callStack = GetCallStack(framePointer, 0);
+
+            lock (_lock)
+            {
+                if (_threads.TryGetValue(Environment.CurrentManagedThreadId, out ThreadState state))
+                {
+                    state.CallStack = callStack;
+                    state.Epoch = _epoch;
+                }
+
+                TryReclaim();
+            }
+        }
+
+        /// <summary>
+        /// Reports the call stack of the current thread when it enters a supervisor call. It can't change until the
+        /// supervisor call returns, so it remains valid for functions evicted in the meantime.
+        /// </summary>
+        /// <param name="framePointer">Frame pointer of the function making the call</param>
+        /// <param name="hostAddress">Address of the call on the function making it</param>
+        public void EnterSupervisorCall(IntPtr framePointer, IntPtr hostAddress)
+        {
+            ulong[] callStack = GetCallStack(framePointer, (ulong)hostAddress);
+
+            lock (_lock)
+            {
+                if (_threads.TryGetValue(Environment.CurrentManagedThreadId, out ThreadState state))
+                {
+                    state.CallStack = callStack;
+                    state.InSupervisorCall = true;
+                }
+
+                TryReclaim();
+            }
+        }
+
+        /// <summary>
+        /// Reports that the current thread returned from a supervisor call, where the call stack it reported is still
+        /// the current one.
+        /// </summary>
+        public void LeaveSupervisorCall()
+        {
+            lock (_lock)
+            {
+                if (_threads.TryGetValue(Environment.CurrentManagedThreadId, out ThreadState state))
+                {
+                    state.InSupervisorCall = false;
+                    state.Epoch = _epoch;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Tries to get a translated function, and marks it as referenced.
+        /// </summary>
+        /// <param name="address">Guest address of the function</param>
+        /// <param name="func">Translated function</param>
+        /// <returns><see langword="true"/> if the function was found, <see langword="false"/> otherwise</returns>
+        public bool TryGetFunction(ulong address, out TranslatedFunction func)
+        {
+            lock (_lock)
+            {
+                if (!_translator.Functions.TryGetValue(address, out func))
+                {
+                    return false;
+                }
+
+                func.Referenced = true;
+
+                _translator.RegisterFunction(address, func);
+
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Adds a new translated function, evicting other functions if the budget is exceeded.
+        /// </summary>
+        /// <param name="address">Guest address of the function</param>
+        /// <param name="func">Translated function</param>
+        /// <returns>The function added, or the one that was added by another thread first</returns>
+        public TranslatedFunction AddFunction(ulong address, TranslatedFunction func)
+        {
+            lock (_lock)
+            {
+                TranslatedFunction oldFunc = _translator.Functions.GetOrAdd(address, func.GuestSize, func);
+
+                if (oldFunc != func)
+                {
+                    _translator.FreeFunction(func.FuncPointer, func.InlineCaches);
+                    func = oldFunc;
+                }
+                else
+                {
+                    _clock.Add(new ClockEntry(address, func));
+                    _liveSize += (ulong)func.HostSize;
+                }
+
+                func.Referenced = true;
+
+                _translator.RegisterFunction(address, func);
+
+                if (_liveSize > _budget)
+                {
+                    Evict();
+                    Reclaim();
+                }
+
+                return func;
+            }
+        }
+
+        /// <summary>
+        /// Removes all the functions overlapping a guest memory region, and frees their code once it is safe.
+        /// </summary>
+        /// <param name="address">Start address of the region</param>
+        /// <param name="size">Size of the region</param>
+        public void Invalidate(ulong address, ulong size)
+        {
+            ulong[] overlapAddresses = Array.Empty<ulong>();
+
+            lock (_lock)
+            {
+                int overlapsCount = _translator.Functions.GetOverlaps(address, size, ref overlapAddresses);
+
+                for (int index = 0; index < overlapsCount; index++)
+                {
+                    ulong overlapAddress = overlapAddresses[index];
+
+                    if (_translator.Functions.TryGetValue(overlapAddress, out TranslatedFunction overlap))
+                    {
+                        Retire(overlapAddress, overlap);
+
+                        _staleClockEntries++;
+                    }
+                }
+
+                // The clock entries of the invalidated functions are removed lazily, unless they make up most of it.
+                if (_staleClockEntries > _clock.Count / 2)
+                {
+                    _clock.RemoveAll(entry => entry.Function.Retired);
+                    _clockHand = 0;
+                    _staleClockEntries = 0;
+                }
+
+                Reclaim();
+            }
+        }
+
+        /// <summary>
+        /// Frees the code of the evicted functions that were not freed yet.
+        /// </summary>
+        /// <remarks>
+        /// This must only be called once no thread is executing code anymore.
+        /// </remarks>
+        public void Clear()
+        {
+            lock (_lock)
+            {
+                foreach (RetiredFunction retired in _retired)
+                {
+                    _translator.FreeFunction(retired.FuncPointer, retired.InlineCaches);
+                }
+
+                _retired.Clear();
+                _clock.Clear();
+
+                _staleClockEntries = 0;
+                _liveSize = 0;
+            }
+        }
+
+        private void Evict()
+        {
+            // A single sweep at most, so that a function gets a chance to be called again after its reference bit is
+            // cleared, before it is evicted.
+            for (int steps = _clock.Count; steps > 0 && _liveSize > _lowWatermark; steps--)
+            {
+                if (_clockHand >= _clock.Count)
+                {
+                    _clockHand = 0;
+                }
+
+                ClockEntry entry = _clock[_clockHand];
+
+                if (entry.Function.Retired)
+                {
+                    RemoveClockEntry(_clockHand);
+
+                    _staleClockEntries--;
+                }
+                else if (entry.Function.Referenced)
+                {
+                    entry.Function.Referenced = false;
+
+                    Unregister(entry.Address);
+
+                    _clockHand++;
+                }
+                else
+                {
+                    Retire(entry.Address, entry.Function);
+                    RemoveClockEntry(_clockHand);
+                }
+            }
+        }
+
+        private void Retire(ulong address, TranslatedFunction func)
+        {
+            _translator.Functions.Remove(address);
+
+            Unregister(address);
+
+            func.Retired = true;
+
+            // The function can only be freed once every thread has reported its call stack after this point.
+            _retired.Add(new RetiredFunction(func.FuncPointer, func.HostSize, func.InlineCaches, ++_epoch));
+
+            _liveSize -= (ulong)func.HostSize;
+        }
+
+        private void Unregister(ulong address)
+        {
+            if (_translator.FunctionTable.IsValid(address))
+            {
+                Volatile.Write(ref _translator.FunctionTable.GetValue(address), _translator.FunctionTable.Fill);
+            }
+        }
+
+        private void RemoveClockEntry(int index)
+        {
+            int lastIndex = _clock.Count - 1;
+
+            _clock[index] = _clock[lastIndex];
+            _clock.RemoveAt(lastIndex);
+        }
+
+        private void TryReclaim()
+        {
+            if (_retired.Count != 0 && ++_safepointsSinceReclaim >= ReclaimInterval)
+            {
+                Reclaim();
+            }
+        }
+
+        private void Reclaim()
+        {
+            _safepointsSinceReclaim = 0;
+
+            if (_retired.Count == 0)
+            {
+                return;
+            }
+
+            ulong minEpoch = ulong.MaxValue;
+
+            _callStacks.Clear();
+
+            foreach (ThreadState state in _threads.Values)
+            {
+                if (!state.InSupervisorCall)
+                {
+                    minEpoch = Math.Min(minEpoch, state.Epoch);
+                }
+
+                _callStacks.AddRange(state.CallStack);
+            }
+
+            _callStacks.Sort();
+
+            int count = 0;
+
+            for (int index = 0; index < _retired.Count; index++)
+            {
+                RetiredFunction retired = _retired[index];
+
+                if (retired.Epoch <= minEpoch && !IsOnCallStack(retired))
+                {
+                    _translator.FreeFunction(retired.FuncPointer, retired.InlineCaches);
+                }
+                else
+                {
+                    _retired[count++] = retired;
+                }
+            }
+
+            _retired.RemoveRange(count, _retired.Count - count);
+        }
+
+        private bool IsOnCallStack(RetiredFunction retired)
+        {
+            ulong start = (ulong)retired.FuncPointer;
+            ulong end = start + (ulong)retired.HostSize;
+
+            int index = _callStacks.BinarySearch(start);
+
+            if (index < 0)
+            {
+                index = ~index;
+            }
+
+            return index < _callStacks.Count && _callStacks[index] < end;
+        }
+
+        private ulong[] GetCallStack(IntPtr framePointer, ulong hostAddress)
+        {
+            List<ulong> callStack = new(_stackWalker.GetCallStack(framePointer, JitCache.RegionPointer, JitCache.RegionSize, IntPtr.Zero, 0));
+
+            if (hostAddress != 0)
+            {
+                callStack.Add(hostAddress);
+            }
+
+            return callStack.ToArray();
+        }
+    }
+}
@@ -156,7 +156,7 @@ namespace Ryujinx.Cpu.LightningJit.Cache
                     funcPtr = _sharedCache.Pointer + funcOffset;
                     code.CopyTo(new Span<byte>((void*)funcPtr, code.Length));
 
-                    TranslatedFunction function = new(funcPtr, guestSize);
+                    TranslatedFunction function = new(funcPtr, guestSize, code.Length);
 
                     _pendingMap.Add(funcOffset, code.Length, guestAddress, function);
                 }
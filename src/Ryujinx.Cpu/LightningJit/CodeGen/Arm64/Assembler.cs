@@ -173,6 +173,14 @@ namespace Ryujinx.Cpu.LightningJit.CodeGen.Arm64
             WriteInstructionAuto(0x31000000u, 0x2b000000u, rd, rn, rm, shiftType, shiftAmount, immForm);
         }
 
+        public readonly void Adr(Operand rd, int imm)
+        {
+            uint immLo = (uint)imm & 3;
+            uint immHi = ((uint)imm >> 2) & 0x7ffff;
+
+            WriteUInt32(0x10000000u | (immLo << 29) | (immHi << 5) | EncodeReg(rd));
+        }
+
         public readonly void And(Operand rd, Operand rn, Operand rm)
         {
             And(rd, rn, rm, ArmShiftType.Lsl, 0);
@@ -6,11 +6,13 @@ namespace Ryujinx.Cpu.LightningJit
     {
         public readonly ReadOnlySpan<byte> Code;
         public readonly int GuestCodeLength;
+        public readonly IntPtr[] InlineCaches;
 
-        public CompiledFunction(ReadOnlySpan<byte> code, int guestCodeLength)
+        public CompiledFunction(ReadOnlySpan<byte> code, int guestCodeLength, IntPtr[] inlineCaches = null)
         {
             Code = code;
             GuestCodeLength = guestCodeLength;
+            InlineCaches = inlineCaches;
         }
     }
 }
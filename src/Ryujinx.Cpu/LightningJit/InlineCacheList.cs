@@ -0,0 +1,53 @@
+using System;
+using System.Collections.Generic;
+
+namespace Ryujinx.Cpu.LightningJit
+{
+    /// <summary>
+    /// Inline caches allocated for the indirect branches of a function being compiled.
+    /// </summary>
+    /// <remarks>
+    /// The caches belong to the function, and are freed along with its code.
+    /// </remarks>
+    class InlineCacheList
+    {
+        private readonly InlineCacheTable _table;
+        private readonly List<IntPtr> _caches;
+
+        /// <summary>
+        /// Stub that fills the inline cache passed on X17 with the function it dispatches to.
+        /// </summary>
+        public IntPtr MissStubPointer => _table.MissStubPointer;
+
+        public InlineCacheList(InlineCacheTable table)
+        {
+            _table = table;
+            _caches = new List<IntPtr>();
+        }
+
+        /// <summary>
+        /// Allocates an empty inline cache.
+        /// </summary>
+        /// <returns>Pointer to the inline cache, or <see cref="IntPtr.Zero"/> if no more caches can be allocated</returns>
+        public IntPtr Allocate()
+        {
+            IntPtr cache = _table.Allocate();
+
+            if (cache != IntPtr.Zero)
+            {
+                _caches.Add(cache);
+            }
+
+            return cache;
+        }
+
+        /// <summary>
+        /// Gets all the inline caches that were allocated.
+        /// </summary>
+        /// <returns>The inline caches, or null if none were allocated</returns>
+        public IntPtr[] ToArray()
+        {
+            return _caches.Count != 0 ? _caches.ToArray() : null;
+        }
+    }
+}
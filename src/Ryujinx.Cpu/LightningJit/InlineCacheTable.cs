@@ -0,0 +1,266 @@
+using ARMeilleure.Common;
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Ryujinx.Cpu.LightningJit
+{
+    /// <summary>
+    /// Storage for the inline caches of the indirect branches of translated functions.
+    /// </summary>
+    /// <remarks>
+    /// Each indirect branch has its own cache, with up to <see cref="EntriesCount"/> targets added in the order they
+    /// are first seen. An entry holds the guest address of a target and a pointer to its entry on the function table,
+    /// rather than the address of its code, so that entries remain valid when functions are removed or replaced.
+    ///
+    /// Entries that were not filled yet point to an entry holding the slow dispatch stub, so code that reads an entry
+    /// while it is being filled always branches somewhere that can handle the guest address.
+    ///
+    /// Caches are owned by the function they were allocated for, and are reused once its code is freed.
+    /// </remarks>
+    unsafe class InlineCacheTable : IDisposable
+    {
+        /// <summary>
+        /// Maximum number of targets of each inline cache.
+        /// </summary>
+        public const int EntriesCount = 4;
+
+        public const int EntrySize = 16;
+        public const int EntryFuncTableEntryOffset = 8;
+        public const int CountOffset = EntriesCount * EntrySize;
+        public const int HitsOffset = CountOffset + 8;
+        public const int MegamorphicDispatchesOffset = HitsOffset + 8;
+
+        private const int CacheSize = MegamorphicDispatchesOffset + 16;
+
+        private const int CachesPerChunk = 4096;
+        private const int MaxChunks = 64;
+
+        private readonly AddressTable<ulong> _functionTable;
+        private readonly List<IntPtr> _chunks;
+        private readonly Stack<IntPtr> _freeCaches;
+        private readonly object _lock;
+
+        private ulong* _fillEntry;
+        private int _chunkCachesCount;
+        private long _missesCount;
+        private long _freedHitsCount;
+        private long _freedMegamorphicDispatchesCount;
+        private bool _disposed;
+
+        /// <summary>
+        /// Stub that fills the inline cache passed on X17 with the function it dispatches to.
+        /// </summary>
+        public IntPtr MissStubPointer { get; }
+
+        /// <summary>
+        /// Number of branches that did not find their target on an inline cache that was not full yet.
+        /// </summary>
+        public long MissesCount => Interlocked.Read(ref _missesCount);
+
+        /// <summary>
+        /// Whether code that counts the hits and megamorphic dispatches of each inline cache is emitted.
+        /// </summary>
+        /// <remarks>
+        /// The counters add a few instructions to every indirect branch, so they are only emitted along with debug logs.
+        /// </remarks>
+        public static bool CollectStatistics { get; set; }
+
+        public InlineCacheTable(AddressTable<ulong> functionTable, IntPtr missStubPointer)
+        {
+            _functionTable = functionTable;
+            _chunks = new List<IntPtr>();
+            _freeCaches = new Stack<IntPtr>();
+            _lock = new object();
+
+            MissStubPointer = missStubPointer;
+
+            _fillEntry = (ulong*)Marshal.AllocHGlobal(sizeof(ulong));
+            *_fillEntry = functionTable.Fill;
+
+            _chunkCachesCount = CachesPerChunk;
+        }
+
+        /// <summary>
+        /// Allocates an empty inline cache.
+        /// </summary>
+        /// <returns>Pointer to the inline cache, or <see cref="IntPtr.Zero"/> if no more caches can be allocated</returns>
+        public IntPtr Allocate()
+        {
+            lock (_lock)
+            {
+                ObjectDisposedException.ThrowIf(_disposed, this);
+
+                byte* cache;
+
+                if (_freeCaches.TryPop(out IntPtr freeCache))
+                {
+                    cache = (byte*)freeCache;
+                }
+                else
+                {
+                    if (_chunkCachesCount == CachesPerChunk)
+                    {
+                        if (_chunks.Count == MaxChunks)
+                        {
+                            return IntPtr.Zero;
+                        }
+
+                        _chunks.Add(Marshal.AllocHGlobal(CachesPerChunk * CacheSize));
+                        _chunkCachesCount = 0;
+                    }
+
+                    cache = (byte*)_chunks[^1] + _chunkCachesCount++ * CacheSize;
+                }
+
+                new Span<byte>(cache, CacheSize).Clear();
+
+                for (int index = 0; index < EntriesCount; index++)
+                {
+                    *(ulong*)(cache + index * EntrySize) = ulong.MaxValue;
+                    *(ulong*)(cache + index * EntrySize + EntryFuncTableEntryOffset) = (ulong)_fillEntry;
+                }
+
+                return (IntPtr)cache;
+            }
+        }
+
+        /// <summary>
+        /// Frees the inline caches of a function, so that they can be allocated again.
+        /// </summary>
+        /// <remarks>
+        /// The code of the function must no longer be executed by any thread.
+        /// </remarks>
+        /// <param name="inlineCaches">Inline caches to free, or null if the function has none</param>
+        public void Free(IntPtr[] inlineCaches)
+        {
+            if (inlineCaches == null)
+            {
+                return;
+            }
+
+            lock (_lock)
+            {
+                if (_disposed)
+                {
+                    return;
+                }
+
+                foreach (IntPtr inlineCache in inlineCaches)
+                {
+                    byte* cache = (byte*)inlineCache;
+
+                    // The counters are cleared when the cache is allocated again, keep them for the statistics.
+                    _freedHitsCount += *(long*)(cache + HitsOffset);
+                    _freedMegamorphicDispatchesCount += *(long*)(cache + MegamorphicDispatchesOffset);
+
+                    *(long*)(cache + HitsOffset) = 0;
+                    *(long*)(cache + MegamorphicDispatchesOffset) = 0;
+
+                    _freeCaches.Push(inlineCache);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Adds a target to an inline cache, if it is not full yet.
+        /// </summary>
+        /// <param name="inlineCache">Inline cache to add the target to</param>
+        /// <param name="guestAddress">Guest address of the target</param>
+        public void AddTarget(IntPtr inlineCache, ulong guestAddress)
+        {
+            Interlocked.Increment(ref _missesCount);
+
+            if (!_functionTable.IsValid(guestAddress))
+            {
+                return;
+            }
+
+            byte* cache = (byte*)inlineCache;
+
+            lock (_lock)
+            {
+                int count = (int)*(ulong*)(cache + CountOffset);
+
+                if (count == EntriesCount)
+                {
+                    return;
+                }
+
+                // Another thread may have missed on the same target before it was added.
+                for (int index = 0; index < count; index++)
+                {
+                    if (*(ulong*)(cache + index * EntrySize) == guestAddress)
+                    {
+                        return;
+                    }
+                }
+
+                ulong funcTableEntry = (ulong)Unsafe.AsPointer(ref _functionTable.GetValue(guestAddress));
+
+                byte* entry = cache + count * EntrySize;
+
+                Volatile.Write(ref *(ulong*)(entry + EntryFuncTableEntryOffset), funcTableEntry);
+                Volatile.Write(ref *(ulong*)entry, guestAddress);
+                Volatile.Write(ref *(ulong*)(cache + CountOffset), (ulong)(count + 1));
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of hits and megamorphic dispatches of all the inline caches.
+        /// </summary>
+        /// <remarks>
+        /// The counts are only collected while <see cref="CollectStatistics"/> is set, and are approximate, as the
+        /// counters are not updated atomically.
+        /// </remarks>
+        /// <param name="hitsCount">Number of branches to a target found on the inline cache</param>
+        /// <param name="megamorphicDispatchesCount">Number of branches dispatched without a cache, as it was full</param>
+        public void GetStatistics(out long hitsCount, out long megamorphicDispatchesCount)
+        {
+            lock (_lock)
+            {
+                hitsCount = _freedHitsCount;
+                megamorphicDispatchesCount = _freedMegamorphicDispatchesCount;
+
+                for (int chunkIndex = 0; chunkIndex < _chunks.Count; chunkIndex++)
+                {
+                    byte* chunk = (byte*)_chunks[chunkIndex];
+                    int cachesCount = chunkIndex == _chunks.Count - 1 ? _chunkCachesCount : CachesPerChunk;
+
+                    for (int index = 0; index < cachesCount; index++)
+                    {
+                        byte* cache = chunk + index * CacheSize;
+
+                        hitsCount += *(long*)(cache + HitsOffset);
+                        megamorphicDispatchesCount += *(long*)(cache + MegamorphicDispatchesOffset);
+                    }
+                }
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (_lock)
+            {
+                if (_disposed)
+                {
+                    return;
+                }
+
+                foreach (IntPtr chunk in _chunks)
+                {
+                    Marshal.FreeHGlobal(chunk);
+                }
+
+                _chunks.Clear();
+
+                Marshal.FreeHGlobal((IntPtr)_fillEntry);
+                _fillEntry = null;
+
+                _disposed = true;
+            }
+        }
+    }
+}
@@ -6,6 +6,12 @@ namespace Ryujinx.Cpu.LightningJit
     {
         private readonly ITickSource _tickSource;
 
+        /// <summary>
+        /// Maximum size in bytes of the code of the functions translated for each process, before the functions which
+        /// were not called recently are evicted. Zero disables the eviction.
+        /// </summary>
+        public static ulong JitCacheBudget { get; set; }
+
         public LightningJitEngine(ITickSource tickSource)
         {
             _tickSource = tickSource;
@@ -41,9 +41,11 @@ namespace Ryujinx.Cpu.LightningJit
             GetContext().OnBreak(address, imm);
         }
 
-        public static void SupervisorCall(ulong address, int imm)
+        public static void SupervisorCall(ulong address, int imm, IntPtr framePointer, IntPtr hostAddress)
         {
+            Context.Translator.EnterSupervisorCall(framePointer, hostAddress);
             GetContext().OnSupervisorCall(address, imm);
+            Context.Translator.LeaveSupervisorCall();
         }
 
         public static void Undefined(ulong address, int opCode)
@@ -66,6 +68,16 @@ namespace Ryujinx.Cpu.LightningJit
             return (ulong)Context.Translator.GetOrTranslatePointer(framePointer, address, GetContext().ExecutionMode);
         }
 
+        public static ulong GetFunctionAddressForInlineCache(IntPtr framePointer, ulong address, IntPtr inlineCache)
+        {
+            ulong hostAddress = (ulong)Context.Translator.GetOrTranslatePointer(framePointer, address, GetContext().ExecutionMode);
+
+            // The function is registered on the function table by now, so the cache can point to its entry.
+            Context.Translator.InlineCaches.AddTarget(inlineCache, address);
+
+            return hostAddress;
+        }
+
         public static void InvalidateCacheLine(ulong address)
         {
             Context.Translator.InvalidateJitCacheRegion(address, DczSizeInBytes);
@@ -6,11 +6,29 @@ namespace Ryujinx.Cpu.LightningJit
     {
         public IntPtr FuncPointer { get; }
         public ulong GuestSize { get; }
+        public int HostSize { get; }
 
-        public TranslatedFunction(IntPtr funcPointer, ulong guestSize)
+        /// <summary>
+        /// Inline caches of the indirect branches of the function, or null if it has none.
+        /// </summary>
+        public IntPtr[] InlineCaches { get; }
+
+        /// <summary>
+        /// Whether the function was called since the eviction clock hand last passed over it.
+        /// </summary>
+        public bool Referenced { get; set; }
+
+        /// <summary>
+        /// Whether the function was removed from the translator, and its code is waiting to be freed.
+        /// </summary>
+        public bool Retired { get; set; }
+
+        public TranslatedFunction(IntPtr funcPointer, ulong guestSize, int hostSize, IntPtr[] inlineCaches = null)
         {
             FuncPointer = funcPointer;
             GuestSize = guestSize;
+            HostSize = hostSize;
+            InlineCaches = inlineCaches;
         }
     }
 }
@@ -1,5 +1,7 @@
+using ARMeilleure;
 using ARMeilleure.Common;
 using ARMeilleure.Memory;
+using Ryujinx.Common.Logging;
 using Ryujinx.Cpu.Jit;
 using Ryujinx.Cpu.LightningJit.Cache;
 using Ryujinx.Cpu.LightningJit.CodeGen.Arm64;
@@ -9,6 +11,7 @@ using Ryujinx.Memory;
 using System;
 using System.Collections.Concurrent;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Runtime.InteropServices;
 using System.Threading;
 
@@ -40,11 +43,13 @@ namespace Ryujinx.Cpu.LightningJit
 
         private readonly ConcurrentQueue<KeyValuePair<ulong, TranslatedFunction>> _oldFuncs;
         private readonly NoWxCache _noWxCache;
+        private readonly JitCacheEvictor _evictor;
         private bool _disposed;
 
         internal TranslatorCache<TranslatedFunction> Functions { get; }
         internal AddressTable<ulong> FunctionTable { get; }
         internal TranslatorStubs Stubs { get; }
+        internal InlineCacheTable InlineCaches { get; }
         internal IMemoryManager Memory { get; }
 
         public Translator(IMemoryManager memory, bool for64Bits)
@@ -68,6 +73,18 @@ namespace Ryujinx.Cpu.LightningJit
 
             FunctionTable.Fill = (ulong)Stubs.SlowDispatchStub;
 
+            // Functions are not registered on the function table when W^X is enforced, so caching it is pointless.
+            if (_noWxCache == null)
+            {
+                InlineCacheTable.CollectStatistics = Logger.Debug.HasValue;
+                InlineCaches = new InlineCacheTable(FunctionTable, Stubs.InlineCacheMissStub);
+            }
+
+            if (_noWxCache == null && LightningJitEngine.JitCacheBudget != 0)
+            {
+                _evictor = new JitCacheEvictor(this, CreateStackWalker(), LightningJitEngine.JitCacheBudget);
+            }
+
             if (memory.Type.IsHostMappedOrTracked())
             {
                 NativeSignalHandler.InitializeSignalHandler();
@@ -91,9 +108,11 @@ namespace Ryujinx.Cpu.LightningJit
             ObjectDisposedException.ThrowIf(_disposed, this);
 
             NativeInterface.RegisterThread(context, Memory, this);
+            _evictor?.RegisterThread();
 
             Stubs.DispatchLoop(context.NativeContextPtr, address);
 
+            _evictor?.UnregisterThread();
             NativeInterface.UnregisterThread();
             _noWxCache?.ClearEntireThreadLocalCache();
         }
@@ -102,14 +121,40 @@ namespace Ryujinx.Cpu.LightningJit
         {
             if (_noWxCache != null)
             {
+                long startTimestamp = Stopwatch.GetTimestamp();
+
                 CompiledFunction func = Compile(address, mode);
 
+                Statistics.RecordTranslationStall(Stopwatch.GetTimestamp() - startTimestamp);
+
                 return _noWxCache.Map(framePointer, func.Code, address, (ulong)func.GuestCodeLength);
             }
 
+            if (_evictor != null)
+            {
+                _evictor.EnterSafepoint(framePointer);
+
+                if (!_evictor.TryGetFunction(address, out TranslatedFunction func))
+                {
+                    func = _evictor.AddFunction(address, Translate(address, mode));
+                }
+
+                return func.FuncPointer;
+            }
+
             return GetOrTranslate(address, mode).FuncPointer;
         }
 
+        internal void EnterSupervisorCall(IntPtr framePointer, IntPtr hostAddress)
+        {
+            _evictor?.EnterSupervisorCall(framePointer, hostAddress);
+        }
+
+        internal void LeaveSupervisorCall()
+        {
+            _evictor?.LeaveSupervisorCall();
+        }
+
         private TranslatedFunction GetOrTranslate(ulong address, ExecutionMode mode)
         {
             if (!Functions.TryGetValue(address, out TranslatedFunction func))
@@ -120,7 +165,7 @@ namespace Ryujinx.Cpu.LightningJit
 
                 if (oldFunc != func)
                 {
-                    JitCache.Unmap(func.FuncPointer);
+                    FreeFunction(func.FuncPointer, func.InlineCaches);
                     func = oldFunc;
                 }
 
@@ -138,21 +183,51 @@ namespace Ryujinx.Cpu.LightningJit
             }
         }
 
+        /// <summary>
+        /// Frees the code and inline caches of a function that is no longer executed by any thread.
+        /// </summary>
+        /// <param name="funcPointer">Pointer to the code of the function</param>
+        /// <param name="inlineCaches">Inline caches of the function, or null if it has none</param>
+        internal void FreeFunction(IntPtr funcPointer, IntPtr[] inlineCaches)
+        {
+            JitCache.Unmap(funcPointer);
+            InlineCaches?.Free(inlineCaches);
+        }
+
         private TranslatedFunction Translate(ulong address, ExecutionMode mode)
         {
+            long startTimestamp = Stopwatch.GetTimestamp();
+
             CompiledFunction func = Compile(address, mode);
             IntPtr funcPointer = JitCache.Map(func.Code);
 
-            return new TranslatedFunction(funcPointer, (ulong)func.GuestCodeLength);
+            Statistics.RecordTranslationStall(Stopwatch.GetTimestamp() - startTimestamp);
+
+            return new TranslatedFunction(funcPointer, (ulong)func.GuestCodeLength, func.Code.Length, func.InlineCaches);
         }
 
         private CompiledFunction Compile(ulong address, ExecutionMode mode)
         {
-            return AarchCompiler.Compile(CpuPresets.CortexA57, Memory, address, FunctionTable, Stubs.DispatchStub, mode, RuntimeInformation.ProcessArchitecture);
+            return AarchCompiler.Compile(
+                CpuPresets.CortexA57,
+                Memory,
+                address,
+                FunctionTable,
+                Stubs.DispatchStub,
+                InlineCaches,
+                mode,
+                RuntimeInformation.ProcessArchitecture);
         }
 
         public void InvalidateJitCacheRegion(ulong address, ulong size)
         {
+            if (_evictor != null)
+            {
+                _evictor.Invalidate(address, size);
+
+                return;
+            }
+
             ulong[] overlapAddresses = Array.Empty<ulong>();
 
             int overlapsCount = Functions.GetOverlaps(address, size, ref overlapAddresses);
@@ -184,15 +259,34 @@ namespace Ryujinx.Cpu.LightningJit
 
             foreach (var func in functions)
             {
-                JitCache.Unmap(func.FuncPointer);
+                FreeFunction(func.FuncPointer, func.InlineCaches);
             }
 
             Functions.Clear();
 
             while (_oldFuncs.TryDequeue(out var kv))
             {
-                JitCache.Unmap(kv.Value.FuncPointer);
+                FreeFunction(kv.Value.FuncPointer, kv.Value.InlineCaches);
             }
+
+            _evictor?.Clear();
+        }
+
+        private void LogInlineCacheStatistics()
+        {
+            if (!InlineCacheTable.CollectStatistics)
+            {
+                return;
+            }
+
+            InlineCaches.GetStatistics(out long hitsCount, out long megamorphicDispatchesCount);
+
+            long missesCount = InlineCaches.MissesCount;
+            long totalCount = Math.Max(1L, hitsCount + missesCount + megamorphicDispatchesCount);
+
+            Logger.Debug?.Print(LogClass.Cpu,
+                $"Inline caches: {hitsCount} hits ({hitsCount * 100 / totalCount}%), {missesCount} misses, " +
+                $"{megamorphicDispatchesCount} megamorphic dispatches.");
         }
 
         protected virtual void Dispose(bool disposing)
@@ -210,6 +304,13 @@ namespace Ryujinx.Cpu.LightningJit
                         ClearJitCache();
                     }
 
+                    if (InlineCaches != null)
+                    {
+                        LogInlineCacheStatistics();
+
+                        InlineCaches.Dispose();
+                    }
+
                     Stubs.Dispose();
                     FunctionTable.Dispose();
                 }
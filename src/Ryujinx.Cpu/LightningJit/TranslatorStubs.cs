@@ -18,8 +18,10 @@ namespace Ryujinx.Cpu.LightningJit
     class TranslatorStubs : IDisposable
     {
         private delegate ulong GetFunctionAddressDelegate(IntPtr framePointer, ulong address);
+        private delegate ulong GetFunctionAddressForInlineCacheDelegate(IntPtr framePointer, ulong address, IntPtr inlineCache);
 
         private readonly Lazy<IntPtr> _slowDispatchStub;
+        private readonly Lazy<IntPtr> _inlineCacheMissStub;
 
         private bool _disposed;
 
@@ -27,6 +29,8 @@ namespace Ryujinx.Cpu.LightningJit
         private readonly NoWxCache _noWxCache;
         private readonly GetFunctionAddressDelegate _getFunctionAddressRef;
         private readonly IntPtr _getFunctionAddress;
+        private readonly GetFunctionAddressForInlineCacheDelegate _getFunctionAddressForInlineCacheRef;
+        private readonly IntPtr _getFunctionAddressForInlineCache;
         private readonly Lazy<IntPtr> _dispatchStub;
         private readonly Lazy<DispatcherFunction> _dispatchLoop;
 
@@ -58,6 +62,20 @@ namespace Ryujinx.Cpu.LightningJit
             }
         }
 
+        /// <summary>
+        /// Gets the inline cache miss stub.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException"><see cref="TranslatorStubs"/> instance was disposed</exception>
+        public IntPtr InlineCacheMissStub
+        {
+            get
+            {
+                ObjectDisposedException.ThrowIf(_disposed, this);
+
+                return _inlineCacheMissStub.Value;
+            }
+        }
+
         /// <summary>
         /// Gets the dispatch loop function.
         /// </summary>
@@ -87,7 +105,10 @@ namespace Ryujinx.Cpu.LightningJit
             _noWxCache = noWxCache;
             _getFunctionAddressRef = NativeInterface.GetFunctionAddress;
             _getFunctionAddress = Marshal.GetFunctionPointerForDelegate(_getFunctionAddressRef);
+            _getFunctionAddressForInlineCacheRef = NativeInterface.GetFunctionAddressForInlineCache;
+            _getFunctionAddressForInlineCache = Marshal.GetFunctionPointerForDelegate(_getFunctionAddressForInlineCacheRef);
             _slowDispatchStub = new(GenerateSlowDispatchStub, isThreadSafe: true);
+            _inlineCacheMissStub = new(GenerateInlineCacheMissStub, isThreadSafe: true);
             _dispatchStub = new(GenerateDispatchStub, isThreadSafe: true);
             _dispatchLoop = new(GenerateDispatchLoop, isThreadSafe: true);
         }
@@ -116,6 +137,11 @@ namespace Ryujinx.Cpu.LightningJit
                         JitCache.Unmap(_dispatchStub.Value);
                     }
 
+                    if (_inlineCacheMissStub.IsValueCreated)
+                    {
+                        JitCache.Unmap(_inlineCacheMissStub.Value);
+                    }
+
                     if (_dispatchLoop.IsValueCreated)
                     {
                         JitCache.Unmap(Marshal.GetFunctionPointerForDelegate(_dispatchLoop.Value));
@@ -260,6 +286,47 @@ namespace Ryujinx.Cpu.LightningJit
             return Map(writer.AsByteSpan());
         }
 
+        /// <summary>
+        /// Generates a <see cref="InlineCacheMissStub"/>.
+        /// </summary>
+        /// <returns>Generated <see cref="InlineCacheMissStub"/></returns>
+        private IntPtr GenerateInlineCacheMissStub()
+        {
+            CodeWriter writer = new();
+
+            if (RuntimeInformation.ProcessArchitecture == Architecture.Arm64)
+            {
+                Assembler asm = new(writer);
+                RegisterSaveRestore rsr = new(1u << 19, hasCall: true);
+
+                // The inline cache of the branch is passed on X17.
+                asm.Mov(Register(2), Register(17));
+
+                rsr.WritePrologue(ref asm);
+
+                Operand context = Register(19);
+                asm.Mov(context, Register(0));
+
+                // Load the target guest address from the native context.
+                asm.Mov(Register(0), Register(29));
+                asm.LdrRiUn(Register(1), context, NativeContext.GetDispatchAddressOffset());
+                asm.Mov(Register(16), (ulong)_getFunctionAddressForInlineCache);
+                asm.Blr(Register(16));
+                asm.Mov(Register(16), Register(0));
+                asm.Mov(Register(0), Register(19));
+
+                rsr.WriteEpilogue(ref asm);
+
+                asm.Br(Register(16));
+            }
+            else
+            {
+                throw new PlatformNotSupportedException();
+            }
+
+            return Map(writer.AsByteSpan());
+        }
+
         /// <summary>
         /// Emits code that syncs FP state before executing guest code, or returns it to normal.
         /// </summary>
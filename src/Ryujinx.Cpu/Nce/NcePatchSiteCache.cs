@@ -0,0 +1,124 @@
+using Ryujinx.Common.Logging;
+using System;
+using System.IO;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace Ryujinx.Cpu.Nce
+{
+    /// <summary>
+    /// Cache of the locations of the instructions patched on a text section, so it does not have to be scanned again.
+    /// </summary>
+    /// <remarks>
+    /// The cache is named after the build ID of the executable and is only checked against the size of the text section,
+    /// hashing the whole section would cost about as much as the scan. Mods and patches can change the code without
+    /// changing the build ID, so the loader does not use the cache for modified executables. The time the scan took is
+    /// kept along with the locations, so that it can be compared with the time it takes to load the cache.
+    /// </remarks>
+    static class NcePatchSiteCache
+    {
+        private const uint Magic = 0x5045434e; // NCEP
+        private const uint Version = 3;
+
+        [StructLayout(LayoutKind.Sequential, Pack = 1)]
+        private struct Header
+        {
+            public uint Magic;
+            public uint Version;
+            public long TextSize;
+            public long ScanTicks;
+            public int SitesCount;
+        }
+
+        /// <summary>
+        /// Tries to load the locations of the patched instructions of a text section.
+        /// </summary>
+        /// <param name="fileName">Name of the cache file</param>
+        /// <param name="textSize">Size in bytes of the text section the locations are for</param>
+        /// <param name="sites">Indices of the instructions to patch</param>
+        /// <param name="scanTime">Time it took to scan the text section for the instructions</param>
+        /// <returns>True if the cache exists and is valid for the text section, false otherwise</returns>
+        public static bool TryLoad(string fileName, int textSize, out int[] sites, out TimeSpan scanTime)
+        {
+            sites = null;
+            scanTime = TimeSpan.Zero;
+
+            if (!File.Exists(fileName))
+            {
+                return false;
+            }
+
+            try
+            {
+                using FileStream stream = new(fileName, FileMode.Open, FileAccess.Read, FileShare.Read);
+
+                Header header = default;
+
+                if (stream.Read(MemoryMarshal.AsBytes(MemoryMarshal.CreateSpan(ref header, 1))) != Unsafe.SizeOf<Header>() ||
+                    header.Magic != Magic ||
+                    header.Version != Version ||
+                    header.TextSize != textSize ||
+                    header.SitesCount < 0 ||
+                    header.SitesCount > textSize / sizeof(uint) ||
+                    stream.Length - stream.Position != (long)header.SitesCount * sizeof(int))
+                {
+                    return false;
+                }
+
+                sites = new int[header.SitesCount];
+                scanTime = TimeSpan.FromTicks(header.ScanTicks);
+
+                stream.ReadExactly(MemoryMarshal.AsBytes(sites.AsSpan()));
+            }
+            catch (Exception ex) when (ex is IOException || ex is UnauthorizedAccessException)
+            {
+                Logger.Warning?.Print(LogClass.Cpu, $"Failed to read the NCE patch cache: {ex.Message}");
+
+                sites = null;
+
+                return false;
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        /// Saves the locations of the patched instructions of a text section.
+        /// </summary>
+        /// <param name="fileName">Name of the cache file</param>
+        /// <param name="textSize">Size in bytes of the text section the locations are for</param>
+        /// <param name="sites">Indices of the instructions to patch</param>
+        /// <param name="scanTime">Time it took to scan the text section for the instructions</param>
+        public static void Save(string fileName, int textSize, int[] sites, TimeSpan scanTime)
+        {
+            Header header = new()
+            {
+                Magic = Magic,
+                Version = Version,
+                TextSize = textSize,
+                ScanTicks = scanTime.Ticks,
+                SitesCount = sites.Length,
+            };
+
+            string tempFileName = fileName + ".tmp";
+
+            try
+            {
+                Directory.CreateDirectory(Path.GetDirectoryName(fileName));
+
+                using (FileStream stream = new(tempFileName, FileMode.Create, FileAccess.Write, FileShare.None))
+                {
+                    stream.Write(MemoryMarshal.AsBytes(MemoryMarshal.CreateSpan(ref header, 1)));
+                    stream.Write(MemoryMarshal.AsBytes(sites.AsSpan()));
+                }
+
+                // Replaced at once, so that a cache cut short by the process being killed is never read.
+                File.Move(tempFileName, fileName, overwrite: true);
+            }
+            catch (Exception ex) when (ex is IOException || ex is UnauthorizedAccessException)
+            {
+                Logger.Warning?.Print(LogClass.Cpu, $"Failed to write the NCE patch cache: {ex.Message}");
+            }
+        }
+    }
+}
@@ -1,7 +1,12 @@
 using Ryujinx.Cpu.Nce.Arm64;
 using Ryujinx.Common.Logging;
 using System;
+using System.Collections.Generic;
+using System.Diagnostics;
 using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+using System.Text;
+using System.Threading.Tasks;
 
 namespace Ryujinx.Cpu.Nce
 {
@@ -12,56 +17,257 @@ namespace Ryujinx.Cpu.Nce
         private const uint IntCalleeSavedRegsMask = 0x1ff80000; // X19 to X28
         private const uint FpCalleeSavedRegsMask = 0xff00; // D8 to D15
 
+        // Size of the slices of the text section scanned by each worker, in instructions.
+        private const int ScanSliceLength = 0x40000;
+
+        private enum PatchKind
+        {
+            Svc,
+            MrsTpidrroEl0,
+            MrsTpidrEl0,
+            MrsCtrEl0,
+            MrsCntpctEl0,
+            MsrTpidrEl0,
+            Count,
+        }
+
+        private static readonly string[] _patchKindNames =
+        {
+            "SVC",
+            "MRS TPIDRRO_EL0",
+            "MRS TPIDR_EL0",
+            "MRS CTR_EL0",
+            "MRS CNTPCT_EL0",
+            "MSR TPIDR_EL0",
+        };
+
         public static NceCpuCodePatch CreatePatch(ReadOnlySpan<byte> textSection)
         {
-            NceCpuCodePatch codePatch = new();
+            return CreatePatch(textSection, null);
+        }
+
+        /// <summary>
+        /// Creates the patch replacing the instructions of a text section that can't be executed natively.
+        /// </summary>
+        /// <param name="textSection">Text section to patch</param>
+        /// <param name="cacheFileName">File where the locations of the instructions are cached, or null to always scan for them</param>
+        /// <returns>Code patch</returns>
+        public static NceCpuCodePatch CreatePatch(ReadOnlySpan<byte> textSection, string cacheFileName)
+        {
+            long startTimestamp = Stopwatch.GetTimestamp();
 
             var textUint = MemoryMarshal.Cast<byte, uint>(textSection);
 
-            for (int i = 0; i < textUint.Length; i++)
+            bool cached = false;
+            TimeSpan lookupTime = TimeSpan.Zero;
+            TimeSpan scanTime;
+
+            if (cacheFileName != null && NcePatchSiteCache.TryLoad(cacheFileName, textSection.Length, out int[] sites, out scanTime))
+            {
+                cached = true;
+                lookupTime = Stopwatch.GetElapsedTime(startTimestamp);
+            }
+            else
+            {
+                long scanTimestamp = Stopwatch.GetTimestamp();
+
+                sites = FindPatchSites(textUint);
+                scanTime = Stopwatch.GetElapsedTime(scanTimestamp);
+
+                if (cacheFileName != null)
+                {
+                    NcePatchSiteCache.Save(cacheFileName, textSection.Length, sites, scanTime);
+                }
+            }
+
+            NceCpuCodePatch codePatch = new();
+
+            // Sites with the same instruction get the same code, so it is only generated once.
+            Dictionary<uint, uint[]> patchCodeCache = new();
+            Span<int> kindCounts = stackalloc int[(int)PatchKind.Count];
+
+            foreach (int i in sites)
             {
+                if ((uint)i >= (uint)textUint.Length)
+                {
+                    continue;
+                }
+
                 uint inst = textUint[i];
-                ulong address = (ulong)i * sizeof(uint);
+                PatchKind kind = GetPatchKind(inst);
 
-                if ((inst & ~(0xffffu << 5)) == 0xd4000001u) // svc #0
+                if (kind == PatchKind.Count)
                 {
-                    uint svcId = (ushort)(inst >> 5);
-                    codePatch.AddCode(i, WriteSvcPatch(svcId));
-                    Logger.Debug?.Print(LogClass.Cpu, $"Patched SVC #{svcId} at 0x{address:X}.");
+                    continue;
                 }
-                else if ((inst & ~0x1f) == 0xd53bd060) // mrs x0, tpidrro_el0
+
+                if (!patchCodeCache.TryGetValue(inst, out uint[] code))
                 {
-                    uint rd = inst & 0x1f;
-                    codePatch.AddCode(i, WriteMrsTpidrroEl0Patch(rd));
-                    Logger.Debug?.Print(LogClass.Cpu, $"Patched MRS x{rd}, tpidrro_el0 at 0x{address:X}.");
+                    code = WritePatch(kind, inst);
+                    patchCodeCache.Add(inst, code);
                 }
-                else if ((inst & ~0x1f) == 0xd53bd040) // mrs x0, tpidr_el0
+
+                codePatch.AddCode(i, code);
+                kindCounts[(int)kind]++;
+
+                Logger.Debug?.Print(LogClass.Cpu, $"Patched {_patchKindNames[(int)kind]} (0x{inst:X8}) at 0x{(ulong)i * sizeof(uint):X}.");
+            }
+
+            if (Logger.Info.HasValue)
+            {
+                LogReport(kindCounts, textSection.Length, cached, lookupTime, scanTime, Stopwatch.GetElapsedTime(startTimestamp));
+            }
+
+            return codePatch;
+        }
+
+        private static PatchKind GetPatchKind(uint inst)
+        {
+            if ((inst & ~(0xffffu << 5)) == 0xd4000001u) // svc #0
+            {
+                return PatchKind.Svc;
+            }
+
+            return (inst & ~0x1fu) switch
+            {
+                0xd53bd060u => PatchKind.MrsTpidrroEl0, // mrs x0, tpidrro_el0
+                0xd53bd040u => PatchKind.MrsTpidrEl0, // mrs x0, tpidr_el0
+                0xd53b0020u when OperatingSystem.IsMacOS() => PatchKind.MrsCtrEl0, // mrs x0, ctr_el0
+                0xd53be020u => PatchKind.MrsCntpctEl0, // mrs x0, cntpct_el0
+                0xd51bd040u => PatchKind.MsrTpidrEl0, // msr tpidr_el0, x0
+                _ => PatchKind.Count,
+            };
+        }
+
+        private static uint[] WritePatch(PatchKind kind, uint inst)
+        {
+            uint rd = inst & 0x1f;
+
+            return kind switch
+            {
+                PatchKind.Svc => WriteSvcPatch((ushort)(inst >> 5)),
+                PatchKind.MrsTpidrroEl0 => WriteMrsTpidrroEl0Patch(rd),
+                PatchKind.MrsTpidrEl0 => WriteMrsTpidrEl0Patch(rd),
+                PatchKind.MrsCtrEl0 => WriteMrsCtrEl0Patch(rd),
+                PatchKind.MrsCntpctEl0 => WriteMrsCntpctEl0Patch(rd),
+                _ => WriteMsrTpidrEl0Patch(rd),
+            };
+        }
+
+        /// <summary>
+        /// Finds the instructions of a text section that need to be patched.
+        /// </summary>
+        /// <remarks>
+        /// Large text sections are split into slices scanned in parallel. Each slice is filtered with vector compares
+        /// against the encodings of SVC and of MRS/MSR with a system register, which are rare enough that only a few
+        /// instructions have to be looked at individually.
+        /// </remarks>
+        /// <param name="text">Instructions of the text section</param>
+        /// <returns>Indices of the instructions to patch, in ascending order</returns>
+        private static unsafe int[] FindPatchSites(ReadOnlySpan<uint> text)
+        {
+            int slicesCount = (text.Length + ScanSliceLength - 1) / ScanSliceLength;
+
+            fixed (uint* pText = text)
+            {
+                if (slicesCount <= 1)
                 {
-                    uint rd = inst & 0x1f;
-                    codePatch.AddCode(i, WriteMrsTpidrEl0Patch(rd));
-                    Logger.Debug?.Print(LogClass.Cpu, $"Patched MRS x{rd}, tpidr_el0 at 0x{address:X}.");
+                    return ScanSlice(pText, 0, text.Length).ToArray();
                 }
-                else if ((inst & ~0x1f) == 0xd53b0020 && OperatingSystem.IsMacOS()) // mrs x0, ctr_el0
+
+                IntPtr textPointer = (IntPtr)pText;
+                int textLength = text.Length;
+
+                List<int>[] sliceSites = new List<int>[slicesCount];
+
+                Parallel.For(0, slicesCount, slice =>
+                {
+                    int start = slice * ScanSliceLength;
+
+                    sliceSites[slice] = ScanSlice((uint*)textPointer, start, Math.Min(textLength, start + ScanSliceLength));
+                });
+
+                List<int> sites = new();
+
+                foreach (List<int> slice in sliceSites)
                 {
-                    uint rd = inst & 0x1f;
-                    codePatch.AddCode(i, WriteMrsCtrEl0Patch(rd));
-                    Logger.Debug?.Print(LogClass.Cpu, $"Patched MRS x{rd}, ctr_el0 at 0x{address:X}.");
+                    sites.AddRange(slice);
                 }
-                else if ((inst & ~0x1f) == 0xd53be020) // mrs x0, cntpct_el0
+
+                return sites.ToArray();
+            }
+        }
+
+        private static unsafe List<int> ScanSlice(uint* text, int start, int end)
+        {
+            List<int> sites = new();
+
+            int i = start;
+
+            if (Vector128.IsHardwareAccelerated)
+            {
+                Vector128<uint> svcMask = Vector128.Create(~(0xffffu << 5));
+                Vector128<uint> svcValue = Vector128.Create(0xd4000001u);
+                Vector128<uint> sysRegMask = Vector128.Create(0xffd00000u);
+                Vector128<uint> sysRegValue = Vector128.Create(0xd5100000u); // MRS or MSR (register)
+
+                for (; i + 8 <= end; i += 8)
                 {
-                    uint rd = inst & 0x1f;
-                    codePatch.AddCode(i, WriteMrsCntpctEl0Patch(rd));
-                    Logger.Debug?.Print(LogClass.Cpu, $"Patched MRS x{rd}, cntpct_el0 at 0x{address:X}.");
+                    Vector128<uint> v0 = Vector128.Load(text + i);
+                    Vector128<uint> v1 = Vector128.Load(text + i + 4);
+
+                    Vector128<uint> match =
+                        Vector128.Equals(v0 & svcMask, svcValue) |
+                        Vector128.Equals(v0 & sysRegMask, sysRegValue) |
+                        Vector128.Equals(v1 & svcMask, svcValue) |
+                        Vector128.Equals(v1 & sysRegMask, sysRegValue);
+
+                    if (match != Vector128<uint>.Zero)
+                    {
+                        ScanScalar(text, i, i + 8, sites);
+                    }
                 }
-                else if ((inst & ~0x1f) == 0xd51bd040) // msr tpidr_el0, x0
+            }
+
+            ScanScalar(text, i, end, sites);
+
+            return sites;
+        }
+
+        private static unsafe void ScanScalar(uint* text, int start, int end, List<int> sites)
+        {
+            for (int i = start; i < end; i++)
+            {
+                if (GetPatchKind(text[i]) != PatchKind.Count)
                 {
-                    uint rd = inst & 0x1f;
-                    codePatch.AddCode(i, WriteMsrTpidrEl0Patch(rd));
-                    Logger.Debug?.Print(LogClass.Cpu, $"Patched MSR tpidr_el0, x{rd} at 0x{address:X}.");
+                    sites.Add(i);
                 }
             }
+        }
 
-            return codePatch;
+        private static void LogReport(ReadOnlySpan<int> kindCounts, int textSize, bool cached, TimeSpan lookupTime, TimeSpan scanTime, TimeSpan elapsed)
+        {
+            int total = 0;
+
+            StringBuilder counts = new();
+
+            for (int kind = 0; kind < kindCounts.Length; kind++)
+            {
+                total += kindCounts[kind];
+
+                counts.Append(kind == 0 ? "" : ", ").Append(_patchKindNames[kind]).Append(": ").Append(kindCounts[kind]);
+            }
+
+            // SVC and CNTPCT_EL0 sites call into managed code, the others only access the native context.
+            int managedCalls = kindCounts[(int)PatchKind.Svc] + kindCounts[(int)PatchKind.MrsCntpctEl0];
+
+            string locations = cached
+                ? $"with cached locations loaded in {lookupTime.TotalMilliseconds:F2} ms instead of a {scanTime.TotalMilliseconds:F2} ms scan"
+                : $"scanned in {scanTime.TotalMilliseconds:F2} ms";
+
+            Logger.Info?.Print(LogClass.Cpu,
+                $"Patched {total} instructions ({managedCalls} calling into managed code) of a {textSize / 1024} KiB text section " +
+                $"in {elapsed.TotalMilliseconds:F2} ms, {locations}. {counts}.");
         }
 
         private static uint[] WriteSvcPatch(uint svcId)
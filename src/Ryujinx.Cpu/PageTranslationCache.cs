@@ -0,0 +1,128 @@
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+namespace Ryujinx.Cpu
+{
+    /// <summary>
+    /// Direct mapped cache of virtual to physical page translations, placed in front of a slower page table.
+    /// </summary>
+    /// <remarks>
+    /// Only translations of mapped pages are cached, so a hit also means the page is mapped.
+    /// The cache must be invalidated after the page table is modified.
+    /// </remarks>
+    internal sealed class PageTranslationCache
+    {
+        private const int PageBits = 12;
+        private const ulong PageMask = (1UL << PageBits) - 1;
+
+        private const int EntryBits = 12;
+        private const int EntryCount = 1 << EntryBits;
+        private const int EntryMask = EntryCount - 1;
+
+        // Each entry holds the virtual page number plus one on the upper bits, and the physical page number on the lower bits.
+        // Zero is never a valid entry, and the 48-bit virtual page number plus one fits in the remaining 37 bits.
+        private const int PaPageBits = 27;
+        private const ulong PaPageMask = (1UL << PaPageBits) - 1;
+
+        private readonly ulong[] _entries;
+        private int _generation;
+
+        /// <summary>
+        /// Creates a new empty translation cache.
+        /// </summary>
+        public PageTranslationCache()
+        {
+            _entries = new ulong[EntryCount];
+        }
+
+        /// <summary>
+        /// Tries to translate a virtual address using the cached translations.
+        /// </summary>
+        /// <param name="va">Virtual address to translate</param>
+        /// <param name="pa">Physical address, if the translation is cached</param>
+        /// <returns>True if the translation of the page is cached, false otherwise</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public bool TryTranslate(ulong va, out ulong pa)
+        {
+            ulong vaPage = va >> PageBits;
+            ulong entry = _entries[(int)vaPage & EntryMask];
+
+            if ((entry >> PaPageBits) == vaPage + 1)
+            {
+                pa = ((entry & PaPageMask) << PageBits) | (va & PageMask);
+
+                return true;
+            }
+
+            pa = 0;
+
+            return false;
+        }
+
+        /// <summary>
+        /// Gets the value that must be passed to <see cref="Fill"/>, read before the page table is walked.
+        /// </summary>
+        /// <returns>Current generation of the cache</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public int GetGeneration()
+        {
+            return Volatile.Read(ref _generation);
+        }
+
+        /// <summary>
+        /// Caches the translation of a mapped page.
+        /// </summary>
+        /// <param name="va">Virtual address of the page</param>
+        /// <param name="pa">Physical address of the page</param>
+        /// <param name="generation">Generation of the cache before the page table was walked</param>
+        public void Fill(ulong va, ulong pa, int generation)
+        {
+            ulong vaPage = va >> PageBits;
+            ulong paPage = pa >> PageBits;
+
+            if (paPage > PaPageMask)
+            {
+                return;
+            }
+
+            ref ulong entry = ref _entries[(int)vaPage & EntryMask];
+
+            Interlocked.Exchange(ref entry, ((vaPage + 1) << PaPageBits) | paPage);
+
+            // The page table might have been modified and the cache invalidated while it was walked,
+            // in which case the translation might already be stale.
+            if (Volatile.Read(ref _generation) != generation)
+            {
+                Volatile.Write(ref entry, 0UL);
+            }
+        }
+
+        /// <summary>
+        /// Removes the cached translations of a range, after its page table entries were modified.
+        /// </summary>
+        /// <param name="va">Virtual address of the range</param>
+        /// <param name="size">Size of the range</param>
+        public void Invalidate(ulong va, ulong size)
+        {
+            Interlocked.Increment(ref _generation);
+
+            ulong startPage = va >> PageBits;
+            ulong endPage = (va + size + PageMask) >> PageBits;
+
+            if (endPage - startPage >= EntryCount)
+            {
+                for (int index = 0; index < EntryCount; index++)
+                {
+                    Volatile.Write(ref _entries[index], 0UL);
+                }
+
+                return;
+            }
+
+            for (ulong page = startPage; page < endPage; page++)
+            {
+                Volatile.Write(ref _entries[(int)page & EntryMask], 0UL);
+            }
+        }
+    }
+}
@@ -0,0 +1,350 @@
+using Ryujinx.Common;
+using Ryujinx.Common.Logging;
+using Ryujinx.Memory;
+using Ryujinx.Memory.Tracking;
+using System;
+using System.Runtime.InteropServices;
+using System.Runtime.Versioning;
+using System.Threading;
+
+namespace Ryujinx.Cpu
+{
+    /// <summary>
+    /// Tracks writes to an address space using the write protect mode of Linux userfaultfd, rather than page protection.
+    /// </summary>
+    /// <remarks>
+    /// Write protected pages keep their protection, so protecting and unprotecting them does not split the mappings of
+    /// the address space. Writes to them block the thread until a handler thread has signalled the tracking and removed
+    /// the write protection, without raising a signal on the thread.
+    ///
+    /// Only writes are tracked. Pages that must fault on reads still need to be protected by the caller.
+    /// </remarks>
+    [SupportedOSPlatform("linux")]
+    public sealed partial class UserfaultfdWriteTracker : IDisposable
+    {
+        [StructLayout(LayoutKind.Sequential)]
+        private struct UffdioApi
+        {
+            public ulong Api;
+            public ulong Features;
+            public ulong Ioctls;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct UffdioRange
+        {
+            public ulong Start;
+            public ulong Length;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct UffdioRegister
+        {
+            public UffdioRange Range;
+            public ulong Mode;
+            public ulong Ioctls;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct UffdioWriteProtect
+        {
+            public UffdioRange Range;
+            public ulong Mode;
+        }
+
+        [StructLayout(LayoutKind.Explicit, Size = 32)]
+        private struct UffdMsg
+        {
+            [FieldOffset(0)]
+            public byte Event;
+            [FieldOffset(8)]
+            public ulong Flags;
+            [FieldOffset(16)]
+            public ulong Address;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct PollFd
+        {
+            public int Fd;
+            public short Events;
+            public short REvents;
+        }
+
+        private const int SysUserfaultfdX64 = 323;
+        private const int SysUserfaultfdArm64 = 282;
+
+        private const int O_NONBLOCK = 0x800;
+        private const int O_CLOEXEC = 0x80000;
+        private const int UFFD_USER_MODE_ONLY = 1;
+
+        private const ulong UFFD_API = 0xaa;
+        private const ulong UFFD_FEATURE_PAGEFAULT_FLAG_WP = 1 << 0;
+        private const ulong UFFD_FEATURE_WP_HUGETLBFS_SHMEM = 1 << 12;
+
+        private const ulong UFFDIO_API = 0xc018aa3f;
+        private const ulong UFFDIO_REGISTER = 0xc020aa00;
+        private const ulong UFFDIO_WAKE = 0x8010aa02;
+        private const ulong UFFDIO_WRITEPROTECT = 0xc018aa06;
+
+        private const ulong UFFDIO_REGISTER_MODE_WP = 1 << 1;
+        private const ulong UFFDIO_WRITEPROTECT_MODE_WP = 1 << 0;
+
+        private const byte UFFD_EVENT_PAGEFAULT = 0x12;
+        private const ulong UFFD_PAGEFAULT_FLAG_WP = 1 << 1;
+
+        private const short POLLIN = 1;
+        private const int EFD_CLOEXEC = 0x80000;
+
+        [LibraryImport("libc", SetLastError = true)]
+        private static partial long syscall(long number, int flags);
+
+        [LibraryImport("libc", SetLastError = true)]
+        private static unsafe partial int ioctl(int fd, ulong request, void* arg);
+
+        [LibraryImport("libc", SetLastError = true)]
+        private static unsafe partial int poll(PollFd* fds, ulong nfds, int timeout);
+
+        [LibraryImport("libc", SetLastError = true)]
+        private static unsafe partial nint read(int fd, void* buffer, nuint count);
+
+        [LibraryImport("libc", SetLastError = true)]
+        private static unsafe partial nint write(int fd, void* buffer, nuint count);
+
+        [LibraryImport("libc", SetLastError = true)]
+        private static partial int eventfd(uint initval, int flags);
+
+        [LibraryImport("libc", SetLastError = true)]
+        private static partial int close(int fd);
+
+        private static readonly Lazy<bool> _isSupported = new(CheckSupport);
+
+        /// <summary>
+        /// Whether the host supports tracking writes to shared memory with userfaultfd.
+        /// </summary>
+        public static bool IsSupported => _isSupported.Value;
+
+        private readonly MemoryTracking _tracking;
+        private readonly ulong _baseAddress;
+        private readonly ulong _pageSize;
+
+        private readonly int _uffd;
+        private readonly int _stopEvent;
+        private readonly Thread _handlerThread;
+
+        private long _faultsCount;
+        private bool _disposed;
+
+        /// <summary>
+        /// Number of write faults handled.
+        /// </summary>
+        public long FaultsCount => Interlocked.Read(ref _faultsCount);
+
+        /// <summary>
+        /// Creates a new userfaultfd write tracker for an address space.
+        /// </summary>
+        /// <param name="addressSpace">Address space accessed by the guest</param>
+        /// <param name="tracking">Tracking signalled when a write protected page of the address space is written</param>
+        /// <exception cref="NotSupportedException">Userfaultfd write protection is not supported by the host</exception>
+        public UserfaultfdWriteTracker(MemoryBlock addressSpace, MemoryTracking tracking)
+        {
+            _tracking = tracking;
+            _baseAddress = (ulong)addressSpace.Pointer;
+            _pageSize = MemoryBlock.GetPageSize();
+
+            _uffd = Open();
+
+            if (_uffd < 0)
+            {
+                throw new NotSupportedException("Userfaultfd write protection is not supported.");
+            }
+
+            _stopEvent = eventfd(0, EFD_CLOEXEC);
+
+            _handlerThread = new Thread(HandleFaults)
+            {
+                Name = "Cpu.WriteTracker",
+                Priority = ThreadPriority.Highest,
+                IsBackground = true,
+            };
+
+            _handlerThread.Start();
+        }
+
+        private static bool CheckSupport()
+        {
+            if (!OperatingSystem.IsLinux() || PlatformInfo.IsBionic)
+            {
+                return false;
+            }
+
+            int uffd = Open();
+
+            if (uffd < 0)
+            {
+                return false;
+            }
+
+            close(uffd);
+
+            return true;
+        }
+
+        private static unsafe int Open()
+        {
+            long sysUserfaultfd = RuntimeInformation.ProcessArchitecture switch
+            {
+                Architecture.X64 => SysUserfaultfdX64,
+                Architecture.Arm64 => SysUserfaultfdArm64,
+                _ => -1,
+            };
+
+            if (sysUserfaultfd < 0)
+            {
+                return -1;
+            }
+
+            // Unprivileged processes may only be allowed to handle faults from user mode, which is all that is needed.
+            int uffd = (int)syscall(sysUserfaultfd, O_CLOEXEC | O_NONBLOCK);
+
+            if (uffd < 0)
+            {
+                uffd = (int)syscall(sysUserfaultfd, O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY);
+            }
+
+            if (uffd < 0)
+            {
+                return -1;
+            }
+
+            const ulong RequiredFeatures = UFFD_FEATURE_PAGEFAULT_FLAG_WP | UFFD_FEATURE_WP_HUGETLBFS_SHMEM;
+
+            UffdioApi api = new()
+            {
+                Api = UFFD_API,
+                Features = RequiredFeatures,
+            };
+
+            if (ioctl(uffd, UFFDIO_API, &api) != 0 || (api.Features & RequiredFeatures) != RequiredFeatures)
+            {
+                close(uffd);
+
+                return -1;
+            }
+
+            return uffd;
+        }
+
+        /// <summary>
+        /// Registers a range of the address space for write protection. This must be done again when the range is mapped.
+        /// </summary>
+        /// <param name="va">Virtual address of the range</param>
+        /// <param name="size">Size of the range</param>
+        /// <returns>True if the range was registered, false otherwise</returns>
+        public unsafe bool Register(ulong va, ulong size)
+        {
+            UffdioRegister register = new()
+            {
+                Range = new UffdioRange { Start = _baseAddress + va, Length = size },
+                Mode = UFFDIO_REGISTER_MODE_WP,
+            };
+
+            return ioctl(_uffd, UFFDIO_REGISTER, &register) == 0;
+        }
+
+        /// <summary>
+        /// Sets or removes the write protection of a range of the address space.
+        /// </summary>
+        /// <remarks>
+        /// Threads waiting on writes to the range are woken up when the protection is removed.
+        /// </remarks>
+        /// <param name="va">Virtual address of the range</param>
+        /// <param name="size">Size of the range</param>
+        /// <param name="protect">True to write protect the range, false to allow writes</param>
+        /// <returns>True if the protection was changed, false if the range is not registered</returns>
+        public unsafe bool WriteProtect(ulong va, ulong size, bool protect)
+        {
+            UffdioWriteProtect writeProtect = new()
+            {
+                Range = new UffdioRange { Start = _baseAddress + va, Length = size },
+                Mode = protect ? UFFDIO_WRITEPROTECT_MODE_WP : 0,
+            };
+
+            return ioctl(_uffd, UFFDIO_WRITEPROTECT, &writeProtect) == 0;
+        }
+
+        private unsafe void HandleFaults()
+        {
+            PollFd* fds = stackalloc PollFd[2];
+            UffdMsg msg;
+
+            while (true)
+            {
+                fds[0] = new PollFd { Fd = _uffd, Events = POLLIN };
+                fds[1] = new PollFd { Fd = _stopEvent, Events = POLLIN };
+
+                if (poll(fds, 2, -1) < 0)
+                {
+                    continue;
+                }
+
+                if (fds[1].REvents != 0)
+                {
+                    return;
+                }
+
+                while (read(_uffd, &msg, (nuint)sizeof(UffdMsg)) == sizeof(UffdMsg))
+                {
+                    if (msg.Event == UFFD_EVENT_PAGEFAULT && (msg.Flags & UFFD_PAGEFAULT_FLAG_WP) != 0)
+                    {
+                        HandleWriteFault(msg.Address);
+                    }
+                }
+            }
+        }
+
+        private unsafe void HandleWriteFault(ulong hostAddress)
+        {
+            ulong va = BitUtils.AlignDown(hostAddress - _baseAddress, _pageSize);
+
+            Interlocked.Increment(ref _faultsCount);
+
+            try
+            {
+                // The tracking removes the write protection, which wakes the thread up.
+                _tracking.VirtualMemoryEvent(va, _pageSize, write: true);
+            }
+            catch (InvalidMemoryRegionException)
+            {
+                // The page was unmapped, the thread will fault again on the unmapped page once woken up.
+                Logger.Debug?.Print(LogClass.Cpu, $"Write to unmapped page 0x{va:X} trapped by the write tracker.");
+            }
+
+            // Wake the thread in case the protection was already removed before the fault was handled, as it is only
+            // woken when the protection is removed.
+            UffdioRange range = new() { Start = _baseAddress + va, Length = _pageSize };
+
+            ioctl(_uffd, UFFDIO_WAKE, &range);
+        }
+
+        public unsafe void Dispose()
+        {
+            if (_disposed)
+            {
+                return;
+            }
+
+            _disposed = true;
+
+            ulong value = 1;
+
+            write(_stopEvent, &value, sizeof(ulong));
+
+            _handlerThread.Join();
+
+            // Closing the file descriptor releases any thread still waiting on a write.
+            close(_uffd);
+            close(_stopEvent);
+        }
+    }
+}
@@ -0,0 +1,21 @@
+namespace Ryujinx.Graphics.GAL
+{
+    /// <summary>
+    /// GPU time of the full and half precision FSR paths, both measured on every benchmarked frame.
+    /// </summary>
+    public readonly struct FsrBenchmarkStatistics
+    {
+        public bool IsHalfPrecision { get; }
+        public long Samples { get; }
+        public double FullPrecisionMilliseconds { get; }
+        public double HalfPrecisionMilliseconds { get; }
+
+        public FsrBenchmarkStatistics(bool isHalfPrecision, long samples, double fullPrecisionMilliseconds, double halfPrecisionMilliseconds)
+        {
+            IsHalfPrecision = isHalfPrecision;
+            Samples = samples;
+            FullPrecisionMilliseconds = fullPrecisionMilliseconds;
+            HalfPrecisionMilliseconds = halfPrecisionMilliseconds;
+        }
+    }
+}
@@ -545,11 +545,11 @@ namespace Ryujinx.Graphics.Gpu.Memory
 
                         address = Math.Min(address, buffer.Address);
                         endAddress = Math.Max(endAddress, buffer.EndAddress);
+                    }
 
-                        lock (_buffers)
-                        {
-                            _buffers.Remove(buffer);
-                        }
+                    lock (_buffers)
+                    {
+                        _buffers.RemoveRange(overlaps, overlapsCount);
                     }
 
                     ulong newSize = endAddress - address;
@@ -625,10 +625,7 @@ namespace Ryujinx.Graphics.Gpu.Memory
 
                     lock (_buffers)
                     {
-                        for (int index = 0; index < overlapsCount; index++)
-                        {
-                            _buffers.Remove(overlaps[index]);
-                        }
+                        _buffers.RemoveRange(overlaps, overlapsCount);
                     }
 
                     ulong newSize = endAddress - address;
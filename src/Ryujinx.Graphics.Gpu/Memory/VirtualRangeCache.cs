@@ -115,10 +115,7 @@ namespace Ryujinx.Graphics.Gpu.Memory
                 {
                     overlapsCount = _virtualRanges.FindOverlapsNonOverlapping(unmappedRange.Address, unmappedRange.Size, ref overlaps);
 
-                    for (int index = 0; index < overlapsCount; index++)
-                    {
-                        _virtualRanges.Remove(overlaps[index]);
-                    }
+                    _virtualRanges.RemoveRange(overlaps, overlapsCount);
                 }
             }
 
@@ -144,10 +141,10 @@ namespace Ryujinx.Graphics.Gpu.Memory
 
                         gpuVa = Math.Min(gpuVa, virtualRange.Address);
                         endAddress = Math.Max(endAddress, virtualRange.EndAddress);
-
-                        _virtualRanges.Remove(virtualRange);
                     }
 
+                    _virtualRanges.RemoveRange(overlaps, overlapsCount);
+
                     ulong newSize = endAddress - gpuVa;
                     MultiRange newRange = _memoryManager.GetPhysicalRegions(gpuVa, newSize);
 
@@ -0,0 +1,127 @@
+using OpenTK.Graphics.OpenGL;
+using Ryujinx.Common.Logging;
+using Ryujinx.Graphics.GAL;
+using System;
+
+namespace Ryujinx.Graphics.OpenGL.Effects
+{
+    /// <summary>
+    /// Measures the GPU time of the full and half precision FSR passes with timestamp queries.
+    /// </summary>
+    /// <remarks>
+    /// Results are only read when a query slot is about to be reused and the driver reports them as
+    /// available, so measuring never stalls the pipeline.
+    /// </remarks>
+    internal class FsrBenchmark : IDisposable
+    {
+        private const int SlotCount = 8;
+        private const int QueriesPerSlot = 3;
+        private const int AverageWeight = 16;
+        private const int LogInterval = 600;
+
+        private readonly int[] _queries = new int[SlotCount * QueriesPerSlot];
+        private readonly bool[] _slotHalfFirst = new bool[SlotCount];
+        private readonly bool[] _slotPending = new bool[SlotCount];
+
+        private int _slot;
+        private long _samples;
+        private double _fullPrecisionMs;
+        private double _halfPrecisionMs;
+
+        public FsrBenchmark()
+        {
+            GL.GenQueries(_queries.Length, _queries);
+        }
+
+        public FsrBenchmarkStatistics GetStatistics(bool isHalfPrecision)
+        {
+            return new FsrBenchmarkStatistics(isHalfPrecision, _samples, _fullPrecisionMs, _halfPrecisionMs);
+        }
+
+        /// <summary>
+        /// Starts measuring a frame, which must run both paths in the order returned.
+        /// </summary>
+        /// <returns>True if the half precision path should run first</returns>
+        public bool Begin()
+        {
+            ReadSlot(_slot);
+
+            // Alternate the order, so that neither path always gets the caches warmed by the other.
+            bool halfFirst = (_slot & 1) != 0;
+
+            _slotHalfFirst[_slot] = halfFirst;
+
+            WriteTimestamp(0);
+
+            return halfFirst;
+        }
+
+        public void Split()
+        {
+            WriteTimestamp(1);
+        }
+
+        public void End()
+        {
+            WriteTimestamp(2);
+
+            _slotPending[_slot] = true;
+            _slot = (_slot + 1) % SlotCount;
+        }
+
+        private void WriteTimestamp(int index)
+        {
+            GL.QueryCounter(_queries[_slot * QueriesPerSlot + index], QueryCounterTarget.Timestamp);
+        }
+
+        private void ReadSlot(int slot)
+        {
+            if (!_slotPending[slot])
+            {
+                return;
+            }
+
+            _slotPending[slot] = false;
+
+            int first = slot * QueriesPerSlot;
+
+            // Timestamps become available in order, so the last one covers the whole slot.
+            GL.GetQueryObject(_queries[first + 2], GetQueryObjectParam.QueryResultAvailable, out int available);
+
+            if (available == 0)
+            {
+                return;
+            }
+
+            GL.GetQueryObject(_queries[first], GetQueryObjectParam.QueryResult, out long start);
+            GL.GetQueryObject(_queries[first + 1], GetQueryObjectParam.QueryResult, out long split);
+            GL.GetQueryObject(_queries[first + 2], GetQueryObjectParam.QueryResult, out long end);
+
+            double firstMs = (split - start) / 1_000_000.0;
+            double secondMs = (end - split) / 1_000_000.0;
+
+            (double halfMs, double fullMs) = _slotHalfFirst[slot] ? (firstMs, secondMs) : (secondMs, firstMs);
+
+            if (_samples++ == 0)
+            {
+                _fullPrecisionMs = fullMs;
+                _halfPrecisionMs = halfMs;
+            }
+            else
+            {
+                _fullPrecisionMs += (fullMs - _fullPrecisionMs) / AverageWeight;
+                _halfPrecisionMs += (halfMs - _halfPrecisionMs) / AverageWeight;
+            }
+
+            if (_samples % LogInterval == 0)
+            {
+                Logger.Info?.Print(LogClass.Gpu, $"FSR benchmark: full precision {_fullPrecisionMs:F3} ms, half precision {_halfPrecisionMs:F3} ms");
+            }
+        }
+
+        public void Dispose()
+        {
+            GL.DeleteQueries(_queries.Length, _queries);
+        }
+    }
+}
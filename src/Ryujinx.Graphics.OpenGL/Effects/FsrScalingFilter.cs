@@ -1,5 +1,6 @@
 using OpenTK.Graphics.OpenGL;
 using Ryujinx.Common;
+using Ryujinx.Common.Logging;
 using Ryujinx.Graphics.GAL;
 using Ryujinx.Graphics.OpenGL.Image;
 using System;
@@ -13,11 +14,16 @@ namespace Ryujinx.Graphics.OpenGL.Effects
         private int _inputUniform;
         private int _outputUniform;
         private int _sharpeningUniform;
+        private int _fusedSharpeningUniform;
         private int _srcX0Uniform;
         private int _srcX1Uniform;
         private int _srcY0Uniform;
         private int _scalingShaderProgram;
         private int _sharpeningShaderProgram;
+        private int _scalingShaderProgramHalf;
+        private int _sharpeningShaderProgramHalf;
+        private int _fusedShaderProgram;
+        private int _fusedShaderProgramHalf;
         private float _sharpeningLevel = 1;
         private int _srcY1Uniform;
         private int _dstX0Uniform;
@@ -27,6 +33,8 @@ namespace Ryujinx.Graphics.OpenGL.Effects
         private int _scaleXUniform;
         private int _scaleYUniform;
         private TextureStorage _intermediaryTexture;
+        private TextureStorage _benchmarkTexture;
+        private FsrBenchmark _benchmark;
 
         public float Level
         {
@@ -37,6 +45,13 @@ namespace Ryujinx.Graphics.OpenGL.Effects
             }
         }
 
+        /// <summary>
+        /// True if the packed half precision variants of EASU and RCAS are used.
+        /// </summary>
+        public bool IsHalfPrecision => _fusedShaderProgram != 0 ? _fusedShaderProgramHalf != 0 : _scalingShaderProgramHalf != 0;
+
+        public FsrBenchmarkStatistics BenchmarkStatistics => _benchmark?.GetStatistics(IsHalfPrecision) ?? default;
+
         public FsrScalingFilter(OpenGLRenderer renderer)
         {
             Initialize();
@@ -52,13 +67,28 @@ namespace Ryujinx.Graphics.OpenGL.Effects
                 GL.DeleteProgram(_sharpeningShaderProgram);
             }
 
+            if (_scalingShaderProgramHalf != 0)
+            {
+                GL.DeleteProgram(_scalingShaderProgramHalf);
+                GL.DeleteProgram(_sharpeningShaderProgramHalf);
+            }
+
+            if (_fusedShaderProgram != 0)
+            {
+                GL.DeleteProgram(_fusedShaderProgram);
+                GL.DeleteProgram(_fusedShaderProgramHalf);
+            }
+
             _intermediaryTexture?.Dispose();
+            _benchmarkTexture?.Dispose();
+            _benchmark?.Dispose();
         }
 
         private void Initialize()
         {
             var scalingShader = EmbeddedResources.ReadAllText("Ryujinx.Graphics.OpenGL/Effects/Shaders/fsr_scaling.glsl");
             var sharpeningShader = EmbeddedResources.ReadAllText("Ryujinx.Graphics.OpenGL/Effects/Shaders/fsr_sharpening.glsl");
+            var fusedShader = EmbeddedResources.ReadAllText("Ryujinx.Graphics.OpenGL/Effects/Shaders/fsr_fused.glsl");
             var fsrA = EmbeddedResources.ReadAllText("Ryujinx.Graphics.OpenGL/Effects/Shaders/ffx_a.h");
             var fsr1 = EmbeddedResources.ReadAllText("Ryujinx.Graphics.OpenGL/Effects/Shaders/ffx_fsr1.h");
 
@@ -66,13 +96,49 @@ namespace Ryujinx.Graphics.OpenGL.Effects
             scalingShader = scalingShader.Replace("#include \"ffx_fsr1.h\"", fsr1);
             sharpeningShader = sharpeningShader.Replace("#include \"ffx_a.h\"", fsrA);
             sharpeningShader = sharpeningShader.Replace("#include \"ffx_fsr1.h\"", fsr1);
+            fusedShader = fusedShader.Replace("#include \"ffx_a.h\"", fsrA);
+            fusedShader = fusedShader.Replace("#include \"ffx_fsr1.h\"", fsr1);
 
             _scalingShaderProgram = CompileProgram(scalingShader, ShaderType.ComputeShader);
             _sharpeningShaderProgram = CompileProgram(sharpeningShader, ShaderType.ComputeShader);
+            _fusedShaderProgram = CompileProgram(fusedShader, ShaderType.ComputeShader);
+
+            if (_fusedShaderProgram == 0)
+            {
+                Logger.Warning?.Print(LogClass.Gpu, "Failed to compile the fused FSR shader, using separate scaling and sharpening passes.");
+            }
+            else if (HwCapabilities.SupportsShaderFloat16)
+            {
+                _fusedShaderProgramHalf = CompileProgram(EnableHalfPrecision(fusedShader), ShaderType.ComputeShader);
+
+                if (_fusedShaderProgramHalf == 0)
+                {
+                    Logger.Warning?.Print(LogClass.Gpu, "Failed to compile the half precision FSR shaders, using full precision.");
+                }
+            }
+
+            if (_fusedShaderProgram == 0 && HwCapabilities.SupportsShaderFloat16)
+            {
+                // Uniforms have explicit locations, so the half variants share them with the 32-bit programs.
+                _scalingShaderProgramHalf = CompileProgram(EnableHalfPrecision(scalingShader), ShaderType.ComputeShader);
+                _sharpeningShaderProgramHalf = CompileProgram(EnableHalfPrecision(sharpeningShader), ShaderType.ComputeShader);
+
+                if (_scalingShaderProgramHalf == 0 || _sharpeningShaderProgramHalf == 0)
+                {
+                    Logger.Warning?.Print(LogClass.Gpu, "Failed to compile the half precision FSR shaders, using full precision.");
+
+                    GL.DeleteProgram(_scalingShaderProgramHalf);
+                    GL.DeleteProgram(_sharpeningShaderProgramHalf);
+
+                    _scalingShaderProgramHalf = 0;
+                    _sharpeningShaderProgramHalf = 0;
+                }
+            }
 
             _inputUniform = GL.GetUniformLocation(_scalingShaderProgram, "Source");
             _outputUniform = GL.GetUniformLocation(_scalingShaderProgram, "imgOutput");
             _sharpeningUniform = GL.GetUniformLocation(_sharpeningShaderProgram, "sharpening");
+            _fusedSharpeningUniform = GL.GetUniformLocation(_fusedShaderProgram, "sharpening");
 
             _srcX0Uniform = GL.GetUniformLocation(_scalingShaderProgram, "srcX0");
             _srcX1Uniform = GL.GetUniformLocation(_scalingShaderProgram, "srcX1");
@@ -94,49 +160,106 @@ namespace Ryujinx.Graphics.OpenGL.Effects
             Extents2D source,
             Extents2D destination)
         {
-            if (_intermediaryTexture == null || _intermediaryTexture.Info.Width != width || _intermediaryTexture.Info.Height != height)
+            var originalInfo = view.Info;
+            var info = new TextureCreateInfo(width,
+                height,
+                originalInfo.Depth,
+                originalInfo.Levels,
+                originalInfo.Samples,
+                originalInfo.BlockWidth,
+                originalInfo.BlockHeight,
+                originalInfo.BytesPerPixel,
+                originalInfo.Format,
+                originalInfo.DepthStencilMode,
+                originalInfo.Target,
+                originalInfo.SwizzleR,
+                originalInfo.SwizzleG,
+                originalInfo.SwizzleB,
+                originalInfo.SwizzleA);
+
+            TextureView textureView = null;
+
+            // The fused pass keeps the upscaled pixels in shared memory and doesn't need the intermediate texture.
+            if (_fusedShaderProgram == 0)
             {
-                _intermediaryTexture?.Dispose();
-                var originalInfo = view.Info;
-                var info = new TextureCreateInfo(width,
-                    height,
-                    originalInfo.Depth,
-                    originalInfo.Levels,
-                    originalInfo.Samples,
-                    originalInfo.BlockWidth,
-                    originalInfo.BlockHeight,
-                    originalInfo.BytesPerPixel,
-                    originalInfo.Format,
-                    originalInfo.DepthStencilMode,
-                    originalInfo.Target,
-                    originalInfo.SwizzleR,
-                    originalInfo.SwizzleG,
-                    originalInfo.SwizzleB,
-                    originalInfo.SwizzleA);
-
-                _intermediaryTexture = new TextureStorage(_renderer, info);
-                _intermediaryTexture.CreateDefaultView();
-            }
+                if (_intermediaryTexture == null || _intermediaryTexture.Info.Width != width || _intermediaryTexture.Info.Height != height)
+                {
+                    _intermediaryTexture?.Dispose();
+                    _intermediaryTexture = new TextureStorage(_renderer, info);
+                    _intermediaryTexture.CreateDefaultView();
+                }
 
-            var textureView = _intermediaryTexture.CreateView(_intermediaryTexture.Info, 0, 0) as TextureView;
+                textureView = _intermediaryTexture.CreateView(_intermediaryTexture.Info, 0, 0) as TextureView;
+            }
 
             int previousProgram = GL.GetInteger(GetPName.CurrentProgram);
             int previousUnit = GL.GetInteger(GetPName.ActiveTexture);
             GL.ActiveTexture(TextureUnit.Texture0);
             int previousTextureBinding = GL.GetInteger(GetPName.TextureBinding2D);
 
-            GL.BindImageTexture(0, textureView.Handle, 0, false, 0, TextureAccess.ReadWrite, SizedInternalFormat.Rgba8);
-
             int threadGroupWorkRegionDim = 16;
             int dispatchX = (width + (threadGroupWorkRegionDim - 1)) / threadGroupWorkRegionDim;
             int dispatchY = (height + (threadGroupWorkRegionDim - 1)) / threadGroupWorkRegionDim;
 
+            if (_renderer.FsrBenchmarkEnabled && IsHalfPrecision)
+            {
+                UpdateBenchmark(info);
+
+                // The path that isn't selected renders to a scratch texture, so the presented frame is unchanged.
+                var benchmarkView = _benchmarkTexture.DefaultView as TextureView;
+                bool halfFirst = _benchmark.Begin();
+
+                RunPasses(halfFirst, view, textureView, halfFirst ? destinationTexture : benchmarkView, dispatchX, dispatchY, source, destination);
+                GL.MemoryBarrier(MemoryBarrierFlags.ShaderImageAccessBarrierBit);
+                _benchmark.Split();
+                RunPasses(!halfFirst, view, textureView, halfFirst ? benchmarkView : destinationTexture, dispatchX, dispatchY, source, destination);
+                _benchmark.End();
+            }
+            else
+            {
+                RunPasses(IsHalfPrecision, view, textureView, destinationTexture, dispatchX, dispatchY, source, destination);
+            }
+
+            GL.UseProgram(previousProgram);
+            GL.MemoryBarrier(MemoryBarrierFlags.ShaderImageAccessBarrierBit);
+
+            (_renderer.Pipeline as Pipeline).RestoreImages1And2();
+
+            GL.ActiveTexture(TextureUnit.Texture0);
+            GL.BindTexture(TextureTarget.Texture2D, previousTextureBinding);
+
+            GL.ActiveTexture((TextureUnit)previousUnit);
+        }
+
+        private void RunPasses(
+            bool halfPrecision,
+            TextureView view,
+            TextureView intermediaryView,
+            TextureView destinationTexture,
+            int dispatchX,
+            int dispatchY,
+            Extents2D source,
+            Extents2D destination)
+        {
+            bool fused = _fusedShaderProgram != 0;
+
+            GL.BindImageTexture(0, fused ? destinationTexture.Handle : intermediaryView.Handle, 0, false, 0, TextureAccess.ReadWrite, SizedInternalFormat.Rgba8);
+
             // Scaling pass
             float srcWidth = Math.Abs(source.X2 - source.X1);
             float srcHeight = Math.Abs(source.Y2 - source.Y1);
             float scaleX = srcWidth / view.Width;
             float scaleY = srcHeight / view.Height;
-            GL.UseProgram(_scalingShaderProgram);
+
+            if (fused)
+            {
+                GL.UseProgram(halfPrecision ? _fusedShaderProgramHalf : _fusedShaderProgram);
+            }
+            else
+            {
+                GL.UseProgram(halfPrecision ? _scalingShaderProgramHalf : _scalingShaderProgram);
+            }
+
             view.Bind(0);
             GL.Uniform1(_inputUniform, 0);
             GL.Uniform1(_outputUniform, 0);
@@ -150,28 +273,52 @@ namespace Ryujinx.Graphics.OpenGL.Effects
             GL.Uniform1(_dstY1Uniform, (float)destination.Y2);
             GL.Uniform1(_scaleXUniform, scaleX);
             GL.Uniform1(_scaleYUniform, scaleY);
+
+            if (fused)
+            {
+                GL.Uniform1(_fusedSharpeningUniform, 1.5f - (Level * 0.01f * 1.5f));
+                GL.DispatchCompute(dispatchX, dispatchY, 1);
+
+                return;
+            }
+
             GL.DispatchCompute(dispatchX, dispatchY, 1);
 
             GL.MemoryBarrier(MemoryBarrierFlags.ShaderImageAccessBarrierBit);
 
             // Sharpening Pass
-            GL.UseProgram(_sharpeningShaderProgram);
+            GL.UseProgram(halfPrecision ? _sharpeningShaderProgramHalf : _sharpeningShaderProgram);
             GL.BindImageTexture(0, destinationTexture.Handle, 0, false, 0, TextureAccess.ReadWrite, SizedInternalFormat.Rgba8);
-            textureView.Bind(0);
+            intermediaryView.Bind(0);
             GL.Uniform1(_inputUniform, 0);
             GL.Uniform1(_outputUniform, 0);
             GL.Uniform1(_sharpeningUniform, 1.5f - (Level * 0.01f * 1.5f));
             GL.DispatchCompute(dispatchX, dispatchY, 1);
+        }
 
-            GL.UseProgram(previousProgram);
-            GL.MemoryBarrier(MemoryBarrierFlags.ShaderImageAccessBarrierBit);
+        private void UpdateBenchmark(TextureCreateInfo info)
+        {
+            _benchmark ??= new FsrBenchmark();
 
-            (_renderer.Pipeline as Pipeline).RestoreImages1And2();
+            if (_benchmarkTexture == null || !_benchmarkTexture.Info.Equals(info))
+            {
+                _benchmarkTexture?.Dispose();
+                _benchmarkTexture = new TextureStorage(_renderer, info);
+                _benchmarkTexture.CreateDefaultView();
+            }
+        }
 
-            GL.ActiveTexture(TextureUnit.Texture0);
-            GL.BindTexture(TextureTarget.Texture2D, previousTextureBinding);
+        private static string EnableHalfPrecision(string source)
+        {
+            // The define has to come before ffx_a.h, which is included right after the uniforms.
+            // ffx_a.h requires the Vulkan GLSL 16-bit type extensions, desktop GL has the AMD ones instead.
+            int versionEnd = source.IndexOf('\n', source.IndexOf("#version", StringComparison.Ordinal)) + 1;
 
-            GL.ActiveTexture((TextureUnit)previousUnit);
+            return source.Insert(versionEnd,
+                "#extension GL_AMD_gpu_shader_half_float : require\n" +
+                "#extension GL_AMD_gpu_shader_int16 : require\n" +
+                "#define A_HALF 1\n" +
+                "#define A_SKIP_EXT 1\n");
         }
     }
 }
@@ -18,7 +18,11 @@ layout( location=11 ) uniform float scaleY;
 #define A_GLSL 1
 #include "ffx_a.h"
 
+#ifdef A_HALF
+#define FSR_EASU_H 1
+#else
 #define FSR_EASU_F 1
+#endif
 AU4 con0, con1, con2, con3;
 float srcW, srcH, dstW, dstH;
 vec2 bLeft, tRight;
@@ -39,9 +43,15 @@ AF2 translateDest(AF2 pos) {
     return translatedPos;
 }
 
+#ifdef A_HALF
+AH4 FsrEasuRH(AF2 p) { AH4 res = AH4(textureGather(Source, translate(p), 0)); return res; }
+AH4 FsrEasuGH(AF2 p) { AH4 res = AH4(textureGather(Source, translate(p), 1)); return res; }
+AH4 FsrEasuBH(AF2 p) { AH4 res = AH4(textureGather(Source, translate(p), 2)); return res; }
+#else
 AF4 FsrEasuRF(AF2 p) { AF4 res = textureGather(Source, translate(p), 0); return res; }
 AF4 FsrEasuGF(AF2 p) { AF4 res = textureGather(Source, translate(p), 1); return res; }
 AF4 FsrEasuBF(AF2 p) { AF4 res = textureGather(Source, translate(p), 2); return res; }
+#endif
 
 #include "ffx_fsr1.h"
 
@@ -56,9 +66,15 @@ void CurrFilter(AU2 pos)
         imageStore(imgOutput, ASU2(pos.x, pos.y), AF4(0,0,0,1));
        return;
     }
+#ifdef A_HALF
+    AH3 c;
+    FsrEasuH(c, AU2(pos.x - bLeft.x, pos.y - bLeft.y), con0, con1, con2, con3);
+    imageStore(imgOutput, ASU2(translateDest(pos)), AF4(c, 1));
+#else
     AF3 c;
     FsrEasuF(c, AU2(pos.x - bLeft.x, pos.y - bLeft.y), con0, con1, con2, con3);
     imageStore(imgOutput, ASU2(translateDest(pos)), AF4(c, 1));
+#endif
 }
 
 void main() {
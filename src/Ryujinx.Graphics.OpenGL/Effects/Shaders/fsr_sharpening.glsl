@@ -9,19 +9,34 @@ layout( location=2 ) uniform float sharpening;
 #define A_GLSL 1
 #include "ffx_a.h"
 
+#ifdef A_HALF
+#define FSR_RCAS_H 1
+#else
 #define FSR_RCAS_F 1
+#endif
 AU4 con0;
 
+#ifdef A_HALF
+AH4 FsrRcasLoadH(ASW2 p) { return AH4(texelFetch(source, ASU2(p), 0)); }
+void FsrRcasInputH(inout AH1 r, inout AH1 g, inout AH1 b) {}
+#else
 AF4 FsrRcasLoadF(ASU2 p) { return AF4(texelFetch(source, p, 0)); }
 void FsrRcasInputF(inout AF1 r, inout AF1 g, inout AF1 b) {}
+#endif
 
 #include "ffx_fsr1.h"
 
 void CurrFilter(AU2 pos)
 {
+#ifdef A_HALF
+    AH3 c;
+    FsrRcasH(c.r, c.g, c.b, pos, con0);
+    imageStore(imgOutput, ASU2(pos), AF4(c, 1));
+#else
     AF3 c;
     FsrRcasF(c.r, c.g, c.b, pos, con0);
     imageStore(imgOutput, ASU2(pos), AF4(c, 1));
+#endif
 }
 
 void main() {
@@ -19,6 +19,7 @@ namespace Ryujinx.Graphics.OpenGL
         private static readonly Lazy<bool> _supportsQuads = new(SupportsQuadsCheck);
         private static readonly Lazy<bool> _supportsSeamlessCubemapPerTexture = new(() => HasExtension("GL_ARB_seamless_cubemap_per_texture"));
         private static readonly Lazy<bool> _supportsShaderBallot = new(() => HasExtension("GL_ARB_shader_ballot"));
+        private static readonly Lazy<bool> _supportsShaderFloat16 = new(() => HasExtension("GL_AMD_gpu_shader_half_float") && HasExtension("GL_AMD_gpu_shader_int16"));
         private static readonly Lazy<bool> _supportsShaderViewportLayerArray = new(() => HasExtension("GL_ARB_shader_viewport_layer_array"));
         private static readonly Lazy<bool> _supportsViewportArray2 = new(() => HasExtension("GL_NV_viewport_array2"));
         private static readonly Lazy<bool> _supportsTextureCompressionBptc = new(() => HasExtension("GL_EXT_texture_compression_bptc"));
@@ -65,6 +66,7 @@ namespace Ryujinx.Graphics.OpenGL
         public static bool SupportsQuads => _supportsQuads.Value;
         public static bool SupportsSeamlessCubemapPerTexture => _supportsSeamlessCubemapPerTexture.Value;
         public static bool SupportsShaderBallot => _supportsShaderBallot.Value;
+        public static bool SupportsShaderFloat16 => _supportsShaderFloat16.Value;
         public static bool SupportsShaderViewportLayerArray => _supportsShaderViewportLayerArray.Value;
         public static bool SupportsViewportArray2 => _supportsViewportArray2.Value;
         public static bool SupportsTextureCompressionBptc => _supportsTextureCompressionBptc.Value;
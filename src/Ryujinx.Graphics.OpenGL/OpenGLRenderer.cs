@@ -43,6 +43,13 @@ namespace Ryujinx.Graphics.OpenGL
 
         public bool PreferThreading => true;
 
+        /// <summary>
+        /// Runs both FSR precision paths on every frame and times them, when FSR is the scaling filter.
+        /// </summary>
+        public bool FsrBenchmarkEnabled { get; set; }
+
+        public FsrBenchmarkStatistics FsrBenchmarkStatistics => _window.FsrBenchmarkStatistics;
+
         public OpenGLRenderer()
         {
             _pipeline = new Pipeline();
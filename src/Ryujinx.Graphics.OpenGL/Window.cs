@@ -32,6 +32,8 @@ namespace Ryujinx.Graphics.OpenGL
 
         internal bool ScreenCaptureRequested { get; set; }
 
+        internal FsrBenchmarkStatistics FsrBenchmarkStatistics => (_scalingFilter as FsrScalingFilter)?.BenchmarkStatistics ?? default;
+
         public Window(OpenGLRenderer renderer)
         {
             _renderer = renderer;
@@ -0,0 +1,148 @@
+using Ryujinx.Common.Logging;
+using Ryujinx.Graphics.GAL;
+using Silk.NET.Vulkan;
+using System;
+
+namespace Ryujinx.Graphics.Vulkan.Effects
+{
+    /// <summary>
+    /// Measures the GPU time of the full and half precision FSR passes with timestamp queries.
+    /// </summary>
+    /// <remarks>
+    /// Results are read back without waiting, when a query slot is about to be reused. By then the
+    /// command buffer that wrote it has almost always completed, frames where it hasn't are skipped.
+    /// </remarks>
+    class FsrBenchmark : IDisposable
+    {
+        private const int SlotCount = 8;
+        private const int QueriesPerSlot = 3;
+        private const int AverageWeight = 16;
+        private const int LogInterval = 600;
+
+        private readonly VulkanRenderer _gd;
+        private readonly Device _device;
+        private readonly QueryPool _queryPool;
+        private readonly bool[] _slotHalfFirst = new bool[SlotCount];
+        private readonly bool[] _slotPending = new bool[SlotCount];
+
+        private int _slot;
+        private long _samples;
+        private double _fullPrecisionMs;
+        private double _halfPrecisionMs;
+
+        private unsafe FsrBenchmark(VulkanRenderer gd, Device device)
+        {
+            _gd = gd;
+            _device = device;
+
+            var queryPoolCreateInfo = new QueryPoolCreateInfo
+            {
+                SType = StructureType.QueryPoolCreateInfo,
+                QueryCount = SlotCount * QueriesPerSlot,
+                QueryType = QueryType.Timestamp,
+            };
+
+            gd.Api.CreateQueryPool(device, in queryPoolCreateInfo, null, out _queryPool).ThrowOnError();
+        }
+
+        public static FsrBenchmark TryCreate(VulkanRenderer gd, Device device)
+        {
+            return gd.SupportsTimestampQueries ? new FsrBenchmark(gd, device) : null;
+        }
+
+        public FsrBenchmarkStatistics GetStatistics(bool isHalfPrecision)
+        {
+            return new FsrBenchmarkStatistics(isHalfPrecision, _samples, _fullPrecisionMs, _halfPrecisionMs);
+        }
+
+        /// <summary>
+        /// Starts measuring a frame, which must run both paths in the order returned.
+        /// </summary>
+        /// <returns>True if the half precision path should run first</returns>
+        public bool Begin(CommandBufferScoped cbs)
+        {
+            ReadSlot(_slot);
+
+            // Alternate the order, so that neither path always gets the caches warmed by the other.
+            bool halfFirst = (_slot & 1) != 0;
+
+            _slotHalfFirst[_slot] = halfFirst;
+
+            _gd.Api.CmdResetQueryPool(cbs.CommandBuffer, _queryPool, (uint)(_slot * QueriesPerSlot), QueriesPerSlot);
+            WriteTimestamp(cbs, 0);
+
+            return halfFirst;
+        }
+
+        public void Split(CommandBufferScoped cbs)
+        {
+            WriteTimestamp(cbs, 1);
+        }
+
+        public void End(CommandBufferScoped cbs)
+        {
+            WriteTimestamp(cbs, 2);
+
+            _slotPending[_slot] = true;
+            _slot = (_slot + 1) % SlotCount;
+        }
+
+        private void WriteTimestamp(CommandBufferScoped cbs, int index)
+        {
+            _gd.Api.CmdWriteTimestamp(cbs.CommandBuffer, PipelineStageFlags.BottomOfPipeBit, _queryPool, (uint)(_slot * QueriesPerSlot + index));
+        }
+
+        private unsafe void ReadSlot(int slot)
+        {
+            if (!_slotPending[slot])
+            {
+                return;
+            }
+
+            _slotPending[slot] = false;
+
+            ulong* timestamps = stackalloc ulong[QueriesPerSlot];
+
+            Result result = _gd.Api.GetQueryPoolResults(
+                _device,
+                _queryPool,
+                (uint)(slot * QueriesPerSlot),
+                QueriesPerSlot,
+                QueriesPerSlot * sizeof(ulong),
+                timestamps,
+                sizeof(ulong),
+                QueryResultFlags.Result64Bit);
+
+            if (result != Result.Success)
+            {
+                return;
+            }
+
+            double firstMs = (timestamps[1] - timestamps[0]) * _gd.TimestampPeriod / 1_000_000.0;
+            double secondMs = (timestamps[2] - timestamps[1]) * _gd.TimestampPeriod / 1_000_000.0;
+
+            (double halfMs, double fullMs) = _slotHalfFirst[slot] ? (firstMs, secondMs) : (secondMs, firstMs);
+
+            if (_samples++ == 0)
+            {
+                _fullPrecisionMs = fullMs;
+                _halfPrecisionMs = halfMs;
+            }
+            else
+            {
+                _fullPrecisionMs += (fullMs - _fullPrecisionMs) / AverageWeight;
+                _halfPrecisionMs += (halfMs - _halfPrecisionMs) / AverageWeight;
+            }
+
+            if (_samples % LogInterval == 0)
+            {
+                Logger.Info?.Print(LogClass.Gpu, $"FSR benchmark: full precision {_fullPrecisionMs:F3} ms, half precision {_halfPrecisionMs:F3} ms");
+            }
+        }
+
+        public unsafe void Dispose()
+        {
+            _gd.Api.DestroyQueryPool(_device, _queryPool, null);
+        }
+    }
+}
@@ -1,4 +1,5 @@
 using Ryujinx.Common;
+using Ryujinx.Common.Logging;
 using Ryujinx.Graphics.GAL;
 using Ryujinx.Graphics.Shader;
 using Ryujinx.Graphics.Shader.Translation;
@@ -17,9 +18,15 @@ namespace Ryujinx.Graphics.Vulkan.Effects
         private ISampler _sampler;
         private ShaderCollection _scalingProgram;
         private ShaderCollection _sharpeningProgram;
+        private ShaderCollection _scalingProgramHalf;
+        private ShaderCollection _sharpeningProgramHalf;
+        private ShaderCollection _fusedProgram;
+        private ShaderCollection _fusedProgramHalf;
         private float _sharpeningLevel = 1;
         private Device _device;
         private TextureView _intermediaryTexture;
+        private TextureView _benchmarkTexture;
+        private FsrBenchmark _benchmark;
 
         public float Level
         {
@@ -30,6 +37,13 @@ namespace Ryujinx.Graphics.Vulkan.Effects
             }
         }
 
+        /// <summary>
+        /// True if the packed half precision variants of EASU and RCAS are used.
+        /// </summary>
+        public bool IsHalfPrecision => _fusedProgram != null ? _fusedProgramHalf != null : _scalingProgramHalf != null;
+
+        public FsrBenchmarkStatistics BenchmarkStatistics => _benchmark?.GetStatistics(IsHalfPrecision) ?? default;
+
         public FsrScalingFilter(VulkanRenderer renderer, Device device)
         {
             _device = device;
@@ -41,10 +55,16 @@ namespace Ryujinx.Graphics.Vulkan.Effects
         public void Dispose()
         {
             _pipeline.Dispose();
-            _scalingProgram.Dispose();
-            _sharpeningProgram.Dispose();
+            _scalingProgram?.Dispose();
+            _sharpeningProgram?.Dispose();
+            _scalingProgramHalf?.Dispose();
+            _sharpeningProgramHalf?.Dispose();
+            _fusedProgram?.Dispose();
+            _fusedProgramHalf?.Dispose();
             _sampler.Dispose();
             _intermediaryTexture?.Dispose();
+            _benchmarkTexture?.Dispose();
+            _benchmark?.Dispose();
         }
 
         public void Initialize()
@@ -53,6 +73,56 @@ namespace Ryujinx.Graphics.Vulkan.Effects
 
             _pipeline.Initialize();
 
+            _sampler = _renderer.CreateSampler(SamplerCreateInfo.Create(MinFilter.Linear, MagFilter.Linear));
+
+            if (!InitializeFused())
+            {
+                InitializeSeparate();
+            }
+        }
+
+        private bool InitializeFused()
+        {
+            // There is no precompiled binary for the fused shader, it is compiled from the GLSL source.
+            // Where the runtime compiler is unavailable this fails and the precompiled two-pass shaders are used instead.
+            var fsrA = EmbeddedResources.ReadAllText("Ryujinx.Graphics.Vulkan/Effects/Shaders/ffx_a.h");
+            var fsr1 = EmbeddedResources.ReadAllText("Ryujinx.Graphics.Vulkan/Effects/Shaders/ffx_fsr1.h");
+
+            var fusedShader = EmbeddedResources.ReadAllText("Ryujinx.Graphics.Vulkan/Effects/Shaders/FsrFused.glsl");
+
+            fusedShader = fusedShader.Replace("#include \"ffx_a.h\"", fsrA);
+            fusedShader = fusedShader.Replace("#include \"ffx_fsr1.h\"", fsr1);
+
+            var fusedResourceLayout = new ResourceLayoutBuilder()
+                .Add(ResourceStages.Compute, ResourceType.UniformBuffer, 2)
+                .Add(ResourceStages.Compute, ResourceType.UniformBuffer, 4)
+                .Add(ResourceStages.Compute, ResourceType.TextureAndSampler, 1)
+                .Add(ResourceStages.Compute, ResourceType.Image, 0, true).Build();
+
+            _fusedProgram = TryCreateProgram(fusedShader, fusedResourceLayout);
+
+            if (_fusedProgram == null)
+            {
+                Logger.Warning?.Print(LogClass.Gpu, "Failed to compile the fused FSR shader, using separate scaling and sharpening passes.");
+
+                return false;
+            }
+
+            if (_renderer.Capabilities.SupportsShaderFloat16 && _renderer.Capabilities.SupportsShaderInt16)
+            {
+                _fusedProgramHalf = TryCreateProgram(EnableHalfPrecision(fusedShader), fusedResourceLayout);
+
+                if (_fusedProgramHalf == null)
+                {
+                    Logger.Warning?.Print(LogClass.Gpu, "Failed to compile the half precision FSR shaders, using full precision.");
+                }
+            }
+
+            return true;
+        }
+
+        private void InitializeSeparate()
+        {
             var scalingShader = EmbeddedResources.Read("Ryujinx.Graphics.Vulkan/Effects/Shaders/FsrScaling.spv");
             var sharpeningShader = EmbeddedResources.Read("Ryujinx.Graphics.Vulkan/Effects/Shaders/FsrSharpening.spv");
 
@@ -68,8 +138,6 @@ namespace Ryujinx.Graphics.Vulkan.Effects
                 .Add(ResourceStages.Compute, ResourceType.TextureAndSampler, 1)
                 .Add(ResourceStages.Compute, ResourceType.Image, 0, true).Build();
 
-            _sampler = _renderer.CreateSampler(SamplerCreateInfo.Create(MinFilter.Linear, MagFilter.Linear));
-
             _scalingProgram = _renderer.CreateProgramWithMinimalLayout(new[]
             {
                 new ShaderSource(scalingShader, ShaderStage.Compute, TargetLanguage.Spirv),
@@ -79,6 +147,59 @@ namespace Ryujinx.Graphics.Vulkan.Effects
             {
                 new ShaderSource(sharpeningShader, ShaderStage.Compute, TargetLanguage.Spirv),
             }, sharpeningResourceLayout);
+
+            if (_renderer.Capabilities.SupportsShaderFloat16 && _renderer.Capabilities.SupportsShaderInt16)
+            {
+                InitializeHalfPrecision(scalingResourceLayout, sharpeningResourceLayout);
+            }
+        }
+
+        private void InitializeHalfPrecision(ResourceLayout scalingResourceLayout, ResourceLayout sharpeningResourceLayout)
+        {
+            // The precompiled shaders only contain the 32-bit path, the half variants are compiled from the same source.
+            var scalingShader = EnableHalfPrecision(EmbeddedResources.ReadAllText("Ryujinx.Graphics.Vulkan/Effects/Shaders/FsrScaling.glsl"));
+            var sharpeningShader = EnableHalfPrecision(EmbeddedResources.ReadAllText("Ryujinx.Graphics.Vulkan/Effects/Shaders/FsrSharpening.glsl"));
+
+            var scalingProgram = TryCreateProgram(scalingShader, scalingResourceLayout);
+            var sharpeningProgram = TryCreateProgram(sharpeningShader, sharpeningResourceLayout);
+
+            if (scalingProgram != null && sharpeningProgram != null)
+            {
+                _scalingProgramHalf = scalingProgram;
+                _sharpeningProgramHalf = sharpeningProgram;
+            }
+            else
+            {
+                Logger.Warning?.Print(LogClass.Gpu, "Failed to compile the half precision FSR shaders, using full precision.");
+
+                scalingProgram?.Dispose();
+                sharpeningProgram?.Dispose();
+            }
+        }
+
+        private ShaderCollection TryCreateProgram(string source, ResourceLayout resourceLayout)
+        {
+            var program = _renderer.CreateProgramWithMinimalLayout(new[]
+            {
+                new ShaderSource(source, ShaderStage.Compute, TargetLanguage.Glsl),
+            }, resourceLayout);
+
+            if (program.CheckProgramLink(true) != ProgramLinkStatus.Success)
+            {
+                program.Dispose();
+
+                return null;
+            }
+
+            return program;
+        }
+
+        private static string EnableHalfPrecision(string source)
+        {
+            // ffx_a.h is inlined right after the bindings, so the define has to follow the version directive.
+            int versionEnd = source.IndexOf('\n', source.IndexOf("#version", StringComparison.Ordinal)) + 1;
+
+            return source.Insert(versionEnd, "#define A_HALF 1\n");
         }
 
         public void Run(
@@ -91,37 +212,32 @@ namespace Ryujinx.Graphics.Vulkan.Effects
             Extent2D source,
             Extent2D destination)
         {
-            if (_intermediaryTexture == null
-                || _intermediaryTexture.Info.Width != width
-                || _intermediaryTexture.Info.Height != height
-                || !_intermediaryTexture.Info.Equals(view.Info))
-            {
-                var originalInfo = view.Info;
-
-                var info = new TextureCreateInfo(
-                    width,
-                    height,
-                    originalInfo.Depth,
-                    originalInfo.Levels,
-                    originalInfo.Samples,
-                    originalInfo.BlockWidth,
-                    originalInfo.BlockHeight,
-                    originalInfo.BytesPerPixel,
-                    originalInfo.Format,
-                    originalInfo.DepthStencilMode,
-                    originalInfo.Target,
-                    originalInfo.SwizzleR,
-                    originalInfo.SwizzleG,
-                    originalInfo.SwizzleB,
-                    originalInfo.SwizzleA);
+            var originalInfo = view.Info;
+
+            var info = new TextureCreateInfo(
+                width,
+                height,
+                originalInfo.Depth,
+                originalInfo.Levels,
+                originalInfo.Samples,
+                originalInfo.BlockWidth,
+                originalInfo.BlockHeight,
+                originalInfo.BytesPerPixel,
+                originalInfo.Format,
+                originalInfo.DepthStencilMode,
+                originalInfo.Target,
+                originalInfo.SwizzleR,
+                originalInfo.SwizzleG,
+                originalInfo.SwizzleB,
+                originalInfo.SwizzleA);
+
+            // The fused pass keeps the upscaled pixels in shared memory and doesn't need the intermediate image.
+            if (_fusedProgram == null && (_intermediaryTexture == null || !_intermediaryTexture.Info.Equals(info)))
+            {
                 _intermediaryTexture?.Dispose();
                 _intermediaryTexture = _renderer.CreateTexture(info) as TextureView;
             }
 
-            _pipeline.SetCommandBuffer(cbs);
-            _pipeline.SetProgram(_scalingProgram);
-            _pipeline.SetTextureAndSampler(ShaderStage.Compute, 1, view, _sampler);
-
             float srcWidth = Math.Abs(source.X2 - source.X1);
             float srcHeight = Math.Abs(source.Y2 - source.Y1);
             float scaleX = srcWidth / view.Width;
@@ -153,20 +269,91 @@ namespace Ryujinx.Graphics.Vulkan.Effects
             int dispatchX = (width + (threadGroupWorkRegionDim - 1)) / threadGroupWorkRegionDim;
             int dispatchY = (height + (threadGroupWorkRegionDim - 1)) / threadGroupWorkRegionDim;
 
-            _pipeline.SetUniformBuffers(stackalloc[] { new BufferAssignment(2, buffer.Range) });
+            _pipeline.SetCommandBuffer(cbs);
+
+            if (_renderer.FsrBenchmarkEnabled && IsHalfPrecision && UpdateBenchmark(info))
+            {
+                // The path that isn't selected renders to a scratch image, so the presented frame is unchanged.
+                bool halfFirst = _benchmark.Begin(cbs);
+
+                RunPasses(halfFirst, view, buffer.Range, sharpeningBuffer.Range, dispatchX, dispatchY, halfFirst ? destinationTexture : null);
+                _benchmark.Split(cbs);
+                RunPasses(!halfFirst, view, buffer.Range, sharpeningBuffer.Range, dispatchX, dispatchY, halfFirst ? null : destinationTexture);
+                _benchmark.End(cbs);
+            }
+            else
+            {
+                RunPasses(IsHalfPrecision, view, buffer.Range, sharpeningBuffer.Range, dispatchX, dispatchY, destinationTexture);
+            }
+
+            _pipeline.Finish();
+        }
+
+        private void RunPasses(
+            bool halfPrecision,
+            TextureView view,
+            BufferRange dimensionsBuffer,
+            BufferRange sharpeningBuffer,
+            int dispatchX,
+            int dispatchY,
+            Auto<DisposableImageView> destinationTexture)
+        {
+            if (_fusedProgram != null)
+            {
+                _pipeline.SetProgram(halfPrecision ? _fusedProgramHalf : _fusedProgram);
+                _pipeline.SetTextureAndSampler(ShaderStage.Compute, 1, view, _sampler);
+                _pipeline.SetUniformBuffers(stackalloc[] { new BufferAssignment(2, dimensionsBuffer), new BufferAssignment(4, sharpeningBuffer) });
+                SetDestination(view, destinationTexture);
+                _pipeline.DispatchCompute(dispatchX, dispatchY, 1);
+                _pipeline.ComputeBarrier();
+
+                return;
+            }
+
+            _pipeline.SetProgram(halfPrecision ? _scalingProgramHalf : _scalingProgram);
+            _pipeline.SetTextureAndSampler(ShaderStage.Compute, 1, view, _sampler);
+            _pipeline.SetUniformBuffers(stackalloc[] { new BufferAssignment(2, dimensionsBuffer) });
             _pipeline.SetImage(ShaderStage.Compute, 0, _intermediaryTexture.GetView(FormatTable.ConvertRgba8SrgbToUnorm(view.Info.Format)));
             _pipeline.DispatchCompute(dispatchX, dispatchY, 1);
             _pipeline.ComputeBarrier();
 
             // Sharpening pass
-            _pipeline.SetProgram(_sharpeningProgram);
+            _pipeline.SetProgram(halfPrecision ? _sharpeningProgramHalf : _sharpeningProgram);
             _pipeline.SetTextureAndSampler(ShaderStage.Compute, 1, _intermediaryTexture, _sampler);
-            _pipeline.SetUniformBuffers(stackalloc[] { new BufferAssignment(4, sharpeningBuffer.Range) });
-            _pipeline.SetImage(0, destinationTexture);
+            _pipeline.SetUniformBuffers(stackalloc[] { new BufferAssignment(4, sharpeningBuffer) });
+            SetDestination(view, destinationTexture);
             _pipeline.DispatchCompute(dispatchX, dispatchY, 1);
             _pipeline.ComputeBarrier();
+        }
 
-            _pipeline.Finish();
+        private void SetDestination(TextureView view, Auto<DisposableImageView> destinationTexture)
+        {
+            if (destinationTexture != null)
+            {
+                _pipeline.SetImage(0, destinationTexture);
+            }
+            else
+            {
+                _pipeline.SetImage(ShaderStage.Compute, 0, _benchmarkTexture.GetView(FormatTable.ConvertRgba8SrgbToUnorm(view.Info.Format)));
+            }
+        }
+
+        private bool UpdateBenchmark(TextureCreateInfo info)
+        {
+            _benchmark ??= FsrBenchmark.TryCreate(_renderer, _device);
+
+            if (_benchmark == null)
+            {
+                return false;
+            }
+
+            if (_benchmarkTexture == null || !_benchmarkTexture.Info.Equals(info))
+            {
+                _benchmarkTexture?.Dispose();
+                _benchmarkTexture = _renderer.CreateTexture(info) as TextureView;
+            }
+
+            return true;
         }
     }
 }
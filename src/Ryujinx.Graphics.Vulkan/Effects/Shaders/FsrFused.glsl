@@ -0,0 +1,156 @@
+// Scaling and sharpening in a single pass
+
+#version 430 core
+layout (local_size_x = 64) in;
+layout( rgba8, binding = 0, set = 3) uniform image2D imgOutput;
+layout( binding = 1, set = 2) uniform sampler2D Source;
+layout( binding = 2 ) uniform dimensions{
+ float srcX0;
+ float srcX1;
+ float srcY0;
+ float srcY1;
+ float dstX0;
+ float dstX1;
+ float dstY0;
+ float dstY1;
+ float scaleX;
+ float scaleY;
+};
+layout( binding = 4 ) uniform sharpening
+{
+    float sharpening_data;
+};
+
+#define A_GPU 1
+#define A_GLSL 1
+#include "ffx_a.h"
+
+#ifdef A_HALF
+#define FSR_EASU_H 1
+#define FSR_RCAS_H 1
+#else
+#define FSR_EASU_F 1
+#define FSR_RCAS_F 1
+#endif
+AU4 con0, con1, con2, con3;
+AU4 rcasCon;
+float srcW, srcH, dstW, dstH;
+vec2 bLeft, tRight;
+
+// Each work group writes a 16x16 tile. EASU results for the tile and a one pixel border around it,
+// which the RCAS taps on the tile edges read, are kept in shared memory instead of an image.
+#define TILE_SIZE 16
+#define CACHE_SIZE (TILE_SIZE + 2)
+shared vec3 easuCache[CACHE_SIZE * CACHE_SIZE];
+ASU2 tileOrigin;
+
+AF2 translate(AF2 pos) {
+    return AF2(pos.x * scaleX, pos.y * scaleY);
+}
+
+void setBounds(vec2 bottomLeft, vec2 topRight) {
+    bLeft = bottomLeft;
+    tRight = topRight;
+}
+
+vec3 loadCache(ASU2 p) {
+    ASU2 c = p - tileOrigin + ASU2(1);
+    return easuCache[c.y * CACHE_SIZE + c.x];
+}
+
+#ifdef A_HALF
+AH4 FsrEasuRH(AF2 p) { AH4 res = AH4(textureGather(Source, translate(p), 0)); return res; }
+AH4 FsrEasuGH(AF2 p) { AH4 res = AH4(textureGather(Source, translate(p), 1)); return res; }
+AH4 FsrEasuBH(AF2 p) { AH4 res = AH4(textureGather(Source, translate(p), 2)); return res; }
+AH4 FsrRcasLoadH(ASW2 p) { return AH4(loadCache(ASU2(p)), 1.0); }
+void FsrRcasInputH(inout AH1 r, inout AH1 g, inout AH1 b) {}
+#else
+AF4 FsrEasuRF(AF2 p) { AF4 res = textureGather(Source, translate(p), 0); return res; }
+AF4 FsrEasuGF(AF2 p) { AF4 res = textureGather(Source, translate(p), 1); return res; }
+AF4 FsrEasuBF(AF2 p) { AF4 res = textureGather(Source, translate(p), 2); return res; }
+AF4 FsrRcasLoadF(ASU2 p) { return AF4(loadCache(p), 1.0); }
+void FsrRcasInputF(inout AF1 r, inout AF1 g, inout AF1 b) {}
+#endif
+
+#include "ffx_fsr1.h"
+
+float insideBox(vec2 v) {
+    vec2 s = step(bLeft, v) - step(tRight, v);
+    return s.x * s.y;
+}
+
+AF2 translateDest(AF2 pos) {
+    AF2 translatedPos = AF2(pos.x, pos.y);
+    translatedPos.x = dstX1 < dstX0 ? dstX1 - translatedPos.x : translatedPos.x;
+    translatedPos.y = dstY0 < dstY1 ? dstY1 + dstY0 - translatedPos.y - 1 : translatedPos.y;
+    return translatedPos;
+}
+
+// Pixels outside the destination region are black, like the intermediate image of the two pass filter.
+vec3 Easu(ASU2 pos)
+{
+    if ((insideBox(vec2(pos.x, pos.y))) == 0) {
+        return vec3(0);
+    }
+#ifdef A_HALF
+    AH3 c;
+    FsrEasuH(c, AU2(pos.x - bLeft.x, pos.y - bLeft.y), con0, con1, con2, con3);
+    return vec3(c);
+#else
+    AF3 c;
+    FsrEasuF(c, AU2(pos.x - bLeft.x, pos.y - bLeft.y), con0, con1, con2, con3);
+    return c;
+#endif
+}
+
+void CurrFilter(AU2 pos)
+{
+    if ((insideBox(vec2(pos.x, pos.y))) == 0) {
+        imageStore(imgOutput, ASU2(pos.x, pos.y), AF4(0, 0, 0, 1));
+        return;
+    }
+#ifdef A_HALF
+    AH3 c;
+    FsrRcasH(c.r, c.g, c.b, pos, rcasCon);
+#else
+    AF3 c;
+    FsrRcasF(c.r, c.g, c.b, pos, rcasCon);
+#endif
+    imageStore(imgOutput, ASU2(translateDest(pos)), AF4(c, 1));
+}
+
+void main() {
+    srcW = abs(srcX1 - srcX0);
+    srcH = abs(srcY1 - srcY0);
+    dstW = abs(dstX1 - dstX0);
+    dstH = abs(dstY1 - dstY0);
+
+    setBounds(vec2(dstX0 < dstX1 ? dstX0 : dstX1, dstY0 < dstY1 ? dstY0 : dstY1),
+        vec2(dstX1 > dstX0 ? dstX1 : dstX0, dstY1 > dstY0 ? dstY1 : dstY0));
+
+    FsrEasuCon(con0, con1, con2, con3,
+        srcW, srcH,  // Viewport size (top left aligned) in the input image which is to be scaled.
+        srcW, srcH,  // The size of the input image.
+        dstW, dstH); // The output resolution.
+
+    FsrRcasCon(rcasCon, sharpening_data);
+
+    // Upscaling into shared memory
+    tileOrigin = ASU2(gl_WorkGroupID.xy) * TILE_SIZE;
+
+    for (uint i = gl_LocalInvocationID.x; i < CACHE_SIZE * CACHE_SIZE; i += gl_WorkGroupSize.x) {
+        easuCache[i] = Easu(tileOrigin + ASU2(i % CACHE_SIZE, i / CACHE_SIZE) - ASU2(1));
+    }
+
+    barrier();
+
+    // Sharpening
+    AU2 gxy = ARmp8x8(gl_LocalInvocationID.x) + AU2(gl_WorkGroupID.x << 4u, gl_WorkGroupID.y << 4u);
+    CurrFilter(gxy);
+    gxy.x += 8u;
+    CurrFilter(gxy);
+    gxy.y += 8u;
+    CurrFilter(gxy);
+    gxy.x -= 8u;
+    CurrFilter(gxy);
+}
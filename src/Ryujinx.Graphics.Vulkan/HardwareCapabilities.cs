@@ -25,8 +25,10 @@ namespace Ryujinx.Graphics.Vulkan
         public readonly bool SupportsIndirectParameters;
         public readonly bool SupportsFragmentShaderInterlock;
         public readonly bool SupportsGeometryShaderPassthrough;
+        public readonly bool SupportsShaderFloat16;
         public readonly bool SupportsShaderFloat64;
         public readonly bool SupportsShaderInt8;
+        public readonly bool SupportsShaderInt16;
         public readonly bool SupportsShaderStencilExport;
         public readonly bool SupportsShaderStorageImageMultisample;
         public readonly bool SupportsConditionalRendering;
@@ -65,8 +67,10 @@ namespace Ryujinx.Graphics.Vulkan
             bool supportsIndirectParameters,
             bool supportsFragmentShaderInterlock,
             bool supportsGeometryShaderPassthrough,
+            bool supportsShaderFloat16,
             bool supportsShaderFloat64,
             bool supportsShaderInt8,
+            bool supportsShaderInt16,
             bool supportsShaderStencilExport,
             bool supportsShaderStorageImageMultisample,
             bool supportsConditionalRendering,
@@ -104,8 +108,10 @@ namespace Ryujinx.Graphics.Vulkan
             SupportsIndirectParameters = supportsIndirectParameters;
             SupportsFragmentShaderInterlock = supportsFragmentShaderInterlock;
             SupportsGeometryShaderPassthrough = supportsGeometryShaderPassthrough;
+            SupportsShaderFloat16 = supportsShaderFloat16;
             SupportsShaderFloat64 = supportsShaderFloat64;
             SupportsShaderInt8 = supportsShaderInt8;
+            SupportsShaderInt16 = supportsShaderInt16;
             SupportsShaderStencilExport = supportsShaderStencilExport;
             SupportsShaderStorageImageMultisample = supportsShaderStorageImageMultisample;
             SupportsConditionalRendering = supportsConditionalRendering;
@@ -5,6 +5,7 @@ using Ryujinx.Graphics.Shader.Translation;
 using Silk.NET.Vulkan;
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Numerics;
 using CompareOp = Ryujinx.Graphics.GAL.CompareOp;
 using Format = Ryujinx.Graphics.GAL.Format;
@@ -35,6 +36,8 @@ namespace Ryujinx.Graphics.Vulkan
         private readonly IProgram _programColorBlit;
         private readonly IProgram _programColorBlitMs;
         private readonly IProgram _programColorBlitClearAlpha;
+        private readonly IProgram _programColorBlitTranspose;
+        private readonly IProgram _programColorBlitClearAlphaTranspose;
         private readonly IProgram _programColorClearF;
         private readonly IProgram _programColorClearSI;
         private readonly IProgram _programColorClearUI;
@@ -86,6 +89,18 @@ namespace Ryujinx.Graphics.Vulkan
                 new ShaderSource(ReadSpirv("ColorBlitClearAlphaFragment.spv"), ShaderStage.Fragment, TargetLanguage.Spirv),
             }, blitResourceLayout);
 
+            _programColorBlitTranspose = gd.CreateProgramWithMinimalLayout(new[]
+            {
+                new ShaderSource(ReadSpirv("ColorBlitTransposeVertex.spv"), ShaderStage.Vertex, TargetLanguage.Spirv),
+                new ShaderSource(ReadSpirv("ColorBlitFragment.spv"), ShaderStage.Fragment, TargetLanguage.Spirv),
+            }, blitResourceLayout);
+
+            _programColorBlitClearAlphaTranspose = gd.CreateProgramWithMinimalLayout(new[]
+            {
+                new ShaderSource(ReadSpirv("ColorBlitTransposeVertex.spv"), ShaderStage.Vertex, TargetLanguage.Spirv),
+                new ShaderSource(ReadSpirv("ColorBlitClearAlphaFragment.spv"), ShaderStage.Fragment, TargetLanguage.Spirv),
+            }, blitResourceLayout);
+
             var colorClearResourceLayout = new ResourceLayoutBuilder().Add(ResourceStages.Vertex, ResourceType.UniformBuffer, 1).Build();
 
             _programColorClearF = gd.CreateProgramWithMinimalLayout(new[]
@@ -375,8 +390,11 @@ namespace Ryujinx.Graphics.Vulkan
             Extents2D srcRegion,
             Extents2D dstRegion,
             bool linearFilter,
-            bool clearAlpha = false)
+            bool clearAlpha = false,
+            bool transpose = false)
         {
+            Debug.Assert(!transpose || (!src.Info.Target.IsMultisample() && !dst.Info.Format.IsDepthOrStencil()));
+
             _pipeline.SetCommandBuffer(cbs);
 
             const int RegionBufferSize = 16;
@@ -387,20 +405,7 @@ namespace Ryujinx.Graphics.Vulkan
 
             Span<float> region = stackalloc float[RegionBufferSize / sizeof(float)];
 
-            region[0] = (float)srcRegion.X1 / src.Width;
-            region[1] = (float)srcRegion.X2 / src.Width;
-            region[2] = (float)srcRegion.Y1 / src.Height;
-            region[3] = (float)srcRegion.Y2 / src.Height;
-
-            if (dstRegion.X1 > dstRegion.X2)
-            {
-                (region[0], region[1]) = (region[1], region[0]);
-            }
-
-            if (dstRegion.Y1 > dstRegion.Y2)
-            {
-                (region[2], region[3]) = (region[3], region[2]);
-            }
+            GetBlitRegion(region, srcRegion, src.Width, src.Height, dstRegion, transpose);
 
             using var buffer = gd.BufferManager.ReserveOrCreate(gd, cbs, RegionBufferSize);
 
@@ -438,11 +443,11 @@ namespace Ryujinx.Graphics.Vulkan
             }
             else if (clearAlpha)
             {
-                _pipeline.SetProgram(_programColorBlitClearAlpha);
+                _pipeline.SetProgram(transpose ? _programColorBlitClearAlphaTranspose : _programColorBlitClearAlpha);
             }
             else
             {
-                _pipeline.SetProgram(_programColorBlit);
+                _pipeline.SetProgram(transpose ? _programColorBlitTranspose : _programColorBlit);
             }
 
             int dstWidth = dst.Width;
@@ -469,6 +474,29 @@ namespace Ryujinx.Graphics.Vulkan
             _pipeline.Finish(gd, cbs);
         }
 
+        // A destination region with X1 > X2 or Y1 > Y2 flips the image on that axis. When transposing,
+        // the source X axis runs along the destination Y axis, so the flips come from the other axis.
+        internal static void GetBlitRegion(Span<float> region, Extents2D srcRegion, int srcWidth, int srcHeight, Extents2D dstRegion, bool transpose)
+        {
+            region[0] = (float)srcRegion.X1 / srcWidth;
+            region[1] = (float)srcRegion.X2 / srcWidth;
+            region[2] = (float)srcRegion.Y1 / srcHeight;
+            region[3] = (float)srcRegion.Y2 / srcHeight;
+
+            bool flipX = transpose ? dstRegion.Y1 > dstRegion.Y2 : dstRegion.X1 > dstRegion.X2;
+            bool flipY = transpose ? dstRegion.X1 > dstRegion.X2 : dstRegion.Y1 > dstRegion.Y2;
+
+            if (flipX)
+            {
+                (region[0], region[1]) = (region[1], region[0]);
+            }
+
+            if (flipY)
+            {
+                (region[2], region[3]) = (region[3], region[2]);
+            }
+        }
+
         private void BlitDepthStencil(
             VulkanRenderer gd,
             CommandBufferScoped cbs,
@@ -1705,6 +1733,8 @@ namespace Ryujinx.Graphics.Vulkan
             if (disposing)
             {
                 _programColorBlitClearAlpha.Dispose();
+                _programColorBlitTranspose.Dispose();
+                _programColorBlitClearAlphaTranspose.Dispose();
                 _programColorBlit.Dispose();
                 _programColorBlitMs.Dispose();
                 _programColorClearF.Dispose();
@@ -0,0 +1,84 @@
+using Ryujinx.Graphics.GAL;
+using Silk.NET.Vulkan;
+
+namespace Ryujinx.Graphics.Vulkan
+{
+    /// <summary>
+    /// Maps the presented image to the orientation of the display panel.
+    /// </summary>
+    /// <remarks>
+    /// When the swapchain pre-transform matches the current surface transform, the compositor can scan out
+    /// the buffer as is instead of rotating it in an extra composition pass. The final blit then has to
+    /// produce the rotated image itself. Transforms follow the Vulkan definitions: the content is mirrored
+    /// horizontally first, if requested, and then rotated clockwise.
+    /// </remarks>
+    static class PreRotation
+    {
+        public const SurfaceTransformFlagsKHR SupportedTransforms =
+            SurfaceTransformFlagsKHR.IdentityBitKhr |
+            SurfaceTransformFlagsKHR.Rotate90BitKhr |
+            SurfaceTransformFlagsKHR.Rotate180BitKhr |
+            SurfaceTransformFlagsKHR.Rotate270BitKhr |
+            SurfaceTransformFlagsKHR.HorizontalMirrorBitKhr |
+            SurfaceTransformFlagsKHR.HorizontalMirrorRotate90BitKhr |
+            SurfaceTransformFlagsKHR.HorizontalMirrorRotate180BitKhr |
+            SurfaceTransformFlagsKHR.HorizontalMirrorRotate270BitKhr;
+
+        /// <summary>
+        /// Checks if the transform swaps the width and height of the image.
+        /// </summary>
+        public static bool SwapsAxes(SurfaceTransformFlagsKHR transform)
+        {
+            return transform is
+                SurfaceTransformFlagsKHR.Rotate90BitKhr or
+                SurfaceTransformFlagsKHR.Rotate270BitKhr or
+                SurfaceTransformFlagsKHR.HorizontalMirrorRotate90BitKhr or
+                SurfaceTransformFlagsKHR.HorizontalMirrorRotate270BitKhr;
+        }
+
+        /// <summary>
+        /// Transforms a point on the pixel grid of a width by height image.
+        /// </summary>
+        /// <param name="transform">Transform to apply</param>
+        /// <param name="x">X coordinate, between 0 and width inclusive</param>
+        /// <param name="y">Y coordinate, between 0 and height inclusive</param>
+        /// <param name="width">Width of the image before the transform</param>
+        /// <param name="height">Height of the image before the transform</param>
+        /// <returns>The point on the transformed image</returns>
+        public static (int X, int Y) TransformPoint(SurfaceTransformFlagsKHR transform, int x, int y, int width, int height)
+        {
+            return transform switch
+            {
+                SurfaceTransformFlagsKHR.Rotate90BitKhr => (height - y, x),
+                SurfaceTransformFlagsKHR.Rotate180BitKhr => (width - x, height - y),
+                SurfaceTransformFlagsKHR.Rotate270BitKhr => (y, width - x),
+                SurfaceTransformFlagsKHR.HorizontalMirrorBitKhr => (width - x, y),
+                SurfaceTransformFlagsKHR.HorizontalMirrorRotate90BitKhr => (height - y, width - x),
+                SurfaceTransformFlagsKHR.HorizontalMirrorRotate180BitKhr => (x, height - y),
+                SurfaceTransformFlagsKHR.HorizontalMirrorRotate270BitKhr => (y, x),
+                _ => (x, y),
+            };
+        }
+
+        /// <summary>
+        /// Transforms a blit destination region.
+        /// </summary>
+        /// <remarks>
+        /// The corners keep their order, so flips encoded in the region are preserved. If the transform swaps
+        /// axes, the region must be drawn with a transposed blit, where the source X axis maps to the Y axis
+        /// of the returned region.
+        /// </remarks>
+        /// <param name="transform">Transform to apply</param>
+        /// <param name="region">Region on the untransformed image</param>
+        /// <param name="width">Width of the image before the transform</param>
+        /// <param name="height">Height of the image before the transform</param>
+        /// <returns>The region on the transformed image</returns>
+        public static Extents2D TransformRegion(SurfaceTransformFlagsKHR transform, Extents2D region, int width, int height)
+        {
+            (int x1, int y1) = TransformPoint(transform, region.X1, region.Y1, width, height);
+            (int x2, int y2) = TransformPoint(transform, region.X2, region.Y2, width, height);
+
+            return new Extents2D(x1, y1, x2, y2);
+        }
+    }
+}
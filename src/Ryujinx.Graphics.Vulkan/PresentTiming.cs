@@ -0,0 +1,194 @@
+using Silk.NET.Vulkan;
+using System;
+using System.Diagnostics;
+
+namespace Ryujinx.Graphics.Vulkan
+{
+    /// <summary>
+    /// Statistics about how close presented frames landed to the time requested with VK_GOOGLE_display_timing.
+    /// </summary>
+    /// <remarks>
+    /// Errors are actual minus desired present time in nanoseconds, so positive values mean the frame was late.
+    /// </remarks>
+    public readonly struct PresentTimingStatistics
+    {
+        public bool IsSupported { get; init; }
+        public long RefreshDuration { get; init; }
+        public long LastError { get; init; }
+        public long AverageError { get; init; }
+        public long MaxError { get; init; }
+        public long LateFrames { get; init; }
+    }
+
+    /// <summary>
+    /// Schedules swapchain presents on the display refresh grid using VK_GOOGLE_display_timing.
+    /// </summary>
+    /// <remarks>
+    /// Each present asks for the next refresh, aligned to the most recent actual present time reported by the
+    /// driver, and never for the same refresh as the previous present. The desired time is only a lower bound,
+    /// so a frame that is not done by then is shown on the following refresh, as it would be without it.
+    /// Without a desired time the compositor latches whatever is queued on the next vsync, which makes frames
+    /// that are queued in a burst alternate between one and two refreshes of latency.
+    /// </remarks>
+    class PresentTiming
+    {
+        public const string ExtensionName = "VK_GOOGLE_display_timing";
+
+        private const int MaxPastTimings = 16;
+        private const int AverageWeight = 16;
+
+        private readonly Device _device;
+
+        private readonly unsafe delegate* unmanaged[Cdecl]<Device, SwapchainKHR, RefreshCycleDurationGOOGLE*, Result> _getRefreshCycleDuration;
+        private readonly unsafe delegate* unmanaged[Cdecl]<Device, SwapchainKHR, uint*, PastPresentationTimingGOOGLE*, Result> _getPastPresentationTiming;
+
+        private SwapchainKHR _swapchain;
+        private long _refreshDuration;
+        private uint _nextPresentId;
+        private long _lastDesiredTime;
+
+        private long _anchorTime;
+        private uint _anchorPresentId;
+
+        private long _lastError;
+        private long _averageError;
+        private long _maxError;
+        private long _lateFrames;
+
+        private unsafe PresentTiming(Device device, IntPtr getRefreshCycleDuration, IntPtr getPastPresentationTiming)
+        {
+            _device = device;
+            _getRefreshCycleDuration = (delegate* unmanaged[Cdecl]<Device, SwapchainKHR, RefreshCycleDurationGOOGLE*, Result>)getRefreshCycleDuration;
+            _getPastPresentationTiming = (delegate* unmanaged[Cdecl]<Device, SwapchainKHR, uint*, PastPresentationTimingGOOGLE*, Result>)getPastPresentationTiming;
+        }
+
+        public static PresentTiming TryCreate(VulkanRenderer gd, Device device)
+        {
+            if (!gd.SupportsDisplayTiming || !gd.PresentTimingEnabled)
+            {
+                return null;
+            }
+
+            IntPtr getRefreshCycleDuration = gd.Api.GetDeviceProcAddr(device, "vkGetRefreshCycleDurationGOOGLE");
+            IntPtr getPastPresentationTiming = gd.Api.GetDeviceProcAddr(device, "vkGetPastPresentationTimingGOOGLE");
+
+            if (getRefreshCycleDuration == IntPtr.Zero || getPastPresentationTiming == IntPtr.Zero)
+            {
+                return null;
+            }
+
+            return new PresentTiming(device, getRefreshCycleDuration, getPastPresentationTiming);
+        }
+
+        public PresentTimingStatistics Statistics => new()
+        {
+            IsSupported = true,
+            RefreshDuration = _refreshDuration,
+            LastError = _lastError,
+            AverageError = _averageError,
+            MaxError = _maxError,
+            LateFrames = _lateFrames,
+        };
+
+        /// <summary>
+        /// Binds the timing state to a newly created swapchain.
+        /// </summary>
+        /// <remarks>
+        /// Present IDs and past timings belong to a swapchain, so the grid anchor is dropped as well.
+        /// Error statistics are kept, they describe the whole session.
+        /// </remarks>
+        public unsafe void Reset(SwapchainKHR swapchain)
+        {
+            _swapchain = swapchain;
+            _nextPresentId = 1;
+            _lastDesiredTime = 0;
+            _anchorTime = 0;
+            _anchorPresentId = 0;
+
+            RefreshCycleDurationGOOGLE refreshCycle;
+
+            if (_getRefreshCycleDuration(_device, swapchain, &refreshCycle) == Result.Success)
+            {
+                _refreshDuration = (long)refreshCycle.RefreshDuration;
+            }
+            else
+            {
+                _refreshDuration = 0;
+            }
+        }
+
+        /// <summary>
+        /// Returns the present time to chain into the next present of the bound swapchain.
+        /// </summary>
+        public PresentTimeGOOGLE NextPresentTime()
+        {
+            UpdatePastTimings();
+
+            uint presentId = _nextPresentId++;
+            long desiredTime = 0;
+
+            if (_refreshDuration > 0 && _anchorTime != 0)
+            {
+                long now = (long)(Stopwatch.GetTimestamp() * (1_000_000_000.0 / Stopwatch.Frequency));
+                long earliest = Math.Max(now, _lastDesiredTime + _refreshDuration);
+                long cycles = (earliest - _anchorTime + _refreshDuration - 1) / _refreshDuration;
+
+                desiredTime = _anchorTime + Math.Max(cycles, 1) * _refreshDuration;
+                _lastDesiredTime = desiredTime;
+            }
+
+            return new PresentTimeGOOGLE
+            {
+                PresentID = presentId,
+                DesiredPresentTime = (ulong)desiredTime,
+            };
+        }
+
+        private unsafe void UpdatePastTimings()
+        {
+            uint count = MaxPastTimings;
+            PastPresentationTimingGOOGLE* timings = stackalloc PastPresentationTimingGOOGLE[MaxPastTimings];
+
+            // Incomplete only means older entries are left for the next call.
+            Result result = _getPastPresentationTiming(_device, _swapchain, &count, timings);
+
+            if (result != Result.Success && result != Result.Incomplete)
+            {
+                return;
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                ref PastPresentationTimingGOOGLE timing = ref timings[i];
+
+                if (timing.ActualPresentTime == 0)
+                {
+                    continue;
+                }
+
+                if (timing.PresentID >= _anchorPresentId)
+                {
+                    _anchorPresentId = timing.PresentID;
+                    _anchorTime = (long)timing.ActualPresentTime;
+                }
+
+                if (timing.DesiredPresentTime == 0)
+                {
+                    continue;
+                }
+
+                long error = (long)timing.ActualPresentTime - (long)timing.DesiredPresentTime;
+
+                _lastError = error;
+                _averageError += (error - _averageError) / AverageWeight;
+                _maxError = Math.Max(_maxError, error);
+
+                // Anything more than half a refresh off landed on a later vsync than requested.
+                if (error > _refreshDuration / 2)
+                {
+                    _lateFrames++;
+                }
+            }
+        }
+    }
+}
@@ -45,7 +45,18 @@ namespace Ryujinx.Graphics.Vulkan
 
                 if (spirv == null)
                 {
-                    spirv = GlslToSpirv(shaderSource.Code, shaderSource.Stage);
+                    try
+                    {
+                        spirv = GlslToSpirv(shaderSource.Code, shaderSource.Stage);
+                    }
+                    catch (Exception ex)
+                    {
+                        // The runtime compiler is a native library that is not shipped on every platform (e.g. Android).
+                        // Report it as a compile failure so callers can fall back to precompiled shaders.
+                        Logger.Error?.Print(LogClass.Gpu, $"Shader compilation error: {ex.Message}");
+
+                        spirv = null;
+                    }
 
                     if (spirv == null)
                     {
@@ -0,0 +1,23 @@
+using Silk.NET.Vulkan;
+using VkFormat = Silk.NET.Vulkan.Format;
+
+namespace Ryujinx.Graphics.Vulkan
+{
+    /// <summary>
+    /// A swapchain and the objects created along with it, which can be built off the render thread.
+    /// </summary>
+    class SwapchainResources
+    {
+        public SwapchainKHR Swapchain { get; init; }
+        public Image[] Images { get; init; }
+        public TextureView[] ImageViews { get; init; }
+        public Semaphore[] ImageAvailableSemaphores { get; init; }
+        public Semaphore[] RenderFinishedSemaphores { get; init; }
+        public int Width { get; init; }
+        public int Height { get; init; }
+        public VkFormat Format { get; init; }
+        public SurfaceTransformFlagsKHR PreTransform { get; init; }
+        public bool PreRotate { get; init; }
+        public SurfaceTransformFlagsKHR CurrentTransform { get; init; }
+    }
+}
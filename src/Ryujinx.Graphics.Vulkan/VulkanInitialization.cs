@@ -46,6 +46,7 @@ namespace Ryujinx.Graphics.Vulkan
             "VK_KHR_maintenance2",
             "VK_EXT_attachment_feedback_loop_layout",
             "VK_EXT_attachment_feedback_loop_dynamic_state",
+            PresentTiming.ExtensionName,
         };
 
         private static readonly string[] _requiredExtensions = {
@@ -409,6 +410,7 @@ namespace Ryujinx.Graphics.Vulkan
                 SamplerAnisotropy = supportedFeatures.SamplerAnisotropy,
                 ShaderClipDistance = supportedFeatures.ShaderClipDistance,
                 ShaderFloat64 = supportedFeatures.ShaderFloat64,
+                ShaderInt16 = supportedFeatures.ShaderInt16,
                 ShaderImageGatherExtended = supportedFeatures.ShaderImageGatherExtended,
                 ShaderStorageImageMultisample = supportedFeatures.ShaderStorageImageMultisample,
                 ShaderStorageImageReadWithoutFormat = supportedFeatures.ShaderStorageImageReadWithoutFormat,
@@ -488,6 +490,7 @@ namespace Ryujinx.Graphics.Vulkan
                 PNext = pExtendedFeatures,
                 DescriptorIndexing = supportedPhysicalDeviceVulkan12Features.DescriptorIndexing,
                 DrawIndirectCount = supportedPhysicalDeviceVulkan12Features.DrawIndirectCount,
+                ShaderFloat16 = supportedPhysicalDeviceVulkan12Features.ShaderFloat16,
                 UniformBufferStandardLayout = supportedPhysicalDeviceVulkan12Features.UniformBufferStandardLayout,
                 UniformAndStorageBuffer8BitAccess = supportedPhysicalDeviceVulkan12Features.UniformAndStorageBuffer8BitAccess,
                 StorageBuffer8BitAccess = supportedPhysicalDeviceVulkan12Features.StorageBuffer8BitAccess,
@@ -76,6 +76,29 @@ namespace Ryujinx.Graphics.Vulkan
 
         public SurfaceTransformFlagsKHR CurrentTransform => _window.CurrentTransform;
 
+        public PresentTimingStatistics PresentTimingStatistics => (_window as Window)?.PresentTimingStatistics ?? default;
+
+        /// <summary>
+        /// Schedules presents with VK_GOOGLE_display_timing when it is supported. Must be set before initialization.
+        /// </summary>
+        public bool PresentTimingEnabled { get; set; } = true;
+
+        public bool IsPreRotated => (_window as Window)?.IsPreRotated ?? false;
+
+        public int SwapchainGeneration => (_window as Window)?.SwapchainGeneration ?? 0;
+
+        /// <summary>
+        /// Pre-rotates surfaces with a 180 degree transform, instead of leaving the rotation to the frontend.
+        /// </summary>
+        public bool PreRotateHalfTurn { get; set; } = true;
+
+        /// <summary>
+        /// Runs both FSR precision paths on every frame and times them, when FSR is the scaling filter.
+        /// </summary>
+        public bool FsrBenchmarkEnabled { get; set; }
+
+        public FsrBenchmarkStatistics FsrBenchmarkStatistics => (_window as Window)?.FsrBenchmarkStatistics ?? default;
+
         private readonly Func<Instance, Vk, SurfaceKHR> _getSurface;
         private readonly Func<string[]> _getRequiredExtensions;
         private readonly string _preferredGpuId;
@@ -94,6 +117,9 @@ namespace Ryujinx.Graphics.Vulkan
         internal bool IsMoltenVk { get; private set; }
         internal bool IsTBDR { get; private set; }
         internal bool IsSharedMemory { get; private set; }
+        internal bool SupportsDisplayTiming { get; private set; }
+        internal bool SupportsTimestampQueries { get; private set; }
+        internal float TimestampPeriod { get; private set; }
 
         public string GpuVendor { get; private set; }
         public string GpuDriver { get; private set; }
@@ -414,8 +440,10 @@ namespace Ryujinx.Graphics.Vulkan
                 _physicalDevice.IsDeviceExtensionPresent(KhrDrawIndirectCount.ExtensionName),
                 _physicalDevice.IsDeviceExtensionPresent("VK_EXT_fragment_shader_interlock"),
                 _physicalDevice.IsDeviceExtensionPresent("VK_NV_geometry_shader_passthrough"),
+                featuresShaderInt8.ShaderFloat16,
                 features2.Features.ShaderFloat64,
                 featuresShaderInt8.ShaderInt8,
+                features2.Features.ShaderInt16,
                 _physicalDevice.IsDeviceExtensionPresent("VK_EXT_shader_stencil_export"),
                 features2.Features.ShaderStorageImageMultisample,
                 _physicalDevice.IsDeviceExtensionPresent(ExtConditionalRendering.ExtensionName),
@@ -500,6 +528,10 @@ namespace Ryujinx.Graphics.Vulkan
 
             QueueFamilyIndex = queueFamilyIndex;
 
+            SupportsDisplayTiming = _physicalDevice.IsDeviceExtensionPresent(PresentTiming.ExtensionName);
+            SupportsTimestampQueries = _physicalDevice.QueueFamilyProperties[queueFamilyIndex].TimestampValidBits != 0;
+            TimestampPeriod = _physicalDevice.PhysicalDeviceProperties.Limits.TimestampPeriod;
+
             _window = new Window(this, _surface, _physicalDevice.PhysicalDevice, _device);
 
             _initialized = true;
@@ -1003,6 +1035,8 @@ namespace Ryujinx.Graphics.Vulkan
 
         internal unsafe void RecreateSurface()
         {
+            (_window as Window)?.ReleaseSurface();
+
             SurfaceApi.DestroySurface(_instance.Instance, _surface, null);
 
             _surface = _getSurface(_instance.Instance, Api);
@@ -1,9 +1,12 @@
+using Ryujinx.Common.Logging;
 using Ryujinx.Graphics.GAL;
 using Ryujinx.Graphics.Vulkan.Effects;
 using Silk.NET.Vulkan;
 using Silk.NET.Vulkan.Extensions.KHR;
 using System;
+using System.Collections.Generic;
 using System.Linq;
+using System.Threading.Tasks;
 using VkFormat = Silk.NET.Vulkan.Format;
 
 namespace Ryujinx.Graphics.Vulkan
@@ -13,11 +16,60 @@ namespace Ryujinx.Graphics.Vulkan
         private const int SurfaceWidth = 1280;
         private const int SurfaceHeight = 720;
 
+        private readonly struct RetiredSwapchain
+        {
+            public readonly SwapchainResources Resources;
+            public readonly ulong NextPresentId;
+
+            public RetiredSwapchain(SwapchainResources resources, ulong nextPresentId)
+            {
+                Resources = resources;
+                NextPresentId = nextPresentId;
+            }
+        }
+
+        /// <summary>
+        /// Window and renderer state a swapchain is built from, taken on the render thread.
+        /// </summary>
+        private readonly struct SwapchainSettings
+        {
+            public readonly SurfaceKHR Surface;
+            public readonly bool VSyncEnabled;
+            public readonly bool ColorSpacePassthroughEnabled;
+            public readonly bool PreRotateHalfTurn;
+
+            public SwapchainSettings(SurfaceKHR surface, bool vsyncEnabled, bool colorSpacePassthroughEnabled, bool preRotateHalfTurn)
+            {
+                Surface = surface;
+                VSyncEnabled = vsyncEnabled;
+                ColorSpacePassthroughEnabled = colorSpacePassthroughEnabled;
+                PreRotateHalfTurn = preRotateHalfTurn;
+            }
+        }
+
         private readonly VulkanRenderer _gd;
         private readonly PhysicalDevice _physicalDevice;
         private readonly Device _device;
+        private readonly PresentTiming _presentTiming;
         private SwapchainKHR _swapchain;
         private SurfaceKHR _surface;
+        private SwapchainResources _swapchainResources;
+
+        private readonly List<RetiredSwapchain> _retiredSwapchains = new();
+        private Task<SwapchainResources> _pendingSwapchain;
+        private volatile bool _resizeRequested;
+
+        // Set if a swapchain could not be built next to the current one, the surface may only allow one at a time.
+        private bool _backgroundBuildFailed;
+
+        // Set when a replacement was created from the current swapchain, which can no longer acquire images.
+        private bool _swapchainRetired;
+
+        // Presents are numbered from 1. Acquiring an image again means that its last present has completed,
+        // along with every present queued before it, including the ones to retired swapchains.
+        private ulong[] _imagePresentIds;
+        private ulong _presentCount;
+        private ulong _completedPresentId;
 
         private Image[] _swapchainImages;
         private TextureView[] _swapchainImageViews;
@@ -31,11 +83,15 @@ namespace Ryujinx.Graphics.Vulkan
         private int _height;
         private bool _vsyncEnabled;
         private bool _swapchainIsDirty;
+        private SurfaceTransformFlagsKHR _preTransform;
+        private bool _preRotate;
+        private int _swapchainGeneration;
         private VkFormat _format;
         private AntiAliasing _currentAntiAliasing;
         private bool _updateEffect;
         private IPostProcessingEffect _effect;
         private IScalingFilter _scalingFilter;
+        private TextureView _scaledTexture;
         private bool _isLinear;
         private float _scalingFilterLevel;
         private bool _updateScalingFilter;
@@ -48,72 +104,215 @@ namespace Ryujinx.Graphics.Vulkan
             _physicalDevice = physicalDevice;
             _device = device;
             _surface = surface;
+            _presentTiming = PresentTiming.TryCreate(gd, device);
 
             CreateSwapchain();
         }
 
+        public PresentTimingStatistics PresentTimingStatistics => _presentTiming?.Statistics ?? default;
+
+        public FsrBenchmarkStatistics FsrBenchmarkStatistics => (_scalingFilter as FsrScalingFilter)?.BenchmarkStatistics ?? default;
+
+        /// <summary>
+        /// True if presented images are already rotated to the display orientation.
+        /// </summary>
+        public bool IsPreRotated => _preRotate;
+
+        /// <summary>
+        /// Incremented every time the swapchain is created.
+        /// </summary>
+        public int SwapchainGeneration => _swapchainGeneration;
+
+        private void CreateSwapchain()
+        {
+            ApplySwapchain(BuildSwapchain(GetSwapchainSettings(), default));
+        }
+
+        private SwapchainSettings GetSwapchainSettings()
+        {
+            return new SwapchainSettings(_surface, _vsyncEnabled, _colorSpacePassthroughEnabled, _gd.PreRotateHalfTurn);
+        }
+
+        private void ApplySwapchain(SwapchainResources resources)
+        {
+            _swapchainResources = resources;
+            _swapchain = resources.Swapchain;
+            _swapchainImages = resources.Images;
+            _swapchainImageViews = resources.ImageViews;
+            _imagePresentIds = new ulong[resources.Images.Length];
+            _imageAvailableSemaphores = resources.ImageAvailableSemaphores;
+            _renderFinishedSemaphores = resources.RenderFinishedSemaphores;
+            _width = resources.Width;
+            _height = resources.Height;
+            _format = resources.Format;
+            _preTransform = resources.PreTransform;
+            _preRotate = resources.PreRotate;
+
+            CurrentTransform = resources.CurrentTransform;
+
+            _swapchainRetired = false;
+
+            _presentTiming?.Reset(_swapchain);
+            _swapchainGeneration++;
+        }
+
         private void RecreateSwapchain()
         {
-            var oldSwapchain = _swapchain;
+            // A replacement that is already being built only has to be waited for. The settings may have changed
+            // since it was started, in which case the swapchain is still dirty and rebuilt again.
+            if (_pendingSwapchain != null && TryApplyPendingSwapchain(true))
+            {
+                return;
+            }
+
             _swapchainIsDirty = false;
 
+            // A retired swapchain can't be replaced again, this happens if building its replacement failed.
+            var oldSwapchain = _swapchainRetired ? default : _swapchain;
+
+            // The old swapchain is retired by the call, even if it fails, images can't be acquired from it anymore.
+            _swapchainRetired = true;
+
+            var resources = BuildSwapchain(GetSwapchainSettings(), oldSwapchain);
+
+            RetireSwapchain();
+            ApplySwapchain(resources);
+        }
+
+        private void StartSwapchainBuild()
+        {
+            var settings = GetSwapchainSettings();
+
+            // Passing the current swapchain as the old one would retire it. It keeps acquiring and presenting
+            // instead, until the new one is ready and replaces it on the render thread.
+            _pendingSwapchain = Task.Run(() => BuildSwapchain(settings, default));
+        }
+
+        private bool TryApplyPendingSwapchain(bool wait)
+        {
+            if (!wait && !_pendingSwapchain.IsCompleted)
+            {
+                return false;
+            }
+
+            var pending = _pendingSwapchain;
+            _pendingSwapchain = null;
+
+            SwapchainResources resources;
+
+            try
+            {
+                resources = pending.GetAwaiter().GetResult();
+            }
+            catch (VulkanException ex)
+            {
+                Logger.Warning?.Print(LogClass.Gpu, $"Failed to build the swapchain in the background, rebuilding it on the render thread from now on: {ex.Message}");
+
+                _backgroundBuildFailed = true;
+                _swapchainIsDirty = true;
+
+                return false;
+            }
+
+            RetireSwapchain();
+            ApplySwapchain(resources);
+
+            return true;
+        }
+
+        private void RetireSwapchain()
+        {
             for (int i = 0; i < _swapchainImageViews.Length; i++)
             {
                 _swapchainImageViews[i].Dispose();
             }
 
-            // Destroy old Swapchain.
-
-            _gd.Api.DeviceWaitIdle(_device);
+            // The old swapchain may still have presents in flight, it is destroyed once a present queued after them completes.
+            _retiredSwapchains.Add(new RetiredSwapchain(_swapchainResources, _presentCount + 1));
+        }
 
-            unsafe
+        private void DestroyRetiredSwapchains(bool force)
+        {
+            for (int i = _retiredSwapchains.Count - 1; i >= 0; i--)
             {
-                for (int i = 0; i < _imageAvailableSemaphores.Length; i++)
-                {
-                    _gd.Api.DestroySemaphore(_device, _imageAvailableSemaphores[i], null);
-                }
+                var retired = _retiredSwapchains[i];
 
-                for (int i = 0; i < _renderFinishedSemaphores.Length; i++)
+                if (!force && _completedPresentId < retired.NextPresentId)
                 {
-                    _gd.Api.DestroySemaphore(_device, _renderFinishedSemaphores[i], null);
+                    continue;
                 }
+
+                DestroySwapchain(retired.Resources);
+
+                _retiredSwapchains.RemoveAt(i);
             }
+        }
 
-            _gd.SwapchainApi.DestroySwapchain(_device, oldSwapchain, Span<AllocationCallbacks>.Empty);
+        private unsafe void DestroySwapchain(SwapchainResources resources)
+        {
+            for (int i = 0; i < resources.ImageAvailableSemaphores.Length; i++)
+            {
+                _gd.Api.DestroySemaphore(_device, resources.ImageAvailableSemaphores[i], null);
+            }
 
-            CreateSwapchain();
+            for (int i = 0; i < resources.RenderFinishedSemaphores.Length; i++)
+            {
+                _gd.Api.DestroySemaphore(_device, resources.RenderFinishedSemaphores[i], null);
+            }
+
+            _gd.SwapchainApi.DestroySwapchain(_device, resources.Swapchain, Span<AllocationCallbacks>.Empty);
+        }
+
+        /// <summary>
+        /// Destroys every swapchain created for the current surface, which must happen before the surface is destroyed.
+        /// </summary>
+        internal void ReleaseSurface()
+        {
+            if (_pendingSwapchain != null)
+            {
+                TryApplyPendingSwapchain(true);
+            }
+
+            _gd.Api.DeviceWaitIdle(_device);
+
+            RetireSwapchain();
+            DestroyRetiredSwapchains(true);
         }
 
         internal void SetSurface(SurfaceKHR surface)
         {
             _surface = surface;
-            RecreateSwapchain();
+            _swapchainIsDirty = false;
+
+            CreateSwapchain();
         }
 
-        private unsafe void CreateSwapchain()
+        private unsafe SwapchainResources BuildSwapchain(in SwapchainSettings settings, SwapchainKHR oldSwapchain)
         {
-            _gd.SurfaceApi.GetPhysicalDeviceSurfaceCapabilities(_physicalDevice, _surface, out var capabilities);
+            var surface = settings.Surface;
+
+            _gd.SurfaceApi.GetPhysicalDeviceSurfaceCapabilities(_physicalDevice, surface, out var capabilities);
 
             uint surfaceFormatsCount;
 
-            _gd.SurfaceApi.GetPhysicalDeviceSurfaceFormats(_physicalDevice, _surface, &surfaceFormatsCount, null);
+            _gd.SurfaceApi.GetPhysicalDeviceSurfaceFormats(_physicalDevice, surface, &surfaceFormatsCount, null);
 
             var surfaceFormats = new SurfaceFormatKHR[surfaceFormatsCount];
 
             fixed (SurfaceFormatKHR* pSurfaceFormats = surfaceFormats)
             {
-                _gd.SurfaceApi.GetPhysicalDeviceSurfaceFormats(_physicalDevice, _surface, &surfaceFormatsCount, pSurfaceFormats);
+                _gd.SurfaceApi.GetPhysicalDeviceSurfaceFormats(_physicalDevice, surface, &surfaceFormatsCount, pSurfaceFormats);
             }
 
             uint presentModesCount;
 
-            _gd.SurfaceApi.GetPhysicalDeviceSurfacePresentModes(_physicalDevice, _surface, &presentModesCount, null);
+            _gd.SurfaceApi.GetPhysicalDeviceSurfacePresentModes(_physicalDevice, surface, &presentModesCount, null);
 
             var presentModes = new PresentModeKHR[presentModesCount];
 
             fixed (PresentModeKHR* pPresentModes = presentModes)
             {
-                _gd.SurfaceApi.GetPhysicalDeviceSurfacePresentModes(_physicalDevice, _surface, &presentModesCount, pPresentModes);
+                _gd.SurfaceApi.GetPhysicalDeviceSurfacePresentModes(_physicalDevice, surface, &presentModesCount, pPresentModes);
             }
 
             uint imageCount = capabilities.MinImageCount + 1;
@@ -122,22 +321,24 @@ namespace Ryujinx.Graphics.Vulkan
                 imageCount = capabilities.MaxImageCount;
             }
 
-            var surfaceFormat = ChooseSwapSurfaceFormat(surfaceFormats, _colorSpacePassthroughEnabled);
+            var surfaceFormat = ChooseSwapSurfaceFormat(surfaceFormats, settings.ColorSpacePassthroughEnabled);
 
             var extent = ChooseSwapExtent(capabilities);
+            var displayExtent = extent;
 
-            _width = (int)extent.Width;
-            _height = (int)extent.Height;
-            _format = surfaceFormat.Format;
+            var preTransform = ChoosePreTransform(capabilities, settings.PreRotateHalfTurn);
+            bool preRotate = Ryujinx.Common.PlatformInfo.IsBionic && preTransform != SurfaceTransformFlagsKHR.IdentityBitKhr;
 
-            var oldSwapchain = _swapchain;
-
-            CurrentTransform = capabilities.CurrentTransform;
+            // The surface extent is in display orientation, the images must be in the panel orientation.
+            if (preRotate && PreRotation.SwapsAxes(preTransform))
+            {
+                extent = new Extent2D(extent.Height, extent.Width);
+            }
 
             var swapchainCreateInfo = new SwapchainCreateInfoKHR
             {
                 SType = StructureType.SwapchainCreateInfoKhr,
-                Surface = _surface,
+                Surface = surface,
                 MinImageCount = imageCount,
                 ImageFormat = surfaceFormat.Format,
                 ImageColorSpace = surfaceFormat.ColorSpace,
@@ -145,15 +346,16 @@ namespace Ryujinx.Graphics.Vulkan
                 ImageUsage = ImageUsageFlags.ColorAttachmentBit | ImageUsageFlags.TransferDstBit | (Ryujinx.Common.PlatformInfo.IsBionic ? 0 : ImageUsageFlags.StorageBit),
                 ImageSharingMode = SharingMode.Exclusive,
                 ImageArrayLayers = 1,
-                PreTransform = Ryujinx.Common.PlatformInfo.IsBionic ? SurfaceTransformFlagsKHR.IdentityBitKhr : capabilities.CurrentTransform,
+                PreTransform = preTransform,
                 CompositeAlpha = ChooseCompositeAlpha(capabilities.SupportedCompositeAlpha),
-                PresentMode = ChooseSwapPresentMode(presentModes, _vsyncEnabled),
+                PresentMode = ChooseSwapPresentMode(presentModes, settings.VSyncEnabled),
                 Clipped = true,
+                OldSwapchain = oldSwapchain,
             };
 
             var textureCreateInfo = new TextureCreateInfo(
-                _width,
-                _height,
+                (int)extent.Width,
+                (int)extent.Height,
                 1,
                 1,
                 1,
@@ -168,22 +370,22 @@ namespace Ryujinx.Graphics.Vulkan
                 SwizzleComponent.Blue,
                 SwizzleComponent.Alpha);
 
-            _gd.SwapchainApi.CreateSwapchain(_device, in swapchainCreateInfo, null, out _swapchain).ThrowOnError();
+            _gd.SwapchainApi.CreateSwapchain(_device, in swapchainCreateInfo, null, out var swapchain).ThrowOnError();
 
-            _gd.SwapchainApi.GetSwapchainImages(_device, _swapchain, &imageCount, null);
+            _gd.SwapchainApi.GetSwapchainImages(_device, swapchain, &imageCount, null);
 
-            _swapchainImages = new Image[imageCount];
+            var swapchainImages = new Image[imageCount];
 
-            fixed (Image* pSwapchainImages = _swapchainImages)
+            fixed (Image* pSwapchainImages = swapchainImages)
             {
-                _gd.SwapchainApi.GetSwapchainImages(_device, _swapchain, &imageCount, pSwapchainImages);
+                _gd.SwapchainApi.GetSwapchainImages(_device, swapchain, &imageCount, pSwapchainImages);
             }
 
-            _swapchainImageViews = new TextureView[imageCount];
+            var swapchainImageViews = new TextureView[imageCount];
 
-            for (int i = 0; i < _swapchainImageViews.Length; i++)
+            for (int i = 0; i < swapchainImageViews.Length; i++)
             {
-                _swapchainImageViews[i] = CreateSwapchainImageView(_swapchainImages[i], surfaceFormat.Format, textureCreateInfo);
+                swapchainImageViews[i] = CreateSwapchainImageView(swapchainImages[i], surfaceFormat.Format, textureCreateInfo);
             }
 
             var semaphoreCreateInfo = new SemaphoreCreateInfo
@@ -191,19 +393,34 @@ namespace Ryujinx.Graphics.Vulkan
                 SType = StructureType.SemaphoreCreateInfo,
             };
 
-            _imageAvailableSemaphores = new Semaphore[imageCount];
+            var imageAvailableSemaphores = new Semaphore[imageCount];
 
-            for (int i = 0; i < _imageAvailableSemaphores.Length; i++)
+            for (int i = 0; i < imageAvailableSemaphores.Length; i++)
             {
-                _gd.Api.CreateSemaphore(_device, in semaphoreCreateInfo, null, out _imageAvailableSemaphores[i]).ThrowOnError();
+                _gd.Api.CreateSemaphore(_device, in semaphoreCreateInfo, null, out imageAvailableSemaphores[i]).ThrowOnError();
             }
 
-            _renderFinishedSemaphores = new Semaphore[imageCount];
+            var renderFinishedSemaphores = new Semaphore[imageCount];
 
-            for (int i = 0; i < _renderFinishedSemaphores.Length; i++)
+            for (int i = 0; i < renderFinishedSemaphores.Length; i++)
             {
-                _gd.Api.CreateSemaphore(_device, in semaphoreCreateInfo, null, out _renderFinishedSemaphores[i]).ThrowOnError();
+                _gd.Api.CreateSemaphore(_device, in semaphoreCreateInfo, null, out renderFinishedSemaphores[i]).ThrowOnError();
             }
+
+            return new SwapchainResources
+            {
+                Swapchain = swapchain,
+                Images = swapchainImages,
+                ImageViews = swapchainImageViews,
+                ImageAvailableSemaphores = imageAvailableSemaphores,
+                RenderFinishedSemaphores = renderFinishedSemaphores,
+                Width = (int)displayExtent.Width,
+                Height = (int)displayExtent.Height,
+                Format = surfaceFormat.Format,
+                PreTransform = preTransform,
+                PreRotate = preRotate,
+                CurrentTransform = capabilities.CurrentTransform,
+            };
         }
 
         private unsafe TextureView CreateSwapchainImageView(Image swapchainImage, VkFormat format, TextureCreateInfo info)
@@ -287,6 +504,30 @@ namespace Ryujinx.Graphics.Vulkan
             }
         }
 
+        private static SurfaceTransformFlagsKHR ChoosePreTransform(SurfaceCapabilitiesKHR capabilities, bool preRotateHalfTurn)
+        {
+            if (!Ryujinx.Common.PlatformInfo.IsBionic)
+            {
+                return capabilities.CurrentTransform;
+            }
+
+            // On Android, rendering in the panel orientation lets the compositor skip its rotation pass.
+            // Fall back to letting the compositor rotate if the transform can't be used as pre-transform.
+            var transform = capabilities.CurrentTransform;
+
+            if (transform == SurfaceTransformFlagsKHR.Rotate180BitKhr && !preRotateHalfTurn)
+            {
+                return SurfaceTransformFlagsKHR.IdentityBitKhr;
+            }
+
+            if ((PreRotation.SupportedTransforms & transform) != 0 && capabilities.SupportedTransforms.HasFlag(transform))
+            {
+                return transform;
+            }
+
+            return SurfaceTransformFlagsKHR.IdentityBitKhr;
+        }
+
         private static PresentModeKHR ChooseSwapPresentMode(PresentModeKHR[] availablePresentModes, bool vsyncEnabled)
         {
             if (!vsyncEnabled && availablePresentModes.Contains(PresentModeKHR.ImmediateKhr))
@@ -320,12 +561,31 @@ namespace Ryujinx.Graphics.Vulkan
         {
             _gd.PipelineInternal.AutoFlush.Present();
 
+            if (_pendingSwapchain != null)
+            {
+                TryApplyPendingSwapchain(false);
+            }
+            else if (_resizeRequested)
+            {
+                _resizeRequested = false;
+
+                if (_backgroundBuildFailed)
+                {
+                    _swapchainIsDirty = true;
+                }
+                else
+                {
+                    StartSwapchainBuild();
+                }
+            }
+
             uint nextImage = 0;
             int semaphoreIndex = _frameIndex++ % _imageAvailableSemaphores.Length;
 
             while (true)
             {
-                var acquireResult = _gd.SwapchainApi.AcquireNextImage(
+                // Images can't be acquired from a retired swapchain, this happens if building its replacement failed.
+                var acquireResult = _swapchainRetired ? Result.ErrorOutOfDateKhr : _gd.SwapchainApi.AcquireNextImage(
                     _device,
                     _swapchain,
                     ulong.MaxValue,
@@ -333,6 +593,12 @@ namespace Ryujinx.Graphics.Vulkan
                     new Fence(),
                     ref nextImage);
 
+                // Keep presenting to a suboptimal swapchain while its replacement is being built.
+                if (acquireResult == Result.SuboptimalKhr && _pendingSwapchain != null && !_swapchainIsDirty)
+                {
+                    break;
+                }
+
                 if (acquireResult == Result.ErrorOutOfDateKhr ||
                     acquireResult == Result.SuboptimalKhr ||
                     _swapchainIsDirty)
@@ -351,6 +617,10 @@ namespace Ryujinx.Graphics.Vulkan
                 }
             }
 
+            _completedPresentId = Math.Max(_completedPresentId, _imagePresentIds[nextImage]);
+
+            DestroyRetiredSwapchains(false);
+
             var swapchainImage = _swapchainImages[nextImage];
 
             _gd.FlushAllCommands();
@@ -434,28 +704,61 @@ namespace Ryujinx.Graphics.Vulkan
 
             if (_scalingFilter != null)
             {
+                // Scaling filters can't write rotated output, pre-rotated frames are scaled into an image
+                // in display orientation first, which is then rotated by the blit.
+                var destination = _swapchainImageViews[nextImage];
+
+                if (_preRotate)
+                {
+                    destination = GetScaledTexture();
+                }
+
                 _scalingFilter.Run(
                     view,
                     cbs,
-                    _swapchainImageViews[nextImage].GetImageViewForAttachment(),
+                    destination.GetImageViewForAttachment(),
                     _format,
                     _width,
                     _height,
                     new Extents2D(srcX0, srcY0, srcX1, srcY1),
                     new Extents2D(dstX0, dstY0, dstX1, dstY1)
                     );
+
+                if (_preRotate)
+                {
+                    _gd.HelperShader.BlitColor(
+                        _gd,
+                        cbs,
+                        destination,
+                        _swapchainImageViews[nextImage],
+                        new Extents2D(0, 0, _width, _height),
+                        PreRotation.TransformRegion(_preTransform, new Extents2D(0, 0, _width, _height), _width, _height),
+                        false,
+                        true,
+                        PreRotation.SwapsAxes(_preTransform));
+                }
             }
             else
             {
+                var dstRegion = new Extents2D(dstX0, dstY1, dstX1, dstY0);
+                bool transpose = false;
+
+                if (_preRotate)
+                {
+                    dstRegion = PreRotation.TransformRegion(_preTransform, dstRegion, _width, _height);
+                    transpose = PreRotation.SwapsAxes(_preTransform);
+                }
+
                 _gd.HelperShader.BlitColor(
                     _gd,
                     cbs,
                     view,
                     _swapchainImageViews[nextImage],
                     new Extents2D(srcX0, srcY0, srcX1, srcY1),
-                    new Extents2D(dstX0, dstY1, dstX1, dstY0),
+                    dstRegion,
                     _isLinear,
-                    true);
+                    true,
+                    transpose);
             }
 
             Transition(
@@ -489,11 +792,30 @@ namespace Ryujinx.Graphics.Vulkan
                 PResults = &result,
             };
 
+            PresentTimesInfoGOOGLE presentTimesInfo;
+            PresentTimeGOOGLE presentTime;
+
+            // Display timing only makes sense when presents are synchronized to the refresh.
+            if (_presentTiming != null && _vsyncEnabled)
+            {
+                presentTime = _presentTiming.NextPresentTime();
+                presentTimesInfo = new PresentTimesInfoGOOGLE
+                {
+                    SType = StructureType.PresentTimesInfoGoogle,
+                    SwapchainCount = 1,
+                    PTimes = &presentTime,
+                };
+
+                presentInfo.PNext = &presentTimesInfo;
+            }
+
             lock (_gd.QueueLock)
             {
                 _gd.SwapchainApi.QueuePresent(_gd.Queue, in presentInfo);
             }
 
+            _imagePresentIds[nextImage] = ++_presentCount;
+
             //While this does nothing in most cases, it's useful to notify the end of the frame.
             swapBuffersCallback?.Invoke();
         }
@@ -528,6 +850,34 @@ namespace Ryujinx.Graphics.Vulkan
             _swapchainIsDirty = true;
         }
 
+        private TextureView GetScaledTexture()
+        {
+            var info = new TextureCreateInfo(
+                _width,
+                _height,
+                1,
+                1,
+                1,
+                1,
+                1,
+                1,
+                FormatTable.GetFormat(_format),
+                DepthStencilMode.Depth,
+                Target.Texture2D,
+                SwizzleComponent.Red,
+                SwizzleComponent.Green,
+                SwizzleComponent.Blue,
+                SwizzleComponent.Alpha);
+
+            if (_scaledTexture == null || !_scaledTexture.Info.Equals(info))
+            {
+                _scaledTexture?.Dispose();
+                _scaledTexture = _gd.CreateTexture(info) as TextureView;
+            }
+
+            return _scaledTexture;
+        }
+
         private void UpdateEffect()
         {
             if (_updateEffect)
@@ -646,7 +996,8 @@ namespace Ryujinx.Graphics.Vulkan
         public override void SetSize(int width, int height)
         {
             // We don't need to use width and height as we can get the size from the surface.
-            _swapchainIsDirty = true;
+            // The new swapchain is built on a background thread while the current one keeps presenting.
+            _resizeRequested = true;
         }
 
         public override void ChangeVSyncMode(bool vsyncEnabled)
@@ -659,28 +1010,17 @@ namespace Ryujinx.Graphics.Vulkan
         {
             if (disposing)
             {
-                unsafe
+                if (_pendingSwapchain != null)
                 {
-                    for (int i = 0; i < _swapchainImageViews.Length; i++)
-                    {
-                        _swapchainImageViews[i].Dispose();
-                    }
-
-                    for (int i = 0; i < _imageAvailableSemaphores.Length; i++)
-                    {
-                        _gd.Api.DestroySemaphore(_device, _imageAvailableSemaphores[i], null);
-                    }
-
-                    for (int i = 0; i < _renderFinishedSemaphores.Length; i++)
-                    {
-                        _gd.Api.DestroySemaphore(_device, _renderFinishedSemaphores[i], null);
-                    }
-
-                    _gd.SwapchainApi.DestroySwapchain(_device, _swapchain, null);
+                    TryApplyPendingSwapchain(true);
                 }
 
+                RetireSwapchain();
+                DestroyRetiredSwapchains(true);
+
                 _effect?.Dispose();
                 _scalingFilter?.Dispose();
+                _scaledTexture?.Dispose();
             }
         }
 
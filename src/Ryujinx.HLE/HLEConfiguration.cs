@@ -132,6 +132,13 @@ namespace Ryujinx.HLE
         /// </summary>
         public MemoryManagerMode MemoryManagerMode { internal get; set; }
 
+        /// <summary>
+        /// Back the guest memory with huge pages where the host supports them.
+        /// This only has an effect with the host mapped memory manager modes.
+        /// </summary>
+        /// <remarks>This cannot be changed after <see cref="Switch"/> instantiation.</remarks>
+        public bool UseHugePages { internal get; set; }
+
         /// <summary>
         /// Control the initial state of the ignore missing services setting.
         /// If this is set to true, when a missing service is encountered, it will try to automatically handle it instead of throwing an exception.
@@ -10,6 +10,7 @@ using Ryujinx.HLE.HOS.Kernel;
 using Ryujinx.HLE.HOS.Kernel.Process;
 using Ryujinx.Memory;
 using System;
+using System.IO;
 using System.Runtime.InteropServices;
 
 namespace Ryujinx.HLE.HOS
@@ -44,11 +45,24 @@ namespace Ryujinx.HLE.HOS
             _codeSize = codeSize;
         }
 
-        public static NceCpuCodePatch CreateCodePatchForNce(KernelContext context, bool for64Bit, ReadOnlySpan<byte> textSection)
+        public static NceCpuCodePatch CreateCodePatchForNce(
+            KernelContext context,
+            bool for64Bit,
+            ReadOnlySpan<byte> textSection,
+            string titleIdText,
+            string buildId,
+            bool diskCacheEnabled)
         {
             if (RuntimeInformation.ProcessArchitecture == Architecture.Arm64 && for64Bit && context.Device.Configuration.UseHypervisor && !OperatingSystem.IsMacOS())
             {
-                return NcePatcher.CreatePatch(textSection);
+                string cacheFileName = null;
+
+                if (diskCacheEnabled && !string.IsNullOrEmpty(buildId))
+                {
+                    cacheFileName = Path.Combine(AppDataManager.GamesDirPath, titleIdText, "cache", "cpu", "nce", $"{buildId}.cache");
+                }
+
+                return NcePatcher.CreatePatch(textSection, cacheFileName);
             }
 
             return null;
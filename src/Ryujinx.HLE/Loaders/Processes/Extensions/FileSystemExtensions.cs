@@ -80,7 +80,7 @@ namespace Ryujinx.HLE.Loaders.Processes.Extensions
             nsoExecutables = nsoExecutables.Where(x => x != null).ToArray();
 
             // Apply Nsos patches.
-            device.Configuration.VirtualFileSystem.ModLoader.ApplyNsoPatches(programId, nsoExecutables);
+            bool nsosPatched = device.Configuration.VirtualFileSystem.ModLoader.ApplyNsoPatches(programId, nsoExecutables);
 
             // Don't use PTC if ExeFS files have been replaced.
             bool enablePtc = device.System.EnablePtc && !modLoadResult.Modified;
@@ -89,6 +89,9 @@ namespace Ryujinx.HLE.Loaders.Processes.Extensions
                 Logger.Warning?.Print(LogClass.Ptc, "Detected unsupported ExeFs modifications. PTC disabled.");
             }
 
+            // The NCE patch cache is keyed on the build ID, which mods and patches don't change.
+            bool codePatchCacheEnabled = enablePtc && !nsosPatched;
+
             string programName = "";
 
             if (!isHomebrew && programId > 0x010000000000FFFF)
@@ -116,6 +119,7 @@ namespace Ryujinx.HLE.Loaders.Processes.Extensions
                 metaLoader,
                 nacpData,
                 enablePtc,
+                codePatchCacheEnabled,
                 true,
                 programName,
                 metaLoader.GetProgramId(),
@@ -230,6 +230,7 @@ namespace Ryujinx.HLE.Loaders.Processes
                                                                        dummyExeFs.GetNpdm(),
                                                                        nacpData,
                                                                        diskCacheEnabled: false,
+                                                                       codePatchCacheEnabled: false,
                                                                        allowCodeMemoryForJit: true,
                                                                        programName,
                                                                        programId,
@@ -331,6 +332,7 @@ namespace Ryujinx.HLE.Loaders.Processes
                                                                        dummyExeFs.GetNpdm(),
                                                                        nacpData,
                                                                        diskCacheEnabled: false,
+                                                                       codePatchCacheEnabled: false,
                                                                        allowCodeMemoryForJit: true,
                                                                        programName,
                                                                        programId,
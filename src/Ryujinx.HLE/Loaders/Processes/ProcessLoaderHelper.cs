@@ -229,6 +229,7 @@ namespace Ryujinx.HLE.Loaders.Processes
             MetaLoader metaLoader,
             BlitStruct<ApplicationControlProperty> applicationControlProperties,
             bool diskCacheEnabled,
+            bool codePatchCacheEnabled,
             bool allowCodeMemoryForJit,
             string name,
             ulong programId,
@@ -259,7 +260,7 @@ namespace Ryujinx.HLE.Loaders.Processes
                 NsoExecutable nso => Convert.ToHexString(nso.BuildId.ItemsRo.ToArray()),
                 NroExecutable nro => Convert.ToHexString(nro.Header.BuildId),
                 _ => "",
-            }).ToUpper());
+            }).ToUpper()).ToArray();
 
             NceCpuCodePatch[] nsoPatch = new NceCpuCodePatch[executables.Length];
             ulong[] nsoBase = new ulong[executables.Length];
@@ -288,7 +289,7 @@ namespace Ryujinx.HLE.Loaders.Processes
 
                 bool for64Bit = ((ProcessCreationFlags)meta.Flags).HasFlag(ProcessCreationFlags.Is64Bit);
 
-                NceCpuCodePatch codePatch = ArmProcessContextFactory.CreateCodePatchForNce(context, for64Bit, nso.Text);
+                NceCpuCodePatch codePatch = ArmProcessContextFactory.CreateCodePatchForNce(context, for64Bit, nso.Text, $"{programId:x16}", buildIds[index], codePatchCacheEnabled);
                 nsoPatch[index] = codePatch;
 
                 if (codePatch != null)
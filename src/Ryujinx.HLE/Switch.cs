@@ -46,6 +46,11 @@ namespace Ryujinx.HLE
                 ? MemoryAllocationFlags.Reserve
                 : MemoryAllocationFlags.Reserve | MemoryAllocationFlags.Mirrorable;
 
+            if (configuration.UseHugePages && memoryAllocationFlags.HasFlag(MemoryAllocationFlags.Mirrorable))
+            {
+                memoryAllocationFlags |= MemoryAllocationFlags.HugePages;
+            }
+
 #pragma warning disable IDE0055 // Disable formatting
             AudioDeviceDriver = new CompatLayerHardwareDeviceDriver(Configuration.AudioDeviceDriver);
             Memory            = new MemoryBlock(Configuration.MemoryConfiguration.ToDramSize(), memoryAllocationFlags);
@@ -141,6 +141,9 @@ namespace Ryujinx.Headless.SDL2
         [Option("memory-manager-mode", Required = false, Default = MemoryManagerMode.HostMappedUnsafe, HelpText = "The selected memory manager mode.")]
         public MemoryManagerMode MemoryManagerMode { get; set; }
 
+        [Option("use-huge-pages", Required = false, Default = false, HelpText = "Back the guest memory with transparent huge pages where supported (Linux only).")]
+        public bool UseHugePages { get; set; }
+
         [Option("audio-volume", Required = false, Default = 1.0f, HelpText = "The audio level (0 to 1).")]
         public float AudioVolume { get; set; }
 
@@ -217,6 +220,9 @@ namespace Ryujinx.Headless.SDL2
         [Option("scaling-filter-level", Required = false, Default = 0, HelpText = "Set the scaling filter intensity (currently only applies to FSR). [0-100]")]
         public int ScalingFilterLevel { get; set; }
 
+        [Option("fsr-benchmark", Required = false, Default = false, HelpText = "Times the full and half precision FSR paths on every frame and logs the results on exit. Requires the Fsr scaling filter.")]
+        public bool FsrBenchmark { get; set; }
+
         // Hacks
 
         [Option("expand-ram", Required = false, Default = false, HelpText = "Expands the RAM amount on the emulated system from 4GiB to 8GiB.")]
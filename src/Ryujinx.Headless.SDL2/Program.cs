@@ -538,10 +538,16 @@ namespace Ryujinx.Headless.SDL2
                     api,
                     (instance, vk) => new SurfaceKHR((ulong)(vulkanWindow.CreateWindowSurface(instance.Handle))),
                     vulkanWindow.GetRequiredInstanceExtensions,
-                    preferredGpuId);
+                    preferredGpuId)
+                {
+                    FsrBenchmarkEnabled = options.FsrBenchmark,
+                };
             }
 
-            return new OpenGLRenderer();
+            return new OpenGLRenderer
+            {
+                FsrBenchmarkEnabled = options.FsrBenchmark,
+            };
         }
 
         private static Switch InitializeEmulationContext(WindowBase window, IRenderer renderer, Options options)
@@ -580,7 +586,10 @@ namespace Ryujinx.Headless.SDL2
                 options.AudioVolume,
                 options.UseHypervisor ?? true,
                 options.MultiplayerLanInterfaceId,
-                Common.Configuration.Multiplayer.MultiplayerMode.Disabled);
+                Common.Configuration.Multiplayer.MultiplayerMode.Disabled)
+            {
+                UseHugePages = options.UseHugePages,
+            };
 
             return new Switch(configuration);
         }
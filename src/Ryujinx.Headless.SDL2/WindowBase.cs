@@ -5,6 +5,7 @@ using Ryujinx.Graphics.GAL;
 using Ryujinx.Graphics.GAL.Multithreading;
 using Ryujinx.Graphics.Gpu;
 using Ryujinx.Graphics.OpenGL;
+using Ryujinx.Graphics.Vulkan;
 using Ryujinx.HLE.HOS.Applets;
 using Ryujinx.HLE.HOS.Services.Am.AppletOE.ApplicationProxyService.ApplicationProxy.Types;
 using Ryujinx.HLE.UI;
@@ -257,6 +258,25 @@ namespace Ryujinx.Headless.SDL2
             Renderer?.Window.SetScalingFilterLevel(ScalingFilterLevel);
         }
 
+        private void LogFsrBenchmarkStatistics()
+        {
+            FsrBenchmarkStatistics statistics = Renderer switch
+            {
+                VulkanRenderer vulkanRenderer when vulkanRenderer.FsrBenchmarkEnabled => vulkanRenderer.FsrBenchmarkStatistics,
+                OpenGLRenderer openGLRenderer when openGLRenderer.FsrBenchmarkEnabled => openGLRenderer.FsrBenchmarkStatistics,
+                _ => default,
+            };
+
+            if (statistics.Samples == 0)
+            {
+                return;
+            }
+
+            Logger.Info?.Print(LogClass.Gpu,
+                $"FSR benchmark: {statistics.Samples} frames, full precision {statistics.FullPrecisionMilliseconds:0.000} ms, " +
+                $"half precision {statistics.HalfPrecisionMilliseconds:0.000} ms, using {(statistics.IsHalfPrecision ? "half" : "full")} precision.");
+        }
+
         public void Render()
         {
             InitializeWindowRenderer();
@@ -326,6 +346,8 @@ namespace Ryujinx.Headless.SDL2
                     threaded.FlushThreadedCommands();
                 }
 
+                LogFsrBenchmarkStatistics();
+
                 _gpuDoneEvent.Set();
             });
 
@@ -48,5 +48,12 @@ namespace Ryujinx.Memory
         /// On some platforms, this requires special flags to be passed that will allow the memory to be executable.
         /// </summary>
         Jit = 1 << 5,
+
+        /// <summary>
+        /// Indicates that the memory should be backed by huge pages where the host supports them, or regular pages otherwise.
+        /// Ranges that are protected with a smaller granularity are split back into regular pages by the host.
+        /// This currently only has an effect on Linux, with transparent huge pages enabled.
+        /// </summary>
+        HugePages = 1 << 6,
     }
 }
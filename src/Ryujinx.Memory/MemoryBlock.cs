@@ -13,6 +13,7 @@ namespace Ryujinx.Memory
         private readonly bool _isMirror;
         private readonly bool _viewCompatible;
         private readonly bool _forJit;
+        private readonly bool _hugePages;
         private IntPtr _sharedMemory;
         private IntPtr _pointer;
 
@@ -26,6 +27,11 @@ namespace Ryujinx.Memory
         /// </summary>
         public ulong Size { get; }
 
+        /// <summary>
+        /// True if the memory block was created with the <see cref="MemoryAllocationFlags.HugePages"/> flag.
+        /// </summary>
+        public bool HugePages => _hugePages;
+
         /// <summary>
         /// Creates a new instance of the memory block class.
         /// </summary>
@@ -35,13 +41,15 @@ namespace Ryujinx.Memory
         /// <exception cref="PlatformNotSupportedException">Throw when the current platform is not supported</exception>
         public MemoryBlock(ulong size, MemoryAllocationFlags flags = MemoryAllocationFlags.None)
         {
+            _hugePages = flags.HasFlag(MemoryAllocationFlags.HugePages);
+
             if (flags.HasFlag(MemoryAllocationFlags.Mirrorable))
             {
-                _sharedMemory = MemoryManagement.CreateSharedMemory(size, flags.HasFlag(MemoryAllocationFlags.Reserve));
+                _sharedMemory = MemoryManagement.CreateSharedMemory(size, flags.HasFlag(MemoryAllocationFlags.Reserve), _hugePages);
 
                 if (!flags.HasFlag(MemoryAllocationFlags.NoMap))
                 {
-                    _pointer = MemoryManagement.MapSharedMemory(_sharedMemory, size);
+                    _pointer = MemoryManagement.MapSharedMemory(_sharedMemory, size, _hugePages);
                 }
 
                 _usesSharedMemory = true;
@@ -50,7 +58,7 @@ namespace Ryujinx.Memory
             {
                 _viewCompatible = flags.HasFlag(MemoryAllocationFlags.ViewCompatible);
                 _forJit = flags.HasFlag(MemoryAllocationFlags.Jit);
-                _pointer = MemoryManagement.Reserve(size, _forJit, _viewCompatible);
+                _pointer = MemoryManagement.Reserve(size, _forJit, _viewCompatible, _hugePages);
             }
             else
             {
@@ -66,11 +74,13 @@ namespace Ryujinx.Memory
         /// </summary>
         /// <param name="size">Size of the memory block in bytes</param>
         /// <param name="sharedMemory">Shared memory to use as backing storage for this block</param>
+        /// <param name="hugePages">True if the shared memory should be mapped with huge pages where supported</param>
         /// <exception cref="SystemException">Throw when there's an error while mapping the shared memory</exception>
         /// <exception cref="PlatformNotSupportedException">Throw when the current platform is not supported</exception>
-        private MemoryBlock(ulong size, IntPtr sharedMemory)
+        private MemoryBlock(ulong size, IntPtr sharedMemory, bool hugePages)
         {
-            _pointer = MemoryManagement.MapSharedMemory(sharedMemory, size);
+            _hugePages = hugePages;
+            _pointer = MemoryManagement.MapSharedMemory(sharedMemory, size, hugePages);
             Size = size;
             _usesSharedMemory = true;
             _isMirror = true;
@@ -91,7 +101,7 @@ namespace Ryujinx.Memory
                 throw new NotSupportedException("Mirroring is not supported on the memory block because the Mirrorable flag was not set.");
             }
 
-            return new MemoryBlock(Size, _sharedMemory);
+            return new MemoryBlock(Size, _sharedMemory, _hugePages);
         }
 
         /// <summary>
@@ -139,7 +149,7 @@ namespace Ryujinx.Memory
                 throw new ArgumentException("The source memory block is not mirrorable, and thus cannot be mapped on the current block.");
             }
 
-            MemoryManagement.MapView(srcBlock._sharedMemory, srcOffset, GetPointerInternal(dstOffset, size), size, this);
+            MemoryManagement.MapView(srcBlock._sharedMemory, srcOffset, GetPointerInternal(dstOffset, size), size, this, _hugePages);
         }
 
         /// <summary>
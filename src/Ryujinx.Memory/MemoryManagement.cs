@@ -20,7 +20,7 @@ namespace Ryujinx.Memory
             }
         }
 
-        public static IntPtr Reserve(ulong size, bool forJit, bool viewCompatible)
+        public static IntPtr Reserve(ulong size, bool forJit, bool viewCompatible, bool hugePages)
         {
             if (OperatingSystem.IsWindows())
             {
@@ -28,7 +28,7 @@ namespace Ryujinx.Memory
             }
             else if (OperatingSystem.IsLinux() || OperatingSystem.IsMacOS() || OperatingSystem.IsIOS() || Ryujinx.Common.PlatformInfo.IsBionic)
             {
-                return MemoryManagementUnix.Reserve(size, forJit);
+                return MemoryManagementUnix.Reserve(size, forJit, hugePages);
             }
             else
             {
@@ -68,7 +68,7 @@ namespace Ryujinx.Memory
             }
         }
 
-        public static void MapView(IntPtr sharedMemory, ulong srcOffset, IntPtr address, ulong size, MemoryBlock owner)
+        public static void MapView(IntPtr sharedMemory, ulong srcOffset, IntPtr address, ulong size, MemoryBlock owner, bool hugePages)
         {
             if (OperatingSystem.IsWindows())
             {
@@ -76,7 +76,7 @@ namespace Ryujinx.Memory
             }
             else if (OperatingSystem.IsLinux() || OperatingSystem.IsMacOS() || OperatingSystem.IsIOS() || Ryujinx.Common.PlatformInfo.IsBionic)
             {
-                MemoryManagementUnix.MapView(sharedMemory, srcOffset, address, size);
+                MemoryManagementUnix.MapView(sharedMemory, srcOffset, address, size, hugePages);
             }
             else
             {
@@ -139,7 +139,7 @@ namespace Ryujinx.Memory
             }
         }
 
-        public static IntPtr CreateSharedMemory(ulong size, bool reserve)
+        public static IntPtr CreateSharedMemory(ulong size, bool reserve, bool hugePages)
         {
             if (OperatingSystem.IsWindows())
             {
@@ -147,7 +147,7 @@ namespace Ryujinx.Memory
             }
             else if (OperatingSystem.IsLinux() || OperatingSystem.IsMacOS() || OperatingSystem.IsIOS() || Ryujinx.Common.PlatformInfo.IsBionic)
             {
-                return MemoryManagementUnix.CreateSharedMemory(size, reserve);
+                return MemoryManagementUnix.CreateSharedMemory(size, reserve, hugePages);
             }
             else
             {
@@ -171,7 +171,7 @@ namespace Ryujinx.Memory
             }
         }
 
-        public static IntPtr MapSharedMemory(IntPtr handle, ulong size)
+        public static IntPtr MapSharedMemory(IntPtr handle, ulong size, bool hugePages)
         {
             if (OperatingSystem.IsWindows())
             {
@@ -179,7 +179,7 @@ namespace Ryujinx.Memory
             }
             else if (OperatingSystem.IsLinux() || OperatingSystem.IsMacOS() || OperatingSystem.IsIOS() || Ryujinx.Common.PlatformInfo.IsBionic)
             {
-                return MemoryManagementUnix.MapSharedMemory(handle, size);
+                return MemoryManagementUnix.MapSharedMemory(handle, size, hugePages);
             }
             else
             {
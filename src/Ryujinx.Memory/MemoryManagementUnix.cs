@@ -1,3 +1,4 @@
+using Ryujinx.Common;
 using Ryujinx.Common.Logging;
 using System;
 using System.Collections.Concurrent;
@@ -13,6 +14,8 @@ namespace Ryujinx.Memory
     [SupportedOSPlatform("android")]
     static class MemoryManagementUnix
     {
+        private const ulong HugePageSize = 0x200000;
+
         private static readonly ConcurrentDictionary<IntPtr, ulong> _allocations = new();
 
         public static IntPtr Allocate(ulong size, bool forJit)
@@ -20,12 +23,15 @@ namespace Ryujinx.Memory
             return AllocateInternal(size, MmapProts.PROT_READ | MmapProts.PROT_WRITE, forJit, false);
         }
 
-        public static IntPtr Reserve(ulong size, bool forJit)
+        public static IntPtr Reserve(ulong size, bool forJit, bool hugePages)
         {
-            return AllocateInternal(size, MmapProts.PROT_NONE, forJit, false);
+            // Views can only be mapped with huge pages if they are aligned to the huge page size on the address space.
+            ulong alignment = UseHugePages(hugePages) ? HugePageSize : 0;
+
+            return AllocateInternal(size, MmapProts.PROT_NONE, forJit, false, alignment);
         }
 
-        private static IntPtr AllocateInternal(ulong size, MmapProts prot, bool forJit, bool shared)
+        private static IntPtr AllocateInternal(ulong size, MmapProts prot, bool forJit, bool shared, ulong alignment = 0)
         {
             MmapFlags flags = MmapFlags.MAP_ANONYMOUS;
 
@@ -53,7 +59,7 @@ namespace Ryujinx.Memory
                 }
             }
 
-            IntPtr ptr = Mmap(IntPtr.Zero, size, prot, flags, -1, 0);
+            IntPtr ptr = alignment != 0 ? MmapAligned(size, prot, flags, alignment) : Mmap(IntPtr.Zero, size, prot, flags, -1, 0);
 
             if (ptr == MAP_FAILED)
             {
@@ -69,6 +75,45 @@ namespace Ryujinx.Memory
             return ptr;
         }
 
+        private static IntPtr MmapAligned(ulong size, MmapProts prot, MmapFlags flags, ulong alignment)
+        {
+            // Map more than needed, then unmap the excess on both sides of the aligned range.
+            IntPtr ptr = Mmap(IntPtr.Zero, size + alignment, prot, flags, -1, 0);
+
+            if (ptr == MAP_FAILED)
+            {
+                return ptr;
+            }
+
+            ulong start = (ulong)ptr;
+            ulong end = start + size + alignment;
+            ulong alignedStart = BitUtils.AlignUp(start, alignment);
+            ulong alignedEnd = alignedStart + size;
+
+            if (alignedStart != start)
+            {
+                munmap(ptr, alignedStart - start);
+            }
+
+            if (alignedEnd != end)
+            {
+                munmap((IntPtr)alignedEnd, end - alignedEnd);
+            }
+
+            return (IntPtr)alignedStart;
+        }
+
+        private static bool UseHugePages(bool hugePages)
+        {
+            return hugePages && OperatingSystem.IsLinux();
+        }
+
+        private static void AdviseHugePages(IntPtr address, ulong size)
+        {
+            // This fails if transparent huge pages are disabled, in which case regular pages are used.
+            madvise(address, size, MADV_HUGEPAGE);
+        }
+
         public static void Commit(IntPtr address, ulong size, bool forJit)
         {
             MmapProts prot = MmapProts.PROT_READ | MmapProts.PROT_WRITE;
@@ -92,7 +137,9 @@ namespace Ryujinx.Memory
                 throw new SystemException(Marshal.GetLastPInvokeErrorMessage());
             }
 
-            if (madvise(address, size, MADV_REMOVE) != 0)
+            // MADV_REMOVE is only supported on shared mappings, private ones such as the JIT cache are discarded with
+            // MADV_DONTNEED instead.
+            if (madvise(address, size, MADV_REMOVE) != 0 && madvise(address, size, MADV_DONTNEED) != 0)
             {
                 throw new SystemException(Marshal.GetLastPInvokeErrorMessage());
             }
@@ -137,7 +184,7 @@ namespace Ryujinx.Memory
             return munmap(address, size) == 0;
         }
 
-        public unsafe static IntPtr CreateSharedMemory(ulong size, bool reserve)
+        public unsafe static IntPtr CreateSharedMemory(ulong size, bool reserve, bool hugePages)
         {
             int fd;
             Logger.Debug?.Print(LogClass.Cpu, $"Operating System: {RuntimeInformation.OSDescription}");
@@ -180,19 +227,26 @@ namespace Ryujinx.Memory
             }
             else
             {
-                byte[] fileName = "/dev/shm/Ryujinx-XXXXXX"u8.ToArray();
+                // Files on /dev/shm only use huge pages if it is mounted with the huge option, unlike anonymous memory
+                // files, that follow the transparent huge pages setting for shared memory.
+                fd = UseHugePages(hugePages) ? CreateMemoryFile() : -1;
 
-                fixed (byte* pFileName = fileName)
+                if (fd == -1)
                 {
-                    fd = mkstemp((IntPtr)pFileName);
-                    if (fd == -1)
-                    {
-                        throw new SystemException(Marshal.GetLastPInvokeErrorMessage());
-                    }
+                    byte[] fileName = "/dev/shm/Ryujinx-XXXXXX"u8.ToArray();
 
-                    if (unlink((IntPtr)pFileName) != 0)
+                    fixed (byte* pFileName = fileName)
                     {
-                        throw new SystemException(Marshal.GetLastPInvokeErrorMessage());
+                        fd = mkstemp((IntPtr)pFileName);
+                        if (fd == -1)
+                        {
+                            throw new SystemException(Marshal.GetLastPInvokeErrorMessage());
+                        }
+
+                        if (unlink((IntPtr)pFileName) != 0)
+                        {
+                            throw new SystemException(Marshal.GetLastPInvokeErrorMessage());
+                        }
                     }
                 }
             }
@@ -205,14 +259,44 @@ namespace Ryujinx.Memory
             return fd;
         }
 
+        private unsafe static int CreateMemoryFile()
+        {
+            byte[] memName = "Ryujinx\0"u8.ToArray();
+
+            fixed (byte* pMemName = memName)
+            {
+                return memfd_create((IntPtr)pMemName, 0);
+            }
+        }
+
         public static void DestroySharedMemory(IntPtr handle)
         {
             close(handle.ToInt32());
         }
 
-        public static IntPtr MapSharedMemory(IntPtr handle, ulong size)
+        public static IntPtr MapSharedMemory(IntPtr handle, ulong size, bool hugePages)
         {
-            return Mmap(IntPtr.Zero, size, MmapProts.PROT_READ | MmapProts.PROT_WRITE, MmapFlags.MAP_SHARED, handle.ToInt32(), 0);
+            if (!UseHugePages(hugePages))
+            {
+                return Mmap(IntPtr.Zero, size, MmapProts.PROT_READ | MmapProts.PROT_WRITE, MmapFlags.MAP_SHARED, handle.ToInt32(), 0);
+            }
+
+            // The file offsets are aligned to the huge page size, so the mapping must be as well.
+            IntPtr ptr = MmapAligned(size, MmapProts.PROT_NONE, MmapFlags.MAP_PRIVATE | MmapFlags.MAP_ANONYMOUS | MmapFlags.MAP_NORESERVE, HugePageSize);
+
+            if (ptr == MAP_FAILED)
+            {
+                return ptr;
+            }
+
+            ptr = Mmap(ptr, size, MmapProts.PROT_READ | MmapProts.PROT_WRITE, MmapFlags.MAP_FIXED | MmapFlags.MAP_SHARED, handle.ToInt32(), 0);
+
+            if (ptr != MAP_FAILED)
+            {
+                AdviseHugePages(ptr, size);
+            }
+
+            return ptr;
         }
 
         public static void UnmapSharedMemory(IntPtr address, ulong size)
@@ -220,9 +304,15 @@ namespace Ryujinx.Memory
             munmap(address, size);
         }
 
-        public static void MapView(IntPtr sharedMemory, ulong srcOffset, IntPtr location, ulong size)
+        public static void MapView(IntPtr sharedMemory, ulong srcOffset, IntPtr location, ulong size, bool hugePages)
         {
             Mmap(location, size, MmapProts.PROT_READ | MmapProts.PROT_WRITE, MmapFlags.MAP_FIXED | MmapFlags.MAP_SHARED, sharedMemory.ToInt32(), (long)srcOffset);
+
+            // Each view is a new mapping, that does not inherit the advice given to the reserved range.
+            if (UseHugePages(hugePages))
+            {
+                AdviseHugePages(location, size);
+            }
         }
 
         public static void UnmapView(IntPtr location, ulong size)
@@ -56,6 +56,7 @@ namespace Ryujinx.Memory
 
         public const int MADV_DONTNEED = 4;
         public const int MADV_REMOVE = 9;
+        public const int MADV_HUGEPAGE = 14;
 
         [LibraryImport("libc", EntryPoint = "mmap", SetLastError = true)]
         private static partial IntPtr Internal_mmap(IntPtr address, ulong length, MmapProts prot, int flags, int fd, long offset);
@@ -78,6 +79,9 @@ namespace Ryujinx.Memory
         [LibraryImport("libc", SetLastError = true)]
         public static partial int unlink(IntPtr pathname);
 
+        [LibraryImport("libc", SetLastError = true)]
+        public static partial int memfd_create(IntPtr name, uint flags);
+
         [LibraryImport("libc", SetLastError = true)]
         public static partial int ftruncate(int fildes, IntPtr length);
 
@@ -1,4 +1,4 @@
-using Ryujinx.Common.Collections;
+using System;
 using System.Collections;
 using System.Collections.Generic;
 
@@ -6,7 +6,11 @@ namespace Ryujinx.Memory.Range
 {
     public class MultiRangeList<T> : IEnumerable<T> where T : IMultiRangeItem
     {
-        private readonly IntervalTree<ulong, T> _items;
+        private const int BackingInitialSize = 1024;
+        private const int ArrayGrowthSize = 32;
+
+        // Each valid sub-range of an item is added to the index separately.
+        private readonly RangeIndex<T> _items;
 
         public int Count { get; private set; }
 
@@ -15,7 +19,7 @@ namespace Ryujinx.Memory.Range
         /// </summary>
         public MultiRangeList()
         {
-            _items = new IntervalTree<ulong, T>();
+            _items = new RangeIndex<T>(BackingInitialSize);
         }
 
         /// <summary>
@@ -35,7 +39,7 @@ namespace Ryujinx.Memory.Range
                     continue;
                 }
 
-                _items.Add(subrange.Address, subrange.EndAddress, item);
+                _items.Insert(subrange.Address, subrange.EndAddress, item);
             }
 
             Count++;
@@ -61,7 +65,13 @@ namespace Ryujinx.Memory.Range
                     continue;
                 }
 
-                removed += _items.Remove(subrange.Address, item);
+                int index = _items.IndexOf(subrange.Address, item);
+
+                if (index >= 0)
+                {
+                    _items.RemoveAt(index);
+                    removed++;
+                }
             }
 
             if (removed > 0)
@@ -104,7 +114,7 @@ namespace Ryujinx.Memory.Range
                     continue;
                 }
 
-                overlapCount = _items.Get(subrange.Address, subrange.EndAddress, ref output, overlapCount);
+                overlapCount = _items.FindOverlaps(subrange.Address, subrange.EndAddress, ref output, overlapCount);
             }
 
             // Remove any duplicates, caused by items having multiple sub range nodes in the tree.
@@ -150,36 +160,38 @@ namespace Ryujinx.Memory.Range
         /// <returns>The number of matches found</returns>
         public int FindOverlaps(ulong baseAddress, ref T[] output)
         {
-            int count = _items.Get(baseAddress, ref output);
+            int outputIndex = 0;
 
             // Only output items with matching base address
-            int insertPtr = 0;
-            for (int i = 0; i < count; i++)
+            for (int index = _items.LowerBound(baseAddress); index < _items.Count && _items.GetStart(index) == baseAddress; index++)
             {
-                if (output[i].BaseAddress == baseAddress)
+                T item = _items.GetValue(index);
+
+                if (item.BaseAddress == baseAddress)
                 {
-                    if (i != insertPtr)
+                    if (outputIndex == output.Length)
                     {
-                        output[insertPtr] = output[i];
+                        Array.Resize(ref output, outputIndex + ArrayGrowthSize);
                     }
 
-                    insertPtr++;
+                    output[outputIndex++] = item;
                 }
             }
 
-            return insertPtr;
+            return outputIndex;
         }
 
         private List<T> GetList()
         {
-            var items = _items.AsList();
             var result = new List<T>();
 
-            foreach (RangeNode<ulong, T> item in items)
+            for (int index = 0; index < _items.Count; index++)
             {
-                if (item.Start == item.Value.BaseAddress)
+                T item = _items.GetValue(index);
+
+                if (_items.GetStart(index) == item.BaseAddress)
                 {
-                    result.Add(item.Value);
+                    result.Add(item);
                 }
             }
 
@@ -0,0 +1,453 @@
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+
+namespace Ryujinx.Memory.Range
+{
+    /// <summary>
+    /// Index of ranges sorted by start address, with the start and end addresses stored on separate arrays
+    /// so that searches only touch the addresses, and can compare several of them at once.
+    /// </summary>
+    /// <remarks>
+    /// Ranges may overlap each other. To avoid scanning the whole list for ranges that start early but end late,
+    /// a running maximum of the end addresses is kept. It is updated by the methods that modify the index,
+    /// so that queries never write any state and can run concurrently with each other.
+    /// </remarks>
+    /// <typeparam name="T">Type of the value associated with each range</typeparam>
+    internal sealed class RangeIndex<T>
+    {
+        private const int ArrayGrowthSize = 32;
+
+        // Size of the window left by the binary search, that is then searched with vector compares.
+        private const int SearchWindowSize = 16;
+
+        private ulong[] _starts;
+        private ulong[] _ends;
+        private ulong[] _maxEnds;
+        private T[] _values;
+
+        private readonly int _backingGrowthSize;
+
+        public int Count { get; private set; }
+
+        /// <summary>
+        /// Creates a new range index.
+        /// </summary>
+        /// <param name="backingInitialSize">The initial size of the backing arrays, also used as the growth size</param>
+        public RangeIndex(int backingInitialSize)
+        {
+            _backingGrowthSize = backingInitialSize;
+            _starts = new ulong[backingInitialSize];
+            _ends = new ulong[backingInitialSize];
+            _maxEnds = new ulong[backingInitialSize];
+            _values = new T[backingInitialSize];
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public ulong GetStart(int index)
+        {
+            return _starts[index];
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public T GetValue(int index)
+        {
+            return _values[index];
+        }
+
+        /// <summary>
+        /// Inserts a new range after all the ranges with the same or a lower start address.
+        /// </summary>
+        /// <param name="start">Start address of the range</param>
+        /// <param name="end">End address of the range</param>
+        /// <param name="value">Value associated with the range</param>
+        public void Insert(ulong start, ulong end, T value)
+        {
+            int index = start == ulong.MaxValue ? Count : LowerBound(_starts, Count, start + 1);
+
+            if (Count == _starts.Length)
+            {
+                int newSize = _starts.Length + _backingGrowthSize;
+
+                Array.Resize(ref _starts, newSize);
+                Array.Resize(ref _ends, newSize);
+                Array.Resize(ref _maxEnds, newSize);
+                Array.Resize(ref _values, newSize);
+            }
+
+            if (index < Count)
+            {
+                Array.Copy(_starts, index, _starts, index + 1, Count - index);
+                Array.Copy(_ends, index, _ends, index + 1, Count - index);
+                Array.Copy(_maxEnds, index, _maxEnds, index + 1, Count - index);
+                Array.Copy(_values, index, _values, index + 1, Count - index);
+            }
+
+            _starts[index] = start;
+            _ends[index] = end;
+            _values[index] = value;
+
+            Count++;
+
+            // The maximum moved to the index is the one of the next range, so it must always be written.
+            UpdateMaxEnds(index, index + 1);
+        }
+
+        /// <summary>
+        /// Changes the end address of a range.
+        /// </summary>
+        /// <param name="index">Index of the range</param>
+        /// <param name="end">New end address</param>
+        public void SetEnd(int index, ulong end)
+        {
+            _ends[index] = end;
+
+            UpdateMaxEnds(index, index);
+        }
+
+        /// <summary>
+        /// Removes a range.
+        /// </summary>
+        /// <param name="index">Index of the range</param>
+        public void RemoveAt(int index)
+        {
+            if (index < --Count)
+            {
+                Array.Copy(_starts, index + 1, _starts, index, Count - index);
+                Array.Copy(_ends, index + 1, _ends, index, Count - index);
+                Array.Copy(_maxEnds, index + 1, _maxEnds, index, Count - index);
+                Array.Copy(_values, index + 1, _values, index, Count - index);
+            }
+
+            _values[Count] = default;
+
+            UpdateMaxEnds(index, index);
+        }
+
+        /// <summary>
+        /// Removes several ranges, moving the remaining ones only once.
+        /// </summary>
+        /// <param name="indices">Indices of the ranges, sorted in ascending order. Repeated indices are ignored</param>
+        /// <returns>The number of ranges removed</returns>
+        public int RemoveSorted(ReadOnlySpan<int> indices)
+        {
+            if (indices.IsEmpty)
+            {
+                return 0;
+            }
+
+            int writeIndex = indices[0];
+            int removed = 0;
+
+            for (int i = 0; i < indices.Length; i++)
+            {
+                int next = i + 1;
+
+                while (next < indices.Length && indices[next] == indices[i])
+                {
+                    next++;
+                }
+
+                removed++;
+
+                // Move the entries between this removed index and the next one.
+                int readIndex = indices[i] + 1;
+                int readEnd = next < indices.Length ? indices[next] : Count;
+                int length = readEnd - readIndex;
+
+                if (length > 0)
+                {
+                    Array.Copy(_starts, readIndex, _starts, writeIndex, length);
+                    Array.Copy(_ends, readIndex, _ends, writeIndex, length);
+                    Array.Copy(_maxEnds, readIndex, _maxEnds, writeIndex, length);
+                    Array.Copy(_values, readIndex, _values, writeIndex, length);
+
+                    writeIndex += length;
+                }
+
+                i = next - 1;
+            }
+
+            Array.Clear(_values, writeIndex, Count - writeIndex);
+
+            Count = writeIndex;
+
+            // The moved maximums before the last removed range may include any of the removed ranges.
+            UpdateMaxEnds(indices[0], indices[^1] - removed + 1);
+
+            return removed;
+        }
+
+        /// <summary>
+        /// Removes all the ranges after the given count.
+        /// </summary>
+        /// <param name="count">Number of ranges to keep</param>
+        public void Truncate(int count)
+        {
+            if (count < Count)
+            {
+                Array.Clear(_values, count, Count - count);
+            }
+
+            Count = count;
+        }
+
+        /// <summary>
+        /// Gets the index of a range with the given start address and value.
+        /// </summary>
+        /// <param name="start">Start address of the range</param>
+        /// <param name="value">Value associated with the range</param>
+        /// <returns>The index of the range, or -1 if not found</returns>
+        public int IndexOf(ulong start, T value)
+        {
+            for (int index = LowerBound(start); index < Count && _starts[index] == start; index++)
+            {
+                if (EqualityComparer<T>.Default.Equals(_values[index], value))
+                {
+                    return index;
+                }
+            }
+
+            return -1;
+        }
+
+        /// <summary>
+        /// Gets the index of the first range with a start address greater than or equal to the given address.
+        /// </summary>
+        /// <param name="address">Address to search</param>
+        /// <returns>Index of the range, or the count if there is none</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public int LowerBound(ulong address)
+        {
+            return LowerBound(_starts, Count, address);
+        }
+
+        /// <summary>
+        /// Gets the last range starting before the end of a memory range, if it overlaps it.
+        /// </summary>
+        /// <remarks>
+        /// When ranges do not overlap each other, this is the only range that can overlap the memory range
+        /// while ending after its end address.
+        /// </remarks>
+        /// <param name="address">Start address of the memory range</param>
+        /// <param name="endAddress">End address of the memory range</param>
+        /// <returns>Index of the overlapping range, or -1 if it does not overlap</returns>
+        public int FindLastOverlap(ulong address, ulong endAddress)
+        {
+            int last = LowerBound(_starts, Count, endAddress) - 1;
+
+            return last >= 0 && _ends[last] > address ? last : -1;
+        }
+
+        /// <summary>
+        /// Gets all values of ranges overlapping a memory range, assuming that ranges do not overlap each other.
+        /// </summary>
+        /// <param name="address">Start address of the memory range</param>
+        /// <param name="endAddress">End address of the memory range</param>
+        /// <param name="output">Output array where matches will be written. It is automatically resized to fit the results</param>
+        /// <returns>The number of overlapping values found</returns>
+        public int FindOverlapsNonOverlapping(ulong address, ulong endAddress, ref T[] output)
+        {
+            int last = LowerBound(_starts, Count, endAddress);
+            int first = last;
+
+            // Without overlaps between ranges, the overlapping ranges are contiguous and end at the last one.
+            while (first > 0 && _ends[first - 1] > address)
+            {
+                first--;
+            }
+
+            int count = last - first;
+
+            if (count > output.Length)
+            {
+                Array.Resize(ref output, count + ArrayGrowthSize);
+            }
+
+            Array.Copy(_values, first, output, 0, count);
+
+            return count;
+        }
+
+        /// <summary>
+        /// Gets all values of ranges overlapping a memory range.
+        /// </summary>
+        /// <param name="address">Start address of the memory range</param>
+        /// <param name="endAddress">End address of the memory range</param>
+        /// <param name="output">Output array where matches will be written. It is automatically resized to fit the results</param>
+        /// <param name="outputIndex">Index to start writing results into the array</param>
+        /// <returns>The total number of values on the output array</returns>
+        public int FindOverlaps(ulong address, ulong endAddress, ref T[] output, int outputIndex = 0)
+        {
+            int last = LowerBound(_starts, Count, endAddress);
+
+            if (last == 0)
+            {
+                return outputIndex;
+            }
+
+            // Every range before the first with a maximum end address above the start address ends before it.
+            int index = address == ulong.MaxValue ? last : LowerBound(_maxEnds, last, address + 1);
+
+            ref ulong ends = ref MemoryMarshal.GetArrayDataReference(_ends);
+
+            if (Vector256.IsHardwareAccelerated)
+            {
+                Vector256<ulong> addressVec = Vector256.Create(address);
+
+                for (; index + Vector256<ulong>.Count <= last; index += Vector256<ulong>.Count)
+                {
+                    uint mask = Vector256.GreaterThan(Vector256.LoadUnsafe(ref ends, (nuint)index), addressVec).ExtractMostSignificantBits();
+
+                    outputIndex = AddMatches(mask, index, ref output, outputIndex);
+                }
+            }
+            else if (Vector128.IsHardwareAccelerated)
+            {
+                Vector128<ulong> addressVec = Vector128.Create(address);
+
+                for (; index + Vector128<ulong>.Count <= last; index += Vector128<ulong>.Count)
+                {
+                    uint mask = Vector128.GreaterThan(Vector128.LoadUnsafe(ref ends, (nuint)index), addressVec).ExtractMostSignificantBits();
+
+                    outputIndex = AddMatches(mask, index, ref output, outputIndex);
+                }
+            }
+
+            for (; index < last; index++)
+            {
+                if (_ends[index] > address)
+                {
+                    outputIndex = AddMatch(index, ref output, outputIndex);
+                }
+            }
+
+            return outputIndex;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private int AddMatches(uint mask, int baseIndex, ref T[] output, int outputIndex)
+        {
+            while (mask != 0)
+            {
+                outputIndex = AddMatch(baseIndex + BitOperations.TrailingZeroCount(mask), ref output, outputIndex);
+
+                mask &= mask - 1;
+            }
+
+            return outputIndex;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private int AddMatch(int index, ref T[] output, int outputIndex)
+        {
+            if (outputIndex == output.Length)
+            {
+                Array.Resize(ref output, outputIndex + ArrayGrowthSize);
+            }
+
+            output[outputIndex] = _values[index];
+
+            return outputIndex + 1;
+        }
+
+        /// <summary>
+        /// Updates the running maximum of the end addresses, after the ranges from the given index were modified.
+        /// </summary>
+        /// <remarks>
+        /// The maximums are stored as they were before the modification. Past the modified ranges, the update
+        /// stops at the first maximum that is unchanged, as all the following ones are then unchanged too.
+        /// </remarks>
+        /// <param name="index">Index of the first modified range</param>
+        /// <param name="unchangedIndex">Index from which ranges were not modified, and the update may stop</param>
+        private void UpdateMaxEnds(int index, int unchangedIndex)
+        {
+            ulong maxEnd = index > 0 ? _maxEnds[index - 1] : 0;
+
+            for (; index < Count; index++)
+            {
+                maxEnd = Math.Max(maxEnd, _ends[index]);
+
+                if (index >= unchangedIndex && _maxEnds[index] == maxEnd)
+                {
+                    break;
+                }
+
+                _maxEnds[index] = maxEnd;
+            }
+        }
+
+        /// <summary>
+        /// Gets the index of the first key greater than or equal to a value, on a sorted array.
+        /// </summary>
+        /// <remarks>
+        /// A binary search narrows the search to a small window, which is then searched with vector compares,
+        /// avoiding the least predictable branches of the binary search.
+        /// </remarks>
+        /// <param name="keys">Sorted keys</param>
+        /// <param name="count">Number of keys on the array</param>
+        /// <param name="value">Value to search</param>
+        /// <returns>Index of the first key greater than or equal to the value, or the count if there is none</returns>
+        private static int LowerBound(ulong[] keys, int count, ulong value)
+        {
+            int left = 0;
+            int right = count;
+
+            while (right - left > SearchWindowSize)
+            {
+                int middle = left + ((right - left) >> 1);
+
+                if (keys[middle] < value)
+                {
+                    left = middle + 1;
+                }
+                else
+                {
+                    right = middle;
+                }
+            }
+
+            ref ulong keysRef = ref MemoryMarshal.GetArrayDataReference(keys);
+
+            // The keys are sorted, so the keys lower than the value are always the first lanes.
+            if (Vector256.IsHardwareAccelerated)
+            {
+                Vector256<ulong> valueVec = Vector256.Create(value);
+
+                for (; left + Vector256<ulong>.Count <= right; left += Vector256<ulong>.Count)
+                {
+                    uint mask = Vector256.LessThan(Vector256.LoadUnsafe(ref keysRef, (nuint)left), valueVec).ExtractMostSignificantBits();
+
+                    if (mask != (1u << Vector256<ulong>.Count) - 1)
+                    {
+                        return left + BitOperations.PopCount(mask);
+                    }
+                }
+            }
+            else if (Vector128.IsHardwareAccelerated)
+            {
+                Vector128<ulong> valueVec = Vector128.Create(value);
+
+                for (; left + Vector128<ulong>.Count <= right; left += Vector128<ulong>.Count)
+                {
+                    uint mask = Vector128.LessThan(Vector128.LoadUnsafe(ref keysRef, (nuint)left), valueVec).ExtractMostSignificantBits();
+
+                    if (mask != (1u << Vector128<ulong>.Count) - 1)
+                    {
+                        return left + BitOperations.PopCount(mask);
+                    }
+                }
+            }
+
+            while (left < right && keys[left] < value)
+            {
+                left++;
+            }
+
+            return left;
+        }
+    }
+}
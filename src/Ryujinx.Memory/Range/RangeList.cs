@@ -1,7 +1,6 @@
 using System;
 using System.Collections;
 using System.Collections.Generic;
-using System.Runtime.CompilerServices;
 
 namespace Ryujinx.Memory.Range
 {
@@ -11,35 +10,19 @@ namespace Ryujinx.Memory.Range
     /// <typeparam name="T">Type of the range.</typeparam>
     public class RangeList<T> : IEnumerable<T> where T : IRange
     {
-        private readonly struct RangeItem<TValue> where TValue : IRange
-        {
-            public readonly ulong Address;
-            public readonly ulong EndAddress;
-
-            public readonly TValue Value;
-
-            public RangeItem(TValue value)
-            {
-                Value = value;
-
-                Address = value.Address;
-                EndAddress = value.Address + value.Size;
-            }
-
-            [MethodImpl(MethodImplOptions.AggressiveInlining)]
-            public bool OverlapsWith(ulong address, ulong endAddress)
-            {
-                return Address < endAddress && address < EndAddress;
-            }
-        }
-
         private const int BackingInitialSize = 1024;
         private const int ArrayGrowthSize = 32;
 
-        private RangeItem<T>[] _items;
-        private readonly int _backingGrowthSize;
+        // Removals of up to this many items search their indices without allocating.
+        private const int StackallocThreshold = 64;
 
-        public int Count { get; protected set; }
+        private readonly RangeIndex<T> _index;
+
+        public int Count
+        {
+            get => _index.Count;
+            protected set => _index.Truncate(value);
+        }
 
         /// <summary>
         /// Creates a new range list.
@@ -47,8 +30,7 @@ namespace Ryujinx.Memory.Range
         /// <param name="backingInitialSize">The initial size of the backing array</param>
         public RangeList(int backingInitialSize = BackingInitialSize)
         {
-            _backingGrowthSize = backingInitialSize;
-            _items = new RangeItem<T>[backingInitialSize];
+            _index = new RangeIndex<T>(backingInitialSize);
         }
 
         /// <summary>
@@ -57,14 +39,7 @@ namespace Ryujinx.Memory.Range
         /// <param name="item">The item to be added</param>
         public void Add(T item)
         {
-            int index = BinarySearch(item.Address);
-
-            if (index < 0)
-            {
-                index = ~index;
-            }
-
-            Insert(index, new RangeItem<T>(item));
+            _index.Insert(item.Address, item.Address + item.Size, item);
         }
 
         /// <summary>
@@ -74,69 +49,18 @@ namespace Ryujinx.Memory.Range
         /// <returns>True if the item was located and updated, false otherwise</returns>
         public bool Update(T item)
         {
-            int index = BinarySearch(item.Address);
+            int index = _index.IndexOf(item.Address, item);
 
             if (index >= 0)
             {
-                while (index > 0 && _items[index - 1].Address == item.Address)
-                {
-                    index--;
-                }
-
-                while (index < Count)
-                {
-                    if (_items[index].Value.Equals(item))
-                    {
-                        _items[index] = new RangeItem<T>(item);
-
-                        return true;
-                    }
+                _index.SetEnd(index, item.Address + item.Size);
 
-                    if (_items[index].Address > item.Address)
-                    {
-                        break;
-                    }
-
-                    index++;
-                }
+                return true;
             }
 
             return false;
         }
 
-        [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        private void Insert(int index, RangeItem<T> item)
-        {
-            if (Count + 1 > _items.Length)
-            {
-                Array.Resize(ref _items, _items.Length + _backingGrowthSize);
-            }
-
-            if (index >= Count)
-            {
-                if (index == Count)
-                {
-                    _items[Count++] = item;
-                }
-            }
-            else
-            {
-                Array.Copy(_items, index, _items, index + 1, Count - index);
-
-                _items[index] = item;
-                Count++;
-            }
-        }
-
-        [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        private void RemoveAt(int index)
-        {
-            if (index < --Count)
-            {
-                Array.Copy(_items, index + 1, _items, index, Count - index);
-            }
-        }
-
         /// <summary>
         /// Removes an item from the list.
         /// </summary>
@@ -144,68 +68,64 @@ namespace Ryujinx.Memory.Range
         /// <returns>True if the item was removed, or false if it was not found</returns>
         public bool Remove(T item)
         {
-            int index = BinarySearch(item.Address);
+            int index = _index.IndexOf(item.Address, item);
 
             if (index >= 0)
             {
-                while (index > 0 && _items[index - 1].Address == item.Address)
-                {
-                    index--;
-                }
-
-                while (index < Count)
-                {
-                    if (_items[index].Value.Equals(item))
-                    {
-                        RemoveAt(index);
+                _index.RemoveAt(index);
 
-                        return true;
-                    }
-
-                    if (_items[index].Address > item.Address)
-                    {
-                        break;
-                    }
-
-                    index++;
-                }
+                return true;
             }
 
             return false;
         }
 
         /// <summary>
-        /// Updates an item's end address.
+        /// Removes several items from the list at once.
         /// </summary>
-        /// <param name="item">The item to be updated</param>
-        public void UpdateEndAddress(T item)
+        /// <remarks>
+        /// This is faster than removing the items one by one, as the remaining items are only moved once.
+        /// </remarks>
+        /// <param name="items">Array with the items to be removed</param>
+        /// <param name="count">Number of items to be removed from the start of the array</param>
+        /// <returns>The number of items removed</returns>
+        public int RemoveRange(T[] items, int count)
         {
-            int index = BinarySearch(item.Address);
+            Span<int> indices = count <= StackallocThreshold ? stackalloc int[count] : new int[count];
 
-            if (index >= 0)
+            int found = 0;
+            bool sorted = true;
+
+            for (int i = 0; i < count; i++)
             {
-                while (index > 0 && _items[index - 1].Address == item.Address)
+                T item = items[i];
+
+                int index = _index.IndexOf(item.Address, item);
+
+                if (index >= 0)
                 {
-                    index--;
+                    sorted &= found == 0 || indices[found - 1] <= index;
+                    indices[found++] = index;
                 }
+            }
 
-                while (index < Count)
-                {
-                    if (_items[index].Value.Equals(item))
-                    {
-                        _items[index] = new RangeItem<T>(item);
+            indices = indices[..found];
 
-                        return;
-                    }
+            if (!sorted)
+            {
+                indices.Sort();
+            }
 
-                    if (_items[index].Address > item.Address)
-                    {
-                        break;
-                    }
+            return _index.RemoveSorted(indices);
+        }
 
-                    index++;
-                }
-            }
+        /// <summary>
+        /// Updates an item's end address.
+        /// </summary>
+        /// <param name="item">The item to be updated</param>
+        public void UpdateEndAddress(T item)
+        {
+            Update(item);
         }
 
         /// <summary>
@@ -234,14 +154,14 @@ namespace Ryujinx.Memory.Range
         /// <returns>The overlapping item, or the default value for the type if none found</returns>
         public T FindFirstOverlap(ulong address, ulong size)
         {
-            int index = BinarySearch(address, address + size);
+            int index = _index.FindLastOverlap(address, address + size);
 
             if (index < 0)
             {
                 return default;
             }
 
-            return _items[index].Value;
+            return _index.GetValue(index);
         }
 
         /// <summary>
@@ -264,31 +184,7 @@ namespace Ryujinx.Memory.Range
         /// <returns>The number of overlapping items found</returns>
         public int FindOverlaps(ulong address, ulong size, ref T[] output)
         {
-            int outputIndex = 0;
-
-            ulong endAddress = address + size;
-
-            for (int i = 0; i < Count; i++)
-            {
-                ref RangeItem<T> item = ref _items[i];
-
-                if (item.Address >= endAddress)
-                {
-                    break;
-                }
-
-                if (item.OverlapsWith(address, endAddress))
-                {
-                    if (outputIndex == output.Length)
-                    {
-                        Array.Resize(ref output, outputIndex + ArrayGrowthSize);
-                    }
-
-                    output[outputIndex++] = item.Value;
-                }
-            }
-
-            return outputIndex;
+            return _index.FindOverlaps(address, address + size, ref output);
         }
 
         /// <summary>
@@ -323,32 +219,7 @@ namespace Ryujinx.Memory.Range
         {
             // This is a bit faster than FindOverlaps, but only works
             // when none of the items on the list overlaps with each other.
-            int outputIndex = 0;
-
-            ulong endAddress = address + size;
-
-            int index = BinarySearch(address, endAddress);
-
-            if (index >= 0)
-            {
-                while (index > 0 && _items[index - 1].OverlapsWith(address, endAddress))
-                {
-                    index--;
-                }
-
-                do
-                {
-                    if (outputIndex == output.Length)
-                    {
-                        Array.Resize(ref output, outputIndex + ArrayGrowthSize);
-                    }
-
-                    output[outputIndex++] = _items[index++].Value;
-                }
-                while (index < Count && _items[index].OverlapsWith(address, endAddress));
-            }
-
-            return outputIndex;
+            return _index.FindOverlapsNonOverlapping(address, address + size, ref output);
         }
 
         /// <summary>
@@ -359,116 +230,26 @@ namespace Ryujinx.Memory.Range
         /// <returns>The number of matches found</returns>
         public int FindOverlaps(ulong address, ref T[] output)
         {
-            int index = BinarySearch(address);
-
             int outputIndex = 0;
 
-            if (index >= 0)
+            for (int index = _index.LowerBound(address); index < Count && _index.GetStart(index) == address; index++)
             {
-                while (index > 0 && _items[index - 1].Address == address)
+                if (outputIndex == output.Length)
                 {
-                    index--;
+                    Array.Resize(ref output, outputIndex + ArrayGrowthSize);
                 }
 
-                while (index < Count)
-                {
-                    ref RangeItem<T> overlap = ref _items[index++];
-
-                    if (overlap.Address != address)
-                    {
-                        break;
-                    }
-
-                    if (outputIndex == output.Length)
-                    {
-                        Array.Resize(ref output, outputIndex + ArrayGrowthSize);
-                    }
-
-                    output[outputIndex++] = overlap.Value;
-                }
+                output[outputIndex++] = _index.GetValue(index);
             }
 
             return outputIndex;
         }
 
-        /// <summary>
-        /// Performs binary search on the internal list of items.
-        /// </summary>
-        /// <param name="address">Address to find</param>
-        /// <returns>List index of the item, or complement index of nearest item with lower value on the list</returns>
-        private int BinarySearch(ulong address)
-        {
-            int left = 0;
-            int right = Count - 1;
-
-            while (left <= right)
-            {
-                int range = right - left;
-
-                int middle = left + (range >> 1);
-
-                ref RangeItem<T> item = ref _items[middle];
-
-                if (item.Address == address)
-                {
-                    return middle;
-                }
-
-                if (address < item.Address)
-                {
-                    right = middle - 1;
-                }
-                else
-                {
-                    left = middle + 1;
-                }
-            }
-
-            return ~left;
-        }
-
-        /// <summary>
-        /// Performs binary search for items overlapping a given memory range.
-        /// </summary>
-        /// <param name="address">Start address of the range</param>
-        /// <param name="endAddress">End address of the range</param>
-        /// <returns>List index of the item, or complement index of nearest item with lower value on the list</returns>
-        private int BinarySearch(ulong address, ulong endAddress)
-        {
-            int left = 0;
-            int right = Count - 1;
-
-            while (left <= right)
-            {
-                int range = right - left;
-
-                int middle = left + (range >> 1);
-
-                ref RangeItem<T> item = ref _items[middle];
-
-                if (item.OverlapsWith(address, endAddress))
-                {
-                    return middle;
-                }
-
-                if (address < item.Address)
-                {
-                    right = middle - 1;
-                }
-                else
-                {
-                    left = middle + 1;
-                }
-            }
-
-            return ~left;
-        }
-
         public IEnumerator<T> GetEnumerator()
         {
             for (int i = 0; i < Count; i++)
             {
-                yield return _items[i].Value;
+                yield return _index.GetValue(i);
             }
         }
 
@@ -476,7 +257,7 @@ namespace Ryujinx.Memory.Range
         {
             for (int i = 0; i < Count; i++)
             {
-                yield return _items[i].Value;
+                yield return _index.GetValue(i);
             }
         }
     }
@@ -1,4 +1,5 @@
 using System;
+using System.Numerics;
 using System.Threading;
 
 namespace Ryujinx.Memory.Tracking
@@ -6,6 +7,11 @@ namespace Ryujinx.Memory.Tracking
     /// <summary>
     /// A bitmap that can be safely modified from multiple threads.
     /// </summary>
+    /// <remarks>
+    /// A summary level has a bit for each mask, set whenever a bit of the mask is set, so that masks without any set bit
+    /// can be skipped 64 at a time. Summary bits are only cleared when the masks are found to be empty while searching
+    /// for set bits, so a set summary bit means the mask may have set bits, and a clear one means it has none.
+    /// </remarks>
     internal class ConcurrentBitmap
     {
         public const int IntSize = 64;
@@ -18,6 +24,11 @@ namespace Ryujinx.Memory.Tracking
         /// </summary>
         public readonly long[] Masks;
 
+        /// <summary>
+        /// Masks with a bit for each mask of <see cref="Masks"/>, set if it may have any set bit.
+        /// </summary>
+        public readonly long[] Summary;
+
         /// <summary>
         /// Create a new multithreaded bitmap.
         /// </summary>
@@ -26,10 +37,12 @@ namespace Ryujinx.Memory.Tracking
         public ConcurrentBitmap(int count, bool set)
         {
             Masks = new long[(count + IntMask) / IntSize];
+            Summary = new long[(Masks.Length + IntMask) / IntSize];
 
             if (set)
             {
                 Array.Fill(Masks, -1L);
+                Array.Fill(Summary, -1L);
             }
         }
 
@@ -39,15 +52,64 @@ namespace Ryujinx.Memory.Tracking
         /// <returns>True if any bits are set, false otherwise</returns>
         public bool AnySet()
         {
-            for (int i = 0; i < Masks.Length; i++)
+            return FindNextSetMask(0, Masks.Length) != Masks.Length;
+        }
+
+        /// <summary>
+        /// Find the first mask with any set bit, within a range of masks.
+        /// </summary>
+        /// <param name="start">The first mask index to check</param>
+        /// <param name="end">The mask index after the last one to check</param>
+        /// <returns>The index of the first mask with a set bit, or <paramref name="end"/> if there is none</returns>
+        public int FindNextSetMask(int start, int end)
+        {
+            if (start >= end)
             {
-                if (Interlocked.Read(ref Masks[i]) != 0)
+                return end;
+            }
+
+            int summaryIndex = start >> IntShift;
+            long summary = Interlocked.Read(ref Summary[summaryIndex]) & (-1L << (start & IntMask));
+
+            while (true)
+            {
+                while (summary != 0)
                 {
-                    return true;
+                    int bit = BitOperations.TrailingZeroCount(summary);
+                    int maskIndex = (summaryIndex << IntShift) + bit;
+
+                    if (maskIndex >= end)
+                    {
+                        return end;
+                    }
+
+                    if (Interlocked.Read(ref Masks[maskIndex]) != 0)
+                    {
+                        return maskIndex;
+                    }
+
+                    long summaryMask = 1L << bit;
+
+                    Interlocked.And(ref Summary[summaryIndex], ~summaryMask);
+
+                    // A bit may have been set after the mask was read, and its summary bit cleared above.
+                    if (Interlocked.Read(ref Masks[maskIndex]) != 0)
+                    {
+                        Interlocked.Or(ref Summary[summaryIndex], summaryMask);
+
+                        return maskIndex;
+                    }
+
+                    summary &= ~summaryMask;
                 }
-            }
 
-            return false;
+                if (++summaryIndex << IntShift >= end)
+                {
+                    return end;
+                }
+
+                summary = Interlocked.Read(ref Summary[summaryIndex]);
+            }
         }
 
         /// <summary>
@@ -121,26 +183,40 @@ namespace Ryujinx.Memory.Tracking
         /// </summary>
         /// <param name="bit">The bit index to set</param>
         /// <param name="value">Whether the bit should be set or not</param>
-        public void Set(int bit, bool value)
+        /// <returns>True if the bit was set before, false otherwise</returns>
+        public bool Set(int bit, bool value)
         {
             int wordIndex = bit >> IntShift;
             int wordBit = bit & IntMask;
 
             long wordMask = 1L << wordBit;
 
+            long oldValue;
+
             if (value)
             {
-                Interlocked.Or(ref Masks[wordIndex], wordMask);
+                oldValue = Interlocked.Or(ref Masks[wordIndex], wordMask);
+
+                // The summary bit is set after the mask, see FindNextSetMask.
+                if (oldValue == 0)
+                {
+                    Interlocked.Or(ref Summary[wordIndex >> IntShift], 1L << (wordIndex & IntMask));
+                }
             }
             else
             {
-                Interlocked.And(ref Masks[wordIndex], ~wordMask);
+                oldValue = Interlocked.And(ref Masks[wordIndex], ~wordMask);
             }
+
+            return (oldValue & wordMask) != 0;
         }
 
         /// <summary>
         /// Clear the bitmap entirely, setting all bits to 0.
         /// </summary>
+        /// <remarks>
+        /// The summary is left as is, as bits may be set again while the bitmap is cleared.
+        /// </remarks>
         public void Clear()
         {
             for (int i = 0; i < Masks.Length; i++)
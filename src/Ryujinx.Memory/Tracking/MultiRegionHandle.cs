@@ -240,11 +240,16 @@ namespace Ryujinx.Memory.Tracking
             {
                 ParseDirtyBits(startValue & startMask, ref baseBit, ref prevHandle, ref rgStart, ref rgSize, modifiedAction);
 
-                for (int i = startIndex + 1; i < endIndex; i++)
+                // Masks without dirty handles are skipped using the bitmap summary.
+                for (int i = _dirtyBitmap.FindNextSetMask(startIndex + 1, endIndex); i < endIndex; i = _dirtyBitmap.FindNextSetMask(i + 1, endIndex))
                 {
+                    baseBit = i << ConcurrentBitmap.IntShift;
+
                     ParseDirtyBits(Volatile.Read(ref masks[i]), ref baseBit, ref prevHandle, ref rgStart, ref rgSize, modifiedAction);
                 }
 
+                baseBit = endIndex << ConcurrentBitmap.IntShift;
+
                 long endValue = Volatile.Read(ref masks[endIndex]);
 
                 ParseDirtyBits(endValue & endMask, ref baseBit, ref prevHandle, ref rgStart, ref rgSize, modifiedAction);
@@ -410,9 +415,11 @@ namespace Ryujinx.Memory.Tracking
         {
             GC.SuppressFinalize(this);
 
-            foreach (var handle in _handles)
+            // Disposed from the end, so that their regions are removed from the end of the sorted region lists,
+            // without moving the regions of the other handles each time.
+            for (int i = _handles.Length - 1; i >= 0; i--)
             {
-                handle.Dispose();
+                _handles[i].Dispose();
             }
         }
     }
@@ -299,8 +299,7 @@ namespace Ryujinx.Memory.Tracking
 
             if (write)
             {
-                bool oldDirty = Dirty;
-                Dirty = true;
+                bool oldDirty = Bitmap.Set(DirtyBit, true);
                 if (!oldDirty)
                 {
                     OnDirty?.Invoke();
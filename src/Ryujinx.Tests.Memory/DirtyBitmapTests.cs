@@ -0,0 +1,126 @@
+using NUnit.Framework;
+using Ryujinx.Memory.Tracking;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+namespace Ryujinx.Tests.Memory
+{
+    /// <summary>
+    /// Tests of granular tracking over regions large enough for the dirty bitmap summary to skip clean handles.
+    /// </summary>
+    public class DirtyBitmapTests
+    {
+        private const int PageSize = 4096;
+
+        private static MemoryTracking CreateTracking(int pageCount)
+        {
+            ulong size = (ulong)pageCount * PageSize;
+
+            return new MemoryTracking(new MockVirtualMemoryManager(size, PageSize), PageSize);
+        }
+
+        private static List<ulong> QueryModified(MultiRegionHandle handle, ulong address, ulong size)
+        {
+            List<ulong> modified = new();
+
+            handle.QueryModified(address, size, (rgAddress, rgSize) =>
+            {
+                for (ulong offset = 0; offset < rgSize; offset += PageSize)
+                {
+                    modified.Add(rgAddress + offset);
+                }
+            });
+
+            return modified;
+        }
+
+        [Test]
+        public void SparseWrites([Values(0x10000, 0x10001)] int pageCount)
+        {
+            MemoryTracking tracking = CreateTracking(pageCount);
+            ulong size = (ulong)pageCount * PageSize;
+
+            MultiRegionHandle handle = tracking.BeginGranularTracking(0, size, null, PageSize, 0);
+
+            // All handles start dirty.
+            Assert.AreEqual(pageCount, QueryModified(handle, 0, size).Count);
+            Assert.AreEqual(0, QueryModified(handle, 0, size).Count);
+
+            // Pages on the first and last masks, and on masks with clean summary words between them.
+            int[] pages = { 0, 63, 64, 4095, 4096, 4097, 40000, pageCount - 2, pageCount - 1 };
+
+            foreach (int page in pages)
+            {
+                tracking.VirtualMemoryEvent((ulong)page * PageSize, 1, true);
+            }
+
+            List<ulong> modified = QueryModified(handle, 0, size);
+
+            Assert.AreEqual(pages.Length, modified.Count);
+
+            for (int i = 0; i < pages.Length; i++)
+            {
+                Assert.AreEqual((ulong)pages[i] * PageSize, modified[i]);
+            }
+
+            Assert.AreEqual(0, QueryModified(handle, 0, size).Count);
+
+            // A partial query must not consume pages outside of it, even if their summary bits are cleaned.
+            tracking.VirtualMemoryEvent(40000UL * PageSize, 1, true);
+            tracking.VirtualMemoryEvent(50000UL * PageSize, 1, true);
+
+            Assert.AreEqual(1, QueryModified(handle, 30000UL * PageSize, 15000UL * PageSize).Count);
+            Assert.AreEqual(new List<ulong> { 50000UL * PageSize }, QueryModified(handle, 0, size));
+
+            handle.Dispose();
+        }
+
+        [Test]
+        [Explicit("Benchmark")]
+        public void QueryModifiedMillionPages()
+        {
+            const int PageCount = 0x100000;
+            const int Iterations = 20;
+
+            ulong size = (ulong)PageCount * PageSize;
+
+            // Creating the handles takes much longer than the queries, so they are shared by every write count.
+            MemoryTracking tracking = CreateTracking(PageCount);
+            MultiRegionHandle handle = tracking.BeginGranularTracking(0, size, null, PageSize, 0);
+
+            // The handles start dirty, and the summary bits of their masks are only cleared by the next query.
+            QueryModified(handle, 0, size);
+            QueryModified(handle, 0, size);
+
+            foreach (int writeCount in new[] { 0, 64, 4096, 0x10000 })
+            {
+                long modifiedPages = 0;
+
+                Stopwatch sw = new();
+
+                for (int iteration = 0; iteration < Iterations; iteration++)
+                {
+                    // Writes spread evenly over the whole region.
+                    for (int write = 0; write < writeCount; write++)
+                    {
+                        ulong page = (ulong)write * (PageCount / (ulong)writeCount);
+
+                        tracking.VirtualMemoryEvent(page * PageSize, 1, true);
+                    }
+
+                    sw.Start();
+
+                    handle.QueryModified(0, size, (_, rgSize) => modifiedPages += (long)(rgSize / PageSize));
+
+                    sw.Stop();
+                }
+
+                Assert.AreEqual((long)writeCount * Iterations, modifiedPages);
+
+                TestContext.Out.WriteLine($"{PageCount} pages, {writeCount} written: {sw.Elapsed.TotalMilliseconds * 1000 / Iterations:F1} us per query");
+            }
+
+            handle.Dispose();
+        }
+    }
+}
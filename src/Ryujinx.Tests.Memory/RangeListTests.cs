@@ -0,0 +1,361 @@
+using NUnit.Framework;
+using Ryujinx.Memory.Range;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+
+namespace Ryujinx.Tests.Memory
+{
+    /// <summary>
+    /// Tests of the range lists against a linear search over all the ranges.
+    /// </summary>
+    public class RangeListTests
+    {
+        private class TestRange : IRange
+        {
+            public ulong Address { get; }
+            public ulong Size { get; set; }
+            public ulong EndAddress => Address + Size;
+
+            public TestRange(ulong address, ulong size)
+            {
+                Address = address;
+                Size = size;
+            }
+
+            public bool OverlapsWith(ulong address, ulong size)
+            {
+                return Address < address + size && address < EndAddress;
+            }
+        }
+
+        private class TestMultiRange : IMultiRangeItem
+        {
+            public MultiRange Range { get; }
+
+            public TestMultiRange(MultiRange range)
+            {
+                Range = range;
+            }
+
+            public bool OverlapsWith(ulong address, ulong size)
+            {
+                for (int i = 0; i < Range.Count; i++)
+                {
+                    MemoryRange subRange = Range.GetSubRange(i);
+
+                    if (!MemoryRange.IsInvalid(ref subRange) && subRange.Address < address + size && address < subRange.EndAddress)
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+        }
+
+        [Test]
+        public void FindOverlaps([Values(4, 300)] int rangeCount)
+        {
+            Random rng = new(rangeCount);
+
+            RangeList<TestRange> list = new(16);
+            List<TestRange> ranges = new();
+
+            TestRange[] overlaps = Array.Empty<TestRange>();
+
+            for (int i = 0; i < 20000; i++)
+            {
+                switch (rng.Next(5))
+                {
+                    case 0 when ranges.Count < rangeCount:
+                        // Mostly small ranges with a few large ones, all of them overlapping each other freely.
+                        ulong size = (ulong)(rng.Next(10) == 0 ? rng.Next(1, 0x10000) : rng.Next(0, 0x100));
+                        TestRange range = new((ulong)rng.Next(0, 0x10000), size);
+
+                        list.Add(range);
+                        ranges.Add(range);
+                        break;
+                    case 1 when ranges.Count > 0:
+                        TestRange removed = ranges[rng.Next(ranges.Count)];
+
+                        Assert.True(list.Remove(removed));
+                        ranges.Remove(removed);
+                        break;
+                    case 2 when ranges.Count > 0:
+                        TestRange updated = ranges[rng.Next(ranges.Count)];
+
+                        updated.Size = (ulong)rng.Next(0, 0x1000);
+                        Assert.True(list.Update(updated));
+                        break;
+                    case 3 when ranges.Count > 0:
+                        TestRange[] removedRanges = ranges.OrderBy(_ => rng.Next()).Take(rng.Next(1, 4)).ToArray();
+
+                        Assert.AreEqual(removedRanges.Length, list.RemoveRange(removedRanges, removedRanges.Length));
+                        ranges.RemoveAll(removedRanges.Contains);
+                        break;
+                    default:
+                        ulong address = (ulong)rng.Next(0, 0x11000);
+                        ulong querySize = (ulong)rng.Next(0, 0x800);
+
+                        int count = list.FindOverlaps(address, querySize, ref overlaps);
+
+                        CollectionAssert.AreEquivalent(ranges.Where(r => r.OverlapsWith(address, querySize)), overlaps.Take(count));
+
+                        count = list.FindOverlaps(address, ref overlaps);
+
+                        CollectionAssert.AreEquivalent(ranges.Where(r => r.Address == address), overlaps.Take(count));
+                        break;
+                }
+
+                Assert.AreEqual(ranges.Count, list.Count);
+            }
+
+            Assert.AreEqual(ranges.Select(r => r.Address).OrderBy(a => a), list.Select(r => r.Address));
+        }
+
+        [Test]
+        public void FindOverlapsNonOverlapping()
+        {
+            const ulong Granularity = 0x100;
+            const int Slots = 1000;
+
+            Random rng = new(123);
+
+            RangeList<TestRange> list = new(16);
+            TestRange[] slots = new TestRange[Slots];
+
+            TestRange[] overlaps = Array.Empty<TestRange>();
+
+            for (int i = 0; i < 20000; i++)
+            {
+                ulong address = (ulong)rng.Next(0, Slots * (int)Granularity);
+                ulong size = (ulong)rng.Next(0, 0x800);
+
+                List<TestRange> expected = slots.Where(r => r != null && r.OverlapsWith(address, size)).ToList();
+
+                int count = list.FindOverlapsNonOverlapping(address, size, ref overlaps);
+
+                Assert.AreEqual(expected, overlaps.Take(count));
+
+                TestRange first = list.FindFirstOverlap(address, size);
+
+                Assert.AreEqual(expected.Count != 0, first != null);
+                Assert.True(first == null || expected.Contains(first));
+
+                if (rng.Next(2) == 0)
+                {
+                    // Replace the overlaps with a single range, as the buffer cache does, removing them in a random order.
+                    int slot = (int)(address / Granularity);
+                    int slotCount = Math.Min(rng.Next(1, 4), Slots - slot);
+
+                    ulong newAddress = (ulong)slot * Granularity;
+                    ulong maxSize = (ulong)slotCount * Granularity;
+
+                    int[] removedSlots = Enumerable.Range(0, Slots).Where(s => slots[s] != null && slots[s].OverlapsWith(newAddress, maxSize)).ToArray();
+                    TestRange[] toRemove = removedSlots.Select(s => slots[s]).OrderBy(_ => rng.Next()).ToArray();
+
+                    Assert.AreEqual(toRemove.Length, list.RemoveRange(toRemove, toRemove.Length));
+
+                    foreach (int removedSlot in removedSlots)
+                    {
+                        slots[removedSlot] = null;
+                    }
+
+                    TestRange range = new(newAddress, (ulong)rng.Next(1, (int)maxSize + 1));
+
+                    list.Add(range);
+                    slots[slot] = range;
+                }
+
+                Assert.AreEqual(slots.Count(r => r != null), list.Count);
+            }
+        }
+
+        [Test]
+        public void RemoveRange()
+        {
+            RangeList<TestRange> list = new(4);
+            TestRange[] ranges = new TestRange[100];
+
+            for (int i = 0; i < ranges.Length; i++)
+            {
+                ranges[i] = new TestRange((ulong)i * 0x10, 0x10);
+                list.Add(ranges[i]);
+            }
+
+            TestRange notAdded = new(0x20, 0x10);
+            TestRange[] toRemove = { ranges[50], ranges[3], notAdded, ranges[99], ranges[3], ranges[0], ranges[51] };
+
+            Assert.AreEqual(5, list.RemoveRange(toRemove, toRemove.Length));
+            Assert.AreEqual(ranges.Except(toRemove), list);
+
+            TestRange[] overlaps = Array.Empty<TestRange>();
+
+            Assert.AreEqual(2, list.FindOverlaps(0x10 * 49, 0x10 * 4, ref overlaps));
+            Assert.AreEqual(new[] { ranges[49], ranges[52] }, overlaps.Take(2));
+        }
+
+        [Test]
+        public void MultiRangeFindOverlaps()
+        {
+            const ulong SubRangeSize = 0x100;
+
+            Random rng = new(456);
+
+            MultiRangeList<TestMultiRange> list = new();
+            List<TestMultiRange> items = new();
+
+            TestMultiRange[] overlaps = Array.Empty<TestMultiRange>();
+
+            for (int i = 0; i < 5000; i++)
+            {
+                if (items.Count < 200 && rng.Next(3) != 0)
+                {
+                    MemoryRange[] subRanges = new MemoryRange[rng.Next(1, 4)];
+
+                    for (int j = 0; j < subRanges.Length; j++)
+                    {
+                        // Items always have at least one valid sub-range, or they are not added.
+                        // Each sub-range starts on a different part of the address space.
+                        subRanges[j] = j != 0 && rng.Next(4) == 0
+                            ? new MemoryRange(MemoryRange.InvalidAddress, SubRangeSize)
+                            : new MemoryRange((ulong)(j * 0x40 + rng.Next(0, 0x40)) * SubRangeSize, SubRangeSize * (ulong)rng.Next(1, 4));
+                    }
+
+                    TestMultiRange item = new(new MultiRange(subRanges));
+
+                    list.Add(item);
+                    items.Add(item);
+                }
+                else if (items.Count > 0)
+                {
+                    TestMultiRange item = items[rng.Next(items.Count)];
+
+                    Assert.True(list.Remove(item));
+                    items.Remove(item);
+                }
+
+                ulong address = (ulong)rng.Next(0, 0xc4) * SubRangeSize;
+                ulong size = (ulong)rng.Next(1, 0x400);
+
+                int count = list.FindOverlaps(address, size, ref overlaps);
+
+                CollectionAssert.AreEquivalent(items.Where(item => item.OverlapsWith(address, size)), overlaps.Take(count));
+
+                count = list.FindOverlaps(address, ref overlaps);
+
+                CollectionAssert.AreEquivalent(items.Where(item => ((IMultiRangeItem)item).BaseAddress == address), overlaps.Take(count));
+                Assert.AreEqual(items.Count, list.Count);
+            }
+
+            CollectionAssert.AreEquivalent(items.Where(item => ((IMultiRangeItem)item).BaseAddress != MemoryRange.InvalidAddress), list);
+        }
+
+        [Test]
+        [Explicit("Benchmark")]
+        public void DrawCallTrace([Values(256, 4096)] int bufferCount)
+        {
+            const int Draws = 200000;
+            const int BindingsPerDraw = 8;
+            const ulong BufferAlignment = 0x1000;
+
+            Random rng = new(bufferCount);
+
+            // Buffers of a few pages spread over a large address space, with gaps between them.
+            RangeList<TestRange> buffers = new();
+            List<TestRange> bufferSlots = new();
+
+            ulong address = 0x80000000;
+
+            for (int i = 0; i < bufferCount; i++)
+            {
+                TestRange buffer = new(address, BufferAlignment * (ulong)rng.Next(1, 16));
+
+                buffers.Add(buffer);
+                bufferSlots.Add(buffer);
+
+                address = buffer.EndAddress + BufferAlignment * (ulong)rng.Next(0, 4);
+            }
+
+            // Textures at the same addresses, with a few views overlapping each other.
+            MultiRangeList<TestMultiRange> textures = new();
+
+            foreach (TestRange buffer in bufferSlots)
+            {
+                textures.Add(new TestMultiRange(new MultiRange(buffer.Address, buffer.Size)));
+
+                if (rng.Next(8) == 0)
+                {
+                    textures.Add(new TestMultiRange(new MultiRange(buffer.Address + BufferAlignment / 2, BufferAlignment)));
+                }
+            }
+
+            // The trace: each draw binds ranges mostly within a small working set of buffers, with occasional
+            // bindings across buffers that merge them into a new one, as the buffer cache does.
+            (int Slot, ulong Offset, ulong Size)[] trace = new (int, ulong, ulong)[Draws * BindingsPerDraw];
+
+            int workingSetBase = 0;
+
+            for (int i = 0; i < trace.Length; i++)
+            {
+                if (i % (BindingsPerDraw * 1000) == 0)
+                {
+                    workingSetBase = rng.Next(0, Math.Max(1, bufferCount - 64));
+                }
+
+                int slot = Math.Min(workingSetBase + rng.Next(0, 64), bufferCount - 1);
+
+                trace[i] = (slot, (ulong)rng.Next(0, 0x800), (ulong)rng.Next(0x10, 0x1000));
+            }
+
+            TestRange[] bufferOverlaps = new TestRange[16];
+            TestMultiRange[] textureOverlaps = new TestMultiRange[16];
+
+            int merges = 0;
+            int textureOverlapsCount = 0;
+
+            Stopwatch sw = Stopwatch.StartNew();
+
+            for (int i = 0; i < trace.Length; i++)
+            {
+                (int slot, ulong offset, ulong size) = trace[i];
+
+                ulong bindAddress = bufferSlots[slot].Address + offset;
+
+                TestRange buffer = buffers.FindFirstOverlap(bindAddress, size);
+
+                if (buffer == null || buffer.Address > bindAddress || buffer.EndAddress < bindAddress + size)
+                {
+                    int count = buffers.FindOverlapsNonOverlapping(bindAddress, size, ref bufferOverlaps);
+
+                    ulong start = bindAddress;
+                    ulong end = bindAddress + size;
+
+                    for (int index = 0; index < count; index++)
+                    {
+                        start = Math.Min(start, bufferOverlaps[index].Address);
+                        end = Math.Max(end, bufferOverlaps[index].EndAddress);
+                    }
+
+                    buffers.RemoveRange(bufferOverlaps, count);
+                    buffers.Add(new TestRange(start, end - start));
+
+                    merges++;
+                }
+
+                if ((i % BindingsPerDraw) == 0)
+                {
+                    textureOverlapsCount += textures.FindOverlaps(bindAddress, size, ref textureOverlaps);
+                }
+            }
+
+            sw.Stop();
+
+            TestContext.Out.WriteLine(
+                $"{bufferCount} buffers: {sw.Elapsed.TotalMilliseconds * 1000000 / Draws:F1} ns per draw, " +
+                $"{merges} merges, {textureOverlapsCount} texture overlaps");
+        }
+    }
+}
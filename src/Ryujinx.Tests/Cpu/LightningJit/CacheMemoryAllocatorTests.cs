@@ -0,0 +1,86 @@
+using NUnit.Framework;
+using Ryujinx.Cpu.LightningJit.Cache;
+
+namespace Ryujinx.Tests.Cpu.LightningJit
+{
+    [TestFixture]
+    internal class CacheMemoryAllocatorTests
+    {
+        private const int Capacity = 0x1000;
+
+        [Test]
+        public void AllocateSplitsFreeBlock()
+        {
+            CacheMemoryAllocator allocator = new(Capacity);
+
+            Assert.AreEqual(0x000, allocator.Allocate(0x100));
+            Assert.AreEqual(0x100, allocator.Allocate(0x100));
+            Assert.AreEqual(0x200, allocator.Allocate(Capacity - 0x200));
+            Assert.AreEqual(-1, allocator.Allocate(4));
+        }
+
+        [Test]
+        public void AllocatePicksBestFit()
+        {
+            CacheMemoryAllocator allocator = new(Capacity);
+
+            allocator.Allocate(0x100);
+            int large = allocator.Allocate(0x300);
+            allocator.Allocate(0x100);
+            int small = allocator.Allocate(0x200);
+            allocator.Allocate(0x100);
+
+            allocator.Free(large, 0x300);
+            allocator.Free(small, 0x200);
+
+            // The smallest hole that fits is used, rather than the first one or the end of the cache.
+            Assert.AreEqual(small, allocator.Allocate(0x180));
+
+            // Exact fits are used as is.
+            Assert.AreEqual(large, allocator.Allocate(0x300));
+        }
+
+        [Test]
+        public void FreeCoalescesNeighbours()
+        {
+            CacheMemoryAllocator allocator = new(Capacity);
+
+            int first = allocator.Allocate(0x100);
+            int second = allocator.Allocate(0x100);
+            int third = allocator.Allocate(0x100);
+
+            allocator.Free(second, 0x100, out int freeOffset, out int freeSize);
+
+            Assert.AreEqual(second, freeOffset);
+            Assert.AreEqual(0x100, freeSize);
+
+            allocator.Free(first, 0x100, out freeOffset, out freeSize);
+
+            Assert.AreEqual(first, freeOffset);
+            Assert.AreEqual(0x200, freeSize);
+
+            allocator.Free(third, 0x100, out freeOffset, out freeSize);
+
+            Assert.AreEqual(0, freeOffset);
+            Assert.AreEqual(Capacity, freeSize);
+
+            Assert.AreEqual(0, allocator.Allocate(Capacity));
+        }
+
+        [Test]
+        public void ForceAllocationSplitsFreeBlock()
+        {
+            CacheMemoryAllocator allocator = new(Capacity);
+
+            allocator.ForceAllocation(0x400, 0x100);
+
+            Assert.AreEqual(0x000, allocator.Allocate(0x400));
+            Assert.AreEqual(0x500, allocator.Allocate(0x100));
+
+            allocator.Free(0x400, 0x100, out int freeOffset, out int freeSize);
+
+            Assert.AreEqual(0x400, freeOffset);
+            Assert.AreEqual(0x100, freeSize);
+        }
+    }
+}
@@ -0,0 +1,201 @@
+using NUnit.Framework;
+using Ryujinx.Cpu.Jit;
+using Ryujinx.Cpu.LightningJit;
+using Ryujinx.Cpu.LightningJit.Cache;
+using Ryujinx.Memory;
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace Ryujinx.Tests.Cpu.LightningJit
+{
+    [TestFixture]
+    internal class JitCacheEvictorTests
+    {
+        private const int FunctionSize = 0x100;
+        private const ulong GuestFunctionSize = 4;
+        private const ulong Budget = 4 * FunctionSize;
+
+        private class MockStackWalker : IStackWalker
+        {
+            public ulong[] CallStack { get; set; } = Array.Empty<ulong>();
+
+            public IEnumerable<ulong> GetCallStack(IntPtr framePointer, IntPtr codeRegionStart, int codeRegionSize, IntPtr codeRegion2Start, int codeRegion2Size)
+            {
+                return CallStack;
+            }
+        }
+
+        private MemoryBlock _ram;
+        private MemoryManager _memory;
+        private Translator _translator;
+        private MockStackWalker _stackWalker;
+        private JitCacheEvictor _evictor;
+
+        [SetUp]
+        public void Setup()
+        {
+            if (RuntimeInformation.ProcessArchitecture != Architecture.Arm64)
+            {
+                Assert.Ignore("LightningJit is only supported on Arm64 hosts.");
+            }
+
+            ulong pageSize = MemoryBlock.GetPageSize();
+
+            _ram = new MemoryBlock(pageSize);
+            _memory = new MemoryManager(_ram, pageSize * 2);
+            _memory.IncrementReferenceCount();
+
+            _translator = new Translator(_memory, for64Bits: true);
+            _stackWalker = new MockStackWalker();
+            _evictor = new JitCacheEvictor(_translator, _stackWalker, Budget);
+        }
+
+        [TearDown]
+        public void Teardown()
+        {
+            if (_evictor == null)
+            {
+                return;
+            }
+
+            _evictor.Clear();
+            _translator.Dispose();
+
+            _memory.DecrementReferenceCount();
+            _ram.Dispose();
+
+            _evictor = null;
+            _stackWalker = null;
+            _translator = null;
+            _memory = null;
+            _ram = null;
+        }
+
+        [Test]
+        public void EvictsFunctionsNotCalledRecently()
+        {
+            List<TranslatedFunction> functions = new();
+
+            for (int index = 0; index < 5; index++)
+            {
+                functions.Add(AddFunction(GetAddress(index)));
+            }
+
+            // The first sweep only clears the reference bits.
+            Assert.AreEqual(5, _translator.Functions.Count);
+
+            Assert.IsTrue(_evictor.TryGetFunction(GetAddress(0), out _));
+
+            functions.Add(AddFunction(GetAddress(5)));
+
+            Assert.IsTrue(_translator.Functions.TryGetValue(GetAddress(0), out _));
+            Assert.GreaterOrEqual(Budget - Budget / 8, (ulong)_translator.Functions.Count * FunctionSize);
+
+            List<IntPtr> evictedCaches = new();
+
+            for (int index = 0; index < functions.Count; index++)
+            {
+                ulong address = GetAddress(index);
+
+                if (!_translator.Functions.TryGetValue(address, out _))
+                {
+                    Assert.IsTrue(functions[index].Retired);
+                    Assert.AreEqual(_translator.FunctionTable.Fill, _translator.FunctionTable.GetValue(address));
+
+                    evictedCaches.Add(functions[index].InlineCaches[0]);
+                }
+            }
+
+            Assert.Greater(evictedCaches.Count, 0);
+
+            // No thread is running, so the code of the evicted functions is freed right away.
+            List<IntPtr> freedCaches = new();
+
+            for (int index = 0; index < evictedCaches.Count; index++)
+            {
+                freedCaches.Add(_translator.InlineCaches.Allocate());
+            }
+
+            CollectionAssert.AreEquivalent(evictedCaches, freedCaches);
+        }
+
+        [Test]
+        public void DefersFreeUntilThreadsLeaveFunction()
+        {
+            _evictor.RegisterThread();
+
+            TranslatedFunction func = AddFunction(GetAddress(0));
+
+            _evictor.Invalidate(GetAddress(0), GuestFunctionSize);
+
+            Assert.IsFalse(_translator.Functions.TryGetValue(GetAddress(0), out _));
+            Assert.IsFalse(IsFreed(func));
+
+            // The thread reported a call stack after the function was invalidated, but it is still executing it.
+            _stackWalker.CallStack = new[] { (ulong)func.FuncPointer + 8 };
+            _evictor.EnterSafepoint(IntPtr.Zero);
+            ForceReclaim();
+
+            Assert.IsFalse(IsFreed(func));
+
+            _stackWalker.CallStack = Array.Empty<ulong>();
+            _evictor.EnterSafepoint(IntPtr.Zero);
+            ForceReclaim();
+
+            Assert.IsTrue(IsFreed(func));
+
+            _evictor.UnregisterThread();
+        }
+
+        [Test]
+        public void FreesDuringSupervisorCall()
+        {
+            _evictor.RegisterThread();
+
+            TranslatedFunction caller = AddFunction(GetAddress(0));
+            TranslatedFunction other = AddFunction(GetAddress(1));
+
+            _evictor.EnterSupervisorCall(IntPtr.Zero, caller.FuncPointer + 8);
+
+            // The call stack of a thread in a supervisor call can't change, so only the functions on it are kept.
+            _evictor.Invalidate(GetAddress(0), GetAddress(2) - GetAddress(0));
+
+            Assert.IsTrue(IsFreed(other));
+            Assert.IsFalse(IsFreed(caller));
+
+            _evictor.LeaveSupervisorCall();
+            _evictor.EnterSafepoint(IntPtr.Zero);
+            ForceReclaim();
+
+            Assert.IsTrue(IsFreed(caller));
+
+            _evictor.UnregisterThread();
+        }
+
+        private static ulong GetAddress(int index)
+        {
+            return 0x1000UL + (ulong)index * 0x1000UL;
+        }
+
+        private TranslatedFunction AddFunction(ulong address)
+        {
+            IntPtr funcPointer = JitCache.Map(new byte[FunctionSize]);
+            IntPtr[] inlineCaches = new[] { _translator.InlineCaches.Allocate() };
+
+            return _evictor.AddFunction(address, new TranslatedFunction(funcPointer, GuestFunctionSize, FunctionSize, inlineCaches));
+        }
+
+        private void ForceReclaim()
+        {
+            // Invalidating a region without any function frees the retired functions that are safe to free.
+            _evictor.Invalidate(0, GuestFunctionSize);
+        }
+
+        private bool IsFreed(TranslatedFunction func)
+        {
+            // Freed inline caches are handed out again first, starting from the last one freed.
+            return _translator.InlineCaches.Allocate() == func.InlineCaches[0];
+        }
+    }
+}
@@ -0,0 +1,189 @@
+using ARMeilleure.CodeGen;
+using ARMeilleure.CodeGen.Linking;
+using ARMeilleure.CodeGen.Unwinding;
+using ARMeilleure.Translation;
+using ARMeilleure.Translation.PTC;
+using NUnit.Framework;
+using Ryujinx.Common.Configuration;
+using Ryujinx.Cpu.Jit;
+using Ryujinx.Memory;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+
+namespace Ryujinx.Tests.Cpu
+{
+    [TestFixture]
+    internal class PtcLoadTests
+    {
+        private const int EntriesCount = 50_000;
+        private const int CodeLength = 256;
+        private const ulong GuestFunctionSize = 64;
+
+        private const string TitleId = "0100000000001000";
+        private const string DisplayVersion = "1.0.0";
+
+        private static readonly ulong _pageSize = MemoryBlock.GetPageSize();
+
+        private string _baseDirPath;
+
+        private MemoryBlock _ram;
+        private MemoryManager _memory;
+
+        [SetUp]
+        public void Setup()
+        {
+            _baseDirPath = Path.Combine(Path.GetTempPath(), $"Ryujinx.Tests.Ptc.{Guid.NewGuid()}");
+
+            Directory.CreateDirectory(_baseDirPath);
+            AppDataManager.Initialize(_baseDirPath);
+
+            ulong size = (EntriesCount * GuestFunctionSize + _pageSize - 1) & ~(_pageSize - 1);
+
+            _ram = new MemoryBlock(size);
+            _memory = new MemoryManager(_ram, _pageSize + size);
+            _memory.IncrementReferenceCount();
+
+            _memory.Map(_pageSize, 0, size, MemoryMapFlags.Private);
+        }
+
+        [TearDown]
+        public void Teardown()
+        {
+            _memory.DecrementReferenceCount();
+            _ram.Dispose();
+
+            _memory = null;
+            _ram = null;
+
+            Directory.Delete(_baseDirPath, true);
+        }
+
+        [Test]
+        [Explicit("Benchmark")]
+        public void LoadSyntheticCache()
+        {
+            WriteSyntheticCache();
+
+            List<int> threadCounts = new();
+
+            for (int threadCount = 1; threadCount < Environment.ProcessorCount; threadCount *= 2)
+            {
+                threadCounts.Add(threadCount);
+            }
+
+            threadCounts.Add(Environment.ProcessorCount);
+
+            foreach (int threadCount in threadCounts)
+            {
+                Translator translator = new(new JitMemoryAllocator(forJit: true), _memory, true);
+
+                Stopwatch sw = Stopwatch.StartNew();
+
+                Ptc ptc = (Ptc)translator.LoadDiskCache(TitleId, DisplayVersion, true);
+
+                ptc.LoadTranslations(translator, threadCount);
+
+                sw.Stop();
+
+                Assert.AreEqual(EntriesCount, translator.Functions.Count);
+
+                TestContext.Out.WriteLine($"{EntriesCount} functions loaded with {threadCount} threads in {sw.Elapsed.TotalMilliseconds:F1} ms");
+
+                ptc.Dispose();
+                ptc.Profiler.Dispose();
+            }
+        }
+
+        [Test]
+        public void MergeJournal()
+        {
+            const int JournaledCount = 100;
+
+            Translator translator = new(new JitMemoryAllocator(forJit: true), _memory, true);
+
+            Ptc ptc = (Ptc)translator.LoadDiskCache(TitleId, DisplayVersion, true);
+
+            ptc.StartJournal();
+
+            Assert.IsTrue(ptc.IsJournaling);
+
+            WriteFunctions(ptc, JournaledCount);
+
+            ptc.Dispose();
+            ptc.Profiler.Dispose();
+
+            // Simulates the process being killed while the last function was written.
+            string journalPath = $"{ptc.CachePathActual}.journal";
+
+            using (FileStream stream = new(journalPath, FileMode.Open))
+            {
+                stream.SetLength(stream.Length - 1);
+            }
+
+            translator = new(new JitMemoryAllocator(forJit: true), _memory, true);
+
+            ptc = (Ptc)translator.LoadDiskCache(TitleId, DisplayVersion, true);
+
+            ptc.LoadTranslations(translator, 1);
+
+            Assert.AreEqual(JournaledCount - 1, translator.Functions.Count);
+            Assert.IsFalse(File.Exists(journalPath));
+
+            ptc.Dispose();
+            ptc.Profiler.Dispose();
+        }
+
+        private void WriteSyntheticCache()
+        {
+            Translator translator = new(new JitMemoryAllocator(forJit: true), _memory, true);
+
+            Ptc ptc = (Ptc)translator.LoadDiskCache(TitleId, DisplayVersion, true);
+
+            WriteFunctions(ptc, EntriesCount);
+
+            ptc.PreSave();
+
+            ptc.Dispose();
+            ptc.Profiler.Dispose();
+        }
+
+        private void WriteFunctions(Ptc ptc, int count)
+        {
+            Random random = new(0x5eed);
+
+            byte[] guestCode = new byte[GuestFunctionSize];
+
+            RelocEntry[] relocEntries = new RelocEntry[]
+            {
+                new(0, Ptc.DispatchStubSymbol),
+                new(8, Ptc.PageTableSymbol),
+                new(16, Ptc.CountTableSymbol),
+            };
+
+            UnwindInfo unwindInfo = new(new UnwindPushEntry[]
+            {
+                new(UnwindPseudoOp.PushReg, 4, regIndex: 19),
+                new(UnwindPseudoOp.PushReg, 8, regIndex: 20),
+            }, 8);
+
+            for (int i = 0; i < count; i++)
+            {
+                ulong address = _pageSize + (ulong)i * GuestFunctionSize;
+
+                random.NextBytes(guestCode);
+
+                _memory.Write(address, guestCode);
+
+                byte[] code = new byte[CodeLength];
+
+                random.NextBytes(code);
+
+                CompiledFunction compiledFunc = new(code, unwindInfo, new RelocInfo(relocEntries));
+
+                ptc.WriteCompiledFunction(address, GuestFunctionSize, Ptc.ComputeHash(_memory, address, GuestFunctionSize), true, compiledFunc);
+            }
+        }
+    }
+}
@@ -0,0 +1,300 @@
+using ARMeilleure;
+using ARMeilleure.State;
+using NUnit.Framework;
+using Ryujinx.Cpu.Jit;
+using Ryujinx.Memory;
+using System;
+using System.Collections.Generic;
+using System.Runtime.Intrinsics.X86;
+
+namespace Ryujinx.Tests.Cpu
+{
+    /// <summary>
+    /// Differential tests of the host SIMD lowerings of instructions which otherwise fall back to the soft float
+    /// helpers or to per element code, against that fallback.
+    /// </summary>
+    [TestFixture]
+    internal class SimdLoweringTests
+    {
+        private const int InstructionOffset = 0x0C;
+
+        private static readonly ulong _pageSize = MemoryBlock.GetPageSize();
+        private static readonly ulong _codeBaseAddress = _pageSize;
+
+        private const ulong DataSize = 0x40000;
+
+        private static readonly ulong _inputAddress = _codeBaseAddress + _pageSize;
+        private static readonly ulong _outputAddress = _inputAddress + DataSize;
+
+        private MemoryBlock _ram;
+        private MemoryManager _memory;
+
+        private bool _fastFP;
+        private bool _useSse41;
+
+        [SetUp]
+        public void Setup()
+        {
+            if (!Sse41.IsSupported)
+            {
+                Assert.Ignore("SSE4.1 lowerings are only used on x86 hosts.");
+            }
+
+            ulong size = _pageSize + DataSize * 2;
+
+            _ram = new MemoryBlock(size);
+            _memory = new MemoryManager(_ram, _codeBaseAddress + size);
+            _memory.IncrementReferenceCount();
+
+            _memory.Map(_codeBaseAddress, 0, size, MemoryMapFlags.Private);
+
+            _fastFP = Optimizations.FastFP;
+            _useSse41 = Optimizations.UseSse41IfAvailable;
+
+            // Fast FP uses approximations for the estimates, which are not bit exact by design.
+            Optimizations.FastFP = false;
+
+            WriteCode();
+        }
+
+        [TearDown]
+        public void Teardown()
+        {
+            if (_memory == null)
+            {
+                return;
+            }
+
+            Optimizations.FastFP = _fastFP;
+            Optimizations.UseSse41IfAvailable = _useSse41;
+
+            _memory.DecrementReferenceCount();
+            _ram.Dispose();
+
+            _memory = null;
+            _ram = null;
+        }
+
+        private static readonly uint[] _fpcrValues =
+        {
+            0u,
+            (uint)FPCR.Fz,
+            (uint)FPCR.Dn,
+            (uint)(FPCR.Fz | FPCR.Dn),
+            (uint)FPCR.RMode0,
+            (uint)FPCR.RMode1,
+            (uint)(FPCR.RMode0 | FPCR.RMode1),
+        };
+
+        [Test]
+        public void RecipEstimate(
+            [Values(0x5EA1D822u, 0x5EE1D822u, 0x0EA1D822u, 0x4EA1D822u, 0x4EE1D822u)] uint opcode, // FRECPE S/D/2S/4S/2D
+            [ValueSource(nameof(_fpcrValues))] uint fpcr)
+        {
+            AssertSameResults(opcode, GetFloatInputs(opcode), (FPCR)fpcr);
+        }
+
+        [Test]
+        public void RecipSqrtEstimate(
+            [Values(0x7EA1D822u, 0x7EE1D822u, 0x2EA1D822u, 0x6EA1D822u, 0x6EE1D822u)] uint opcode, // FRSQRTE S/D/2S/4S/2D
+            [ValueSource(nameof(_fpcrValues))] uint fpcr)
+        {
+            AssertSameResults(opcode, GetFloatInputs(opcode), (FPCR)fpcr);
+        }
+
+        [Test]
+        public void SaturatingNarrow(
+            [Values(0x0E214822u, 0x4E214822u, 0x0E614822u, 0x4E614822u, // SQXTN(2) V2.8B/16B/4H/8H, V1
+                    0x2E212822u, 0x6E212822u, 0x2E612822u, 0x6E612822u, // SQXTUN(2)
+                    0x2E214822u, 0x6E214822u, 0x2E614822u, 0x6E614822u)] uint opcode) // UQXTN(2)
+        {
+            AssertSameResults(opcode, GetIntegerInputs(((opcode >> 22) & 1) + 1), default);
+        }
+
+        private void AssertSameResults(uint opcode, List<V128> inputs, FPCR fpcr)
+        {
+            byte[] expected = Run(opcode, inputs, fpcr, useSse41: false);
+            byte[] actual = Run(opcode, inputs, fpcr, useSse41: true);
+
+            for (int index = 0; index < inputs.Count; index++)
+            {
+                ReadOnlySpan<byte> expectedEntry = expected.AsSpan(index * 32, 32);
+                ReadOnlySpan<byte> actualEntry = actual.AsSpan(index * 32, 32);
+
+                if (!expectedEntry.SequenceEqual(actualEntry))
+                {
+                    Assert.Fail($"Opcode 0x{opcode:X8}, FPCR 0x{(uint)fpcr:X8}, input {inputs[index]}: " +
+                        $"expected {Convert.ToHexString(expectedEntry)}, got {Convert.ToHexString(actualEntry)}.");
+                }
+            }
+        }
+
+        private byte[] Run(uint opcode, List<V128> inputs, FPCR fpcr, bool useSse41)
+        {
+            Optimizations.UseSse41IfAvailable = useSse41;
+
+            _memory.Write(_codeBaseAddress + InstructionOffset, opcode);
+
+            // Each input is followed by the initial value of the destination register, used by the narrows that write the
+            // upper half of it.
+            for (int index = 0; index < inputs.Count; index++)
+            {
+                _memory.Write(_inputAddress + (ulong)index * 32, inputs[index]);
+                _memory.Write(_inputAddress + (ulong)index * 32 + 16, new V128(0x0123456789ABCDEFul, 0xFEDCBA9876543210ul));
+            }
+
+            ExecutionContext context = CpuContext.CreateExecutionContext();
+
+            context.Fpcr = fpcr;
+
+            context.SetX(0, _inputAddress);
+            context.SetX(1, _outputAddress);
+            context.SetX(2, (ulong)inputs.Count);
+
+            // Every function is translated again, as the translator is disposed when the last thread exits.
+            CpuContext cpuContext = new(_memory, for64Bit: true);
+
+            cpuContext.Execute(context, _codeBaseAddress);
+
+            return _memory.GetSpan(_outputAddress, inputs.Count * 32).ToArray();
+        }
+
+        private void WriteCode()
+        {
+            Write(0x00, 0x3CC10401); // loop: LDR Q1, [X0], #16
+            Write(0x04, 0x3CC10402); // LDR Q2, [X0], #16
+            Write(0x08, 0xD51B443F); // MSR FPSR, XZR
+            Write(InstructionOffset, 0xD503201F); // Instruction under test, with V2 as destination and V1 as source.
+            Write(0x10, 0xD53B4423); // MRS X3, FPSR
+            Write(0x14, 0x3C810422); // STR Q2, [X1], #16
+            Write(0x18, 0xF8010423); // STR X3, [X1], #16
+            Write(0x1C, 0xF1000442); // SUBS X2, X2, #1
+            Write(0x20, 0x54FFFF01); // B.NE loop
+            Write(0x24, 0xD65F03C0); // RET
+        }
+
+        private void Write(ulong offset, uint opcode)
+        {
+            _memory.Write(_codeBaseAddress + offset, opcode);
+        }
+
+        private static List<V128> GetFloatInputs(uint opcode)
+        {
+            bool doubles = (opcode & (1u << 22)) != 0;
+
+            List<V128> inputs = new();
+
+            Random random = new(0x5eed);
+
+            if (doubles)
+            {
+                int[] exponents = { 0, 1, 2, 1021, 1022, 1023, 1024, 2043, 2044, 2045, 2046, 2047 };
+
+                // Every combination of sign, exponent parity and top 8 bits of the fraction, with random low bits.
+                foreach (int exp in exponents)
+                {
+                    for (ulong sign = 0; sign < 2; sign++)
+                    {
+                        for (ulong fraction = 0; fraction < 256; fraction += 2)
+                        {
+                            ulong e0 = sign << 63 | (ulong)exp << 52 | fraction << 44 | (ulong)random.NextInt64(1L << 44);
+                            ulong e1 = sign << 63 | (ulong)exp << 52 | (fraction + 1) << 44 | (ulong)random.NextInt64(1L << 44);
+
+                            inputs.Add(new V128(e0, e1));
+                        }
+                    }
+                }
+            }
+            else
+            {
+                int[] exponents = { 0, 1, 2, 125, 126, 127, 128, 251, 252, 253, 254, 255 };
+
+                foreach (int exp in exponents)
+                {
+                    for (uint sign = 0; sign < 2; sign++)
+                    {
+                        for (uint fraction = 0; fraction < 256; fraction += 4)
+                        {
+                            uint[] e = new uint[4];
+
+                            for (uint index = 0; index < 4; index++)
+                            {
+                                e[index] = sign << 31 | (uint)exp << 23 | (fraction + index) << 15 | (uint)random.Next(1 << 15);
+                            }
+
+                            inputs.Add(new V128(e[0], e[1], e[2], e[3]));
+                        }
+                    }
+                }
+            }
+
+            // Vectors mixing in range and out of range elements, and zeros, infinities and NaNs.
+            for (int index = 0; index < 256; index++)
+            {
+                inputs.Add(new V128((ulong)random.NextInt64(), (ulong)random.NextInt64()));
+            }
+
+            inputs.Add(new V128(0ul, 0ul));
+            inputs.Add(doubles ? new V128(0x7FF0000000000000ul, 0xFFF0000000000000ul) : new V128(0xFF8000007F800000ul, 0ul));
+            inputs.Add(doubles ? new V128(0x7FF8000000000001ul, 0x7FF0000000000001ul) : new V128(0x7F8000017FC00001ul, 0ul));
+
+            return inputs;
+        }
+
+        private static List<V128> GetIntegerInputs(uint sizeSrc)
+        {
+            List<V128> inputs = new();
+
+            Random random = new(0x5eed);
+
+            int eSize = 8 << (int)sizeSrc;
+            int elems = 128 / eSize;
+
+            long[] boundaries =
+            {
+                0, 1, -1, 0x7F, 0x80, -0x80, -0x81, 0xFF, 0x100, 0x7FFF, 0x8000, -0x8000, -0x8001, 0xFFFF, 0x10000,
+            };
+
+            for (int index = 0; index < 1024; index++)
+            {
+                ulong[] e = new ulong[elems];
+
+                for (int elem = 0; elem < elems; elem++)
+                {
+                    int half = 0x80 << (eSize / 2 - 8);
+
+                    e[elem] = (index % 4) switch
+                    {
+                        // Elements which do not saturate for any of the narrows, then for the signed narrows only.
+                        0 => (ulong)random.Next(half),
+                        1 => (ulong)random.Next(-half, half),
+                        2 => (ulong)boundaries[random.Next(boundaries.Length)],
+                        _ => (ulong)random.NextInt64(),
+                    };
+                }
+
+                ulong lo = 0;
+                ulong hi = 0;
+
+                for (int elem = 0; elem < elems; elem++)
+                {
+                    ulong value = e[elem] & (ulong.MaxValue >> (64 - eSize));
+                    int bit = elem * eSize;
+
+                    if (bit < 64)
+                    {
+                        lo |= value << bit;
+                    }
+                    else
+                    {
+                        hi |= value << (bit - 64);
+                    }
+                }
+
+                inputs.Add(new V128(lo, hi));
+            }
+
+            return inputs;
+        }
+    }
+}
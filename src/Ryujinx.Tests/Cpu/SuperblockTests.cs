@@ -0,0 +1,156 @@
+using ARMeilleure;
+using ARMeilleure.State;
+using NUnit.Framework;
+using Ryujinx.Cpu.Jit;
+using Ryujinx.Memory;
+using System.Diagnostics;
+
+namespace Ryujinx.Tests.Cpu
+{
+    [TestFixture]
+    internal class SuperblockTests
+    {
+        private const ulong KernelOffset = 0x40;
+        private const ulong OutOfLineOffset = 0x200;
+
+        private const int InstructionsPerIteration = 9;
+
+        private static readonly ulong _pageSize = MemoryBlock.GetPageSize();
+        private static readonly ulong _codeBaseAddress = _pageSize;
+
+        private MemoryBlock _ram;
+        private MemoryManager _memory;
+
+        private bool _useSuperblocks;
+
+        [SetUp]
+        public void Setup()
+        {
+            _ram = new MemoryBlock(_pageSize);
+            _memory = new MemoryManager(_ram, _pageSize * 2);
+            _memory.IncrementReferenceCount();
+
+            _memory.Map(_codeBaseAddress, 0, _pageSize, MemoryMapFlags.Private);
+
+            _useSuperblocks = Optimizations.UseSuperblocks;
+
+            WriteCode();
+        }
+
+        [TearDown]
+        public void Teardown()
+        {
+            Optimizations.UseSuperblocks = _useSuperblocks;
+
+            _memory.DecrementReferenceCount();
+            _ram.Dispose();
+
+            _memory = null;
+            _ram = null;
+        }
+
+        [Test]
+        public void OutOfLineBlockLinked([Values(false, true)] bool useSuperblocks)
+        {
+            Optimizations.UseSuperblocks = useSuperblocks;
+
+            ExecutionContext context = Run(outerIterations: 3, innerIterations: 5);
+
+            // x1 = sum of the loop counter, x2 = running xor of x1, x3 = sum of x2, x4 = xor mix of x1 and x3.
+            ulong x1 = 0, x2 = 0, x3 = 0, x4 = 0;
+
+            for (int outer = 0; outer < 3; outer++)
+            {
+                for (ulong x0 = 5; x0 != 0; x0--)
+                {
+                    x1 += x0;
+                    x2 ^= x1;
+                    x4 = (x4 + x1) ^ x3;
+                    x3 += x2;
+                }
+            }
+
+            Assert.AreEqual(x1, context.GetX(1));
+            Assert.AreEqual(x2, context.GetX(2));
+            Assert.AreEqual(x3, context.GetX(3));
+            Assert.AreEqual(x4, context.GetX(4));
+        }
+
+        [Test]
+        [Explicit("Benchmark")]
+        public void GuestInstructionsPerSecond([Values(false, true)] bool useSuperblocks)
+        {
+            const int OuterIterations = 2000;
+            const int InnerIterations = 10000;
+
+            Optimizations.UseSuperblocks = useSuperblocks;
+
+            // Warm up the translator itself, so that the time the host runtime spends compiling it is not measured.
+            // The kernel is called enough times to be promoted to high quality code early on each run.
+            Run(OuterIterations / 10, InnerIterations);
+
+            Stopwatch sw = Stopwatch.StartNew();
+
+            Run(OuterIterations, InnerIterations);
+
+            sw.Stop();
+
+            long instructions = 3 + (long)OuterIterations * (5 + (long)InstructionsPerIteration * InnerIterations);
+
+            double mips = instructions / sw.Elapsed.TotalSeconds / 1_000_000d;
+
+            TestContext.Out.WriteLine($"Superblocks {(useSuperblocks ? "enabled" : "disabled")}: {instructions} guest instructions in {sw.Elapsed.TotalMilliseconds:F1} ms ({mips:F1} MIPS)");
+        }
+
+        private ExecutionContext Run(int outerIterations, int innerIterations)
+        {
+            _memory.Write(_codeBaseAddress + 0x04, MovzX(19, (ushort)outerIterations));
+            _memory.Write(_codeBaseAddress + KernelOffset, MovzX(0, (ushort)innerIterations));
+
+            ExecutionContext context = CpuContext.CreateExecutionContext();
+
+            // Every function is translated again, as the translator is disposed when the last thread exits.
+            CpuContext cpuContext = new(_memory, for64Bit: true);
+
+            cpuContext.Execute(context, _codeBaseAddress);
+
+            return context;
+        }
+
+        private void WriteCode()
+        {
+            // main:
+            Write(0x00, 0xAA1E03F4); // MOV X20, X30
+            Write(0x04, MovzX(19, 0)); // MOV X19, #outerIterations
+            Write(0x08, 0x9400000E); // loop: BL kernel
+            Write(0x0C, 0xF1000673); // SUBS X19, X19, #1
+            Write(0x10, 0x54FFFFC1); // B.NE loop
+            Write(0x14, 0xD65F0280); // RET X20
+
+            // kernel:
+            Write(KernelOffset + 0x00, MovzX(0, 0)); // MOV X0, #innerIterations
+            Write(KernelOffset + 0x04, 0x8B000021); // loop: ADD X1, X1, X0
+            Write(KernelOffset + 0x08, 0xCA010042); // EOR X2, X2, X1
+            Write(KernelOffset + 0x0C, 0x1400006D); // B outOfLine
+            Write(KernelOffset + 0x10, 0x8B020063); // back: ADD X3, X3, X2
+            Write(KernelOffset + 0x14, 0xF1000400); // SUBS X0, X0, #1
+            Write(KernelOffset + 0x18, 0x54FFFF61); // B.NE loop
+            Write(KernelOffset + 0x1C, 0xD65F03C0); // RET
+
+            // outOfLine, placed far enough from the kernel to not be considered part of it by the decoder alone:
+            Write(OutOfLineOffset + 0x00, 0x8B010084); // ADD X4, X4, X1
+            Write(OutOfLineOffset + 0x04, 0xCA030084); // EOR X4, X4, X3
+            Write(OutOfLineOffset + 0x08, 0x17FFFF92); // B back
+        }
+
+        private void Write(ulong offset, uint opcode)
+        {
+            _memory.Write(_codeBaseAddress + offset, opcode);
+        }
+
+        private static uint MovzX(int rd, ushort imm)
+        {
+            return 0xD2800000u | ((uint)imm << 5) | (uint)rd;
+        }
+    }
+}
@@ -0,0 +1,190 @@
+using NUnit.Framework;
+using Ryujinx.Graphics.GAL;
+using Ryujinx.Graphics.Vulkan;
+using Silk.NET.Vulkan;
+using System;
+
+namespace Ryujinx.Tests.Graphics
+{
+    /// <summary>
+    /// Checks that a pre-rotated present blit produces the same image the compositor would show when
+    /// rotating an unrotated frame itself. The blit is emulated on the CPU, so no device is needed.
+    /// </summary>
+    [TestFixture]
+    internal class PreRotationTests
+    {
+        private const int SourceWidth = 6;
+        private const int SourceHeight = 4;
+
+        // Letterboxed destination, with a border that must stay untouched.
+        private const int DisplayWidth = 8;
+        private const int DisplayHeight = 6;
+        private static readonly Extents2D _displayRegion = new(1, 1, 7, 5);
+
+        private static readonly SurfaceTransformFlagsKHR[] _transforms =
+        {
+            SurfaceTransformFlagsKHR.IdentityBitKhr,
+            SurfaceTransformFlagsKHR.Rotate90BitKhr,
+            SurfaceTransformFlagsKHR.Rotate180BitKhr,
+            SurfaceTransformFlagsKHR.Rotate270BitKhr,
+            SurfaceTransformFlagsKHR.HorizontalMirrorBitKhr,
+            SurfaceTransformFlagsKHR.HorizontalMirrorRotate90BitKhr,
+            SurfaceTransformFlagsKHR.HorizontalMirrorRotate180BitKhr,
+            SurfaceTransformFlagsKHR.HorizontalMirrorRotate270BitKhr,
+        };
+
+        [Test]
+        public void PreRotatedBlitMatchesCompositorRotation(
+            [ValueSource(nameof(_transforms))] SurfaceTransformFlagsKHR transform,
+            [Values] bool flipX,
+            [Values] bool flipY)
+        {
+            int[,] source = new int[SourceHeight, SourceWidth];
+
+            for (int y = 0; y < SourceHeight; y++)
+            {
+                for (int x = 0; x < SourceWidth; x++)
+                {
+                    source[y, x] = y * SourceWidth + x + 1;
+                }
+            }
+
+            var srcRegion = new Extents2D(0, 0, SourceWidth, SourceHeight);
+            var dstRegion = new Extents2D(
+                flipX ? _displayRegion.X2 : _displayRegion.X1,
+                flipY ? _displayRegion.Y2 : _displayRegion.Y1,
+                flipX ? _displayRegion.X1 : _displayRegion.X2,
+                flipY ? _displayRegion.Y1 : _displayRegion.Y2);
+
+            int[,] display = Blit(source, srcRegion, dstRegion, false, DisplayWidth, DisplayHeight);
+            int[,] expected = Compose(display, transform);
+
+            bool swapsAxes = PreRotation.SwapsAxes(transform);
+            int panelWidth = swapsAxes ? DisplayHeight : DisplayWidth;
+            int panelHeight = swapsAxes ? DisplayWidth : DisplayHeight;
+
+            int[,] actual = Blit(
+                source,
+                srcRegion,
+                PreRotation.TransformRegion(transform, dstRegion, DisplayWidth, DisplayHeight),
+                swapsAxes,
+                panelWidth,
+                panelHeight);
+
+            Assert.That(actual, Is.EqualTo(expected));
+        }
+
+        [Test]
+        public void TransformsCoverAllSurfaceTransforms()
+        {
+            foreach (SurfaceTransformFlagsKHR transform in _transforms)
+            {
+                Assert.That(PreRotation.SupportedTransforms.HasFlag(transform), Is.True);
+            }
+
+            Assert.That(PreRotation.SupportedTransforms.HasFlag(SurfaceTransformFlagsKHR.InheritBitKhr), Is.False);
+        }
+
+        // Emulates HelperShader.BlitColor with nearest filtering. Pixels are sampled at their centers, and the
+        // texture coordinates are interpolated across the viewport like the blit vertex shaders do.
+        private static int[,] Blit(int[,] source, Extents2D srcRegion, Extents2D dstRegion, bool transpose, int width, int height)
+        {
+            int srcHeight = source.GetLength(0);
+            int srcWidth = source.GetLength(1);
+
+            Span<float> region = stackalloc float[4];
+
+            HelperShader.GetBlitRegion(region, srcRegion, srcWidth, srcHeight, dstRegion, transpose);
+
+            int viewportX = Math.Min(dstRegion.X1, dstRegion.X2);
+            int viewportY = Math.Min(dstRegion.Y1, dstRegion.Y2);
+            int viewportWidth = Math.Abs(dstRegion.X2 - dstRegion.X1);
+            int viewportHeight = Math.Abs(dstRegion.Y2 - dstRegion.Y1);
+
+            int[,] result = new int[height, width];
+
+            for (int y = viewportY; y < viewportY + viewportHeight; y++)
+            {
+                for (int x = viewportX; x < viewportX + viewportWidth; x++)
+                {
+                    float s = (x + 0.5f - viewportX) / viewportWidth;
+                    float t = (y + 0.5f - viewportY) / viewportHeight;
+
+                    if (transpose)
+                    {
+                        (s, t) = (t, s);
+                    }
+
+                    float u = region[0] + (region[1] - region[0]) * s;
+                    float v = region[2] + (region[3] - region[2]) * t;
+
+                    result[y, x] = source[(int)(v * srcHeight), (int)(u * srcWidth)];
+                }
+            }
+
+            return result;
+        }
+
+        // What the compositor shows for an unrotated frame: mirror first, then rotate clockwise.
+        private static int[,] Compose(int[,] image, SurfaceTransformFlagsKHR transform)
+        {
+            (bool mirror, int rotations) = transform switch
+            {
+                SurfaceTransformFlagsKHR.Rotate90BitKhr => (false, 1),
+                SurfaceTransformFlagsKHR.Rotate180BitKhr => (false, 2),
+                SurfaceTransformFlagsKHR.Rotate270BitKhr => (false, 3),
+                SurfaceTransformFlagsKHR.HorizontalMirrorBitKhr => (true, 0),
+                SurfaceTransformFlagsKHR.HorizontalMirrorRotate90BitKhr => (true, 1),
+                SurfaceTransformFlagsKHR.HorizontalMirrorRotate180BitKhr => (true, 2),
+                SurfaceTransformFlagsKHR.HorizontalMirrorRotate270BitKhr => (true, 3),
+                _ => (false, 0),
+            };
+
+            if (mirror)
+            {
+                image = MirrorHorizontal(image);
+            }
+
+            for (int i = 0; i < rotations; i++)
+            {
+                image = RotateClockwise(image);
+            }
+
+            return image;
+        }
+
+        private static int[,] MirrorHorizontal(int[,] image)
+        {
+            int height = image.GetLength(0);
+            int width = image.GetLength(1);
+            int[,] result = new int[height, width];
+
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    result[y, x] = image[y, width - 1 - x];
+                }
+            }
+
+            return result;
+        }
+
+        private static int[,] RotateClockwise(int[,] image)
+        {
+            int height = image.GetLength(0);
+            int width = image.GetLength(1);
+            int[,] result = new int[width, height];
+
+            for (int y = 0; y < width; y++)
+            {
+                for (int x = 0; x < height; x++)
+                {
+                    result[y, x] = image[height - 1 - x, y];
+                }
+            }
+
+            return result;
+        }
+    }
+}
@@ -0,0 +1,188 @@
+using NUnit.Framework;
+using Ryujinx.Memory;
+using System;
+using System.Diagnostics;
+using System.IO;
+using System.Runtime.InteropServices;
+
+namespace Ryujinx.Tests.Memory
+{
+    [TestFixture]
+    internal partial class HugePages
+    {
+        private const ulong PageSize = 0x1000;
+
+        private static ulong _sink;
+
+        /// <summary>
+        /// Counter of the data TLB misses of the current thread, read from the performance monitoring unit.
+        /// </summary>
+        private sealed partial class DtlbMissCounter : IDisposable
+        {
+            [StructLayout(LayoutKind.Explicit, Size = 128)]
+            private struct PerfEventAttr
+            {
+                [FieldOffset(0)]
+                public uint Type;
+                [FieldOffset(4)]
+                public uint Size;
+                [FieldOffset(8)]
+                public ulong Config;
+                [FieldOffset(40)]
+                public ulong Flags;
+            }
+
+            private const int SysPerfEventOpenX64 = 298;
+            private const int SysPerfEventOpenArm64 = 241;
+
+            private const uint PERF_TYPE_HW_CACHE = 3;
+            private const ulong PERF_COUNT_HW_CACHE_DTLB = 3;
+            private const ulong PERF_COUNT_HW_CACHE_OP_READ = 0;
+            private const ulong PERF_COUNT_HW_CACHE_RESULT_MISS = 1;
+
+            private const ulong FlagDisabled = 1 << 0;
+            private const ulong FlagExcludeKernel = 1 << 5;
+            private const ulong FlagExcludeHv = 1 << 6;
+
+            private const ulong PERF_EVENT_IOC_ENABLE = 0x2400;
+            private const ulong PERF_EVENT_IOC_DISABLE = 0x2401;
+            private const ulong PERF_EVENT_IOC_RESET = 0x2403;
+
+            [LibraryImport("libc", SetLastError = true)]
+            private static partial int syscall(long number, ref PerfEventAttr attr, int pid, int cpu, int groupFd, ulong flags);
+
+            [LibraryImport("libc", SetLastError = true)]
+            private static partial int ioctl(int fd, ulong request, ulong arg);
+
+            [LibraryImport("libc", SetLastError = true)]
+            private static partial nint read(int fd, out ulong value, nuint count);
+
+            [LibraryImport("libc", SetLastError = true)]
+            private static partial int close(int fd);
+
+            private readonly int _fd;
+
+            private DtlbMissCounter(int fd)
+            {
+                _fd = fd;
+            }
+
+            /// <summary>
+            /// Opens a counter of the data TLB load misses of the current thread.
+            /// </summary>
+            /// <returns>The counter, or null if the host does not expose the event</returns>
+            public static DtlbMissCounter TryCreate()
+            {
+                long sysPerfEventOpen = RuntimeInformation.ProcessArchitecture switch
+                {
+                    Architecture.X64 => SysPerfEventOpenX64,
+                    Architecture.Arm64 => SysPerfEventOpenArm64,
+                    _ => -1,
+                };
+
+                if (!OperatingSystem.IsLinux() || sysPerfEventOpen < 0)
+                {
+                    return null;
+                }
+
+                PerfEventAttr attr = new()
+                {
+                    Type = PERF_TYPE_HW_CACHE,
+                    Size = (uint)Marshal.SizeOf<PerfEventAttr>(),
+                    Config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                    Flags = FlagDisabled | FlagExcludeKernel | FlagExcludeHv,
+                };
+
+                int fd = syscall(sysPerfEventOpen, ref attr, 0, -1, -1, 0);
+
+                return fd < 0 ? null : new DtlbMissCounter(fd);
+            }
+
+            public void Start()
+            {
+                ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+
+            public ulong Stop()
+            {
+                ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+
+                return read(_fd, out ulong value, sizeof(ulong)) == sizeof(ulong) ? value : 0;
+            }
+
+            public void Dispose()
+            {
+                close(_fd);
+            }
+        }
+
+        private static long ReadShmemPmdMappedKiB()
+        {
+            const string Field = "ShmemPmdMapped:";
+
+            foreach (string line in File.ReadLines("/proc/self/smaps_rollup"))
+            {
+                if (line.StartsWith(Field))
+                {
+                    return long.Parse(line.AsSpan(Field.Length).Trim().TrimEnd("kB").Trim());
+                }
+            }
+
+            return -1;
+        }
+
+        [Test]
+        [Explicit("Benchmark")]
+        [Platform("Linux")]
+        public unsafe void RandomAccessTlbMisses([Values] bool hugePages)
+        {
+            const ulong Size = 0x20000000;
+            const int Accesses = 0x1000000;
+
+            MemoryAllocationFlags hugePagesFlag = hugePages ? MemoryAllocationFlags.HugePages : MemoryAllocationFlags.None;
+
+            using MemoryBlock backing = new(Size, MemoryAllocationFlags.Mirrorable | hugePagesFlag);
+            using MemoryBlock addressSpace = new(Size, MemoryAllocationFlags.Reserve | MemoryAllocationFlags.ViewCompatible | hugePagesFlag);
+
+            addressSpace.MapView(backing, 0, 0, Size);
+
+            long pmdMappedBefore = ReadShmemPmdMappedKiB();
+
+            // Populate the memory through the view, as the guest would.
+            for (ulong offset = 0; offset < Size; offset += PageSize)
+            {
+                addressSpace.Write(offset, offset);
+            }
+
+            long pmdMapped = ReadShmemPmdMappedKiB() - pmdMappedBefore;
+
+            using DtlbMissCounter counter = DtlbMissCounter.TryCreate();
+
+            byte* basePtr = (byte*)addressSpace.Pointer;
+            ulong state = 1;
+            ulong sum = 0;
+
+            Stopwatch sw = Stopwatch.StartNew();
+            counter?.Start();
+
+            for (int i = 0; i < Accesses; i++)
+            {
+                state = state * 6364136223846793005UL + 1442695040888963407UL;
+
+                sum += *(ulong*)(basePtr + ((state >> 16) & (Size - sizeof(ulong)) & ~(ulong)(sizeof(ulong) - 1)));
+            }
+
+            ulong misses = counter?.Stop() ?? 0;
+            sw.Stop();
+
+            _sink = sum;
+
+            string missesText = counter != null ? $"{misses} dTLB load misses" : "dTLB load misses unavailable";
+
+            TestContext.Out.WriteLine(
+                $"{(hugePages ? "Huge pages" : "Regular pages")}: {sw.Elapsed.TotalMilliseconds * 1000000 / Accesses:F2} ns per access, " +
+                $"{missesText}, {pmdMapped} KiB mapped with huge pages");
+        }
+    }
+}
@@ -0,0 +1,94 @@
+using NUnit.Framework;
+using Ryujinx.Cpu.Jit;
+using Ryujinx.Memory;
+using System.Diagnostics;
+
+namespace Ryujinx.Tests.Memory
+{
+    [TestFixture]
+    internal class NoMirrorTranslation
+    {
+        private const ulong PageSize = 0x1000;
+
+        private static ulong _sink;
+
+        private static MemoryManagerHostNoMirror CreateMemoryManager(MemoryBlock backing, ulong asSize)
+        {
+            MemoryBlock addressSpace = new(asSize, MemoryAllocationFlags.Reserve | MemoryAllocationFlags.ViewCompatible);
+            MemoryManagerHostNoMirror memoryManager = new(addressSpace, backing, false, null);
+
+            memoryManager.IncrementReferenceCount();
+
+            return memoryManager;
+        }
+
+        [Test]
+        // Memory aliasing tests fail on CI at the moment.
+        [Platform(Exclude = "MacOsX")]
+        public void RemapUpdatesTranslations()
+        {
+            // Two addresses sharing the same translation cache entry.
+            const ulong Va = 0x10000;
+            const ulong AliasVa = Va + 0x1000000;
+
+            using MemoryBlock backing = new(PageSize * 4, MemoryAllocationFlags.Mirrorable);
+
+            backing.Write(0, 1);
+            backing.Write(PageSize, 2);
+
+            MemoryManagerHostNoMirror memoryManager = CreateMemoryManager(backing, 0x4000000);
+
+            memoryManager.Map(Va, 0, PageSize, MemoryMapFlags.None);
+            Assert.AreEqual(1, memoryManager.Read<int>(Va));
+
+            memoryManager.Unmap(Va, PageSize);
+            Assert.Throws<InvalidMemoryRegionException>(() => memoryManager.Read<int>(Va));
+
+            memoryManager.Map(Va, PageSize, PageSize, MemoryMapFlags.None);
+            Assert.AreEqual(2, memoryManager.Read<int>(Va));
+
+            memoryManager.Map(AliasVa, 0, PageSize, MemoryMapFlags.None);
+            Assert.AreEqual(1, memoryManager.Read<int>(AliasVa));
+            Assert.AreEqual(2, memoryManager.Read<int>(Va));
+
+            memoryManager.Write(Va + 4, 3);
+            Assert.AreEqual(3, backing.Read<int>(PageSize + 4));
+
+            memoryManager.DecrementReferenceCount();
+        }
+
+        [Test]
+        [Explicit("Benchmark")]
+        public void RandomReads([Values(0x1000000UL, 0x10000000UL)] ulong size)
+        {
+            const int Reads = 0x1000000;
+
+            using MemoryBlock backing = new(size, MemoryAllocationFlags.Mirrorable);
+
+            MemoryManagerHostNoMirror memoryManager = CreateMemoryManager(backing, size);
+
+            memoryManager.Map(0, 0, size, MemoryMapFlags.None);
+
+            ulong state = 1;
+            ulong sum = 0;
+
+            Stopwatch sw = Stopwatch.StartNew();
+
+            for (int i = 0; i < Reads; i++)
+            {
+                state = state * 6364136223846793005UL + 1442695040888963407UL;
+
+                // The start of random pages, to measure the translation rather than cache misses on the data.
+                sum += memoryManager.Read<ulong>((state >> 16) & (size - 1) & ~(PageSize - 1));
+            }
+
+            sw.Stop();
+
+            _sink = sum;
+
+            TestContext.Out.WriteLine($"{size / PageSize} pages: {sw.Elapsed.TotalMilliseconds * 1000000 / Reads:F2} ns per read");
+
+            memoryManager.DecrementReferenceCount();
+        }
+    }
+}
@@ -0,0 +1,176 @@
+using NUnit.Framework;
+using Ryujinx.Cpu;
+using Ryujinx.Cpu.Signal;
+using Ryujinx.Memory;
+using Ryujinx.Memory.Tracking;
+using System;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+
+namespace Ryujinx.Tests.Memory
+{
+    [TestFixture]
+    internal partial class WriteTracking
+    {
+        private const int PageSize = 0x1000;
+        private const ulong AlternateStackSize = 0x10000;
+
+        [LibraryImport("libc")]
+        private static partial IntPtr memset(IntPtr dest, int value, nuint count);
+
+        private sealed class TrackedMemory : IDisposable
+        {
+            public readonly MemoryBlock Backing;
+            public readonly MemoryBlock AddressSpace;
+            public readonly MemoryTracking Tracking;
+            public readonly UserfaultfdWriteTracker WriteTracker;
+
+            private readonly MemoryEhMeilleure _exceptionHandler;
+            private readonly MemoryBlock _alternateStack;
+
+            public TrackedMemory(ulong size, bool userfaultfd)
+            {
+                Backing = new MemoryBlock(size, MemoryAllocationFlags.Mirrorable);
+                AddressSpace = new MemoryBlock(size, MemoryAllocationFlags.Reserve | MemoryAllocationFlags.ViewCompatible);
+                AddressSpace.MapView(Backing, 0, 0, size);
+
+                MockVirtualMemoryManager memoryManager = new(size, PageSize);
+
+                Tracking = new MemoryTracking(memoryManager, PageSize);
+
+                if (userfaultfd)
+                {
+                    WriteTracker = new UserfaultfdWriteTracker(AddressSpace, Tracking);
+
+                    Assert.True(WriteTracker.Register(0, size));
+
+                    memoryManager.OnProtect += (va, rgSize, protection) => WriteTracker.WriteProtect(va, rgSize, protection != MemoryPermission.ReadAndWrite);
+                }
+                else
+                {
+                    NativeSignalHandler.InitializeSignalHandler();
+
+                    // The tracking is called from the signal handler, on a stack larger than the one of the runtime.
+                    _alternateStack = new MemoryBlock(AlternateStackSize);
+                    NativeSignalHandler.InstallUnixAlternateStackForCurrentThread(_alternateStack.GetPointer(0, AlternateStackSize), AlternateStackSize);
+
+                    _exceptionHandler = new MemoryEhMeilleure(AddressSpace, null, Tracking);
+
+                    memoryManager.OnProtect += (va, rgSize, protection) => AddressSpace.Reprotect(va, rgSize, protection);
+                }
+            }
+
+            public void Dispose()
+            {
+                WriteTracker?.Dispose();
+                _exceptionHandler?.Dispose();
+
+                if (_alternateStack != null)
+                {
+                    NativeSignalHandler.UninstallUnixAlternateStackForCurrentThread();
+                    _alternateStack.Dispose();
+                }
+
+                AddressSpace.Dispose();
+                Backing.Dispose();
+            }
+        }
+
+        private static void IgnoreIfUnsupported(bool userfaultfd)
+        {
+            if (userfaultfd && !(OperatingSystem.IsLinux() && UserfaultfdWriteTracker.IsSupported))
+            {
+                Assert.Ignore("Userfaultfd write protection is not supported by the host.");
+            }
+        }
+
+        private static int CountModified(MultiRegionHandle handle, ulong size)
+        {
+            int modified = 0;
+
+            handle.QueryModified(0, size, (_, rgSize) => modified += (int)(rgSize / PageSize));
+
+            return modified;
+        }
+
+        [Test]
+        [Platform("Linux")]
+        public void UserfaultfdTracksWrites()
+        {
+            IgnoreIfUnsupported(true);
+
+            const int PageCount = 64;
+            const ulong Size = PageCount * PageSize;
+
+            using TrackedMemory memory = new(Size, userfaultfd: true);
+
+            MultiRegionHandle handle = memory.Tracking.BeginGranularTracking(0, Size, null, PageSize, 0);
+
+            // All handles start dirty, the query write protects them.
+            Assert.AreEqual(PageCount, CountModified(handle, Size));
+
+            for (int i = 0; i < PageCount; i += 3)
+            {
+                memory.AddressSpace.Write((ulong)i * PageSize, i);
+            }
+
+            Assert.AreEqual((PageCount + 2) / 3, CountModified(handle, Size));
+            Assert.AreEqual((PageCount + 2) / 3, memory.WriteTracker.FaultsCount);
+
+            // The query protects the written pages again. Reads never fault.
+            memory.AddressSpace.Read<int>(PageSize);
+            memory.AddressSpace.Write(0, 1);
+            memory.AddressSpace.Write(4, 2);
+
+            Assert.AreEqual((PageCount + 2) / 3 + 1, memory.WriteTracker.FaultsCount);
+            Assert.AreEqual(1, CountModified(handle, Size));
+            Assert.AreEqual(1, memory.Backing.Read<int>(0));
+            Assert.AreEqual(2, memory.Backing.Read<int>(4));
+            Assert.AreEqual(3, memory.Backing.Read<int>(3 * PageSize));
+
+            handle.Dispose();
+        }
+
+        [Test]
+        [Explicit("Benchmark")]
+        [Platform("Linux")]
+        public void WriteFaultsPerSecond([Values] bool userfaultfd)
+        {
+            IgnoreIfUnsupported(userfaultfd);
+
+            const int PageCount = 0x4000;
+            const int Iterations = 10;
+            const ulong Size = PageCount * PageSize;
+
+            using TrackedMemory memory = new(Size, userfaultfd);
+
+            MultiRegionHandle handle = memory.Tracking.BeginGranularTracking(0, Size, null, PageSize, 0);
+
+            Stopwatch sw = new();
+
+            for (int iteration = 0; iteration < Iterations; iteration++)
+            {
+                // Protects every page written since the last query.
+                CountModified(handle, Size);
+
+                sw.Start();
+
+                // Written from native code, as the signal handler can't call the tracking from a thread running managed code.
+                for (int page = 0; page < PageCount; page++)
+                {
+                    memset(memory.AddressSpace.GetPointer((ulong)page * PageSize, sizeof(int)), page, sizeof(int));
+                }
+
+                sw.Stop();
+            }
+
+            Assert.AreEqual(PageCount, CountModified(handle, Size));
+
+            double faultsPerSecond = (double)PageCount * Iterations / sw.Elapsed.TotalSeconds;
+
+            TestContext.Out.WriteLine($"{(userfaultfd ? "userfaultfd" : "mprotect")}: {faultsPerSecond:F0} write faults per second");
+
+            handle.Dispose();
+        }
+    }
+}
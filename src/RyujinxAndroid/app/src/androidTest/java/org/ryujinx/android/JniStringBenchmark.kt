@@ -0,0 +1,52 @@
+package org.ryujinx.android
+
+import android.util.Log
+import androidx.test.ext.junit.runners.AndroidJUnit4
+
+import org.junit.Test
+import org.junit.runner.RunWith
+
+import org.junit.Assert.*
+
+/**
+ * Compares the per-call cost of the previous JNI string marshalling against the arena based one.
+ */
+@RunWith(AndroidJUnit4::class)
+class JniStringBenchmark {
+    private val iterations = 100000
+
+    private fun run(name: String, value: String) {
+        val helpers = NativeHelpers.instance
+
+        // Warm up, so the arena has reached its steady state size.
+        helpers.benchmarkStringMarshalling(value, 1000)
+
+        val results = helpers.benchmarkStringMarshalling(value, iterations)
+        assertEquals(4, results.size)
+
+        val perCall = results.map { it.toDouble() / iterations }
+        Log.i(
+            "JniStringBenchmark",
+            "$name: to native %.1f -> %.1f ns, to java %.1f -> %.1f ns".format(
+                perCall[0], perCall[1], perCall[2], perCall[3]
+            )
+        )
+
+        results.forEach { assertTrue(it > 0) }
+    }
+
+    @Test
+    fun driverPath() {
+        run("driver path", "/data/user/0/org.ryujinx.android/files/drivers/turnip/vulkan.ad07xx.so")
+    }
+
+    @Test
+    fun userName() {
+        run("user name", "Ryujinx")
+    }
+
+    @Test
+    fun supplementaryCharacters() {
+        run("supplementary", "プレイヤー🎮".repeat(8))
+    }
+}
@@ -0,0 +1,297 @@
+//
+// Frame pacing for the emulator present loop.
+//
+// The GPU thread calls waitForPresent before handing a frame to the swapchain and
+// onFramePresented once it has been queued. Frames are released on a fixed grid of
+// whole refresh cycles, sized from the rate the game actually produces frames, so a
+// 30 fps title lands on every other vsync instead of alternating between one and
+// three. When the surface reports display present timestamps the grid is phase
+// locked to real vsyncs, otherwise queue times are used for the jitter statistics.
+//
+
+#include "frame_pacer.h"
+#include <ctime>
+#include <cerrno>
+#include <cstdlib>
+#include <android/log.h>
+
+FramePacer _framePacer;
+
+static int64_t getMonotonicTime() {
+    timespec time{};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<int64_t>(time.tv_sec) * 1000000000LL + time.tv_nsec;
+}
+
+static void sleepUntil(int64_t deadline) {
+    timespec time{};
+    time.tv_sec = deadline / 1000000000LL;
+    time.tv_nsec = deadline % 1000000000LL;
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr) == EINTR) {
+    }
+}
+
+void FramePacer::reset() {
+    std::lock_guard<std::mutex> guard(_lock);
+
+    resetLocked();
+}
+
+void FramePacer::resetLocked() {
+    _window = nullptr;
+    _refreshPeriod = DefaultRefreshPeriod;
+    _lastArrival = 0;
+    _lastSleep = 0;
+    _lastQueue = 0;
+    _lastDisplayPresent = 0;
+    _nextDeadline = 0;
+    _averageFrameTime = 0;
+    _intervalCycles = 1;
+    _candidateCycles = 1;
+    _candidateCount = 0;
+    _hasFrameTimestamps = false;
+    _pendingHead = 0;
+    _pendingCount = 0;
+}
+
+void FramePacer::attach(ANativeWindow *window) {
+    if (window == _window)
+        return;
+
+    resetLocked();
+
+    _window = window;
+
+    int64_t refreshPeriod = 0;
+    if (window->perform(window, NATIVE_WINDOW_GET_REFRESH_CYCLE_DURATION, &refreshPeriod) == 0 &&
+        refreshPeriod > 0) {
+        _refreshPeriod = refreshPeriod;
+    }
+
+    _hasFrameTimestamps = window->perform(window, NATIVE_WINDOW_ENABLE_FRAME_TIMESTAMPS, 1) == 0;
+
+    _targetInterval = _refreshPeriod;
+    _publishedRefreshPeriod = _refreshPeriod;
+    _publishedHasFrameTimestamps = _hasFrameTimestamps;
+
+    __android_log_print(ANDROID_LOG_INFO, "FramePacer",
+                        "Attached to window, refresh period %lld ns, frame timestamps %s",
+                        static_cast<long long>(_refreshPeriod),
+                        _hasFrameTimestamps ? "enabled" : "unavailable");
+}
+
+void FramePacer::updateInterval(int64_t frameTime) {
+    if (frameTime <= 0)
+        return;
+
+    _averageFrameTime = _averageFrameTime == 0
+                        ? frameTime
+                        : _averageFrameTime + (frameTime - _averageFrameTime) / 8;
+
+    // Allow the game to run up to 10% slower than a refresh multiple before stepping down.
+    auto tolerance = _refreshPeriod / 10;
+    int cycles = static_cast<int>((_averageFrameTime - tolerance + _refreshPeriod - 1) / _refreshPeriod);
+
+    if (cycles < 1)
+        cycles = 1;
+    else if (cycles > MaxIntervalCycles)
+        cycles = MaxIntervalCycles;
+
+    if (cycles == _intervalCycles) {
+        _candidateCount = 0;
+        return;
+    }
+
+    if (cycles != _candidateCycles) {
+        _candidateCycles = cycles;
+        _candidateCount = 0;
+    }
+
+    if (++_candidateCount < IntervalChangeThreshold)
+        return;
+
+    // Keep the grid anchored, only stretch or shrink the wait for the pending frame.
+    if (_nextDeadline != 0)
+        _nextDeadline += (cycles - _intervalCycles) * _refreshPeriod;
+
+    _intervalCycles = cycles;
+    _candidateCount = 0;
+    _targetInterval = _intervalCycles * _refreshPeriod;
+}
+
+int64_t FramePacer::alignToVsync(int64_t deadline) const {
+    if (_lastDisplayPresent <= 0)
+        return deadline;
+
+    // Release frames half a cycle before a vsync, leaving the GPU and compositor time to latch it.
+    auto anchor = _lastDisplayPresent - _refreshPeriod / 2;
+    auto phase = (deadline - anchor) % _refreshPeriod;
+
+    if (phase < 0)
+        phase += _refreshPeriod;
+
+    return phase < _refreshPeriod / 2 ? deadline - phase : deadline + (_refreshPeriod - phase);
+}
+
+PacingDecision FramePacer::waitForPresent(ANativeWindow *window) {
+    if (window == nullptr)
+        return PacingDecision::Immediate;
+
+    std::unique_lock<std::mutex> guard(_lock);
+
+    attach(window);
+
+    auto now = getMonotonicTime();
+
+    // Measure how fast frames are produced, excluding the time we held the producer back.
+    if (_lastArrival != 0)
+        updateInterval(now - _lastArrival - _lastSleep);
+
+    _lastArrival = now;
+    _lastSleep = 0;
+
+    if (!_enabled)
+        return PacingDecision::Immediate;
+
+    auto interval = _intervalCycles * _refreshPeriod;
+    auto decision = PacingDecision::Immediate;
+
+    if (_nextDeadline == 0) {
+        _nextDeadline = now + interval;
+    } else {
+        auto deadline = alignToVsync(_nextDeadline);
+
+        if (now < deadline) {
+            decision = PacingDecision::Delayed;
+            _nextDeadline = deadline + interval;
+
+            guard.unlock();
+            sleepUntil(deadline);
+            guard.lock();
+
+            _lastSleep = getMonotonicTime() - now;
+            _totalDelay += _lastSleep;
+        } else if (now - deadline > _refreshPeriod / 2) {
+            decision = PacingDecision::Late;
+            _nextDeadline = now + interval;
+        } else {
+            _nextDeadline = deadline + interval;
+        }
+    }
+
+    _framesPaced++;
+    _decisionCounts[static_cast<int>(decision)]++;
+    _lastDecision = static_cast<int32_t>(decision);
+
+    return decision;
+}
+
+void FramePacer::onFramePresented(ANativeWindow *window) {
+    if (window == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    if (window != _window)
+        return;
+
+    auto now = getMonotonicTime();
+
+    if (!_hasFrameTimestamps) {
+        if (_lastQueue != 0)
+            recordJitter(now - _lastQueue);
+
+        _lastQueue = now;
+        return;
+    }
+
+    _lastQueue = now;
+
+    uint64_t nextFrameId = 0;
+    if (window->perform(window, NATIVE_WINDOW_GET_NEXT_FRAME_ID, &nextFrameId) == 0 &&
+        nextFrameId > 0) {
+        if (_pendingCount == PendingFrameCount) {
+            _pendingHead = (_pendingHead + 1) % PendingFrameCount;
+            _pendingCount--;
+        }
+
+        _pendingFrames[(_pendingHead + _pendingCount) % PendingFrameCount] = nextFrameId - 1;
+        _pendingCount++;
+    }
+
+    pollDisplayTimestamps();
+}
+
+void FramePacer::pollDisplayTimestamps() {
+    while (_pendingCount > 0) {
+        auto frameId = _pendingFrames[_pendingHead];
+        int64_t *none = nullptr;
+        int64_t displayPresent = NativeWindowTimestampInvalid;
+
+        auto result = _window->perform(_window, NATIVE_WINDOW_GET_FRAME_TIMESTAMPS, frameId,
+                                       none, none, none, none, none, none,
+                                       &displayPresent, none, none);
+
+        // Timestamps arrive a few frames late, stop at the first frame that is still in flight.
+        if (result == 0 && displayPresent == NativeWindowTimestampPending)
+            break;
+
+        _pendingHead = (_pendingHead + 1) % PendingFrameCount;
+        _pendingCount--;
+
+        if (result != 0 || displayPresent <= 0)
+            continue;
+
+        if (_lastDisplayPresent > 0)
+            recordJitter(displayPresent - _lastDisplayPresent);
+
+        _lastDisplayPresent = displayPresent;
+    }
+}
+
+void FramePacer::recordJitter(int64_t interval) {
+    auto jitter = std::llabs(interval - _targetInterval.load(std::memory_order_relaxed));
+    auto bucket = jitter / JitterBucketWidth;
+
+    if (bucket >= JitterBucketCount)
+        bucket = JitterBucketCount - 1;
+
+    _jitterHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void FramePacer::setEnabled(bool enabled) {
+    _enabled = enabled;
+}
+
+bool FramePacer::isEnabled() const {
+    return _enabled;
+}
+
+void FramePacer::getStats(int64_t *stats) const {
+    stats[FramePacingStatTargetInterval] = _targetInterval;
+    stats[FramePacingStatRefreshPeriod] = _publishedRefreshPeriod;
+    stats[FramePacingStatFramesPaced] = _framesPaced;
+    stats[FramePacingStatFramesImmediate] = _decisionCounts[static_cast<int>(PacingDecision::Immediate)];
+    stats[FramePacingStatFramesDelayed] = _decisionCounts[static_cast<int>(PacingDecision::Delayed)];
+    stats[FramePacingStatFramesLate] = _decisionCounts[static_cast<int>(PacingDecision::Late)];
+    stats[FramePacingStatTotalDelay] = _totalDelay;
+    stats[FramePacingStatLastDecision] = _lastDecision;
+    stats[FramePacingStatDisplayTimestamps] = _publishedHasFrameTimestamps ? 1 : 0;
+}
+
+void FramePacer::getJitterHistogram(int32_t *histogram) const {
+    for (int i = 0; i < JitterBucketCount; i++)
+        histogram[i] = _jitterHistogram[i].load(std::memory_order_relaxed);
+}
+
+void FramePacer::resetStats() {
+    _framesPaced = 0;
+    _totalDelay = 0;
+
+    for (auto &count: _decisionCounts)
+        count = 0;
+
+    for (auto &bucket: _jitterHistogram)
+        bucket = 0;
+}
@@ -0,0 +1,106 @@
+//
+// Frame pacing for the emulator present loop.
+//
+
+#ifndef RYUJINXNATIVE_FRAME_PACER_H
+#define RYUJINXNATIVE_FRAME_PACER_H
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include "native_window.h"
+
+// How the pacer handled a single frame before it was allowed to present.
+enum class PacingDecision : int32_t {
+    // The frame arrived after its deadline but within half a refresh cycle, it was presented as is.
+    Immediate = 0,
+    // The frame arrived early and was held back until its deadline.
+    Delayed = 1,
+    // The frame missed its deadline by more than half a refresh cycle, the schedule was re-anchored.
+    Late = 2,
+};
+
+// Layout of the array returned by NativeHelpers.getFramePacingStats.
+enum FramePacingStat {
+    FramePacingStatTargetInterval = 0,
+    FramePacingStatRefreshPeriod,
+    FramePacingStatFramesPaced,
+    FramePacingStatFramesImmediate,
+    FramePacingStatFramesDelayed,
+    FramePacingStatFramesLate,
+    FramePacingStatTotalDelay,
+    FramePacingStatLastDecision,
+    FramePacingStatDisplayTimestamps,
+    FramePacingStatCount
+};
+
+class FramePacer {
+public:
+    // Jitter is bucketed in 0.5 ms steps, the last bucket collects everything above.
+    static constexpr int JitterBucketCount = 32;
+    static constexpr int64_t JitterBucketWidth = 500000;
+
+    // Called once the rendering thread starts, drops all schedule state.
+    void reset();
+
+    // Blocks the calling thread until the next frame may be presented on the given window.
+    PacingDecision waitForPresent(ANativeWindow *window);
+
+    // Records that a frame has been queued to the given window.
+    void onFramePresented(ANativeWindow *window);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void getStats(int64_t *stats) const;
+    void getJitterHistogram(int32_t *histogram) const;
+    void resetStats();
+
+private:
+    static constexpr int PendingFrameCount = 8;
+    static constexpr int64_t DefaultRefreshPeriod = 16666667;
+    static constexpr int MaxIntervalCycles = 4;
+    static constexpr int IntervalChangeThreshold = 30;
+
+    void resetLocked();
+    void attach(ANativeWindow *window);
+    void updateInterval(int64_t frameTime);
+    int64_t alignToVsync(int64_t deadline) const;
+    void pollDisplayTimestamps();
+    void recordJitter(int64_t interval);
+
+    std::atomic<bool> _enabled{true};
+
+    // Schedule state. waitForPresent runs on the GPU thread while onFramePresented runs on
+    // whichever thread queues the swapchain image, so both take the lock.
+    std::mutex _lock;
+    ANativeWindow *_window = nullptr;
+    int64_t _refreshPeriod = DefaultRefreshPeriod;
+    int64_t _lastArrival = 0;
+    int64_t _lastSleep = 0;
+    int64_t _lastQueue = 0;
+    int64_t _lastDisplayPresent = 0;
+    int64_t _nextDeadline = 0;
+    int64_t _averageFrameTime = 0;
+    int _intervalCycles = 1;
+    int _candidateCycles = 1;
+    int _candidateCount = 0;
+    bool _hasFrameTimestamps = false;
+    uint64_t _pendingFrames[PendingFrameCount] = {};
+    int _pendingHead = 0;
+    int _pendingCount = 0;
+
+    // Stats, read from the UI thread.
+    std::atomic<int64_t> _targetInterval{DefaultRefreshPeriod};
+    std::atomic<int64_t> _publishedRefreshPeriod{DefaultRefreshPeriod};
+    std::atomic<int64_t> _framesPaced{0};
+    std::atomic<int64_t> _decisionCounts[3] = {};
+    std::atomic<int64_t> _totalDelay{0};
+    std::atomic<int32_t> _lastDecision{0};
+    std::atomic<bool> _publishedHasFrameTimestamps{false};
+    std::atomic<int32_t> _jitterHistogram[JitterBucketCount] = {};
+};
+
+extern FramePacer _framePacer;
+
+#endif //RYUJINXNATIVE_FRAME_PACER_H
@@ -0,0 +1,159 @@
+//
+// Measures the throughput of the CPU FSR kernels for every supported instruction set.
+//
+// Usage: fsr_benchmark [srcWidth srcHeight dstWidth dstHeight [iterations]]
+//
+// Every vectorized result is compared against the scalar reference, and the benchmark fails if any
+// output byte differs.
+//
+
+#include "fsr_cpu.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    struct Image {
+        int32_t width;
+        int32_t height;
+        std::vector<uint8_t> pixels;
+
+        Image(int32_t width, int32_t height) : width(width), height(height),
+                                               pixels(static_cast<size_t>(width) * height * 4) {}
+
+        int32_t stride() const { return width * 4; }
+    };
+
+    // Gradients with hard diagonal edges and some noise, so every branch of the filters is exercised.
+    Image makeSource(int32_t width, int32_t height) {
+        Image image(width, height);
+        uint32_t seed = 0x12345678;
+
+        for (int32_t y = 0; y < height; y++) {
+            for (int32_t x = 0; x < width; x++) {
+                seed = seed * 1664525u + 1013904223u;
+                uint8_t noise = static_cast<uint8_t>(seed >> 28);
+                bool edge = ((x + y) / 16 + (x - y + height) / 24) & 1;
+                uint8_t *pixel = &image.pixels[(static_cast<size_t>(y) * width + x) * 4];
+
+                pixel[0] = static_cast<uint8_t>((x * 255 / width) ^ (edge ? 0xc0 : 0) ^ noise);
+                pixel[1] = static_cast<uint8_t>((y * 255 / height) + noise);
+                pixel[2] = edge ? 230 : static_cast<uint8_t>(20 + noise);
+                pixel[3] = 255;
+            }
+        }
+
+        return image;
+    }
+
+    template<typename F>
+    double measure(int iterations, F &&run) {
+        // One untimed run to size the working images.
+        run();
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < iterations; i++) {
+            run();
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / iterations;
+    }
+
+    int maxDifference(const Image &a, const Image &b) {
+        int result = 0;
+
+        for (size_t i = 0; i < a.pixels.size(); i++) {
+            result = std::max(result, std::abs(a.pixels[i] - b.pixels[i]));
+        }
+
+        return result;
+    }
+}
+
+int main(int argc, char **argv) {
+    int32_t srcWidth = 1280;
+    int32_t srcHeight = 720;
+    int32_t dstWidth = 1920;
+    int32_t dstHeight = 1080;
+    int iterations = 5;
+
+    if (argc >= 5) {
+        srcWidth = std::atoi(argv[1]);
+        srcHeight = std::atoi(argv[2]);
+        dstWidth = std::atoi(argv[3]);
+        dstHeight = std::atoi(argv[4]);
+    }
+
+    if (argc >= 6) {
+        iterations = std::max(1, std::atoi(argv[5]));
+    }
+
+    if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0) {
+        std::fprintf(stderr, "invalid image size\n");
+        return 1;
+    }
+
+    const float sharpness = 0.25f;
+    const double megapixels = static_cast<double>(dstWidth) * dstHeight / 1e6;
+
+    Image source = makeSource(srcWidth, srcHeight);
+    Image upscaled(dstWidth, dstHeight);
+    Image referenceEasu(dstWidth, dstHeight);
+    Image referenceUpscale(dstWidth, dstHeight);
+
+    fsrEasu(source.pixels.data(), srcWidth, srcHeight, source.stride(),
+            referenceEasu.pixels.data(), dstWidth, dstHeight, referenceEasu.stride(), FsrIsaScalar);
+    fsrUpscale(source.pixels.data(), srcWidth, srcHeight, source.stride(),
+               referenceUpscale.pixels.data(), dstWidth, dstHeight, referenceUpscale.stride(), sharpness, FsrIsaScalar);
+
+    std::printf("FSR %dx%d -> %dx%d, %d iterations, best isa: %s\n",
+                srcWidth, srcHeight, dstWidth, dstHeight, iterations, fsrGetIsaName(fsrGetBestIsa()));
+    std::printf("%-8s %12s %12s %12s %8s\n", "isa", "easu MP/s", "rcas MP/s", "fsr MP/s", "maxdiff");
+
+    uint32_t isas = fsrGetSupportedIsas();
+    bool mismatch = false;
+
+    for (FsrIsa isa : {FsrIsaScalar, FsrIsaSse41, FsrIsaAvx2, FsrIsaNeon}) {
+        if ((isas & (1u << isa)) == 0) {
+            continue;
+        }
+
+        double easuTime = measure(iterations, [&] {
+            fsrEasu(source.pixels.data(), srcWidth, srcHeight, source.stride(),
+                    upscaled.pixels.data(), dstWidth, dstHeight, upscaled.stride(), isa);
+        });
+
+        int difference = maxDifference(upscaled, referenceEasu);
+
+        Image sharpened(dstWidth, dstHeight);
+
+        double rcasTime = measure(iterations, [&] {
+            fsrRcas(referenceEasu.pixels.data(), dstWidth, dstHeight, referenceEasu.stride(),
+                    sharpened.pixels.data(), sharpened.stride(), sharpness, isa);
+        });
+
+        double upscaleTime = measure(iterations, [&] {
+            fsrUpscale(source.pixels.data(), srcWidth, srcHeight, source.stride(),
+                       upscaled.pixels.data(), dstWidth, dstHeight, upscaled.stride(), sharpness, isa);
+        });
+
+        difference = std::max(difference, maxDifference(upscaled, referenceUpscale));
+        mismatch |= difference != 0;
+
+        std::printf("%-8s %12.1f %12.1f %12.1f %8d\n", fsrGetIsaName(isa),
+                    megapixels / easuTime, megapixels / rcasTime, megapixels / upscaleTime, difference);
+    }
+
+    if (mismatch) {
+        std::fprintf(stderr, "vectorized output differs from the scalar reference\n");
+        return 1;
+    }
+
+    return 0;
+}
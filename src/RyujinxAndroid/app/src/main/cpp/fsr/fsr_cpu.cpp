@@ -0,0 +1,216 @@
+#include "fsr_cpu.h"
+#include "fsr_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// The constant setup functions of ffx_fsr1.h are shared with the shaders, the filters themselves are
+// GPU only and are ported in fsr_kernels.h.
+#define A_CPU 1
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+
+#include "ffx_a.h"
+#include "ffx_fsr1.h"
+
+#pragma GCC diagnostic pop
+
+namespace {
+    const FsrKernelTable *getKernels(FsrIsa isa) {
+        if ((fsrGetSupportedIsas() & (1u << isa)) == 0) {
+            return nullptr;
+        }
+
+        switch (isa) {
+            case FsrIsaScalar:
+                return &FsrKernelsScalar;
+#if defined(__x86_64__) || defined(__i386__)
+            case FsrIsaSse41:
+                return &FsrKernelsSse41;
+            case FsrIsaAvx2:
+                return &FsrKernelsAvx2;
+#endif
+#if defined(__aarch64__)
+            case FsrIsaNeon:
+                return &FsrKernelsNeon;
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+    float bitsToFloat(AU1 bits) {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void toPlanes(const uint8_t *src, int32_t width, int32_t height, int32_t stride, FsrPlanes &planes) {
+        planes.resize(width, height);
+
+        for (int32_t y = 0; y < height; y++) {
+            const uint8_t *row = src + static_cast<size_t>(y) * stride;
+            size_t offset = static_cast<size_t>(y) * width;
+
+            for (int32_t x = 0; x < width; x++) {
+                planes.r[offset + x] = row[x * 4 + 0] * (1.0f / 255.0f);
+                planes.g[offset + x] = row[x * 4 + 1] * (1.0f / 255.0f);
+                planes.b[offset + x] = row[x * 4 + 2] * (1.0f / 255.0f);
+            }
+        }
+    }
+
+    uint8_t toUnorm8(float value) {
+        return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    void fromPlanes(const FsrPlanes &planes, uint8_t *dst, int32_t stride) {
+        for (int32_t y = 0; y < planes.height; y++) {
+            uint8_t *row = dst + static_cast<size_t>(y) * stride;
+            size_t offset = static_cast<size_t>(y) * planes.width;
+
+            for (int32_t x = 0; x < planes.width; x++) {
+                row[x * 4 + 0] = toUnorm8(planes.r[offset + x]);
+                row[x * 4 + 1] = toUnorm8(planes.g[offset + x]);
+                row[x * 4 + 2] = toUnorm8(planes.b[offset + x]);
+                row[x * 4 + 3] = 255;
+            }
+        }
+    }
+
+    FsrEasuConstants getEasuConstants(int32_t srcWidth, int32_t srcHeight, int32_t dstWidth, int32_t dstHeight) {
+        AU1 con0[4], con1[4], con2[4], con3[4];
+
+        FsrEasuCon(con0, con1, con2, con3,
+                   static_cast<AF1>(srcWidth), static_cast<AF1>(srcHeight),
+                   static_cast<AF1>(srcWidth), static_cast<AF1>(srcHeight),
+                   static_cast<AF1>(dstWidth), static_cast<AF1>(dstHeight));
+
+        return {bitsToFloat(con0[0]), bitsToFloat(con0[1]), bitsToFloat(con0[2]), bitsToFloat(con0[3])};
+    }
+
+    float getRcasSharpness(float sharpness) {
+        AU1 con[4];
+
+        FsrRcasCon(con, sharpness);
+
+        return bitsToFloat(con[0]);
+    }
+
+    bool validSize(int32_t width, int32_t height, int32_t stride) {
+        return width > 0 && height > 0 && stride >= width * 4;
+    }
+
+    // Working images are kept per thread, so repeated calls for the same size don't allocate.
+    thread_local FsrPlanes sourcePlanes;
+    thread_local FsrPlanes easuPlanes;
+    thread_local FsrPlanes rcasPlanes;
+}
+
+uint32_t fsrGetSupportedIsas() {
+    uint32_t isas = 1u << FsrIsaScalar;
+
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("sse4.1")) {
+        isas |= 1u << FsrIsaSse41;
+    }
+
+    if (__builtin_cpu_supports("avx2")) {
+        isas |= 1u << FsrIsaAvx2;
+    }
+#endif
+
+#if defined(__aarch64__)
+    isas |= 1u << FsrIsaNeon;
+#endif
+
+    return isas;
+}
+
+FsrIsa fsrGetBestIsa() {
+    uint32_t isas = fsrGetSupportedIsas();
+
+    for (FsrIsa isa : {FsrIsaAvx2, FsrIsaNeon, FsrIsaSse41}) {
+        if (isas & (1u << isa)) {
+            return isa;
+        }
+    }
+
+    return FsrIsaScalar;
+}
+
+const char *fsrGetIsaName(FsrIsa isa) {
+    switch (isa) {
+        case FsrIsaScalar:
+            return "scalar";
+        case FsrIsaSse41:
+            return "sse4.1";
+        case FsrIsaAvx2:
+            return "avx2";
+        case FsrIsaNeon:
+            return "neon";
+        default:
+            return "unknown";
+    }
+}
+
+bool fsrEasu(const uint8_t *src, int32_t srcWidth, int32_t srcHeight, int32_t srcStride,
+             uint8_t *dst, int32_t dstWidth, int32_t dstHeight, int32_t dstStride, FsrIsa isa) {
+    auto kernels = getKernels(isa);
+
+    if (kernels == nullptr || !validSize(srcWidth, srcHeight, srcStride) || !validSize(dstWidth, dstHeight, dstStride)) {
+        return false;
+    }
+
+    toPlanes(src, srcWidth, srcHeight, srcStride, sourcePlanes);
+    easuPlanes.resize(dstWidth, dstHeight);
+
+    kernels->easu(sourcePlanes, getEasuConstants(srcWidth, srcHeight, dstWidth, dstHeight), easuPlanes, 0, dstHeight);
+
+    fromPlanes(easuPlanes, dst, dstStride);
+
+    return true;
+}
+
+bool fsrRcas(const uint8_t *src, int32_t width, int32_t height, int32_t srcStride,
+             uint8_t *dst, int32_t dstStride, float sharpness, FsrIsa isa) {
+    auto kernels = getKernels(isa);
+
+    if (kernels == nullptr || !validSize(width, height, srcStride) || !validSize(width, height, dstStride)) {
+        return false;
+    }
+
+    toPlanes(src, width, height, srcStride, sourcePlanes);
+    rcasPlanes.resize(width, height);
+
+    kernels->rcas(sourcePlanes, getRcasSharpness(sharpness), rcasPlanes, 0, height);
+
+    fromPlanes(rcasPlanes, dst, dstStride);
+
+    return true;
+}
+
+bool fsrUpscale(const uint8_t *src, int32_t srcWidth, int32_t srcHeight, int32_t srcStride,
+                uint8_t *dst, int32_t dstWidth, int32_t dstHeight, int32_t dstStride, float sharpness, FsrIsa isa) {
+    auto kernels = getKernels(isa);
+
+    if (kernels == nullptr || !validSize(srcWidth, srcHeight, srcStride) || !validSize(dstWidth, dstHeight, dstStride)) {
+        return false;
+    }
+
+    // The intermediate image stays in float, like the render target between the two passes on the GPU.
+    toPlanes(src, srcWidth, srcHeight, srcStride, sourcePlanes);
+    easuPlanes.resize(dstWidth, dstHeight);
+    rcasPlanes.resize(dstWidth, dstHeight);
+
+    kernels->easu(sourcePlanes, getEasuConstants(srcWidth, srcHeight, dstWidth, dstHeight), easuPlanes, 0, dstHeight);
+    kernels->rcas(easuPlanes, getRcasSharpness(sharpness), rcasPlanes, 0, dstHeight);
+
+    fromPlanes(rcasPlanes, dst, dstStride);
+
+    return true;
+}
@@ -0,0 +1,43 @@
+//
+// CPU implementation of FidelityFX Super Resolution 1.0 (EASU upscaling and RCAS sharpening).
+//
+
+#ifndef RYUJINXNATIVE_FSR_CPU_H
+#define RYUJINXNATIVE_FSR_CPU_H
+
+#include <cstdint>
+
+// Instruction sets the kernels are built for. The scalar path is the reference implementation, the
+// vectorized ones produce bit identical output.
+enum FsrIsa : int32_t {
+    FsrIsaScalar = 0,
+    FsrIsaSse41 = 1,
+    FsrIsaAvx2 = 2,
+    FsrIsaNeon = 3,
+};
+
+extern "C" {
+
+// Bitmask of (1 << FsrIsa) for every instruction set that was built and is supported by this CPU.
+uint32_t fsrGetSupportedIsas();
+
+FsrIsa fsrGetBestIsa();
+
+const char *fsrGetIsaName(FsrIsa isa);
+
+// Images are RGBA8 with a stride in bytes. Alpha is not filtered, output pixels are opaque.
+// Each function returns false if the ISA is unavailable or the sizes are invalid.
+
+bool fsrEasu(const uint8_t *src, int32_t srcWidth, int32_t srcHeight, int32_t srcStride,
+             uint8_t *dst, int32_t dstWidth, int32_t dstHeight, int32_t dstStride, FsrIsa isa);
+
+// Sharpness is in stops, 0 is the sharpest. It is the same value the shaders pass to FsrRcasCon.
+bool fsrRcas(const uint8_t *src, int32_t width, int32_t height, int32_t srcStride,
+             uint8_t *dst, int32_t dstStride, float sharpness, FsrIsa isa);
+
+bool fsrUpscale(const uint8_t *src, int32_t srcWidth, int32_t srcHeight, int32_t srcStride,
+                uint8_t *dst, int32_t dstWidth, int32_t dstHeight, int32_t dstStride, float sharpness, FsrIsa isa);
+
+}
+
+#endif //RYUJINXNATIVE_FSR_CPU_H
@@ -0,0 +1,370 @@
+//
+// EASU and RCAS from ffx_fsr1.h, written once against the vector types in fsr_simd.h.
+//
+
+#ifndef RYUJINXNATIVE_FSR_KERNELS_H
+#define RYUJINXNATIVE_FSR_KERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Planar 32-bit float image, one plane per color channel.
+struct FsrPlanes {
+    int32_t width = 0;
+    int32_t height = 0;
+    std::vector<float> r;
+    std::vector<float> g;
+    std::vector<float> b;
+
+    void resize(int32_t newWidth, int32_t newHeight) {
+        width = newWidth;
+        height = newHeight;
+        r.resize(static_cast<size_t>(newWidth) * newHeight);
+        g.resize(static_cast<size_t>(newWidth) * newHeight);
+        b.resize(static_cast<size_t>(newWidth) * newHeight);
+    }
+};
+
+// Output pixel to input pixel mapping, decoded from con0 of FsrEasuCon.
+struct FsrEasuConstants {
+    float scaleX;
+    float scaleY;
+    float offsetX;
+    float offsetY;
+};
+
+// Each function processes output rows [y0, y1), so callers can split an image between threads.
+struct FsrKernelTable {
+    void (*easu)(const FsrPlanes &src, const FsrEasuConstants &con, FsrPlanes &dst, int32_t y0, int32_t y1);
+    void (*rcas)(const FsrPlanes &src, float sharpness, FsrPlanes &dst, int32_t y0, int32_t y1);
+};
+
+extern const FsrKernelTable FsrKernelsScalar;
+extern const FsrKernelTable FsrKernelsSse41;
+extern const FsrKernelTable FsrKernelsAvx2;
+extern const FsrKernelTable FsrKernelsNeon;
+
+#ifdef FSR_KERNEL_IMPLEMENTATION
+
+#include "fsr_simd.h"
+
+namespace fsr {
+
+// ffx_a.h approximations, see APrxLoRcpF1, APrxMedRcpF1 and APrxLoRsqF1.
+template<typename V>
+inline V rcpLo(V a) {
+    return V::subFromBits(0x7ef07ebb, a);
+}
+
+template<typename V>
+inline V rcpMed(V a) {
+    V b = V::subFromBits(0x7ef19fff, a);
+    return b * (V::broadcast(2.0f) - b * a);
+}
+
+template<typename V>
+inline V rsqLo(V a) {
+    return V::subFromHalfBits(0x5f347d74, a);
+}
+
+template<typename V>
+inline V saturate(V a) {
+    return V::min(V::broadcast(1.0f), V::max(V::broadcast(0.0f), a));
+}
+
+template<typename V>
+inline V luma(V r, V g, V b) {
+    return b * V::broadcast(0.5f) + (r * V::broadcast(0.5f) + g);
+}
+
+template<typename V>
+inline void easuSet(V &dirX, V &dirY, V &len, V w, V lA, V lB, V lC, V lD, V lE) {
+    V dc = lD - lC;
+    V cb = lC - lB;
+    V lenX = rcpLo(V::max(V::abs(dc), V::abs(cb)));
+    V dx = lD - lB;
+    dirX = dirX + dx * w;
+    lenX = saturate(V::abs(dx) * lenX);
+    lenX = lenX * lenX;
+    len = len + lenX * w;
+
+    V ec = lE - lC;
+    V ca = lC - lA;
+    V lenY = rcpLo(V::max(V::abs(ec), V::abs(ca)));
+    V dy = lE - lA;
+    dirY = dirY + dy * w;
+    lenY = saturate(V::abs(dy) * lenY);
+    lenY = lenY * lenY;
+    len = len + lenY * w;
+}
+
+template<typename V>
+struct EasuTap {
+    V r, g, b;
+};
+
+template<typename V>
+struct EasuState {
+    V ppX, ppY;
+    V dirX, dirY;
+    V len2X, len2Y;
+    V lob, clp;
+    V aR, aG, aB, aW;
+
+    void tap(float offX, float offY, const EasuTap<V> &c) {
+        V ox = V::broadcast(offX) - ppX;
+        V oy = V::broadcast(offY) - ppY;
+        V vx = ox * dirX + oy * dirY;
+        V vy = ox * (V::broadcast(0.0f) - dirY) + oy * dirX;
+        vx = vx * len2X;
+        vy = vy * len2Y;
+        V d2 = V::min(vx * vx + vy * vy, clp);
+        V wB = V::broadcast(2.0f / 5.0f) * d2 + V::broadcast(-1.0f);
+        V wA = lob * d2 + V::broadcast(-1.0f);
+        wB = wB * wB;
+        wA = wA * wA;
+        wB = V::broadcast(25.0f / 16.0f) * wB + V::broadcast(-(25.0f / 16.0f - 1.0f));
+        V w = wB * wA;
+        aR = aR + c.r * w;
+        aG = aG + c.g * w;
+        aB = aB + c.b * w;
+        aW = aW + w;
+    }
+};
+
+// Port of FsrEasuF. The 12 taps are read directly with clamp to edge addressing, which is what the
+// textureGather calls of the shader resolve to.
+template<typename V>
+inline void easuPixels(const FsrPlanes &src, const FsrEasuConstants &con, FsrPlanes &dst, int32_t x, int32_t y) {
+    // All lanes share the output row, so the vertical position is computed once.
+    float rowY = static_cast<float>(y) * con.scaleY + con.offsetY;
+    float floorY = std::floor(rowY);
+
+    V ppX = V::ramp(static_cast<float>(x)) * V::broadcast(con.scaleX) + V::broadcast(con.offsetX);
+    V fpX = V::floor(ppX);
+    ppX = ppX - fpX;
+    V ppY = V::broadcast(rowY - floorY);
+
+    auto maxX = src.width - 1;
+    auto maxY = src.height - 1;
+    auto fx = V::toInt(fpX);
+    auto fy = static_cast<int32_t>(floorY);
+
+    typename V::Int columns[4] = {
+        V::clamp(V::add(fx, -1), 0, maxX),
+        V::clamp(fx, 0, maxX),
+        V::clamp(V::add(fx, 1), 0, maxX),
+        V::clamp(V::add(fx, 2), 0, maxX),
+    };
+
+    int32_t rows[4];
+
+    for (int row = 0; row < 4; row++) {
+        int32_t clamped = std::min(std::max(fy + row - 1, 0), maxY);
+        rows[row] = clamped * src.width;
+    }
+
+    auto fetch = [&](int column, int row) {
+        auto index = V::add(columns[column], rows[row]);
+        return EasuTap<V>{V::gather(src.r.data(), index), V::gather(src.g.data(), index),
+                          V::gather(src.b.data(), index)};
+    };
+
+    //    b c
+    //  e f g h
+    //  i j k l
+    //    n o
+    auto b = fetch(1, 0);
+    auto c = fetch(2, 0);
+    auto e = fetch(0, 1);
+    auto f = fetch(1, 1);
+    auto g = fetch(2, 1);
+    auto h = fetch(3, 1);
+    auto i = fetch(0, 2);
+    auto j = fetch(1, 2);
+    auto k = fetch(2, 2);
+    auto l = fetch(3, 2);
+    auto n = fetch(1, 3);
+    auto o = fetch(2, 3);
+
+    V bL = luma(b.r, b.g, b.b);
+    V cL = luma(c.r, c.g, c.b);
+    V eL = luma(e.r, e.g, e.b);
+    V fL = luma(f.r, f.g, f.b);
+    V gL = luma(g.r, g.g, g.b);
+    V hL = luma(h.r, h.g, h.b);
+    V iL = luma(i.r, i.g, i.b);
+    V jL = luma(j.r, j.g, j.b);
+    V kL = luma(k.r, k.g, k.b);
+    V lL = luma(l.r, l.g, l.b);
+    V nL = luma(n.r, n.g, n.b);
+    V oL = luma(o.r, o.g, o.b);
+
+    V one = V::broadcast(1.0f);
+    V dirX = V::broadcast(0.0f);
+    V dirY = V::broadcast(0.0f);
+    V len = V::broadcast(0.0f);
+
+    easuSet(dirX, dirY, len, (one - ppX) * (one - ppY), bL, eL, fL, gL, jL);
+    easuSet(dirX, dirY, len, ppX * (one - ppY), cL, fL, gL, hL, kL);
+    easuSet(dirX, dirY, len, (one - ppX) * ppY, fL, iL, jL, kL, nL);
+    easuSet(dirX, dirY, len, ppX * ppY, gL, jL, kL, lL, oL);
+
+    // Normalize with approximation, and cleanup close to zero.
+    V dirR = dirX * dirX + dirY * dirY;
+    auto zero = V::less(dirR, V::broadcast(1.0f / 32768.0f));
+    dirR = V::select(zero, one, rsqLo(dirR));
+    dirX = V::select(zero, one, dirX);
+    dirX = dirX * dirR;
+    dirY = dirY * dirR;
+
+    len = len * V::broadcast(0.5f);
+    len = len * len;
+
+    V stretch = (dirX * dirX + dirY * dirY) * rcpLo(V::max(V::abs(dirX), V::abs(dirY)));
+
+    EasuState<V> state;
+    state.ppX = ppX;
+    state.ppY = ppY;
+    state.dirX = dirX;
+    state.dirY = dirY;
+    state.len2X = one + (stretch - one) * len;
+    state.len2Y = one + V::broadcast(-0.5f) * len;
+    state.lob = V::broadcast(0.5f) + V::broadcast((1.0f / 4.0f - 0.04f) - 0.5f) * len;
+    state.clp = rcpLo(state.lob);
+    state.aR = state.aG = state.aB = state.aW = V::broadcast(0.0f);
+
+    state.tap(0.0f, -1.0f, b);
+    state.tap(1.0f, -1.0f, c);
+    state.tap(-1.0f, 1.0f, i);
+    state.tap(0.0f, 1.0f, j);
+    state.tap(0.0f, 0.0f, f);
+    state.tap(-1.0f, 0.0f, e);
+    state.tap(1.0f, 1.0f, k);
+    state.tap(2.0f, 1.0f, l);
+    state.tap(2.0f, 0.0f, h);
+    state.tap(1.0f, 0.0f, g);
+    state.tap(1.0f, 2.0f, o);
+    state.tap(0.0f, 2.0f, n);
+
+    // Normalize and dering against the 4 nearest taps.
+    V rcpW = one / state.aW;
+    auto resolve = [&](V accumulated, V f, V g, V j, V k) {
+        V min4 = V::min(V::min(f, V::min(g, j)), k);
+        V max4 = V::max(V::max(f, V::max(g, j)), k);
+        return V::min(max4, V::max(min4, accumulated * rcpW));
+    };
+
+    size_t offset = static_cast<size_t>(y) * dst.width + x;
+    resolve(state.aR, f.r, g.r, j.r, k.r).store(&dst.r[offset]);
+    resolve(state.aG, f.g, g.g, j.g, k.g).store(&dst.g[offset]);
+    resolve(state.aB, f.b, g.b, j.b, k.b).store(&dst.b[offset]);
+}
+
+template<typename V>
+void easuRows(const FsrPlanes &src, const FsrEasuConstants &con, FsrPlanes &dst, int32_t y0, int32_t y1) {
+    for (int32_t y = y0; y < y1; y++) {
+        int32_t x = 0;
+
+        for (; x + V::Width <= dst.width; x += V::Width)
+            easuPixels<V>(src, con, dst, x, y);
+
+        for (; x < dst.width; x++)
+            easuPixels<ScalarVec>(src, con, dst, x, y);
+    }
+}
+
+template<typename V>
+inline V max3(V a, V b, V c) {
+    return V::max(a, V::max(b, c));
+}
+
+template<typename V>
+inline V min3(V a, V b, V c) {
+    return V::min(a, V::min(b, c));
+}
+
+// Port of FsrRcasF without FSR_RCAS_DENOISE, matching the sharpening shader. The noise detection term is
+// only used by the denoise path, so it is left out.
+template<typename V>
+inline void rcasPixels(const FsrPlanes &src, V sharpness, FsrPlanes &dst, int32_t x, int32_t y,
+                       int32_t left, int32_t right, int32_t up, int32_t down) {
+    size_t center = static_cast<size_t>(y) * src.width;
+    size_t above = static_cast<size_t>(up) * src.width;
+    size_t below = static_cast<size_t>(down) * src.width;
+
+    //    b
+    //  d e f
+    //    h
+    auto resolve = [&](const std::vector<float> &plane, V &bv, V &dv, V &ev, V &fv, V &hv) {
+        bv = V::load(&plane[above + x]);
+        dv = V::load(&plane[center + left]);
+        ev = V::load(&plane[center + x]);
+        fv = V::load(&plane[center + right]);
+        hv = V::load(&plane[below + x]);
+    };
+
+    V bR, dR, eR, fR, hR;
+    V bG, dG, eG, fG, hG;
+    V bB, dB, eB, fB, hB;
+    resolve(src.r, bR, dR, eR, fR, hR);
+    resolve(src.g, bG, dG, eG, fG, hG);
+    resolve(src.b, bB, dB, eB, fB, hB);
+
+    auto lobeFor = [](V b, V d, V e, V f, V h) {
+        V mn4 = V::min(min3(b, d, f), h);
+        V mx4 = V::max(max3(b, d, f), h);
+        V hitMin = V::min(mn4, e) * (V::broadcast(1.0f) / (V::broadcast(4.0f) * mx4));
+        V hitMax = (V::broadcast(1.0f) - V::max(mx4, e)) *
+                   (V::broadcast(1.0f) / (V::broadcast(4.0f) * mn4 + V::broadcast(-4.0f)));
+        return V::max(V::broadcast(0.0f) - hitMin, hitMax);
+    };
+
+    V lobe = max3(lobeFor(bR, dR, eR, fR, hR), lobeFor(bG, dG, eG, fG, hG), lobeFor(bB, dB, eB, fB, hB));
+    lobe = V::max(V::broadcast(-(0.25f - 1.0f / 16.0f)), V::min(lobe, V::broadcast(0.0f))) * sharpness;
+
+    V rcpL = rcpMed(V::broadcast(4.0f) * lobe + V::broadcast(1.0f));
+
+    size_t offset = static_cast<size_t>(y) * dst.width + x;
+    ((lobe * bR + lobe * dR + lobe * hR + lobe * fR + eR) * rcpL).store(&dst.r[offset]);
+    ((lobe * bG + lobe * dG + lobe * hG + lobe * fG + eG) * rcpL).store(&dst.g[offset]);
+    ((lobe * bB + lobe * dB + lobe * hB + lobe * fB + eB) * rcpL).store(&dst.b[offset]);
+}
+
+template<typename V>
+void rcasRows(const FsrPlanes &src, float sharpness, FsrPlanes &dst, int32_t y0, int32_t y1) {
+    auto maxX = src.width - 1;
+    auto maxY = src.height - 1;
+
+    auto scalarPixel = [&](int32_t x, int32_t y, int32_t up, int32_t down) {
+        rcasPixels<ScalarVec>(src, ScalarVec::broadcast(sharpness), dst, x, y,
+                              x > 0 ? x - 1 : 0, x < maxX ? x + 1 : maxX, up, down);
+    };
+
+    for (int32_t y = y0; y < y1; y++) {
+        int32_t up = y > 0 ? y - 1 : 0;
+        int32_t down = y < maxY ? y + 1 : maxY;
+
+        // Away from the left and right edges the neighbours are contiguous and can be loaded as vectors.
+        scalarPixel(0, y, up, down);
+
+        int32_t x = 1;
+
+        for (; x + V::Width <= maxX; x += V::Width)
+            rcasPixels<V>(src, V::broadcast(sharpness), dst, x, y, x - 1, x + 1, up, down);
+
+        for (; x <= maxX; x++)
+            scalarPixel(x, y, up, down);
+    }
+}
+
+}
+
+#define FSR_DEFINE_KERNEL_TABLE(name, type) \
+    const FsrKernelTable name = {fsr::easuRows<type>, fsr::rcasRows<type>}
+
+#endif
+
+#endif //RYUJINXNATIVE_FSR_KERNELS_H
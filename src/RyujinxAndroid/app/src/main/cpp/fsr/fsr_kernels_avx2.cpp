@@ -0,0 +1,6 @@
+// Built with -mavx2, only called after checking for support at runtime.
+
+#define FSR_KERNEL_IMPLEMENTATION
+#include "fsr_kernels.h"
+
+FSR_DEFINE_KERNEL_TABLE(FsrKernelsAvx2, Avx2Vec);
@@ -0,0 +1,6 @@
+// NEON is part of the AArch64 baseline, so this table is always usable when built.
+
+#define FSR_KERNEL_IMPLEMENTATION
+#include "fsr_kernels.h"
+
+FSR_DEFINE_KERNEL_TABLE(FsrKernelsNeon, NeonVec);
@@ -0,0 +1,4 @@
+#define FSR_KERNEL_IMPLEMENTATION
+#include "fsr_kernels.h"
+
+FSR_DEFINE_KERNEL_TABLE(FsrKernelsScalar, ScalarVec);
@@ -0,0 +1,236 @@
+//
+// Minimal float vector types used to instantiate the FSR kernels for each instruction set.
+//
+
+#ifndef RYUJINXNATIVE_FSR_SIMD_H
+#define RYUJINXNATIVE_FSR_SIMD_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Every type provides the same operations with the same rounding, so a kernel produces bit identical
+// results for every instantiation as long as the compiler doesn't contract multiplies and adds.
+// min and max follow the "a < b ? a : b" convention, which is what SSE does for NaN operands.
+
+struct ScalarVec {
+    static constexpr int Width = 1;
+
+    using Int = int32_t;
+    using Mask = bool;
+
+    float v;
+
+    static ScalarVec load(const float *p) { return {*p}; }
+    static ScalarVec broadcast(float value) { return {value}; }
+    static ScalarVec ramp(float start) { return {start}; }
+    void store(float *p) const { *p = v; }
+
+    static ScalarVec gather(const float *base, Int index) { return {base[index]}; }
+
+    friend ScalarVec operator+(ScalarVec a, ScalarVec b) { return {a.v + b.v}; }
+    friend ScalarVec operator-(ScalarVec a, ScalarVec b) { return {a.v - b.v}; }
+    friend ScalarVec operator*(ScalarVec a, ScalarVec b) { return {a.v * b.v}; }
+    friend ScalarVec operator/(ScalarVec a, ScalarVec b) { return {a.v / b.v}; }
+
+    static ScalarVec min(ScalarVec a, ScalarVec b) { return {a.v < b.v ? a.v : b.v}; }
+    static ScalarVec max(ScalarVec a, ScalarVec b) { return {a.v > b.v ? a.v : b.v}; }
+    static ScalarVec abs(ScalarVec a) { return {std::fabs(a.v)}; }
+    static ScalarVec floor(ScalarVec a) { return {std::floor(a.v)}; }
+
+    static Mask less(ScalarVec a, ScalarVec b) { return a.v < b.v; }
+    static ScalarVec select(Mask mask, ScalarVec a, ScalarVec b) { return mask ? a : b; }
+
+    // Float bits minus a magic constant, and the same with the bits shifted right by one first.
+    static ScalarVec subFromBits(uint32_t magic, ScalarVec a) {
+        uint32_t bits;
+        memcpy(&bits, &a.v, sizeof(bits));
+        bits = magic - bits;
+        float result;
+        memcpy(&result, &bits, sizeof(result));
+        return {result};
+    }
+
+    static ScalarVec subFromHalfBits(uint32_t magic, ScalarVec a) {
+        uint32_t bits;
+        memcpy(&bits, &a.v, sizeof(bits));
+        bits = magic - (bits >> 1);
+        float result;
+        memcpy(&result, &bits, sizeof(result));
+        return {result};
+    }
+
+    static Int toInt(ScalarVec a) { return static_cast<int32_t>(a.v); }
+    static Int clamp(Int a, int32_t low, int32_t high) { return a < low ? low : (a > high ? high : a); }
+    static Int add(Int a, int32_t b) { return a + b; }
+};
+
+#if defined(__SSE4_1__)
+struct Sse41Vec {
+    static constexpr int Width = 4;
+
+    using Int = __m128i;
+    using Mask = __m128;
+
+    __m128 v;
+
+    static Sse41Vec load(const float *p) { return {_mm_loadu_ps(p)}; }
+    static Sse41Vec broadcast(float value) { return {_mm_set1_ps(value)}; }
+    static Sse41Vec ramp(float start) { return {_mm_setr_ps(start, start + 1, start + 2, start + 3)}; }
+    void store(float *p) const { _mm_storeu_ps(p, v); }
+
+    static Sse41Vec gather(const float *base, Int index) {
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), index);
+        return {_mm_setr_ps(base[lanes[0]], base[lanes[1]], base[lanes[2]], base[lanes[3]])};
+    }
+
+    friend Sse41Vec operator+(Sse41Vec a, Sse41Vec b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend Sse41Vec operator-(Sse41Vec a, Sse41Vec b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend Sse41Vec operator*(Sse41Vec a, Sse41Vec b) { return {_mm_mul_ps(a.v, b.v)}; }
+    friend Sse41Vec operator/(Sse41Vec a, Sse41Vec b) { return {_mm_div_ps(a.v, b.v)}; }
+
+    static Sse41Vec min(Sse41Vec a, Sse41Vec b) { return {_mm_min_ps(a.v, b.v)}; }
+    static Sse41Vec max(Sse41Vec a, Sse41Vec b) { return {_mm_max_ps(a.v, b.v)}; }
+    static Sse41Vec abs(Sse41Vec a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+    static Sse41Vec floor(Sse41Vec a) { return {_mm_floor_ps(a.v)}; }
+
+    static Mask less(Sse41Vec a, Sse41Vec b) { return _mm_cmplt_ps(a.v, b.v); }
+    static Sse41Vec select(Mask mask, Sse41Vec a, Sse41Vec b) { return {_mm_blendv_ps(b.v, a.v, mask)}; }
+
+    static Sse41Vec subFromBits(uint32_t magic, Sse41Vec a) {
+        auto bits = _mm_sub_epi32(_mm_set1_epi32(static_cast<int32_t>(magic)), _mm_castps_si128(a.v));
+        return {_mm_castsi128_ps(bits)};
+    }
+
+    static Sse41Vec subFromHalfBits(uint32_t magic, Sse41Vec a) {
+        auto half = _mm_srli_epi32(_mm_castps_si128(a.v), 1);
+        return {_mm_castsi128_ps(_mm_sub_epi32(_mm_set1_epi32(static_cast<int32_t>(magic)), half))};
+    }
+
+    static Int toInt(Sse41Vec a) { return _mm_cvttps_epi32(a.v); }
+    static Int clamp(Int a, int32_t low, int32_t high) {
+        return _mm_min_epi32(_mm_max_epi32(a, _mm_set1_epi32(low)), _mm_set1_epi32(high));
+    }
+    static Int add(Int a, int32_t b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+};
+#endif
+
+#if defined(__AVX2__)
+struct Avx2Vec {
+    static constexpr int Width = 8;
+
+    using Int = __m256i;
+    using Mask = __m256;
+
+    __m256 v;
+
+    static Avx2Vec load(const float *p) { return {_mm256_loadu_ps(p)}; }
+    static Avx2Vec broadcast(float value) { return {_mm256_set1_ps(value)}; }
+    static Avx2Vec ramp(float start) {
+        return {_mm256_add_ps(_mm256_set1_ps(start), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7))};
+    }
+    void store(float *p) const { _mm256_storeu_ps(p, v); }
+
+    static Avx2Vec gather(const float *base, Int index) { return {_mm256_i32gather_ps(base, index, 4)}; }
+
+    friend Avx2Vec operator+(Avx2Vec a, Avx2Vec b) { return {_mm256_add_ps(a.v, b.v)}; }
+    friend Avx2Vec operator-(Avx2Vec a, Avx2Vec b) { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend Avx2Vec operator*(Avx2Vec a, Avx2Vec b) { return {_mm256_mul_ps(a.v, b.v)}; }
+    friend Avx2Vec operator/(Avx2Vec a, Avx2Vec b) { return {_mm256_div_ps(a.v, b.v)}; }
+
+    static Avx2Vec min(Avx2Vec a, Avx2Vec b) { return {_mm256_min_ps(a.v, b.v)}; }
+    static Avx2Vec max(Avx2Vec a, Avx2Vec b) { return {_mm256_max_ps(a.v, b.v)}; }
+    static Avx2Vec abs(Avx2Vec a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+    static Avx2Vec floor(Avx2Vec a) { return {_mm256_floor_ps(a.v)}; }
+
+    static Mask less(Avx2Vec a, Avx2Vec b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+    static Avx2Vec select(Mask mask, Avx2Vec a, Avx2Vec b) { return {_mm256_blendv_ps(b.v, a.v, mask)}; }
+
+    static Avx2Vec subFromBits(uint32_t magic, Avx2Vec a) {
+        auto bits = _mm256_sub_epi32(_mm256_set1_epi32(static_cast<int32_t>(magic)), _mm256_castps_si256(a.v));
+        return {_mm256_castsi256_ps(bits)};
+    }
+
+    static Avx2Vec subFromHalfBits(uint32_t magic, Avx2Vec a) {
+        auto half = _mm256_srli_epi32(_mm256_castps_si256(a.v), 1);
+        return {_mm256_castsi256_ps(_mm256_sub_epi32(_mm256_set1_epi32(static_cast<int32_t>(magic)), half))};
+    }
+
+    static Int toInt(Avx2Vec a) { return _mm256_cvttps_epi32(a.v); }
+    static Int clamp(Int a, int32_t low, int32_t high) {
+        return _mm256_min_epi32(_mm256_max_epi32(a, _mm256_set1_epi32(low)), _mm256_set1_epi32(high));
+    }
+    static Int add(Int a, int32_t b) { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+};
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+struct NeonVec {
+    static constexpr int Width = 4;
+
+    using Int = int32x4_t;
+    using Mask = uint32x4_t;
+
+    float32x4_t v;
+
+    static NeonVec load(const float *p) { return {vld1q_f32(p)}; }
+    static NeonVec broadcast(float value) { return {vdupq_n_f32(value)}; }
+    static NeonVec ramp(float start) {
+        static const float offsets[4] = {0, 1, 2, 3};
+        return {vaddq_f32(vdupq_n_f32(start), vld1q_f32(offsets))};
+    }
+    void store(float *p) const { vst1q_f32(p, v); }
+
+    static NeonVec gather(const float *base, Int index) {
+        float32x4_t result = vdupq_n_f32(base[vgetq_lane_s32(index, 0)]);
+        result = vsetq_lane_f32(base[vgetq_lane_s32(index, 1)], result, 1);
+        result = vsetq_lane_f32(base[vgetq_lane_s32(index, 2)], result, 2);
+        result = vsetq_lane_f32(base[vgetq_lane_s32(index, 3)], result, 3);
+        return {result};
+    }
+
+    friend NeonVec operator+(NeonVec a, NeonVec b) { return {vaddq_f32(a.v, b.v)}; }
+    friend NeonVec operator-(NeonVec a, NeonVec b) { return {vsubq_f32(a.v, b.v)}; }
+    friend NeonVec operator*(NeonVec a, NeonVec b) { return {vmulq_f32(a.v, b.v)}; }
+    friend NeonVec operator/(NeonVec a, NeonVec b) { return {vdivq_f32(a.v, b.v)}; }
+
+    // vminq/vmaxq propagate NaN, compare and select instead to match the other types.
+    static NeonVec min(NeonVec a, NeonVec b) { return {vbslq_f32(vcltq_f32(a.v, b.v), a.v, b.v)}; }
+    static NeonVec max(NeonVec a, NeonVec b) { return {vbslq_f32(vcgtq_f32(a.v, b.v), a.v, b.v)}; }
+    static NeonVec abs(NeonVec a) { return {vabsq_f32(a.v)}; }
+    static NeonVec floor(NeonVec a) { return {vrndmq_f32(a.v)}; }
+
+    static Mask less(NeonVec a, NeonVec b) { return vcltq_f32(a.v, b.v); }
+    static NeonVec select(Mask mask, NeonVec a, NeonVec b) { return {vbslq_f32(mask, a.v, b.v)}; }
+
+    static NeonVec subFromBits(uint32_t magic, NeonVec a) {
+        return {vreinterpretq_f32_u32(vsubq_u32(vdupq_n_u32(magic), vreinterpretq_u32_f32(a.v)))};
+    }
+
+    static NeonVec subFromHalfBits(uint32_t magic, NeonVec a) {
+        auto half = vshrq_n_u32(vreinterpretq_u32_f32(a.v), 1);
+        return {vreinterpretq_f32_u32(vsubq_u32(vdupq_n_u32(magic), half))};
+    }
+
+    static Int toInt(NeonVec a) { return vcvtq_s32_f32(a.v); }
+    static Int clamp(Int a, int32_t low, int32_t high) {
+        return vminq_s32(vmaxq_s32(a, vdupq_n_s32(low)), vdupq_n_s32(high));
+    }
+    static Int add(Int a, int32_t b) { return vaddq_s32(a, vdupq_n_s32(b)); }
+};
+#endif
+
+#endif //RYUJINXNATIVE_FSR_SIMD_H
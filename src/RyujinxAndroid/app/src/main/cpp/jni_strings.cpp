@@ -0,0 +1,202 @@
+//
+// Allocation free string marshalling for JNI entry points.
+//
+
+#include "jni_strings.h"
+#include <cstring>
+
+constexpr uint32_t ReplacementCharacter = 0xFFFD;
+constexpr size_t ArenaAlignment = alignof(std::max_align_t);
+
+JniStringArena &JniStringArena::current() {
+    static thread_local JniStringArena arena;
+
+    return arena;
+}
+
+char *JniStringArena::allocate(size_t size) {
+    size = (size + ArenaAlignment - 1) & ~(ArenaAlignment - 1);
+
+    while (_block < MaxBlocks) {
+        char *data;
+        size_t capacity;
+
+        if (_block == 0) {
+            data = _inline;
+            capacity = BlockSize;
+        } else {
+            auto &block = _blocks[_block];
+
+            // Blocks past the current one hold no live allocations, so they can be grown freely.
+            if (_offset == 0 && block.size < size) {
+                auto blockSize = BlockSize << _block;
+                block.size = blockSize > size ? blockSize : size;
+                block.data = std::make_unique<char[]>(block.size);
+            }
+
+            data = block.data.get();
+            capacity = block.size;
+        }
+
+        if (data != nullptr && capacity - _offset >= size) {
+            auto result = data + _offset;
+            _offset += size;
+
+            return result;
+        }
+
+        _block++;
+        _offset = 0;
+    }
+
+    return nullptr;
+}
+
+JniStringArena::Mark JniStringArena::mark() const {
+    return {_block, _offset};
+}
+
+void JniStringArena::release(Mark mark) {
+    _block = mark.block;
+    _offset = mark.offset;
+}
+
+static size_t encodeUtf8(uint32_t codePoint, char *out) {
+    if (codePoint < 0x80) {
+        out[0] = static_cast<char>(codePoint);
+        return 1;
+    }
+
+    if (codePoint < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+        out[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+
+    if (codePoint < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+        out[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+
+    out[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+    out[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+// Decodes one code point, advancing the cursor by the number of bytes consumed.
+static uint32_t decodeUtf8(const unsigned char *&cursor, const unsigned char *end) {
+    auto lead = *cursor++;
+
+    if (lead < 0x80)
+        return lead;
+
+    size_t length;
+    uint32_t codePoint;
+    uint32_t minimum;
+
+    if ((lead & 0xE0) == 0xC0) {
+        length = 1;
+        codePoint = lead & 0x1F;
+        minimum = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 2;
+        codePoint = lead & 0x0F;
+        minimum = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 3;
+        codePoint = lead & 0x07;
+        minimum = 0x10000;
+    } else {
+        return ReplacementCharacter;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        if (cursor == end || (*cursor & 0xC0) != 0x80)
+            return ReplacementCharacter;
+
+        codePoint = (codePoint << 6) | (*cursor++ & 0x3F);
+    }
+
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+        return ReplacementCharacter;
+
+    return codePoint;
+}
+
+const char *getArenaString(JNIEnv *env, jstring string) {
+    if (string == nullptr)
+        return nullptr;
+
+    auto &arena = JniStringArena::current();
+    auto length = static_cast<size_t>(env->GetStringLength(string));
+
+    // A UTF-16 unit never needs more than 3 UTF-8 bytes, a surrogate pair needs 4 for 2 units.
+    auto result = arena.allocate(length * 3 + 1);
+    if (result == nullptr)
+        return nullptr;
+
+    auto temporary = arena.mark();
+    auto units = reinterpret_cast<jchar *>(arena.allocate(length * sizeof(jchar)));
+    if (units == nullptr) {
+        arena.release(temporary);
+        return nullptr;
+    }
+
+    env->GetStringRegion(string, 0, static_cast<jsize>(length), units);
+
+    size_t written = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        uint32_t codePoint = units[i];
+
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF && i + 1 < length &&
+            units[i + 1] >= 0xDC00 && units[i + 1] <= 0xDFFF) {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (units[++i] - 0xDC00);
+        } else if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+            codePoint = ReplacementCharacter;
+        }
+
+        written += encodeUtf8(codePoint, result + written);
+    }
+
+    result[written] = '\0';
+
+    // The UTF-16 copy is only needed during conversion.
+    arena.release(temporary);
+
+    return result;
+}
+
+jstring createJavaString(JNIEnv *env, const char *string) {
+    if (string == nullptr)
+        return nullptr;
+
+    JniStringScope scope;
+
+    auto length = strlen(string);
+    auto units = reinterpret_cast<jchar *>(JniStringArena::current().allocate(length * sizeof(jchar)));
+    if (units == nullptr)
+        return env->NewStringUTF(string);
+
+    auto cursor = reinterpret_cast<const unsigned char *>(string);
+    auto end = cursor + length;
+    size_t count = 0;
+
+    while (cursor < end) {
+        auto codePoint = decodeUtf8(cursor, end);
+
+        if (codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            units[count++] = static_cast<jchar>(0xD800 + (codePoint >> 10));
+            units[count++] = static_cast<jchar>(0xDC00 + (codePoint & 0x3FF));
+        } else {
+            units[count++] = static_cast<jchar>(codePoint);
+        }
+    }
+
+    return env->NewString(units, static_cast<jsize>(count));
+}
@@ -0,0 +1,72 @@
+//
+// Allocation free string marshalling for JNI entry points.
+//
+
+#ifndef RYUJINXNATIVE_JNI_STRINGS_H
+#define RYUJINXNATIVE_JNI_STRINGS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <jni.h>
+
+// Per thread bump allocator backing all temporary strings created by JNI entry points.
+// Memory is handed out from fixed size blocks that are kept for the lifetime of the thread,
+// so after the first few calls no allocation happens at all. Pointers stay valid until the
+// JniStringScope that was active when they were created is destroyed.
+class JniStringArena {
+public:
+    static constexpr size_t BlockSize = 4096;
+    static constexpr size_t MaxBlocks = 16;
+
+    struct Mark {
+        size_t block;
+        size_t offset;
+    };
+
+    static JniStringArena &current();
+
+    char *allocate(size_t size);
+
+    Mark mark() const;
+    void release(Mark mark);
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+    };
+
+    char _inline[BlockSize];
+    Block _blocks[MaxBlocks];
+    size_t _block = 0;
+    size_t _offset = 0;
+};
+
+// Restores the arena to its previous state when leaving an entry point.
+class JniStringScope {
+public:
+    JniStringScope() : _arena(JniStringArena::current()), _mark(_arena.mark()) {}
+
+    ~JniStringScope() { _arena.release(_mark); }
+
+    JniStringScope(const JniStringScope &) = delete;
+    JniStringScope &operator=(const JniStringScope &) = delete;
+
+private:
+    JniStringArena &_arena;
+    JniStringArena::Mark _mark;
+};
+
+// Converts a Java string to a NUL terminated standard UTF-8 string allocated from the arena.
+// The UTF-16 contents are read with GetStringRegion, so surrogate pairs become 4 byte sequences
+// instead of the 6 byte modified UTF-8 form GetStringUTFChars would produce, and unpaired
+// surrogates are replaced with U+FFFD. Returns nullptr for a null string.
+const char *getArenaString(JNIEnv *env, jstring string);
+
+// Creates a Java string from standard UTF-8. The text is decoded to UTF-16 in the arena and
+// passed to NewString, which avoids the modified UTF-8 requirement of NewStringUTF. Invalid
+// sequences are replaced with U+FFFD.
+jstring createJavaString(JNIEnv *env, const char *string);
+
+#endif //RYUJINXNATIVE_JNI_STRINGS_H
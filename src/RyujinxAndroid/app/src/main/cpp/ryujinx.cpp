@@ -18,12 +18,15 @@
 
 #include "ryuijnx.h"
 #include "pthread.h"
+#include "frame_pacer.h"
+#include "telemetry.h"
+#include "jni_strings.h"
+#include "vulkan_loader.h"
+#include "surface_manager.h"
 #include <chrono>
 #include <csignal>
 
 
-std::chrono::time_point<std::chrono::steady_clock, std::chrono::nanoseconds> _currentTimePoint;
-
 extern "C"
 {
 JNIEXPORT jlong JNICALL
@@ -31,7 +34,7 @@ Java_org_ryujinx_android_NativeHelpers_getNativeWindow(
         JNIEnv *env,
         jobject instance,
         jobject surface) {
-    auto nativeWindow = ANativeWindow_fromSurface(env, surface);
+    auto nativeWindow = _surfaceManager.attach(ANativeWindow_fromSurface(env, surface));
     return nativeWindow == NULL ? -1 : (jlong) nativeWindow;
 }
 
@@ -40,10 +43,18 @@ Java_org_ryujinx_android_NativeHelpers_releaseNativeWindow(
         JNIEnv *env,
         jobject instance,
         jlong window) {
-    auto nativeWindow = (ANativeWindow *) window;
+    if (window == 0 || window == -1)
+        return;
 
-    if (nativeWindow != NULL)
-        ANativeWindow_release(nativeWindow);
+    _surfaceManager.release((ANativeWindow *) window);
+}
+
+JNIEXPORT void JNICALL
+Java_org_ryujinx_android_NativeHelpers_setCurrentNativeWindow(
+        JNIEnv *env,
+        jobject instance,
+        jlong window) {
+    _surfaceManager.setCurrent(window == -1 ? nullptr : (ANativeWindow *) window);
 }
 
 long createSurface(long native_surface, long instance) {
@@ -67,36 +78,6 @@ Java_org_ryujinx_android_NativeHelpers_getCreateSurfacePtr(
         jobject instance) {
     return (jlong) createSurface;
 }
-
-char *getStringPointer(
-        JNIEnv *env,
-        jstring jS) {
-    const char *cparam = env->GetStringUTFChars(jS, 0);
-    auto len = env->GetStringUTFLength(jS);
-    char *s = new char[len];
-    strcpy(s, cparam);
-    env->ReleaseStringUTFChars(jS, cparam);
-
-    return s;
-}
-
-jstring createString(
-        JNIEnv *env,
-        char *ch) {
-    auto str = env->NewStringUTF(ch);
-
-    return str;
-}
-
-jstring createStringFromStdString(
-        JNIEnv *env,
-        std::string s) {
-    auto str = env->NewStringUTF(s.c_str());
-
-    return str;
-}
-
-
 }
 extern "C"
 void setRenderingThread() {
@@ -104,7 +85,7 @@ void setRenderingThread() {
 
     _renderingThreadId = currentId;
 
-    _currentTimePoint = std::chrono::high_resolution_clock::now();
+    _framePacer.reset();
 }
 extern "C"
 JNIEXPORT void JNICALL
@@ -120,7 +101,7 @@ bool isInitialOrientationFlipped = true;
 
 extern "C"
 void setCurrentTransform(long native_window, int transform) {
-    if (native_window == 0 || native_window == -1)
+    if (native_window == 0)
         return;
     auto nativeWindow = (ANativeWindow *) native_window;
 
@@ -175,9 +156,11 @@ Java_org_ryujinx_android_NativeHelpers_loadDriver(JNIEnv *env, jobject thiz,
                                                   jstring native_lib_path,
                                                   jstring private_apps_path,
                                                   jstring driver_name) {
-    auto libPath = getStringPointer(env, native_lib_path);
-    auto privateAppsPath = getStringPointer(env, private_apps_path);
-    auto driverName = getStringPointer(env, driver_name);
+    JniStringScope scope;
+
+    auto libPath = getArenaString(env, native_lib_path);
+    auto privateAppsPath = getArenaString(env, private_apps_path);
+    auto driverName = getArenaString(env, driver_name);
 
     auto handle = adrenotools_open_libvulkan(
             RTLD_NOW,
@@ -190,10 +173,6 @@ Java_org_ryujinx_android_NativeHelpers_loadDriver(JNIEnv *env, jobject thiz,
             nullptr
     );
 
-    delete libPath;
-    delete privateAppsPath;
-    delete driverName;
-
     return (jlong) handle;
 }
 
@@ -239,7 +218,7 @@ Java_org_ryujinx_android_NativeHelpers_setSwapInterval(JNIEnv *env, jobject thiz
 extern "C"
 JNIEXPORT jstring JNICALL
 Java_org_ryujinx_android_NativeHelpers_getStringJava(JNIEnv *env, jobject thiz, jlong ptr) {
-    return createString(env, (char*)ptr);
+    return createJavaString(env, (const char *) ptr);
 }
 
 extern "C"
@@ -248,3 +227,159 @@ Java_org_ryujinx_android_NativeHelpers_setIsInitialOrientationFlipped(JNIEnv *en
                                                                       jboolean is_flipped) {
     isInitialOrientationFlipped = is_flipped;
 }
+
+extern "C"
+bool getIsInitialOrientationFlipped() {
+    return isInitialOrientationFlipped;
+}
+
+extern "C"
+void framePacerWaitForPresent(long native_window) {
+    if (native_window == 0 || native_window == -1)
+        return;
+
+    _framePacer.waitForPresent((ANativeWindow *) native_window);
+}
+
+extern "C"
+void framePacerFramePresented(long native_window) {
+    if (native_window == 0 || native_window == -1)
+        return;
+
+    _framePacer.onFramePresented((ANativeWindow *) native_window);
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_org_ryujinx_android_NativeHelpers_setFramePacingEnabled(JNIEnv *env, jobject thiz,
+                                                             jboolean enable) {
+    _framePacer.setEnabled(enable);
+}
+
+extern "C"
+JNIEXPORT jlongArray JNICALL
+Java_org_ryujinx_android_NativeHelpers_getFramePacingStats(JNIEnv *env, jobject thiz) {
+    jlong stats[FramePacingStatCount];
+    _framePacer.getStats(reinterpret_cast<int64_t *>(stats));
+
+    auto array = env->NewLongArray(FramePacingStatCount);
+    env->SetLongArrayRegion(array, 0, FramePacingStatCount, stats);
+
+    return array;
+}
+
+extern "C"
+JNIEXPORT jintArray JNICALL
+Java_org_ryujinx_android_NativeHelpers_getFramePacingJitterHistogram(JNIEnv *env, jobject thiz) {
+    jint histogram[FramePacer::JitterBucketCount];
+    _framePacer.getJitterHistogram(reinterpret_cast<int32_t *>(histogram));
+
+    auto array = env->NewIntArray(FramePacer::JitterBucketCount);
+    env->SetIntArrayRegion(array, 0, FramePacer::JitterBucketCount, histogram);
+
+    return array;
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_org_ryujinx_android_NativeHelpers_resetFramePacingStats(JNIEnv *env, jobject thiz) {
+    _framePacer.resetStats();
+}
+
+extern "C"
+void *telemetryGetBuffer() {
+    return getTelemetryBuffer();
+}
+
+extern "C"
+JNIEXPORT jobject JNICALL
+Java_org_ryujinx_android_NativeHelpers_getTelemetryBuffer(JNIEnv *env, jobject thiz) {
+    auto buffer = getTelemetryBuffer();
+
+    if (buffer == nullptr)
+        return nullptr;
+
+    return env->NewDirectByteBuffer(buffer, static_cast<jlong>(getTelemetryBufferSize()));
+}
+
+extern "C"
+JNIEXPORT jlongArray JNICALL
+Java_org_ryujinx_android_NativeHelpers_benchmarkStringMarshalling(JNIEnv *env, jobject thiz,
+                                                                  jstring value,
+                                                                  jint iterations) {
+    using clock = std::chrono::steady_clock;
+
+    jlong results[4] = {};
+
+    // Previous implementation: copy through GetStringUTFChars into a heap allocation.
+    auto start = clock::now();
+    for (int i = 0; i < iterations; i++) {
+        auto chars = env->GetStringUTFChars(value, nullptr);
+        auto copy = new char[env->GetStringUTFLength(value) + 1];
+        strcpy(copy, chars);
+        env->ReleaseStringUTFChars(value, chars);
+        delete[] copy;
+    }
+    results[0] = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+    start = clock::now();
+    for (int i = 0; i < iterations; i++) {
+        JniStringScope scope;
+        getArenaString(env, value);
+    }
+    results[1] = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+    JniStringScope scope;
+    auto native = getArenaString(env, value);
+
+    start = clock::now();
+    for (int i = 0; i < iterations; i++)
+        env->DeleteLocalRef(env->NewStringUTF(native));
+    results[2] = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+    start = clock::now();
+    for (int i = 0; i < iterations; i++)
+        env->DeleteLocalRef(createJavaString(env, native));
+    results[3] = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+    auto array = env->NewLongArray(4);
+    env->SetLongArrayRegion(array, 0, 4, results);
+
+    return array;
+}
+
+extern "C"
+void *vulkanLoaderCreate(void *driver) {
+    auto table = new VulkanDispatchTable(driver);
+
+    if (!table->isValid()) {
+        delete table;
+        return nullptr;
+    }
+
+    return table;
+}
+
+extern "C"
+void vulkanLoaderDestroy(void *table) {
+    delete static_cast<VulkanDispatchTable *>(table);
+}
+
+extern "C"
+void *vulkanLoaderGetProcAddr(void *table, void *instance, void *device, const char *name) {
+    return reinterpret_cast<void *>(static_cast<VulkanDispatchTable *>(table)->getProcAddr(
+            static_cast<VkInstance>(instance), static_cast<VkDevice>(device), name));
+}
+
+extern "C"
+long surfaceManagerAcquireCurrent() {
+    return (long) _surfaceManager.acquireCurrent();
+}
+
+extern "C"
+void surfaceManagerRelease(long native_window) {
+    if (native_window == 0 || native_window == -1)
+        return;
+
+    _surfaceManager.release((ANativeWindow *) native_window);
+}
@@ -0,0 +1,77 @@
+//
+// Lifetime tracking for the native windows handed to the frontend and the renderer.
+//
+
+#include "surface_manager.h"
+#include <android/log.h>
+
+SurfaceManager _surfaceManager;
+
+ANativeWindow *SurfaceManager::attach(ANativeWindow *window) {
+    if (window == nullptr)
+        return nullptr;
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    _references[window]++;
+
+    return window;
+}
+
+bool SurfaceManager::release(ANativeWindow *window) {
+    if (window == nullptr)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        auto entry = _references.find(window);
+
+        if (entry == _references.end()) {
+            __android_log_print(ANDROID_LOG_WARN, "SurfaceManager",
+                                "Ignoring release of unknown window %p", window);
+            return false;
+        }
+
+        if (--entry->second == 0)
+            _references.erase(entry);
+    }
+
+    // Dropping the last reference disconnects the window, which must not happen under the lock.
+    ANativeWindow_release(window);
+
+    return true;
+}
+
+void SurfaceManager::setCurrent(ANativeWindow *window) {
+    ANativeWindow *previous;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        if (window == _current)
+            return;
+
+        if (window != nullptr) {
+            ANativeWindow_acquire(window);
+            _references[window]++;
+        }
+
+        previous = _current;
+        _current = window;
+    }
+
+    release(previous);
+}
+
+ANativeWindow *SurfaceManager::acquireCurrent() {
+    std::lock_guard<std::mutex> guard(_lock);
+
+    if (_current == nullptr)
+        return nullptr;
+
+    ANativeWindow_acquire(_current);
+    _references[_current]++;
+
+    return _current;
+}
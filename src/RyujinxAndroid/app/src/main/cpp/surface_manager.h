@@ -0,0 +1,41 @@
+//
+// Lifetime tracking for the native windows handed to the frontend and the renderer.
+//
+
+#ifndef RYUJINXNATIVE_SURFACE_MANAGER_H
+#define RYUJINXNATIVE_SURFACE_MANAGER_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "native_window.h"
+
+// Windows cross the JNI boundary as plain jlong values, so the manager keeps a count of the
+// references it has handed out for every window. A handle that was never handed out, or
+// was already released, is ignored instead of dropping a reference someone else still owns.
+//
+// The frontend publishes the window the game should be shown on with setCurrent. The
+// renderer takes its own reference through acquireCurrent, which keeps the window alive
+// while it is still presenting to it, even after the frontend released its handle.
+class SurfaceManager {
+public:
+    // Takes ownership of the reference returned by ANativeWindow_fromSurface.
+    ANativeWindow *attach(ANativeWindow *window);
+
+    bool release(ANativeWindow *window);
+
+    // Makes the window the presentation target, holding a reference until it is replaced.
+    void setCurrent(ANativeWindow *window);
+
+    // Returns the presentation target with a new reference, or nullptr if there is none.
+    ANativeWindow *acquireCurrent();
+
+private:
+    std::mutex _lock;
+    std::unordered_map<ANativeWindow *, int32_t> _references;
+    ANativeWindow *_current = nullptr;
+};
+
+extern SurfaceManager _surfaceManager;
+
+#endif //RYUJINXNATIVE_SURFACE_MANAGER_H
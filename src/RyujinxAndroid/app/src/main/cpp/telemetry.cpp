@@ -0,0 +1,36 @@
+//
+// Per-frame telemetry ring shared between the emulator and the Android frontend.
+//
+
+#include "telemetry.h"
+#include <sys/mman.h>
+#include <android/log.h>
+
+size_t getTelemetryBufferSize() {
+    return sizeof(TelemetryHeader) + sizeof(TelemetryRecord) * TelemetryCapacity;
+}
+
+static void *createTelemetryBuffer() {
+    auto buffer = mmap(nullptr, getTelemetryBufferSize(), PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (buffer == MAP_FAILED) {
+        __android_log_print(ANDROID_LOG_ERROR, "Telemetry", "Failed to map telemetry buffer");
+        return nullptr;
+    }
+
+    // Anonymous mappings are zero filled, only the header needs to be set up.
+    auto header = static_cast<TelemetryHeader *>(buffer);
+    header->version = TelemetryVersion;
+    header->recordSize = sizeof(TelemetryRecord);
+    header->capacity = TelemetryCapacity;
+    __atomic_store_n(&header->magic, TelemetryMagic, __ATOMIC_RELEASE);
+
+    return buffer;
+}
+
+void *getTelemetryBuffer() {
+    static void *buffer = createTelemetryBuffer();
+
+    return buffer;
+}
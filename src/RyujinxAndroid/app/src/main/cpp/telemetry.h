@@ -0,0 +1,54 @@
+//
+// Per-frame telemetry ring shared between the emulator and the Android frontend.
+//
+
+#ifndef RYUJINXNATIVE_TELEMETRY_H
+#define RYUJINXNATIVE_TELEMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+
+// 'RYTM'
+constexpr uint32_t TelemetryMagic = 0x4D545952;
+constexpr uint32_t TelemetryVersion = 1;
+constexpr uint32_t TelemetryCapacity = 1024;
+
+// The ring is written by a single producer, the managed present callback in LibRyujinx, and
+// read by any number of consumers. Layouts are mirrored in LibRyujinx/Android/NativeTelemetry.cs
+// and PerformanceMonitor.kt, keep all three in sync when changing them.
+//
+// A record is published by first clearing its sequence, writing the payload, then storing
+// index + 1 to the sequence and finally to writeIndex. Readers copy a record and accept it only
+// if the sequence read before and after the copy matches the index they expected.
+struct TelemetryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t capacity;
+    uint64_t writeIndex;
+    uint64_t reserved[5];
+};
+
+struct TelemetryRecord {
+    uint64_t sequence;
+    // All times are in nanoseconds, timestamp uses CLOCK_MONOTONIC.
+    int64_t timestamp;
+    int64_t frameTime;
+    int64_t fifoTime;
+    int64_t gpuWaitTime;
+    int64_t presentLatency;
+    int64_t jitStallTime;
+    // Actual minus desired present time reported by VK_GOOGLE_display_timing, 0 when unsupported.
+    int64_t presentError;
+};
+
+static_assert(sizeof(TelemetryHeader) == 64, "TelemetryHeader layout changed");
+static_assert(sizeof(TelemetryRecord) == 64, "TelemetryRecord layout changed");
+static_assert((TelemetryCapacity & (TelemetryCapacity - 1)) == 0, "Capacity must be a power of two");
+
+// Returns the process wide telemetry region, created on first use and never freed.
+void *getTelemetryBuffer();
+
+size_t getTelemetryBufferSize();
+
+#endif //RYUJINXNATIVE_TELEMETRY_H
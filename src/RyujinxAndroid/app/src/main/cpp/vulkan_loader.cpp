@@ -0,0 +1,106 @@
+//
+// Cached Vulkan entry point resolution for custom drivers.
+//
+
+#include "vulkan_loader.h"
+#include <dlfcn.h>
+
+// Commands dispatched on an instance or physical device. vkGetDeviceProcAddr must return null for
+// them, but some drivers return an entry point that expects a device, so they are never asked of it.
+static bool isInstanceLevel(std::string_view name) {
+    static constexpr std::string_view instanceCommands[] = {
+            "vkCreateInstance",
+            "vkDestroyInstance",
+            "vkCreateDevice",
+            "vkGetInstanceProcAddr",
+            "vkDestroySurfaceKHR",
+            "vkCreateDebugUtilsMessengerEXT",
+            "vkDestroyDebugUtilsMessengerEXT",
+            "vkSubmitDebugUtilsMessageEXT",
+            "vkCreateDebugReportCallbackEXT",
+            "vkDestroyDebugReportCallbackEXT",
+            "vkDebugReportMessageEXT",
+            "vkGetDisplayPlaneSupportedDisplaysKHR",
+            "vkGetDisplayModePropertiesKHR",
+            "vkGetDisplayModeProperties2KHR",
+            "vkCreateDisplayModeKHR",
+            "vkGetDisplayPlaneCapabilitiesKHR",
+            "vkGetDisplayPlaneCapabilities2KHR",
+            "vkReleaseDisplayEXT",
+            "vkAcquireDrmDisplayEXT",
+            "vkGetDrmDisplayEXT",
+            "vkAcquireXlibDisplayEXT",
+            "vkGetRandROutputDisplayEXT",
+            "vkAcquireWinrtDisplayNV",
+            "vkGetWinrtDisplayNV",
+    };
+
+    if (name.starts_with("vkEnumerate") || name.starts_with("vkGetPhysicalDevice"))
+        return true;
+
+    // vkCreateAndroidSurfaceKHR, vkCreateHeadlessSurfaceEXT and the other platform surfaces.
+    if (name.starts_with("vkCreate") && name.find("Surface") != std::string_view::npos)
+        return true;
+
+    for (std::string_view command : instanceCommands) {
+        if (name == command)
+            return true;
+    }
+
+    return false;
+}
+
+VulkanDispatchTable::VulkanDispatchTable(void *driver) {
+    if (driver == nullptr)
+        return;
+
+    _getInstanceProcAddr = reinterpret_cast<PFN_vkGetInstanceProcAddr>(dlsym(driver, "vkGetInstanceProcAddr"));
+    _getDeviceProcAddr = reinterpret_cast<PFN_vkGetDeviceProcAddr>(dlsym(driver, "vkGetDeviceProcAddr"));
+}
+
+bool VulkanDispatchTable::isValid() const {
+    return _getInstanceProcAddr != nullptr && _getDeviceProcAddr != nullptr;
+}
+
+PFN_vkVoidFunction VulkanDispatchTable::getProcAddr(VkInstance instance, VkDevice device, const char *name) {
+    std::string_view key(name);
+    std::lock_guard<std::mutex> guard(_lock);
+
+    // Entry points are only valid for the handle they were queried with, drop them when it changes.
+    if (instance != _instance) {
+        _instance = instance;
+        _device = VK_NULL_HANDLE;
+        _instanceFunctions.clear();
+        _deviceFunctions.clear();
+    }
+
+    if (device != _device) {
+        _device = device;
+        _deviceFunctions.clear();
+    }
+
+    // Failed lookups are cached as well, a device level name missing from the device is only asked once.
+    if (device != VK_NULL_HANDLE && !isInstanceLevel(key)) {
+        auto entry = _deviceFunctions.find(key);
+        if (entry == _deviceFunctions.end())
+            entry = _deviceFunctions.emplace(key, _getDeviceProcAddr(device, name)).first;
+
+        if (entry->second != nullptr)
+            return entry->second;
+    }
+
+    if (instance != VK_NULL_HANDLE) {
+        auto entry = _instanceFunctions.find(key);
+        if (entry == _instanceFunctions.end())
+            entry = _instanceFunctions.emplace(key, _getInstanceProcAddr(instance, name)).first;
+
+        if (entry->second != nullptr)
+            return entry->second;
+    }
+
+    auto entry = _globalFunctions.find(key);
+    if (entry == _globalFunctions.end())
+        entry = _globalFunctions.emplace(key, _getInstanceProcAddr(VK_NULL_HANDLE, name)).first;
+
+    return entry->second;
+}
@@ -0,0 +1,49 @@
+//
+// Cached Vulkan entry point resolution for custom drivers.
+//
+
+#ifndef RYUJINXNATIVE_VULKAN_LOADER_H
+#define RYUJINXNATIVE_VULKAN_LOADER_H
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "vulkan_wrapper.h"
+
+// Resolves and caches entry points of a single driver, usually one returned by
+// adrenotools_open_libvulkan. Every name is looked up at most once per instance and once per
+// device. Device level commands are resolved with vkGetDeviceProcAddr first so calls go straight
+// to the driver instead of through the loader trampoline that dispatches on the device handle.
+// Instance level commands are only resolved with vkGetInstanceProcAddr.
+class VulkanDispatchTable {
+public:
+    explicit VulkanDispatchTable(void *driver);
+
+    bool isValid() const;
+
+    PFN_vkVoidFunction getProcAddr(VkInstance instance, VkDevice device, const char *name);
+
+private:
+    struct NameHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view name) const {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    using FunctionMap = std::unordered_map<std::string, PFN_vkVoidFunction, NameHash, std::equal_to<>>;
+
+    PFN_vkGetInstanceProcAddr _getInstanceProcAddr = nullptr;
+    PFN_vkGetDeviceProcAddr _getDeviceProcAddr = nullptr;
+
+    std::mutex _lock;
+    VkInstance _instance = VK_NULL_HANDLE;
+    VkDevice _device = VK_NULL_HANDLE;
+    FunctionMap _globalFunctions;
+    FunctionMap _instanceFunctions;
+    FunctionMap _deviceFunctions;
+};
+
+#endif //RYUJINXNATIVE_VULKAN_LOADER_H
@@ -68,6 +68,8 @@ class GameHost(context: Context?, private val mainViewModel: MainViewModel) : Su
         if (_width != width || _height != height) {
             _currentWindow = _nativeWindow.requeryWindowHandle()
 
+            NativeHelpers.instance.setCurrentNativeWindow(_currentWindow)
+
             _nativeWindow.swapInterval = 0
         }
 
@@ -97,6 +99,8 @@ class GameHost(context: Context?, private val mainViewModel: MainViewModel) : Su
 
         RyujinxNative.jnaInstance.uiHandlerSetResponse(false, "")
 
+        NativeHelpers.instance.setCurrentNativeWindow(-1)
+
         _updateThread?.join()
         _renderingThreadWatcher?.join()
     }
@@ -139,11 +143,16 @@ class GameHost(context: Context?, private val mainViewModel: MainViewModel) : Su
                                 "Loading ${if (mainViewModel.isMiiEditorLaunched) "Mii Editor" else game!!.titleName}"
                         }
                     c = 0
-                    mainViewModel.updateStats(
-                        RyujinxNative.jnaInstance.deviceGetGameFifo(),
-                        RyujinxNative.jnaInstance.deviceGetGameFrameRate(),
-                        RyujinxNative.jnaInstance.deviceGetGameFrameTime()
-                    )
+                    val stats = MainActivity.performanceMonitor.getGameStats()
+                    if (stats != null) {
+                        mainViewModel.updateStats(stats.first, stats.second, stats.third)
+                    } else {
+                        mainViewModel.updateStats(
+                            RyujinxNative.jnaInstance.deviceGetGameFifo(),
+                            RyujinxNative.jnaInstance.deviceGetGameFrameRate(),
+                            RyujinxNative.jnaInstance.deviceGetGameFrameTime()
+                        )
+                    }
                 }
             }
         }
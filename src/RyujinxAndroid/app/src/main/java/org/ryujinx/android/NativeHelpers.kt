@@ -1,6 +1,7 @@
 package org.ryujinx.android
 
 import android.view.Surface
+import java.nio.ByteBuffer
 
 class NativeHelpers {
 
@@ -15,6 +16,7 @@ class NativeHelpers {
     external fun releaseNativeWindow(window: Long)
     external fun getCreateSurfacePtr(): Long
     external fun getNativeWindow(surface: Surface): Long
+    external fun setCurrentNativeWindow(window: Long)
 
     external fun loadDriver(
         nativeLibPath: String,
@@ -28,4 +30,10 @@ class NativeHelpers {
     external fun setSwapInterval(nativeWindow: Long, swapInterval: Int): Int
     external fun getStringJava(ptr: Long): String
     external fun setIsInitialOrientationFlipped(isFlipped: Boolean)
+    external fun setFramePacingEnabled(enable: Boolean)
+    external fun getFramePacingStats(): LongArray
+    external fun getFramePacingJitterHistogram(): IntArray
+    external fun resetFramePacingStats()
+    external fun getTelemetryBuffer(): ByteBuffer?
+    external fun benchmarkStringMarshalling(value: String, iterations: Int): LongArray
 }
@@ -33,8 +33,13 @@ class NativeWindow(val surface: SurfaceView) {
     }
 
     fun requeryWindowHandle(): Long {
+        val previousPointer = nativePointer
         nativePointer = nativeHelpers.getNativeWindow(surface.holder.surface)
 
+        // The renderer holds its own reference to the window it presents to.
+        if (previousPointer != -1L)
+            nativeHelpers.releaseNativeWindow(previousPointer)
+
         swapInterval = swapInterval
 
         return nativePointer
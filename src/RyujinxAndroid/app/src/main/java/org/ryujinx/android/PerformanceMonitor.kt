@@ -4,10 +4,121 @@ import android.app.ActivityManager
 import android.content.Context.ACTIVITY_SERVICE
 import androidx.compose.runtime.MutableState
 import java.io.RandomAccessFile
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+data class FrameTelemetry(
+    val timestamp: Long,
+    val frameTime: Long,
+    val fifoTime: Long,
+    val gpuWaitTime: Long,
+    val presentLatency: Long,
+    val jitStallTime: Long,
+    val presentError: Long
+)
 
 class PerformanceMonitor {
+    companion object {
+        // Layout of the native telemetry ring, see telemetry.h.
+        private const val TelemetryMagic = 0x4D545952
+        private const val TelemetryVersion = 1
+        private const val HeaderSize = 64
+        private const val RecordSize = 64
+        private const val WriteIndexOffset = 16
+        private const val StatsWindowNs = 1_000_000_000L
+    }
+
     val numberOfCores = Runtime.getRuntime().availableProcessors()
 
+    private val telemetry: ByteBuffer? by lazy {
+        val buffer = NativeHelpers.instance.getTelemetryBuffer()?.order(ByteOrder.nativeOrder())
+
+        if (buffer == null || buffer.getInt(0) != TelemetryMagic || buffer.getInt(4) != TelemetryVersion
+            || buffer.getInt(8) != RecordSize)
+            null
+        else
+            buffer
+    }
+    private val telemetryCapacity: Int by lazy { telemetry?.getInt(12) ?: 0 }
+    private var lastReadIndex: Long = 0
+
+    // Copies every record published since the previous call, oldest first. Records that were
+    // overwritten before they could be read are skipped.
+    fun readFrameTelemetry(frames: MutableList<FrameTelemetry>) {
+        val buffer = telemetry ?: return
+        val writeIndex = buffer.getLong(WriteIndexOffset)
+
+        if (writeIndex < lastReadIndex)
+            lastReadIndex = 0
+
+        var index = maxOf(lastReadIndex, writeIndex - telemetryCapacity)
+
+        while (index < writeIndex) {
+            val offset = HeaderSize + (index % telemetryCapacity).toInt() * RecordSize
+            val sequence = buffer.getLong(offset)
+            val frame = FrameTelemetry(
+                buffer.getLong(offset + 8),
+                buffer.getLong(offset + 16),
+                buffer.getLong(offset + 24),
+                buffer.getLong(offset + 32),
+                buffer.getLong(offset + 40),
+                buffer.getLong(offset + 48),
+                buffer.getLong(offset + 56)
+            )
+
+            // The producer may have lapped us while copying, drop the record if it changed.
+            if (sequence == index + 1 && buffer.getLong(offset) == sequence)
+                frames.add(frame)
+
+            index++
+        }
+
+        lastReadIndex = writeIndex
+    }
+
+    private val statsFrames = ArrayDeque<FrameTelemetry>()
+    private val newFrames = mutableListOf<FrameTelemetry>()
+
+    // Returns fifo percentage, frame rate and frame time in milliseconds over the last second,
+    // computed from the telemetry ring instead of polling the emulator. Returns null when the
+    // ring is not available.
+    fun getGameStats(): Triple<Double, Double, Double>? {
+        telemetry ?: return null
+
+        newFrames.clear()
+        readFrameTelemetry(newFrames)
+        statsFrames.addAll(newFrames)
+
+        val last = statsFrames.lastOrNull() ?: return Triple(0.0, 0.0, 0.0)
+
+        while (statsFrames.first().timestamp < last.timestamp - StatsWindowNs)
+            statsFrames.removeFirst()
+
+        var fifoTime = 0L
+        var frameTime = 0L
+        var frameCount = 0
+
+        for (frame in statsFrames) {
+            if (frame.frameTime <= 0)
+                continue
+
+            fifoTime += frame.fifoTime
+            frameTime += frame.frameTime
+            frameCount++
+        }
+
+        if (frameCount == 0 || frameTime == 0L)
+            return Triple(0.0, 0.0, 0.0)
+
+        val averageFrameTime = frameTime.toDouble() / frameCount
+
+        return Triple(
+            fifoTime * 100.0 / frameTime,
+            1_000_000_000.0 / averageFrameTime,
+            averageFrameTime / 1_000_000.0
+        )
+    }
+
     fun getFrequencies(frequencies: MutableList<Double>){
         frequencies.clear()
         for (i in 0..<numberOfCores) {
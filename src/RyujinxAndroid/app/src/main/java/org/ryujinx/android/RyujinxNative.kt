@@ -16,7 +16,9 @@ interface RyujinxNativeJna : Library {
         enablePtc: Boolean,
         enableInternetAccess: Boolean,
         timeZone: String,
-        ignoreMissingServices: Boolean
+        ignoreMissingServices: Boolean,
+        jitCacheBudgetMiB: Int,
+        useHugePages: Boolean
     ): Boolean
 
     fun graphicsInitialize(
@@ -28,7 +30,8 @@ interface RyujinxNativeJna : Library {
         enableMacroHLE: Boolean = true,
         enableShaderCache: Boolean = true,
         enableTextureRecompression: Boolean = false,
-        backendThreading: Int = BackendThreading.Auto.ordinal
+        backendThreading: Int = BackendThreading.Auto.ordinal,
+        enableDisplayTiming: Boolean = true
     ): Boolean
 
     fun graphicsInitializeRenderer(
@@ -103,18 +106,6 @@ class RyujinxNative {
             MainActivity.frameEnded()
         }
 
-        @JvmStatic
-        fun getSurfacePtr() : Long
-        {
-            return MainActivity.mainViewModel?.gameHost?.currentSurface ?: -1
-        }
-
-        @JvmStatic
-        fun getWindowHandle() : Long
-        {
-            return MainActivity.mainViewModel?.gameHost?.currentWindowhandle ?: -1
-        }
-
         @JvmStatic
         fun updateProgress(infoPtr : Long, progress: Float)
         {
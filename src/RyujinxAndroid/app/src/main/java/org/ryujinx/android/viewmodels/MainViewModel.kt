@@ -91,7 +91,8 @@ class MainViewModel(val activity: MainActivity) {
             enableShaderCache = settings.enableShaderCache,
             enableTextureRecompression = settings.enableTextureRecompression,
             rescale = settings.resScale,
-            backendThreading = org.ryujinx.android.BackendThreading.Auto.ordinal
+            backendThreading = org.ryujinx.android.BackendThreading.Auto.ordinal,
+            enableDisplayTiming = settings.enableDisplayTiming
         )
 
         if (!success)
@@ -166,7 +167,9 @@ class MainViewModel(val activity: MainActivity) {
                     settings.enablePtc,
                     false,
                     "UTC",
-                    settings.ignoreMissingServices
+                    settings.ignoreMissingServices,
+                    settings.jitCacheBudget,
+                    settings.useHugePages
                 )
 
                 semaphore.release()
@@ -194,7 +197,8 @@ class MainViewModel(val activity: MainActivity) {
             enableShaderCache = settings.enableShaderCache,
             enableTextureRecompression = settings.enableTextureRecompression,
             rescale = settings.resScale,
-            backendThreading = org.ryujinx.android.BackendThreading.Auto.ordinal
+            backendThreading = org.ryujinx.android.BackendThreading.Auto.ordinal,
+            enableDisplayTiming = settings.enableDisplayTiming
         )
 
         if (!success)
@@ -269,7 +273,9 @@ class MainViewModel(val activity: MainActivity) {
                     settings.enablePtc,
                     false,
                     "UTC",
-                    settings.ignoreMissingServices
+                    settings.ignoreMissingServices,
+                    settings.jitCacheBudget,
+                    settings.useHugePages
                 )
 
                 semaphore.release()
@@ -14,12 +14,15 @@ class QuickSettings(val activity: Activity) {
     var isHostMapped: Boolean
     var enableShaderCache: Boolean
     var enableTextureRecompression: Boolean
+    var enableDisplayTiming: Boolean
     var resScale: Float
     var isGrid: Boolean
     var useSwitchLayout: Boolean
     var enableMotion: Boolean
     var enablePerformanceMode: Boolean
     var controllerStickSensitivity: Float
+    var jitCacheBudget: Int
+    var useHugePages: Boolean
 
     // Logs
     var enableDebugLogs: Boolean
@@ -44,6 +47,7 @@ class QuickSettings(val activity: Activity) {
         ignoreMissingServices = sharedPref.getBoolean("ignoreMissingServices", false)
         enableShaderCache = sharedPref.getBoolean("enableShaderCache", true)
         enableTextureRecompression = sharedPref.getBoolean("enableTextureRecompression", false)
+        enableDisplayTiming = sharedPref.getBoolean("enableDisplayTiming", true)
         resScale = sharedPref.getFloat("resScale", 1f)
         useVirtualController = sharedPref.getBoolean("useVirtualController", true)
         isGrid = sharedPref.getBoolean("isGrid", true)
@@ -51,6 +55,8 @@ class QuickSettings(val activity: Activity) {
         enableMotion = sharedPref.getBoolean("enableMotion", true)
         enablePerformanceMode = sharedPref.getBoolean("enablePerformanceMode", true)
         controllerStickSensitivity = sharedPref.getFloat("controllerStickSensitivity", 1.0f)
+        jitCacheBudget = sharedPref.getInt("jitCacheBudget", 0)
+        useHugePages = sharedPref.getBoolean("useHugePages", false)
 
         enableDebugLogs = sharedPref.getBoolean("enableDebugLogs", false)
         enableStubLogs = sharedPref.getBoolean("enableStubLogs", false)
@@ -74,6 +80,7 @@ class QuickSettings(val activity: Activity) {
         editor.putBoolean("ignoreMissingServices", ignoreMissingServices)
         editor.putBoolean("enableShaderCache", enableShaderCache)
         editor.putBoolean("enableTextureRecompression", enableTextureRecompression)
+        editor.putBoolean("enableDisplayTiming", enableDisplayTiming)
         editor.putFloat("resScale", resScale)
         editor.putBoolean("useVirtualController", useVirtualController)
         editor.putBoolean("isGrid", isGrid)
@@ -81,6 +88,8 @@ class QuickSettings(val activity: Activity) {
         editor.putBoolean("enableMotion", enableMotion)
         editor.putBoolean("enablePerformanceMode", enablePerformanceMode)
         editor.putFloat("controllerStickSensitivity", controllerStickSensitivity)
+        editor.putInt("jitCacheBudget", jitCacheBudget)
+        editor.putBoolean("useHugePages", useHugePages)
 
         editor.putBoolean("enableDebugLogs", enableDebugLogs)
         editor.putBoolean("enableStubLogs", enableStubLogs)
@@ -48,8 +48,11 @@ class SettingsViewModel(var navController: NavHostController, val activity: Main
         enableDocked: MutableState<Boolean>,
         enablePtc: MutableState<Boolean>,
         ignoreMissingServices: MutableState<Boolean>,
+        jitCacheBudget: MutableState<Int>,
+        useHugePages: MutableState<Boolean>,
         enableShaderCache: MutableState<Boolean>,
         enableTextureRecompression: MutableState<Boolean>,
+        enableDisplayTiming: MutableState<Boolean>,
         resScale: MutableState<Float>,
         useVirtualController: MutableState<Boolean>,
         isGrid: MutableState<Boolean>,
@@ -74,9 +77,12 @@ class SettingsViewModel(var navController: NavHostController, val activity: Main
         enableDocked.value = sharedPref.getBoolean("enableDocked", true)
         enablePtc.value = sharedPref.getBoolean("enablePtc", true)
         ignoreMissingServices.value = sharedPref.getBoolean("ignoreMissingServices", false)
+        jitCacheBudget.value = sharedPref.getInt("jitCacheBudget", 0)
+        useHugePages.value = sharedPref.getBoolean("useHugePages", false)
         enableShaderCache.value = sharedPref.getBoolean("enableShaderCache", true)
         enableTextureRecompression.value =
             sharedPref.getBoolean("enableTextureRecompression", false)
+        enableDisplayTiming.value = sharedPref.getBoolean("enableDisplayTiming", true)
         resScale.value = sharedPref.getFloat("resScale", 1f)
         useVirtualController.value = sharedPref.getBoolean("useVirtualController", true)
         isGrid.value = sharedPref.getBoolean("isGrid", true)
@@ -103,8 +109,11 @@ class SettingsViewModel(var navController: NavHostController, val activity: Main
         enableDocked: MutableState<Boolean>,
         enablePtc: MutableState<Boolean>,
         ignoreMissingServices: MutableState<Boolean>,
+        jitCacheBudget: MutableState<Int>,
+        useHugePages: MutableState<Boolean>,
         enableShaderCache: MutableState<Boolean>,
         enableTextureRecompression: MutableState<Boolean>,
+        enableDisplayTiming: MutableState<Boolean>,
         resScale: MutableState<Float>,
         useVirtualController: MutableState<Boolean>,
         isGrid: MutableState<Boolean>,
@@ -130,8 +139,11 @@ class SettingsViewModel(var navController: NavHostController, val activity: Main
         editor.putBoolean("enableDocked", enableDocked.value)
         editor.putBoolean("enablePtc", enablePtc.value)
         editor.putBoolean("ignoreMissingServices", ignoreMissingServices.value)
+        editor.putInt("jitCacheBudget", jitCacheBudget.value)
+        editor.putBoolean("useHugePages", useHugePages.value)
         editor.putBoolean("enableShaderCache", enableShaderCache.value)
         editor.putBoolean("enableTextureRecompression", enableTextureRecompression.value)
+        editor.putBoolean("enableDisplayTiming", enableDisplayTiming.value)
         editor.putFloat("resScale", resScale.value)
         editor.putBoolean("useVirtualController", useVirtualController.value)
         editor.putBoolean("isGrid", isGrid.value)
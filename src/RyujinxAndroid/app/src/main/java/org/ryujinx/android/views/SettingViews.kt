@@ -106,12 +106,21 @@ class SettingViews {
             val ignoreMissingServices = remember {
                 mutableStateOf(false)
             }
+            val jitCacheBudget = remember {
+                mutableStateOf(0)
+            }
+            val useHugePages = remember {
+                mutableStateOf(false)
+            }
             val enableShaderCache = remember {
                 mutableStateOf(false)
             }
             val enableTextureRecompression = remember {
                 mutableStateOf(false)
             }
+            val enableDisplayTiming = remember {
+                mutableStateOf(true)
+            }
             val resScale = remember {
                 mutableStateOf(1f)
             }
@@ -148,8 +157,11 @@ class SettingViews {
                     isHostMapped,
                     useNce,
                     enableVsync, enableDocked, enablePtc, ignoreMissingServices,
+                    jitCacheBudget,
+                    useHugePages,
                     enableShaderCache,
                     enableTextureRecompression,
+                    enableDisplayTiming,
                     resScale,
                     useVirtualController,
                     isGrid,
@@ -184,8 +196,11 @@ class SettingViews {
                                     enableDocked,
                                     enablePtc,
                                     ignoreMissingServices,
+                                    jitCacheBudget,
+                                    useHugePages,
                                     enableShaderCache,
                                     enableTextureRecompression,
+                                    enableDisplayTiming,
                                     resScale,
                                     useVirtualController,
                                     isGrid,
@@ -464,6 +479,21 @@ class SettingViews {
                                     isHostMapped.value = !isHostMapped.value
                                 })
                             }
+                            Row(
+                                modifier = Modifier
+                                    .fillMaxWidth()
+                                    .padding(8.dp),
+                                horizontalArrangement = Arrangement.SpaceBetween,
+                                verticalAlignment = Alignment.CenterVertically
+                            ) {
+                                Text(
+                                    text = "Use Huge Pages",
+                                    modifier = Modifier.align(Alignment.CenterVertically)
+                                )
+                                Switch(checked = useHugePages.value, onCheckedChange = {
+                                    useHugePages.value = !useHugePages.value
+                                })
+                            }
                             Row(
                                 modifier = Modifier
                                     .fillMaxWidth()
@@ -494,6 +524,25 @@ class SettingViews {
                                     enablePtc.value = !enablePtc.value
                                 })
                             }
+                            Row(
+                                modifier = Modifier
+                                    .fillMaxWidth()
+                                    .padding(8.dp),
+                                horizontalArrangement = Arrangement.SpaceBetween,
+                                verticalAlignment = Alignment.CenterVertically
+                            ) {
+                                Text(
+                                    text = "JIT Cache Budget",
+                                    modifier = Modifier.align(Alignment.CenterVertically)
+                                )
+                                Text(text = if (jitCacheBudget.value == 0) "Unlimited" else jitCacheBudget.value.toString() + " MiB")
+                            }
+                            Slider(value = jitCacheBudget.value.toFloat(),
+                                valueRange = 0f..1024f,
+                                steps = 7,
+                                onValueChange = { it ->
+                                    jitCacheBudget.value = it.toInt()
+                                })
                             Row(
                                 modifier = Modifier
                                     .fillMaxWidth()
@@ -722,6 +771,24 @@ class SettingViews {
                                             !enableTextureRecompression.value
                                     })
                             }
+                            Row(
+                                modifier = Modifier
+                                    .fillMaxWidth()
+                                    .padding(8.dp),
+                                horizontalArrangement = Arrangement.SpaceBetween,
+                                verticalAlignment = Alignment.CenterVertically
+                            ) {
+                                Text(
+                                    text = "Enable Display Timing",
+                                    modifier = Modifier.align(Alignment.CenterVertically)
+                                )
+                                Switch(
+                                    checked = enableDisplayTiming.value,
+                                    onCheckedChange = {
+                                        enableDisplayTiming.value =
+                                            !enableDisplayTiming.value
+                                    })
+                            }
                             Row(
                                 modifier = Modifier
                                     .fillMaxWidth()
@@ -1138,8 +1205,11 @@ class SettingViews {
                     settingsViewModel.save(
                         isHostMapped,
                         useNce, enableVsync, enableDocked, enablePtc, ignoreMissingServices,
+                        jitCacheBudget,
+                        useHugePages,
                         enableShaderCache,
                         enableTextureRecompression,
+                        enableDisplayTiming,
                         resScale,
                         useVirtualController,
                         isGrid,